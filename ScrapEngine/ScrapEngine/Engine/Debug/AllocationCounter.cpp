@@ -0,0 +1,86 @@
+#include <Engine/Debug/AllocationCounter.h>
+
+#ifdef SCRAP_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+//Plain counter, the operator new can be called before any other static is initialized
+static thread_local uint64_t thread_allocation_count = 0;
+
+void* operator new(const size_t size)
+{
+	thread_allocation_count++;
+	void* memory = std::malloc(size == 0 ? 1 : size);
+	if (!memory)
+	{
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* operator new[](const size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(const size_t size, const std::nothrow_t&) noexcept
+{
+	thread_allocation_count++;
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](const size_t size, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+bool ScrapEngine::Debug::AllocationCounter::is_enabled()
+{
+	return true;
+}
+
+uint64_t ScrapEngine::Debug::AllocationCounter::get_thread_allocation_count()
+{
+	return thread_allocation_count;
+}
+#else
+bool ScrapEngine::Debug::AllocationCounter::is_enabled()
+{
+	return false;
+}
+
+uint64_t ScrapEngine::Debug::AllocationCounter::get_thread_allocation_count()
+{
+	return 0;
+}
+#endif
+
+ScrapEngine::Debug::AllocationScope::AllocationScope()
+	: start_count_(AllocationCounter::get_thread_allocation_count())
+{
+}
+
+uint64_t ScrapEngine::Debug::AllocationScope::get_allocation_count() const
+{
+	return AllocationCounter::get_thread_allocation_count() - start_count_;
+}
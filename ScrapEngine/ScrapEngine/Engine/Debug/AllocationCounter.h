@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+//Define SCRAP_COUNT_ALLOCATIONS to replace the global operator new and count the heap allocations of every thread
+//Without it the counters always return 0, so the checks can stay in the code
+namespace ScrapEngine
+{
+	namespace Debug
+	{
+		class AllocationCounter
+		{
+		public:
+			//True if the global operator new is replaced by the counting one
+			static bool is_enabled();
+
+			//Allocations made by the calling thread since it started
+			static uint64_t get_thread_allocation_count();
+		};
+
+		//Count the allocations made by the calling thread while the scope is alive
+		class AllocationScope
+		{
+		private:
+			uint64_t start_count_;
+		public:
+			AllocationScope();
+			~AllocationScope() = default;
+
+			uint64_t get_allocation_count() const;
+		};
+	}
+}
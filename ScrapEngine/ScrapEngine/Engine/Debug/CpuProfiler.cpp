@@ -0,0 +1,160 @@
+#include <Engine/Debug/CpuProfiler.h>
+#include <Engine/Debug/DebugLog.h>
+#include <fstream>
+
+std::atomic<bool> ScrapEngine::Debug::CpuProfiler::enabled_(false);
+std::mutex ScrapEngine::Debug::CpuProfiler::buffers_mutex_;
+std::vector<std::unique_ptr<ScrapEngine::Debug::CpuProfiler::thread_buffer>>
+ScrapEngine::Debug::CpuProfiler::buffers_;
+const std::chrono::steady_clock::time_point ScrapEngine::Debug::CpuProfiler::start_time_ =
+	std::chrono::steady_clock::now();
+
+ScrapEngine::Debug::CpuProfiler::event_slot::event_slot()
+	: sequence(0), name(nullptr), start_us(0), duration_us(0)
+{
+}
+
+ScrapEngine::Debug::CpuProfiler::thread_buffer::thread_buffer()
+	: events(new event_slot[thread_buffer_capacity]), write_count(0)
+{
+}
+
+ScrapEngine::Debug::CpuProfiler::thread_buffer* ScrapEngine::Debug::CpuProfiler::get_thread_buffer()
+{
+	//The buffers are never released before the exit, so the pointer stays valid for the whole thread
+	thread_local thread_buffer* buffer = nullptr;
+	if (!buffer)
+	{
+		std::lock_guard<std::mutex> lock(buffers_mutex_);
+		buffers_.emplace_back(new thread_buffer());
+		buffer = buffers_.back().get();
+		buffer->thread_id = static_cast<uint32_t>(buffers_.size());
+		buffer->thread_name = "thread " + std::to_string(buffer->thread_id);
+	}
+	return buffer;
+}
+
+void ScrapEngine::Debug::CpuProfiler::set_enabled(const bool enabled)
+{
+	enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+bool ScrapEngine::Debug::CpuProfiler::is_enabled()
+{
+	return enabled_.load(std::memory_order_relaxed);
+}
+
+void ScrapEngine::Debug::CpuProfiler::set_thread_name(const std::string& name)
+{
+	thread_buffer* buffer = get_thread_buffer();
+	std::lock_guard<std::mutex> lock(buffers_mutex_);
+	buffer->thread_name = name;
+}
+
+uint64_t ScrapEngine::Debug::CpuProfiler::now_us()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - start_time_).count());
+}
+
+void ScrapEngine::Debug::CpuProfiler::add_event(const char* name, const uint64_t start_us,
+                                                const uint64_t duration_us)
+{
+	thread_buffer* buffer = get_thread_buffer();
+	//Only this thread writes, the slot is marked as incomplete before its fields are overwritten
+	const uint64_t index = buffer->write_count.load(std::memory_order_relaxed);
+	event_slot& slot = buffer->events[index % thread_buffer_capacity];
+	slot.sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.start_us.store(start_us, std::memory_order_relaxed);
+	slot.duration_us.store(duration_us, std::memory_order_relaxed);
+	slot.sequence.store(index + 1, std::memory_order_release);
+	buffer->write_count.store(index + 1, std::memory_order_release);
+}
+
+bool ScrapEngine::Debug::CpuProfiler::read_event(const event_slot& slot, const uint64_t index, trace_event& event)
+{
+	if (slot.sequence.load(std::memory_order_acquire) != index + 1)
+	{
+		return false;
+	}
+	event.name = slot.name.load(std::memory_order_relaxed);
+	event.start_us = slot.start_us.load(std::memory_order_relaxed);
+	event.duration_us = slot.duration_us.load(std::memory_order_relaxed);
+	//If the sequence is still the same no write touched the slot during the copy
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return slot.sequence.load(std::memory_order_relaxed) == index + 1;
+}
+
+void ScrapEngine::Debug::CpuProfiler::write_escaped(std::ostream& stream, const char* text)
+{
+	for (const char* c = text; *c; c++)
+	{
+		if (*c == '"' || *c == '\\')
+		{
+			stream << '\\';
+		}
+		stream << *c;
+	}
+}
+
+bool ScrapEngine::Debug::CpuProfiler::dump_chrome_trace(const std::string& path)
+{
+	std::ofstream file(path, std::ios::out | std::ios::trunc);
+	if (!file.is_open())
+	{
+		DebugLog::print_to_console_log("[CpuProfiler] Cannot open the trace file " + path);
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(buffers_mutex_);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	for (const std::unique_ptr<thread_buffer>& buffer : buffers_)
+	{
+		if (!first)
+		{
+			file << ',';
+		}
+		first = false;
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread_id
+			<< ",\"args\":{\"name\":\"";
+		write_escaped(file, buffer->thread_name.c_str());
+		file << "\"}}";
+
+		//Only the last thread_buffer_capacity events are still in the ring
+		const uint64_t count = buffer->write_count.load(std::memory_order_acquire);
+		const uint64_t begin = count > thread_buffer_capacity ? count - thread_buffer_capacity : 0;
+		trace_event event;
+		for (uint64_t i = begin; i < count; i++)
+		{
+			if (!read_event(buffer->events[i % thread_buffer_capacity], i, event))
+			{
+				continue;
+			}
+			file << ",\n{\"name\":\"";
+			write_escaped(file, event.name ? event.name : "");
+			file << "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id
+				<< ",\"ts\":" << event.start_us << ",\"dur\":" << event.duration_us << '}';
+		}
+	}
+	file << "]}\n";
+
+	DebugLog::print_to_console_log("[CpuProfiler] Trace written to " + path);
+	return true;
+}
+
+ScrapEngine::Debug::CpuProfilerScope::CpuProfilerScope(const char* name)
+	: name_(CpuProfiler::is_enabled() ? name : nullptr), start_us_(name_ ? CpuProfiler::now_us() : 0)
+{
+}
+
+ScrapEngine::Debug::CpuProfilerScope::~CpuProfilerScope()
+{
+	//A zone started while the profiler was disabled is not recorded
+	if (name_)
+	{
+		CpuProfiler::add_event(name_, start_us_, CpuProfiler::now_us() - start_us_);
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//Scoped cpu zones, define SCRAP_DISABLE_CPU_PROFILER to compile them out
+//The name must be a string literal (or live for the whole execution), only its pointer is stored
+#ifndef SCRAP_DISABLE_CPU_PROFILER
+#define SCRAP_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SCRAP_PROFILE_CONCAT(a, b) SCRAP_PROFILE_CONCAT_IMPL(a, b)
+#define SCRAP_PROFILE_SCOPE(name) \
+	const ScrapEngine::Debug::CpuProfilerScope SCRAP_PROFILE_CONCAT(scrap_profile_scope_, __LINE__)(name)
+#define SCRAP_PROFILE_FUNCTION() SCRAP_PROFILE_SCOPE(__FUNCTION__)
+#define SCRAP_PROFILE_THREAD_NAME(name) ScrapEngine::Debug::CpuProfiler::set_thread_name(name)
+#else
+#define SCRAP_PROFILE_SCOPE(name)
+#define SCRAP_PROFILE_FUNCTION()
+#define SCRAP_PROFILE_THREAD_NAME(name)
+#endif
+
+namespace ScrapEngine
+{
+	namespace Debug
+	{
+		//Collect the cpu zones of every thread and export them as Chrome trace_event json
+		//Every thread writes in its own ring buffer without locks, the oldest events are overwritten
+		//The mutex is used only the first time a thread records an event and by the dump
+		//Build with SCRAP_DISABLE_CPU_PROFILER (Shipping configuration) to remove the zones
+		class CpuProfiler
+		{
+		public:
+			struct trace_event
+			{
+				const char* name = nullptr;
+				//Microseconds from the start of the profiler
+				uint64_t start_us = 0;
+				uint64_t duration_us = 0;
+			};
+
+			//Events kept for each thread
+			static const uint32_t thread_buffer_capacity = 1 << 16;
+		private:
+			//Ring slot guarded by a sequence number, like a seqlock
+			//sequence is 0 while the slot is written and index + 1 once the event index is complete
+			//The fields are atomics so the dump can read them while the thread overwrites the slot
+			struct event_slot
+			{
+				std::atomic<uint64_t> sequence;
+				std::atomic<const char*> name;
+				std::atomic<uint64_t> start_us;
+				std::atomic<uint64_t> duration_us;
+
+				event_slot();
+			};
+
+			//Written only by its thread, read by the dump
+			struct thread_buffer
+			{
+				std::unique_ptr<event_slot[]> events;
+				std::atomic<uint64_t> write_count;
+				uint32_t thread_id = 0;
+				std::string thread_name;
+
+				thread_buffer();
+			};
+
+			static std::atomic<bool> enabled_;
+			static std::mutex buffers_mutex_;
+			static std::vector<std::unique_ptr<thread_buffer>> buffers_;
+			static const std::chrono::steady_clock::time_point start_time_;
+
+			static thread_buffer* get_thread_buffer();
+			//Copy the event index of the slot, false if it was overwritten before or during the copy
+			static bool read_event(const event_slot& slot, uint64_t index, trace_event& event);
+			static void write_escaped(std::ostream& stream, const char* text);
+		public:
+			//The zones are recorded only while enabled, disabled by default
+			static void set_enabled(bool enabled);
+			static bool is_enabled();
+
+			//Name shown for the calling thread in the trace
+			static void set_thread_name(const std::string& name);
+
+			static uint64_t now_us();
+			static void add_event(const char* name, uint64_t start_us, uint64_t duration_us);
+
+			//Write the events recorded so far, the threads can keep recording while it's written
+			//Events overwritten during the dump are skipped, so it's better called between frames
+			static bool dump_chrome_trace(const std::string& path);
+		};
+
+		//Record the time between its construction and its destruction, use SCRAP_PROFILE_SCOPE
+		class CpuProfilerScope
+		{
+		private:
+			const char* name_;
+			uint64_t start_us_;
+		public:
+			explicit CpuProfilerScope(const char* name);
+			~CpuProfilerScope();
+
+			CpuProfilerScope(const CpuProfilerScope&) = delete;
+			CpuProfilerScope& operator=(const CpuProfilerScope&) = delete;
+		};
+	}
+}
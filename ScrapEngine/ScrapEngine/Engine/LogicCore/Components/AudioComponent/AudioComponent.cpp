@@ -2,13 +2,13 @@
 #include <Engine/Audio/Source/AudioSource.h>
 
 ScrapEngine::Core::AudioComponent::AudioComponent(Audio::AudioSource* input_audio_source)
-	: SComponent("AudioComponent"), audio_source_(input_audio_source)
+	: PooledComponent("AudioComponent"), audio_source_(input_audio_source)
 {
 }
 
 ScrapEngine::Core::AudioComponent::~AudioComponent()
 {
-	delete audio_source_;
+	//The source is owned by the AudioManager, deleted by unload_sound() or with the manager
 }
 
 void ScrapEngine::Core::AudioComponent::set_source_pitch(const float pitch) const
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <Engine/LogicCore/Components/SComponent.h>
+#include <Engine/LogicCore/Components/PooledComponent.h>
 
 namespace ScrapEngine
 {
@@ -14,9 +14,10 @@ namespace ScrapEngine
 {
 	namespace Core
 	{
-		class AudioComponent : public SComponent
+		class AudioComponent : public PooledComponent<AudioComponent, component_family::audio>
 		{
 		protected:
+			//Owned by the AudioManager
 			Audio::AudioSource* audio_source_ = nullptr;
 		public:
 			AudioComponent(Audio::AudioSource* input_audio_source);
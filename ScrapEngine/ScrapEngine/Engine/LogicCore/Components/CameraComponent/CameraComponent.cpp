@@ -9,7 +9,7 @@ void ScrapEngine::Core::CameraComponent::set_rotation(const SVector3& rotation)
 }
 
 ScrapEngine::Core::CameraComponent::CameraComponent(ScrapEngine::Render::Camera* game_camera)
-	: SComponent("CameraComponent"), game_camera_ref_(game_camera)
+	: PooledComponent("CameraComponent"), game_camera_ref_(game_camera)
 {
 }
 
@@ -100,7 +100,6 @@ void ScrapEngine::Core::CameraComponent::update_component_location()
 void ScrapEngine::Core::CameraComponent::update_component_rotation()
 {
 	SComponent::update_component_rotation();
-	game_camera_ref_->set_camera_location(get_component_location());
 	set_rotation(get_component_rotation());
 }
 
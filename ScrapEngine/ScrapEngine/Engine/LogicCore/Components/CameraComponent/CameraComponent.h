@@ -1,6 +1,6 @@
 #pragma once
 
-#include <Engine/LogicCore/Components/SComponent.h>
+#include <Engine/LogicCore/Components/PooledComponent.h>
 
 namespace ScrapEngine
 {
@@ -14,7 +14,7 @@ namespace ScrapEngine
 {
 	namespace Core
 	{
-		class CameraComponent : public SComponent
+		class CameraComponent : public PooledComponent<CameraComponent, component_family::camera>
 		{
 		private:
 			Render::Camera* game_camera_ref_ = nullptr;
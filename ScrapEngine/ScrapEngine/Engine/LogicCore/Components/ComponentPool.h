@@ -0,0 +1,195 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+namespace ScrapEngine
+{
+	namespace Core
+	{
+		//Compile time ids of the component families, each family has its own ComponentPool
+		//The components of a family derive from the same class (ex: BoxRigidBodyComponent from RigidBodyComponent)
+		enum class component_family : uint8_t
+		{
+			mesh = 0,
+			camera,
+			rigidbody,
+			trigger,
+			audio,
+			//Components without a pool, defined outside of the engine
+			none
+		};
+
+		static const size_t component_family_count = static_cast<size_t>(component_family::none);
+
+		//Storage of the components of a family
+		//The objects are constructed in fixed size chunks, so they are close in memory and they never move
+		//Every chunk keeps a mask of its alive slots, the iterations walk the chunks in memory order
+		//A derived class bigger than T is allocated on the heap and listed after the chunks
+		//Used only by the game thread, like the creation and destruction of the components
+		//This class is a Singleton for each family
+		template <typename T>
+		class ComponentPool
+		{
+		private:
+			//Singleton static instance
+			static ComponentPool* instance_;
+
+			//The constructor is private because this class is a Singleton
+			ComponentPool() = default;
+
+			static const size_t chunk_capacity = 64;
+			static const uint32_t heap_chunk = UINT32_MAX;
+			//Set in the indices of the components allocated on the heap
+			static const uint32_t heap_index_bit = 0x80000000u;
+
+			typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_type;
+
+			//The header is also written before the heap allocations, so deallocate() finds the owner in O(1)
+			struct slot
+			{
+				uint32_t chunk_index;
+				storage_type storage;
+			};
+
+			struct chunk
+			{
+				slot slots[chunk_capacity];
+				T* components[chunk_capacity];
+				uint64_t alive = 0;
+			};
+
+			std::vector<std::unique_ptr<chunk>> chunks_;
+			std::vector<slot*> free_slots_;
+			std::vector<T*> heap_components_;
+			//Slot given by the last allocate(), the constructor of the component calls add() right after it
+			slot* constructing_ = nullptr;
+
+			static size_t storage_offset()
+			{
+				return offsetof(slot, storage);
+			}
+		public:
+			~ComponentPool() = default;
+
+			static ComponentPool* get_instance()
+			{
+				if (instance_ == nullptr)
+				{
+					instance_ = new ComponentPool();
+				}
+				return instance_;
+			}
+
+			//Memory for a component of the family, a derived class bigger than T uses the heap
+			void* allocate(const size_t size)
+			{
+				if (size > sizeof(storage_type))
+				{
+					char* memory = static_cast<char*>(::operator new(storage_offset() + size));
+					reinterpret_cast<slot*>(memory)->chunk_index = heap_chunk;
+					constructing_ = nullptr;
+					return memory + storage_offset();
+				}
+				if (free_slots_.empty())
+				{
+					const uint32_t chunk_index = static_cast<uint32_t>(chunks_.size());
+					chunks_.emplace_back(new chunk());
+					//Reversed, so the slots are used in memory order
+					for (size_t i = chunk_capacity; i-- > 0;)
+					{
+						chunks_.back()->slots[i].chunk_index = chunk_index;
+						free_slots_.push_back(&chunks_.back()->slots[i]);
+					}
+				}
+				slot* memory = free_slots_.back();
+				free_slots_.pop_back();
+				constructing_ = memory;
+				return &memory->storage;
+			}
+
+			void deallocate(void* memory)
+			{
+				slot* memory_slot = reinterpret_cast<slot*>(static_cast<char*>(memory) - storage_offset());
+				if (memory_slot->chunk_index == heap_chunk)
+				{
+					::operator delete(memory_slot);
+					return;
+				}
+				free_slots_.push_back(memory_slot);
+			}
+
+			//Return the index of the component, used by remove()
+			uint32_t add(T* component)
+			{
+				slot* constructing = constructing_;
+				constructing_ = nullptr;
+				//The component is in the slot allocated for it, unless it was not created by allocate()
+				const uintptr_t address = reinterpret_cast<uintptr_t>(component);
+				const uintptr_t storage = constructing ? reinterpret_cast<uintptr_t>(&constructing->storage) : 0;
+				if (constructing && address >= storage && address < storage + sizeof(storage_type))
+				{
+					chunk& owner_chunk = *chunks_[constructing->chunk_index];
+					const size_t slot_index = static_cast<size_t>(constructing - owner_chunk.slots);
+					owner_chunk.components[slot_index] = component;
+					owner_chunk.alive |= uint64_t(1) << slot_index;
+					return static_cast<uint32_t>(constructing->chunk_index * chunk_capacity + slot_index);
+				}
+				heap_components_.push_back(component);
+				return heap_index_bit | static_cast<uint32_t>(heap_components_.size() - 1);
+			}
+
+			//The components in the chunks never move
+			//On the heap the last component takes the place of the removed one, it's returned so its index can be updated
+			//Return nullptr if no component moved
+			T* remove(const uint32_t index)
+			{
+				if (!(index & heap_index_bit))
+				{
+					chunks_[index / chunk_capacity]->alive &= ~(uint64_t(1) << (index % chunk_capacity));
+					return nullptr;
+				}
+				const uint32_t heap_index = index & ~heap_index_bit;
+				const size_t last = heap_components_.size() - 1;
+				T* moved = nullptr;
+				if (heap_index != last)
+				{
+					moved = heap_components_[last];
+					heap_components_[heap_index] = moved;
+				}
+				heap_components_.pop_back();
+				return moved;
+			}
+
+			//Call function for every component, the ones in the chunks in memory order
+			template <typename Function>
+			void for_each(Function& function) const
+			{
+				for (const std::unique_ptr<chunk>& current_chunk : chunks_)
+				{
+					const uint64_t alive = current_chunk->alive;
+					for (size_t i = 0; i < chunk_capacity && (alive >> i) != 0; i++)
+					{
+						if (alive & (uint64_t(1) << i))
+						{
+							function(current_chunk->components[i]);
+						}
+					}
+				}
+				for (T* component : heap_components_)
+				{
+					function(component);
+				}
+			}
+		};
+
+		//Init static instance reference
+
+		template <typename T>
+		ComponentPool<T>* ComponentPool<T>::instance_ = nullptr;
+	}
+}
@@ -12,7 +12,18 @@
 #include <Engine/LogicCore/Components/AudioComponent/2dAudioComponent/2DAudioComponent.h>
 #include <Engine/LogicCore/Components/AudioComponent/3dAudioComponent/3DAudioComponent.h>
 #include <Engine/LogicCore/Components/CameraComponent/CameraComponent.h>
-#include <Engine/Rendering/Model/MeshInstance/VulkanMeshInstance.h>
+#include <Engine/LogicCore/GameObject/SGameObject.h>
+#include <Engine/Debug/DebugLog.h>
+
+ScrapEngine::Core::ComponentsManager::~ComponentsManager()
+{
+	//The render manager is deleted before this class and it deletes its meshes,
+	//the physics and audio managers are still alive
+	for (prefab_pool& pool : prefabs_)
+	{
+		destroy_prefab_pool(pool, false);
+	}
+}
 
 void ScrapEngine::Core::ComponentsManager::set_render_manager(Render::RenderManager* input_render_manager_ref)
 {
@@ -33,10 +44,12 @@ ScrapEngine::Core::MeshComponent* ScrapEngine::Core::ComponentsManager::create_n
 	const std::string& vertex_shader_path, const std::string& fragment_shader_path, const std::string& model_path,
 	const std::vector<std::string>& textures_path)
 {
-	Render::VulkanMeshInstance* mesh = render_manager_ref_->load_mesh(vertex_shader_path, fragment_shader_path,
-	                                                                  model_path,
-	                                                                  textures_path);
-	MeshComponent* mesh_component = new MeshComponent(mesh);
+	Render::VulkanMeshInstance* mesh_instance = nullptr;
+	const slot_handle mesh = render_manager_ref_->load_mesh(vertex_shader_path, fragment_shader_path,
+	                                                        model_path,
+	                                                        textures_path,
+	                                                        &mesh_instance);
+	MeshComponent* mesh_component = new MeshComponent(render_manager_ref_, mesh, mesh_instance);
 
 	loaded_meshes_.insert({mesh_component, mesh});
 
@@ -47,10 +60,12 @@ ScrapEngine::Core::MeshComponent* ScrapEngine::Core::ComponentsManager::create_n
 	const std::string& model_path, const std::vector<std::string>& textures_path)
 {
 	//Use default render_manager_ shader
-	Render::VulkanMeshInstance* mesh = render_manager_ref_->load_mesh(
+	Render::VulkanMeshInstance* mesh_instance = nullptr;
+	const slot_handle mesh = render_manager_ref_->load_mesh(
 		model_path,
-		textures_path);
-	MeshComponent* mesh_component = new MeshComponent(mesh);
+		textures_path,
+		&mesh_instance);
+	MeshComponent* mesh_component = new MeshComponent(render_manager_ref_, mesh, mesh_instance);
 
 	loaded_meshes_.insert({mesh_component, mesh});
 
@@ -63,7 +78,7 @@ void ScrapEngine::Core::ComponentsManager::destroy_mesh_component(
 	//If the element is present
 	if (loaded_meshes_.find(component_to_destroy) != loaded_meshes_.end())
 	{
-		loaded_meshes_[component_to_destroy]->set_for_deletion();
+		render_manager_ref_->unload_mesh(loaded_meshes_[component_to_destroy]);
 		//Erase by key
 		loaded_meshes_.erase(component_to_destroy);
 	}
@@ -80,10 +95,14 @@ ScrapEngine::Core::CameraComponent* ScrapEngine::Core::ComponentsManager::get_ca
 
 void ScrapEngine::Core::ComponentsManager::update_rigidbody_physics(const float factor)
 {
-	for (auto const& element : loaded_rigidbody_collisions_)
+	//Stream over the rigidbody pool instead of the map nodes
+	for_each<RigidBodyComponent>([factor](const RigidBodyComponent& component)
 	{
-		element.first->update_transform(factor);
-	}
+		if (component.in_world_)
+		{
+			component.update_transform(factor);
+		}
+	});
 }
 
 ScrapEngine::Core::BoxRigidBodyComponent* ScrapEngine::Core::ComponentsManager::create_box_rigidbody_component(
@@ -193,6 +212,7 @@ void ScrapEngine::Core::ComponentsManager::destroy_rigidbody_component(RigidBody
 		loaded_rigidbody_inverse_.erase(loaded_rigidbody_collisions_[component_to_destroy]);
 		//Remove it
 		physics_manager_ref_->remove_rigidbody(loaded_rigidbody_collisions_[component_to_destroy]);
+		component_to_destroy->in_world_ = false;
 		//Erase by key
 		loaded_rigidbody_collisions_.erase(component_to_destroy);
 	}
@@ -229,3 +249,191 @@ void ScrapEngine::Core::ComponentsManager::destroy_trigger_component(TriggerComp
 		loaded_collider_collisions_.erase(component_to_destroy);
 	}
 }
+
+ScrapEngine::Core::prefab_id ScrapEngine::Core::ComponentsManager::register_prefab(
+	const prefab_description& description)
+{
+	prefab_pool pool;
+	pool.description = description;
+	prefabs_.push_back(pool);
+
+	return static_cast<prefab_id>(prefabs_.size() - 1);
+}
+
+void ScrapEngine::Core::ComponentsManager::prewarm_prefab(const prefab_id prefab, const size_t count)
+{
+	prefab_pool& pool = prefabs_[prefab];
+	pool.instances.reserve(pool.instances.size() + count);
+	pool.free_instances.reserve(pool.free_instances.size() + count);
+	for (size_t i = 0; i < count; i++)
+	{
+		pool.free_instances.push_back(create_prefab_instance(prefab));
+	}
+}
+
+ScrapEngine::Core::prefab_instance* ScrapEngine::Core::ComponentsManager::acquire_prefab(
+	const prefab_id prefab, const STransform& transform)
+{
+	prefab_pool& pool = prefabs_[prefab];
+	prefab_instance* instance;
+	if (!pool.free_instances.empty())
+	{
+		instance = pool.free_instances.back();
+		pool.free_instances.pop_back();
+	}
+	else
+	{
+		//The pool was too small, this spawn loads the resources
+		Debug::DebugLog::print_to_console_log("[ComponentsManager] Prefab pool " + std::to_string(prefab) +
+			" is empty, creating a new instance");
+		instance = create_prefab_instance(prefab);
+	}
+	instance->in_use = true;
+	place_prefab_instance(pool, instance, transform);
+
+	return instance;
+}
+
+void ScrapEngine::Core::ComponentsManager::instantiate_prefab(const prefab_id prefab,
+                                                              const std::vector<STransform>& transforms,
+                                                              std::vector<prefab_instance*>& instances)
+{
+	instances.reserve(instances.size() + transforms.size());
+	for (const STransform& transform : transforms)
+	{
+		instances.push_back(acquire_prefab(prefab, transform));
+	}
+}
+
+void ScrapEngine::Core::ComponentsManager::release_prefab(prefab_instance* instance)
+{
+	if (!instance->in_use)
+	{
+		return;
+	}
+	instance->in_use = false;
+	//Detach from the game object that used the instance
+	SComponent* components[] = {instance->mesh, instance->trigger, instance->sound};
+	for (SComponent* component : components)
+	{
+		if (component && component->get_owner())
+		{
+			component->get_owner()->remove_component(component);
+		}
+	}
+	instance->mesh->set_is_visible(false);
+	if (instance->trigger)
+	{
+		instance->trigger->set_is_active(false);
+	}
+	if (instance->sound)
+	{
+		instance->sound->stop();
+	}
+	prefabs_[instance->prefab].free_instances.push_back(instance);
+}
+
+size_t ScrapEngine::Core::ComponentsManager::get_prefab_free_count(const prefab_id prefab) const
+{
+	return prefabs_[prefab].free_instances.size();
+}
+
+void ScrapEngine::Core::ComponentsManager::unregister_prefab(const prefab_id prefab)
+{
+	destroy_prefab_pool(prefabs_[prefab], true);
+}
+
+void ScrapEngine::Core::ComponentsManager::destroy_prefab_pool(prefab_pool& pool, const bool unload_meshes)
+{
+	for (prefab_instance* instance : pool.instances)
+	{
+		if (unload_meshes)
+		{
+			release_prefab(instance);
+			destroy_mesh_component(instance->mesh);
+		}
+		else
+		{
+			//The mesh instance is gone, only detach the components from the game objects still using them
+			SComponent* components[] = {instance->mesh, instance->trigger, instance->sound};
+			for (SComponent* component : components)
+			{
+				if (component && component->get_owner())
+				{
+					component->get_owner()->remove_component(component);
+				}
+			}
+			loaded_meshes_.erase(instance->mesh);
+		}
+		delete instance->mesh;
+		if (instance->trigger)
+		{
+			destroy_trigger_component(instance->trigger);
+			delete instance->trigger;
+		}
+		if (instance->sound)
+		{
+			unload_sound(instance->sound);
+			delete instance->sound;
+		}
+		delete instance;
+	}
+	pool.instances.clear();
+	pool.free_instances.clear();
+}
+
+ScrapEngine::Core::prefab_instance* ScrapEngine::Core::ComponentsManager::create_prefab_instance(
+	const prefab_id prefab)
+{
+	const prefab_description& description = prefabs_[prefab].description;
+	prefab_instance* instance = new prefab_instance();
+	instance->prefab = prefab;
+	//The model, the textures and the pipelines are shared by the pools, only the per instance data is created
+	if (description.vertex_shader_path.empty() || description.fragment_shader_path.empty())
+	{
+		instance->mesh = create_new_mesh_component(description.model_path, description.textures_path);
+	}
+	else
+	{
+		instance->mesh = create_new_mesh_component(description.vertex_shader_path,
+		                                           description.fragment_shader_path,
+		                                           description.model_path, description.textures_path);
+	}
+	instance->mesh->set_is_visible(false);
+	instance->mesh->owned_by_pool_ = true;
+	if (description.trigger_size.get_x() > 0.f || description.trigger_size.get_y() > 0.f ||
+		description.trigger_size.get_z() > 0.f)
+	{
+		instance->trigger = create_box_trigger_component(description.trigger_size, SVector3());
+		instance->trigger->set_is_active(false);
+		instance->trigger->owned_by_pool_ = true;
+	}
+	if (!description.sound_path.empty())
+	{
+		instance->sound = create_3d_sound(description.sound_path);
+		instance->sound->set_source_gain(description.sound_gain);
+		instance->sound->owned_by_pool_ = true;
+	}
+	prefabs_[prefab].instances.push_back(instance);
+
+	return instance;
+}
+
+void ScrapEngine::Core::ComponentsManager::place_prefab_instance(const prefab_pool& pool, prefab_instance* instance,
+                                                                 const STransform& transform)
+{
+	instance->mesh->set_component_location(transform.get_position());
+	instance->mesh->set_component_rotation(transform.get_rotation());
+	instance->mesh->set_component_scale(transform.get_scale() * pool.description.mesh_scale);
+	instance->mesh->set_is_visible(true);
+	if (instance->trigger)
+	{
+		instance->trigger->set_component_location(transform.get_position());
+		instance->trigger->set_component_rotation(transform.get_rotation());
+		instance->trigger->set_is_active(true);
+	}
+	if (instance->sound)
+	{
+		instance->sound->set_component_location(transform.get_position());
+	}
+}
@@ -1,7 +1,14 @@
 ﻿#pragma once
 
 #include <Engine/LogicCore/Math/Vector/SVector3.h>
+#include <Engine/LogicCore/Math/Transform/STransform.h>
+#include <Engine/LogicCore/Components/ComponentPool.h>
+#include <Engine/LogicCore/GameObject/SGameObject.h>
+#include <Engine/Utility/SlotMap.h>
 #include <unordered_map>
+#include <vector>
+#include <string>
+#include <type_traits>
 
 namespace ScrapEngine
 {
@@ -25,7 +32,6 @@ namespace ScrapEngine
 {
 	namespace Render
 	{
-		class VulkanMeshInstance;
 		class RenderManager;
 	}
 }
@@ -70,6 +76,49 @@ namespace ScrapEngine
 			float hit_fraction;
 		};
 
+		typedef uint32_t prefab_id;
+
+		/**
+		 * \brief Components shared by all the instances of a prefab, registered once
+		 */
+		struct prefab_description
+		{
+			std::string model_path;
+			std::vector<std::string> textures_path;
+			/**
+			 * \brief Empty to use the default shaders
+			 */
+			std::string vertex_shader_path;
+			std::string fragment_shader_path;
+			/**
+			 * \brief Scale of the mesh, multiplied by the scale of the spawn transform
+			 */
+			SVector3 mesh_scale = SVector3(1, 1, 1);
+			/**
+			 * \brief Size of the box trigger, a zero size means no trigger
+			 */
+			SVector3 trigger_size;
+			/**
+			 * \brief 3D sound of the instance, empty means no sound
+			 */
+			std::string sound_path;
+			float sound_gain = 1.f;
+		};
+
+		/**
+		 * \brief Components of a pooled prefab instance
+		 * They are owned by the pool, release_prefab() hides and disables them and unregister_prefab() destroys them
+		 * A game object that still uses them when it's deleted only detaches them
+		 */
+		struct prefab_instance
+		{
+			prefab_id prefab = 0;
+			MeshComponent* mesh = nullptr;
+			BoxTriggerComponent* trigger = nullptr;
+			AudioComponent3D* sound = nullptr;
+			bool in_use = false;
+		};
+
 		class ComponentsManager
 		{
 		private:
@@ -82,19 +131,54 @@ namespace ScrapEngine
 			std::unordered_map<RigidBodyComponent*, Physics::RigidBody*> loaded_rigidbody_collisions_;
 			std::unordered_map<Physics::RigidBody*, RigidBodyComponent*> loaded_rigidbody_inverse_;
 
-			std::unordered_map<MeshComponent*, Render::VulkanMeshInstance*> loaded_meshes_;
+			std::unordered_map<MeshComponent*, slot_handle> loaded_meshes_;
 			std::unordered_map<TriggerComponent*, Physics::CollisionBody*> loaded_collider_collisions_;
 
 			//Keep a single camera component
 			CameraComponent* camera_ = nullptr;
+
+			struct prefab_pool
+			{
+				prefab_description description;
+				//Every instance created for the prefab, in use or not
+				std::vector<prefab_instance*> instances;
+				std::vector<prefab_instance*> free_instances;
+			};
+
+			std::vector<prefab_pool> prefabs_;
+
+			template <typename T, typename... Others, typename Function>
+			static void invoke_for_component(Function& function, T* component, std::true_type single);
+			template <typename T, typename... Others, typename Function>
+			static void invoke_for_component(Function& function, T* component, std::false_type single);
+			template <typename T, typename Function, typename... Others>
+			static void invoke_with_others(Function& function, T& component, Others*... others);
+
+			prefab_instance* create_prefab_instance(prefab_id prefab);
+			//Release the instances in use and delete every instance of the pool
+			//Without unloading the meshes when the render manager already deleted them
+			void destroy_prefab_pool(prefab_pool& pool, bool unload_meshes);
+			static void place_prefab_instance(const prefab_pool& pool, prefab_instance* instance,
+			                                  const STransform& transform);
 		public:
 			explicit ComponentsManager() = default;
-			~ComponentsManager() = default;
+			~ComponentsManager();
 
 			void set_render_manager(Render::RenderManager* input_render_manager_ref);
 			void set_physics_manager(Physics::PhysicsManager* input_physics_manager);
 			void set_audio_manager(Audio::AudioManager* input_audio_manager);
 
+			//----------------------------------------
+			//Queries
+			//Call function for every component of the family T, walking the chunks of its pool in memory order
+			//With more families the function also receives the components of the same owner:
+			//for_each<RigidBodyComponent, MeshComponent>([](RigidBodyComponent& body, MeshComponent& mesh) {})
+			//Only the first component of each of the other families is passed, like SGameObject::get_component()
+			//The owners without all of them are skipped
+			//The function must not create or destroy components of the family T
+			template <typename T, typename... Others, typename Function>
+			void for_each(Function function) const;
+
 			//----------------------------------------
 			//MeshStuff
 			//Currently the engine doesn't support custom shaders, so specify the path is kinda useless
@@ -149,6 +233,66 @@ namespace ScrapEngine
 			AudioComponent2D* create_2d_sound(const std::string& filename) const;
 			AudioComponent3D* create_3d_sound(const std::string& filename) const;
 			void unload_sound(AudioComponent* audio) const;
+			//----------------------------------------
+			//Prefabs
+			//The mesh, trigger and sound of an instance are created once and reused by every spawn,
+			//so spawning a pooled instance doesn't load anything or allocate gpu and physics resources
+			prefab_id register_prefab(const prefab_description& description);
+			//Create the instances in advance, usually while loading the level
+			void prewarm_prefab(prefab_id prefab, size_t count);
+			//Take a free instance (or create a new one if the pool is empty) and show it at the transform
+			prefab_instance* acquire_prefab(prefab_id prefab, const STransform& transform);
+			//Acquire an instance for each transform, appending them to instances
+			void instantiate_prefab(prefab_id prefab, const std::vector<STransform>& transforms,
+			                        std::vector<prefab_instance*>& instances);
+			//Hide the instance, disable its trigger, stop its sound and give it back to the pool
+			//The components are detached from their owner, the instance must not be used after this call
+			void release_prefab(prefab_instance* instance);
+			size_t get_prefab_free_count(prefab_id prefab) const;
+			//Destroy every instance of the prefab, removing the triggers from the physics world
+			//The instances in use are released first, the id can be used again only after register_prefab()
+			void unregister_prefab(prefab_id prefab);
 		};
+
+		template <typename T, typename... Others, typename Function>
+		void ComponentsManager::for_each(Function function) const
+		{
+			auto invoke = [&function](T* component)
+			{
+				invoke_for_component<T, Others...>(function, component,
+				                                   std::integral_constant<bool, sizeof...(Others) == 0>());
+			};
+			ComponentPool<T>::get_instance()->for_each(invoke);
+		}
+
+		template <typename T, typename... Others, typename Function>
+		void ComponentsManager::invoke_for_component(Function& function, T* component, std::true_type)
+		{
+			function(*component);
+		}
+
+		template <typename T, typename... Others, typename Function>
+		void ComponentsManager::invoke_for_component(Function& function, T* component, std::false_type)
+		{
+			const SGameObject* owner = component->get_owner();
+			if (owner)
+			{
+				invoke_with_others(function, *component, owner->get_component<Others>()...);
+			}
+		}
+
+		template <typename T, typename Function, typename... Others>
+		void ComponentsManager::invoke_with_others(Function& function, T& component, Others*... others)
+		{
+			const bool found[] = {(others != nullptr)...};
+			for (const bool component_found : found)
+			{
+				if (!component_found)
+				{
+					return;
+				}
+			}
+			function(component, *others...);
+		}
 	}
 }
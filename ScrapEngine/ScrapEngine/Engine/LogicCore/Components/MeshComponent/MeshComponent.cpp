@@ -1,100 +1,133 @@
 #include <Engine/LogicCore/Components/MeshComponent/MeshComponent.h>
 #include <Engine/Rendering/Model/MeshInstance/VulkanMeshInstance.h>
+#include <Engine/Rendering/Manager/RenderManager.h>
+#include <Engine/Debug/DebugLog.h>
 
-ScrapEngine::Core::MeshComponent::MeshComponent(Render::VulkanMeshInstance* input_vulkan_mesh)
-	: SComponent("MeshComponent"), vulkan_mesh_(input_vulkan_mesh)
+ScrapEngine::Core::MeshComponent::MeshComponent(Render::RenderManager* input_render_manager_ref,
+                                                const slot_handle& input_vulkan_mesh,
+                                                Render::VulkanMeshInstance* input_reserved_mesh)
+	: PooledComponent("MeshComponent"), render_manager_ref_(input_render_manager_ref),
+	  vulkan_mesh_(input_vulkan_mesh), reserved_mesh_(input_reserved_mesh)
 {
 }
 
-void ScrapEngine::Core::MeshComponent::set_component_location(const SVector3& location)
+ScrapEngine::Render::VulkanMeshInstance* ScrapEngine::Core::MeshComponent::get_vulkan_mesh() const
 {
-	SComponent::set_component_location(location);
-	vulkan_mesh_->set_mesh_location(location);
-}
-
-void ScrapEngine::Core::MeshComponent::set_component_rotation(const SVector3& rotation)
-{
-	SComponent::set_component_rotation(rotation);
-	vulkan_mesh_->set_mesh_rotation(rotation);
-}
-
-void ScrapEngine::Core::MeshComponent::set_component_scale(const SVector3& scale)
-{
-	SComponent::set_component_scale(scale);
-	vulkan_mesh_->set_mesh_scale(scale);
-}
-
-void ScrapEngine::Core::MeshComponent::add_component_rotation(const SVector3& rotation)
-{
-	SComponent::add_component_rotation(rotation);
-	vulkan_mesh_->set_mesh_rotation(get_component_rotation());
+	//The mesh is inserted in the slot map at the next render sync
+	if (render_manager_ref_->is_mesh_reserved(vulkan_mesh_))
+	{
+		return reserved_mesh_;
+	}
+	Render::VulkanMeshInstance* mesh = render_manager_ref_->get_mesh(vulkan_mesh_);
+	if (!mesh && !stale_logged_)
+	{
+		Debug::DebugLog::print_to_console_log("[MeshComponent] The mesh has been unloaded, its handle is stale");
+		stale_logged_ = true;
+	}
+	return mesh;
 }
 
 bool ScrapEngine::Core::MeshComponent::get_is_visible() const
 {
-	return vulkan_mesh_->get_is_visible();
+	Render::VulkanMeshInstance* mesh = get_vulkan_mesh();
+	return mesh ? mesh->get_game_state()->is_visible : false;
 }
 
 void ScrapEngine::Core::MeshComponent::set_is_visible(const bool visible) const
 {
-	vulkan_mesh_->set_is_visible(visible);
+	Render::VulkanMeshInstance* mesh = get_vulkan_mesh();
+	if (mesh)
+	{
+		mesh->get_game_state()->is_visible = visible;
+	}
 }
 
 bool ScrapEngine::Core::MeshComponent::get_is_static() const
 {
-	return vulkan_mesh_->get_is_static();
+	Render::VulkanMeshInstance* mesh = get_vulkan_mesh();
+	return mesh ? mesh->get_game_state()->is_static : false;
 }
 
 void ScrapEngine::Core::MeshComponent::set_is_static(const bool is_static) const
 {
-	vulkan_mesh_->set_is_static(is_static);
+	Render::VulkanMeshInstance* mesh = get_vulkan_mesh();
+	if (mesh)
+	{
+		mesh->get_game_state()->is_static = is_static;
+	}
 }
 
 bool ScrapEngine::Core::MeshComponent::get_cast_shadows() const
 {
-	return vulkan_mesh_->get_cast_shadows();
+	Render::VulkanMeshInstance* mesh = get_vulkan_mesh();
+	return mesh ? mesh->get_game_state()->cast_shadows : false;
 }
 
 void ScrapEngine::Core::MeshComponent::set_cast_shadows(const bool cast_shadows) const
 {
-	return vulkan_mesh_->set_cast_shadows(cast_shadows);
+	Render::VulkanMeshInstance* mesh = get_vulkan_mesh();
+	if (mesh)
+	{
+		mesh->get_game_state()->cast_shadows = cast_shadows;
+	}
 }
 
 bool ScrapEngine::Core::MeshComponent::get_frustum_check() const
 {
-	return vulkan_mesh_->get_frustum_check();
+	Render::VulkanMeshInstance* mesh = get_vulkan_mesh();
+	return mesh ? mesh->get_game_state()->frustum_check : false;
 }
 
 void ScrapEngine::Core::MeshComponent::set_frustum_check(const bool should_check) const
 {
-	vulkan_mesh_->set_frustum_check(should_check);
+	Render::VulkanMeshInstance* mesh = get_vulkan_mesh();
+	if (mesh)
+	{
+		mesh->get_game_state()->frustum_check = should_check;
+	}
 }
 
 float ScrapEngine::Core::MeshComponent::get_frustum_check_radius() const
 {
-	return vulkan_mesh_->get_frustum_check_radius();
+	Render::VulkanMeshInstance* mesh = get_vulkan_mesh();
+	return mesh ? mesh->get_game_state()->frustum_check_radius : 0.f;
 }
 
 void ScrapEngine::Core::MeshComponent::set_frustum_check_radius(const float radius) const
 {
-	vulkan_mesh_->set_frustum_check_radius(radius);
+	Render::VulkanMeshInstance* mesh = get_vulkan_mesh();
+	if (mesh)
+	{
+		mesh->get_game_state()->frustum_check_radius = radius;
+	}
 }
 
 void ScrapEngine::Core::MeshComponent::update_component_location()
 {
 	SComponent::update_component_location();
-	vulkan_mesh_->set_mesh_location(get_component_location());
+	Render::VulkanMeshInstance* mesh = get_vulkan_mesh();
+	if (mesh)
+	{
+		mesh->get_game_state()->transform.set_position(get_component_location());
+	}
 }
 
 void ScrapEngine::Core::MeshComponent::update_component_rotation()
 {
 	SComponent::update_component_rotation();
-	vulkan_mesh_->set_mesh_location(get_component_location());
-	vulkan_mesh_->set_mesh_rotation(get_component_rotation());
+	Render::VulkanMeshInstance* mesh = get_vulkan_mesh();
+	if (mesh)
+	{
+		mesh->get_game_state()->transform.set_rotation(get_component_rotation());
+	}
 }
 
 void ScrapEngine::Core::MeshComponent::update_component_scale()
 {
 	SComponent::update_component_scale();
-	vulkan_mesh_->set_mesh_scale(get_component_scale());
+	Render::VulkanMeshInstance* mesh = get_vulkan_mesh();
+	if (mesh)
+	{
+		mesh->get_game_state()->transform.set_scale(get_component_scale());
+	}
 }
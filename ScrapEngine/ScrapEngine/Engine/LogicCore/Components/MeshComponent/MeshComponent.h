@@ -1,12 +1,14 @@
 #pragma once
 
-#include <Engine/LogicCore/Components/SComponent.h>
+#include <Engine/LogicCore/Components/PooledComponent.h>
+#include <Engine/Utility/SlotMap.h>
 
 namespace ScrapEngine
 {
 	namespace Render
 	{
 		class VulkanMeshInstance;
+		class RenderManager;
 	}
 }
 
@@ -14,21 +16,25 @@ namespace ScrapEngine
 {
 	namespace Core
 	{
-		class MeshComponent : public SComponent
+		class MeshComponent : public PooledComponent<MeshComponent, component_family::mesh>
 		{
 		private:
 			//More documentation about the mesh is inside the render mesh class
 			//If you need anything try to check Engine/Rendering/Model/MeshInstance/VulkanMeshInstance.h
-			Render::VulkanMeshInstance* vulkan_mesh_;
+			Render::RenderManager* render_manager_ref_;
+			//The handle is stale once the mesh has been deleted, then the getters return the default values
+			slot_handle vulkan_mesh_;
+			//Instance created by load_mesh(), used only while the handle is reserved and not inserted yet
+			Render::VulkanMeshInstance* reserved_mesh_;
+			//A stale handle is logged once
+			mutable bool stale_logged_ = false;
+
+			Render::VulkanMeshInstance* get_vulkan_mesh() const;
 		public:
-			explicit MeshComponent(Render::VulkanMeshInstance* input_vulkan_mesh);
+			explicit MeshComponent(Render::RenderManager* input_render_manager_ref, const slot_handle& input_vulkan_mesh,
+			                       Render::VulkanMeshInstance* input_reserved_mesh);
 			~MeshComponent() = default;
 
-			void set_component_location(const SVector3& location) override;
-			void set_component_rotation(const SVector3& rotation) override;
-			void set_component_scale(const SVector3& scale) override;
-			void add_component_rotation(const SVector3& rotation) override;
-
 			//Get/Set if the mesh is visible in game
 			bool get_is_visible() const;
 			void set_is_visible(bool visible) const;
@@ -56,7 +62,8 @@ namespace ScrapEngine
 			float get_frustum_check_radius() const;
 			void set_frustum_check_radius(float radius) const;
 
-			//Call the standard implementation, then update vulkan_mesh_ values
+			//Call the standard implementation, then update the game state of vulkan_mesh_
+			//The render thread sees the new values with the next RenderWorld snapshot
 			void update_component_location() override;
 			void update_component_rotation() override;
 			void update_component_scale() override;
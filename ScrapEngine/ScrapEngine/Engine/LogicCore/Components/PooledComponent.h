@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Engine/LogicCore/Components/SComponent.h>
+#include <Engine/LogicCore/Components/ComponentPool.h>
+
+namespace ScrapEngine
+{
+	namespace Core
+	{
+		//Base of the component families: T is the family class, created and deleted in its ComponentPool
+		//Every component of the family is listed in the pool, so the systems can iterate them without
+		//walking the game objects (see ComponentsManager::for_each())
+		template <typename T, component_family Family>
+		class PooledComponent : public SComponent
+		{
+		private:
+			//Slot of the component in its pool, given by ComponentPool::add()
+			uint32_t pool_index_;
+		public:
+			static const component_family family = Family;
+			typedef T family_type;
+
+			explicit PooledComponent(const std::string& component_name)
+				: SComponent(component_name, Family)
+			{
+				//Only the pointer is stored, the object is used after the construction
+				pool_index_ = ComponentPool<T>::get_instance()->add(static_cast<T*>(this));
+			}
+
+			virtual ~PooledComponent()
+			{
+				T* moved = ComponentPool<T>::get_instance()->remove(pool_index_);
+				if (moved)
+				{
+					static_cast<PooledComponent*>(moved)->pool_index_ = pool_index_;
+				}
+			}
+
+			static void* operator new(const size_t size)
+			{
+				return ComponentPool<T>::get_instance()->allocate(size);
+			}
+
+			static void operator delete(void* memory)
+			{
+				ComponentPool<T>::get_instance()->deallocate(memory);
+			}
+		};
+	}
+}
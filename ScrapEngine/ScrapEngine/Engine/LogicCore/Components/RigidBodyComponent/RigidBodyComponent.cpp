@@ -4,7 +4,7 @@
 #include <Engine/LogicCore/Math/Vector/SVector3.h>
 
 ScrapEngine::Core::RigidBodyComponent::RigidBodyComponent(Physics::RigidBody* rigidbody)
-	: SComponent("RigidbodyComponent"), rigidbody_(rigidbody)
+	: PooledComponent("RigidbodyComponent"), rigidbody_(rigidbody)
 {
 }
 
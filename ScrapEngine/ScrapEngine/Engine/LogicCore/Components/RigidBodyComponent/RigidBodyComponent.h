@@ -1,6 +1,6 @@
 #pragma once
 
-#include <Engine/LogicCore/Components/SComponent.h>
+#include <Engine/LogicCore/Components/PooledComponent.h>
 
 namespace ScrapEngine
 {
@@ -17,7 +17,7 @@ namespace ScrapEngine
 	{
 		class MeshComponent;
 
-		class RigidBodyComponent : public SComponent
+		class RigidBodyComponent : public PooledComponent<RigidBodyComponent, component_family::rigidbody>
 		{
 		private:
 			Physics::RigidBody* rigidbody_ = nullptr;
@@ -26,6 +26,9 @@ namespace ScrapEngine
 
 			//Friend class to let TriggerComponent get "rigidbody_"
 			friend class TriggerComponent;
+			//Friend class to mark the component removed from the physics world
+			friend class ComponentsManager;
+			bool in_world_ = true;
 
 			//Parameters that check if a dynamic rigidbody should update mesh data
 			bool update_mesh_position_ = true;
@@ -1,84 +1,94 @@
 #include <Engine/LogicCore/Components/SComponent.h>
 #include <Engine/LogicCore/GameObject/SGameObject.h>
-#include <glm/mat4x4.hpp>
 
-ScrapEngine::Core::SComponent::SComponent(const std::string& component_name) : SObject(component_name)
+ScrapEngine::Core::SComponent::SComponent(const std::string& component_name, const component_family family)
+	: SObject(component_name), family_(family)
 {
+	component_transform_id_ = TransformStore::get_instance()->create(
+		glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f), this);
 }
 
 ScrapEngine::Core::SComponent::~SComponent()
 {
-	//Empty here
+	TransformStore::get_instance()->destroy(component_transform_id_);
+}
+
+void ScrapEngine::Core::SComponent::on_world_transform_changed(const uint8_t changed)
+{
+	if (changed & TransformStore::location)
+	{
+		update_component_location();
+	}
+	if (changed & TransformStore::rotation)
+	{
+		update_component_rotation();
+	}
+	if (changed & TransformStore::scale)
+	{
+		update_component_scale();
+	}
 }
 
 void ScrapEngine::Core::SComponent::set_component_location(const SVector3& location)
 {
-	object_world_transform_.set_position(location);
-	update_relative_location();
+	TransformStore::get_instance()->set_world_position(component_transform_id_, location.get_glm_vector());
 }
 
 void ScrapEngine::Core::SComponent::set_component_rotation(const SVector3& rotation)
 {
-	object_world_transform_.set_rotation(rotation);
-	update_relative_rotation();
+	TransformStore::get_instance()->set_world_rotation(component_transform_id_, SQuaternion(rotation).get_glm_quat());
 }
 
 void ScrapEngine::Core::SComponent::set_component_scale(const SVector3& scale)
 {
-	object_world_transform_.set_scale(scale);
-	update_relative_scale();
+	TransformStore::get_instance()->set_world_scale(component_transform_id_, scale.get_glm_vector());
 }
 
 void ScrapEngine::Core::SComponent::add_component_rotation(const SVector3& rotation)
 {
-	object_world_transform_.add_rotation(rotation);
-	update_relative_rotation();
+	TransformStore* store = TransformStore::get_instance();
+	store->set_world_rotation(component_transform_id_,
+	                          store->get_world_rotation(component_transform_id_) *
+	                          SQuaternion(rotation).get_glm_quat());
 }
 
 void ScrapEngine::Core::SComponent::update_component_location()
 {
-	const glm::mat4 local_m = generate_unscaled_transform_matrix(object_relative_transform_);
-	const glm::mat4 father_m = generate_unscaled_transform_matrix(owner_->object_transform_);
-	glm::mat4 full_m = father_m * local_m;
-
-	const glm::vec3 pos = glm::vec3(full_m[3][0], full_m[3][1], full_m[3][2]);
-
-	object_world_transform_.set_position(SVector3(pos));
+	//This will be defined by the derived components when is necessary, otherwise it will have no effect
 }
 
 void ScrapEngine::Core::SComponent::update_component_rotation()
 {
-	object_world_transform_.set_rotation(
-		owner_->object_transform_.get_quat_rotation() * object_relative_transform_.get_quat_rotation()
-	);
-	set_component_rotation(object_world_transform_.get_rotation());
-
-	update_component_location();
+	//This will be defined by the derived components when is necessary, otherwise it will have no effect
 }
 
 void ScrapEngine::Core::SComponent::update_component_scale()
 {
-	object_world_transform_.set_scale(owner_->object_transform_.get_scale() + object_relative_transform_.get_scale());
+	//This will be defined by the derived components when is necessary, otherwise it will have no effect
 }
 
 ScrapEngine::Core::STransform ScrapEngine::Core::SComponent::get_component_transform() const
 {
-	return object_world_transform_;
+	const TransformStore* store = TransformStore::get_instance();
+	STransform transform(SVector3(store->get_world_position(component_transform_id_)), SVector3(),
+	                     SVector3(store->get_world_scale(component_transform_id_)));
+	transform.set_rotation(SQuaternion(store->get_world_rotation(component_transform_id_)));
+	return transform;
 }
 
 ScrapEngine::Core::SVector3 ScrapEngine::Core::SComponent::get_component_location() const
 {
-	return object_world_transform_.get_position();
+	return SVector3(TransformStore::get_instance()->get_world_position(component_transform_id_));
 }
 
 ScrapEngine::Core::SVector3 ScrapEngine::Core::SComponent::get_component_rotation() const
 {
-	return object_world_transform_.get_rotation();
+	return SQuaternion(TransformStore::get_instance()->get_world_rotation(component_transform_id_)).to_euler_angles();
 }
 
 ScrapEngine::Core::SVector3 ScrapEngine::Core::SComponent::get_component_scale() const
 {
-	return object_world_transform_.get_scale();
+	return SVector3(TransformStore::get_instance()->get_world_scale(component_transform_id_));
 }
 
 ScrapEngine::Core::SGameObject* ScrapEngine::Core::SComponent::get_owner() const
@@ -86,45 +96,22 @@ ScrapEngine::Core::SGameObject* ScrapEngine::Core::SComponent::get_owner() const
 	return owner_;
 }
 
-ScrapEngine::Core::SVector3 ScrapEngine::Core::SComponent::get_component_relative_location() const
-{
-	return object_relative_transform_.get_position();
-}
-
-ScrapEngine::Core::SVector3 ScrapEngine::Core::SComponent::get_component_relative_rotation() const
+ScrapEngine::Core::component_family ScrapEngine::Core::SComponent::get_family() const
 {
-	return object_relative_transform_.get_rotation();
+	return family_;
 }
 
-ScrapEngine::Core::SVector3 ScrapEngine::Core::SComponent::get_component_relative_scale() const
+ScrapEngine::Core::SVector3 ScrapEngine::Core::SComponent::get_component_relative_location() const
 {
-	return object_relative_transform_.get_scale();
+	return SVector3(TransformStore::get_instance()->get_local_position(component_transform_id_));
 }
 
-void ScrapEngine::Core::SComponent::update_relative_location()
-{
-	if (owner_)
-	{
-		object_relative_transform_.set_position(
-			object_world_transform_.get_position() - owner_->object_transform_.get_position());
-	}
-}
-
-void ScrapEngine::Core::SComponent::update_relative_rotation()
+ScrapEngine::Core::SVector3 ScrapEngine::Core::SComponent::get_component_relative_rotation() const
 {
-	if (owner_)
-	{
-		object_relative_transform_.set_rotation(
-			owner_->object_transform_.get_quat_rotation().get_inverse() * object_world_transform_.get_quat_rotation()
-		);
-	}
+	return SQuaternion(TransformStore::get_instance()->get_local_rotation(component_transform_id_)).to_euler_angles();
 }
 
-void ScrapEngine::Core::SComponent::update_relative_scale()
+ScrapEngine::Core::SVector3 ScrapEngine::Core::SComponent::get_component_relative_scale() const
 {
-	if (owner_)
-	{
-		object_relative_transform_.set_scale(
-			object_world_transform_.get_scale() - owner_->object_transform_.get_scale());
-	}
+	return SVector3(TransformStore::get_instance()->get_local_scale(component_transform_id_));
 }
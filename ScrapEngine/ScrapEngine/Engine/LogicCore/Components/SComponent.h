@@ -2,6 +2,8 @@
 
 #include <Engine/LogicCore/SObject.h>
 #include <Engine/LogicCore/Math/Transform/STransform.h>
+#include <Engine/LogicCore/Math/Transform/TransformStore.h>
+#include <Engine/LogicCore/Components/ComponentPool.h>
 
 namespace ScrapEngine
 {
@@ -9,20 +11,28 @@ namespace ScrapEngine
 	{
 		class SGameObject;
 
-		class SComponent : public SObject
+		class SComponent : public SObject, public TransformListener
 		{
 			//Friend class to update relative transform
 			//Accessing private methods the user shouldn't see and use
 			friend class SGameObject;
+			//To mark the components of the prefab pools
+			friend class ComponentsManager;
 		private:
 			//The current owner of this component
 			//Should never be null
 			SGameObject* owner_ = nullptr;
-		protected:
-			STransform object_relative_transform_;
-			STransform object_world_transform_;
+			//The transform is kept in the TransformStore, its parent is the owner_ transform
+			transform_id component_transform_id_;
+			//Used by the game object to find its components by family
+			component_family family_;
+			//The components of a prefab pool are deleted by the pool, their owner only detaches them
+			bool owned_by_pool_ = false;
+
+			//Called by TransformStore::update(), dispatch the changes to the update_component_*() methods
+			void on_world_transform_changed(uint8_t changed) override;
 		public:
-			explicit SComponent(const std::string& component_name);
+			explicit SComponent(const std::string& component_name, component_family family = component_family::none);
 			virtual ~SComponent() = 0;
 
 			virtual void set_component_location(const SVector3& location);
@@ -36,19 +46,15 @@ namespace ScrapEngine
 			virtual SVector3 get_component_scale() const;
 
 			SGameObject* get_owner() const;
+			component_family get_family() const;
 
 			SVector3 get_component_relative_location() const;
 			SVector3 get_component_relative_rotation() const;
 			SVector3 get_component_relative_scale() const;
 
-		private:
-			//Update the relative values based on owner_ transform
-			virtual void update_relative_location();
-			virtual void update_relative_rotation();
-			virtual void update_relative_scale();
-
 		protected: //Because objects derived may need to re-define one of them
-			//Update world transform with the local transform data and owner_ transform
+			//Called once per frame when the world transform changed, after the owner or a setter moved it
+			//The getters already return the new world values
 			virtual void update_component_location();
 			virtual void update_component_rotation();
 			virtual void update_component_scale();
@@ -4,7 +4,7 @@
 #include <Engine/Physics/RigidBody/RigidBody.h>
 
 ScrapEngine::Core::TriggerComponent::TriggerComponent(Physics::CollisionBody* collisionbody)
-	: SComponent("TriggerComponent"), collisionbody_(collisionbody)
+	: PooledComponent("TriggerComponent"), collisionbody_(collisionbody)
 {
 }
 
@@ -25,12 +25,31 @@ void ScrapEngine::Core::TriggerComponent::set_component_rotation(const SVector3&
 	collisionbody_->update_trasform(get_component_transform());
 }
 
+void ScrapEngine::Core::TriggerComponent::set_is_active(const bool active)
+{
+	is_active_ = active;
+	collisionbody_->set_is_active(active);
+}
+
+bool ScrapEngine::Core::TriggerComponent::get_is_active() const
+{
+	return is_active_;
+}
+
 bool ScrapEngine::Core::TriggerComponent::test_collision(TriggerComponent* other) const
 {
+	if (!is_active_ || !other->is_active_)
+	{
+		return false;
+	}
 	return collisionbody_->test_collision(other->collisionbody_);
 }
 
 bool ScrapEngine::Core::TriggerComponent::test_collision(RigidBodyComponent* other) const
 {
+	if (!is_active_)
+	{
+		return false;
+	}
 	return collisionbody_->test_collision(other->rigidbody_->get_rigidbody());
 }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <Engine/LogicCore/Components/SComponent.h>
+#include <Engine/LogicCore/Components/PooledComponent.h>
 
 namespace ScrapEngine
 {
@@ -16,10 +16,11 @@ namespace ScrapEngine
 	{
 		class RigidBodyComponent;
 
-		class TriggerComponent : public SComponent
+		class TriggerComponent : public PooledComponent<TriggerComponent, component_family::trigger>
 		{
 		private:
 			Physics::CollisionBody* collisionbody_ = nullptr;
+			bool is_active_ = true;
 		public:
 			TriggerComponent(Physics::CollisionBody* collisionbody);
 			virtual ~TriggerComponent() = 0;
@@ -27,6 +28,10 @@ namespace ScrapEngine
 			void set_component_location(const SVector3& location) override;
 			void set_component_rotation(const SVector3& rotation) override;
 
+			//An inactive trigger never collides, used by the pooled prefab instances
+			void set_is_active(bool active);
+			bool get_is_active() const;
+
 			bool test_collision(TriggerComponent* other) const;
 			bool test_collision(RigidBodyComponent* other) const;
 		};
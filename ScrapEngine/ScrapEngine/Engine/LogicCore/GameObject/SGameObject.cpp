@@ -5,16 +5,29 @@
 
 ScrapEngine::Core::SGameObject::SGameObject(const std::string& object_name,
                                             const STransform& input_object_transform)
-	: SObject(object_name), object_transform_(input_object_transform)
+	: SObject(object_name)
 {
+	object_transform_id_ = TransformStore::get_instance()->create(
+		input_object_transform.get_position().get_glm_vector(),
+		input_object_transform.get_quat_rotation().get_glm_quat(),
+		input_object_transform.get_scale().get_glm_vector());
 }
 
 ScrapEngine::Core::SGameObject::~SGameObject()
 {
 	for (SComponent* component : object_components_)
 	{
-		delete component;
+		if (component->owned_by_pool_)
+		{
+			component->owner_ = nullptr;
+			TransformStore::get_instance()->set_parent(component->component_transform_id_, TransformStore::invalid_id);
+		}
+		else
+		{
+			delete component;
+		}
 	}
+	TransformStore::get_instance()->destroy(object_transform_id_);
 }
 
 void ScrapEngine::Core::SGameObject::game_start()
@@ -62,156 +75,69 @@ bool ScrapEngine::Core::SGameObject::get_should_update() const
 	return should_update_;
 }
 
-void ScrapEngine::Core::SGameObject::set_object_location(const SVector3& location, const bool should_update_relative)
+void ScrapEngine::Core::SGameObject::set_parallel_update(const bool parallel_update)
 {
-	object_transform_.set_position(location);
-	//Check if i should update the relative values
-	if (should_update_relative)
-	{
-		update_relative_location();
-	}
-	//Update the transform of every component
-	for (SComponent* component : object_components_)
-	{
-		component->update_component_location();
-	}
-	//Update the transform of every child
-	for (SGameObject* child_object : object_child_)
-	{
-		child_object->update_object_location();
-	}
-}
-
-void ScrapEngine::Core::SGameObject::set_object_rotation(const SVector3& rotation, const bool should_update_relative)
-{
-	object_transform_.set_rotation(rotation);
-	//Check if i should update the relative values
-	if (should_update_relative)
-	{
-		update_relative_rotation();
-	}
-	//Update the transform of every component
-	for (SComponent* component : object_components_)
-	{
-		component->update_component_rotation();
-	}
-	//Update the transform of every child
-	for (SGameObject* child_object : object_child_)
-	{
-		child_object->update_object_rotation();
-	}
+	this->parallel_update_ = parallel_update;
 }
 
-void ScrapEngine::Core::SGameObject::set_object_scale(const SVector3& scale, const bool should_update_relative)
+bool ScrapEngine::Core::SGameObject::get_parallel_update() const
 {
-	object_transform_.set_scale(scale);
-	//Check if i should update the relative values
-	if (should_update_relative)
-	{
-		update_relative_scale();
-	}
-	//Update the transform of every component
-	for (SComponent* component : object_components_)
-	{
-		component->update_component_scale();
-	}
-	//Update the transform of every child
-	for (SGameObject* child_object : object_child_)
-	{
-		child_object->update_object_scale();
-	}
+	return parallel_update_;
 }
 
-void ScrapEngine::Core::SGameObject::add_object_rotation(const SVector3& rotation)
+void ScrapEngine::Core::SGameObject::set_object_location(const SVector3& location)
 {
-	object_transform_.add_rotation(rotation);
-
-	update_relative_rotation();
-	//Update the rotation
-	set_object_rotation(get_object_rotation());
+	TransformStore::get_instance()->set_world_position(object_transform_id_, location.get_glm_vector());
 }
 
-ScrapEngine::Core::SVector3 ScrapEngine::Core::SGameObject::get_object_location() const
+void ScrapEngine::Core::SGameObject::set_object_rotation(const SVector3& rotation)
 {
-	return object_transform_.get_position();
+	TransformStore::get_instance()->set_world_rotation(object_transform_id_, SQuaternion(rotation).get_glm_quat());
 }
 
-ScrapEngine::Core::SVector3 ScrapEngine::Core::SGameObject::get_object_rotation() const
+void ScrapEngine::Core::SGameObject::set_object_scale(const SVector3& scale)
 {
-	return object_transform_.get_rotation();
+	TransformStore::get_instance()->set_world_scale(object_transform_id_, scale.get_glm_vector());
 }
 
-ScrapEngine::Core::SVector3 ScrapEngine::Core::SGameObject::get_object_scale() const
-{
-	return object_transform_.get_scale();
-}
-
-void ScrapEngine::Core::SGameObject::update_relative_location()
-{
-	if (father_object_)
-	{
-		object_relative_transform_.set_position(
-			object_transform_.get_position() - father_object_->object_transform_.get_position());
-	}
-}
-
-void ScrapEngine::Core::SGameObject::update_relative_rotation()
-{
-	if (father_object_)
-	{
-		object_relative_transform_.set_rotation(
-			father_object_->object_transform_.get_quat_rotation().get_inverse() *
-			object_transform_.get_quat_rotation()
-		);
-	}
-}
-
-void ScrapEngine::Core::SGameObject::update_relative_scale()
+void ScrapEngine::Core::SGameObject::add_object_rotation(const SVector3& rotation)
 {
-	if (father_object_)
-	{
-		object_relative_transform_.set_scale(
-			object_transform_.get_scale() - father_object_->object_transform_.get_scale());
-	}
+	TransformStore* store = TransformStore::get_instance();
+	store->set_world_rotation(object_transform_id_,
+	                          store->get_world_rotation(object_transform_id_) * SQuaternion(rotation).get_glm_quat());
 }
 
-void ScrapEngine::Core::SGameObject::update_object_location()
+ScrapEngine::Core::SVector3 ScrapEngine::Core::SGameObject::get_object_location() const
 {
-	const glm::mat4 local_m = generate_unscaled_transform_matrix(object_relative_transform_);
-	const glm::mat4 father_m = generate_unscaled_transform_matrix(father_object_->object_transform_);
-	const glm::mat4 full_m = father_m * local_m;
-
-	const glm::vec3 pos = glm::vec3(full_m[3][0], full_m[3][1], full_m[3][2]);
-
-	set_object_location(SVector3(pos), false);
+	return SVector3(TransformStore::get_instance()->get_world_position(object_transform_id_));
 }
 
-void ScrapEngine::Core::SGameObject::update_object_rotation()
+ScrapEngine::Core::SVector3 ScrapEngine::Core::SGameObject::get_object_rotation() const
 {
-	object_transform_.set_rotation(
-		father_object_->object_transform_.get_quat_rotation() * object_relative_transform_.get_quat_rotation()
-	);
-	set_object_rotation(object_transform_.get_rotation(), false);
-
-	//Update location based on new rotation
-	update_object_location();
+	return SQuaternion(TransformStore::get_instance()->get_world_rotation(object_transform_id_)).to_euler_angles();
 }
 
-void ScrapEngine::Core::SGameObject::update_object_scale()
+ScrapEngine::Core::SVector3 ScrapEngine::Core::SGameObject::get_object_scale() const
 {
-	object_transform_.set_scale(father_object_->object_transform_.get_scale() + object_relative_transform_.get_scale());
+	return SVector3(TransformStore::get_instance()->get_world_scale(object_transform_id_));
 }
 
 void ScrapEngine::Core::SGameObject::add_component(SComponent* component, const bool update_position)
 {
 	object_components_.push_back(component);
 	component->owner_ = this;
+	const size_t family = static_cast<size_t>(component->family_);
+	if (family < component_family_count && !family_components_[family])
+	{
+		family_components_[family] = component;
+	}
+	TransformStore::get_instance()->set_parent(component->component_transform_id_, object_transform_id_);
 	if (update_position)
 	{
 		//Set component default values same as object
-		component->set_component_location(object_transform_.get_position());
-		component->set_component_rotation(object_transform_.get_rotation());
-		component->set_component_scale(object_transform_.get_scale());
+		component->set_component_location(get_object_location());
+		component->set_component_rotation(get_object_rotation());
+		component->set_component_scale(get_object_scale());
 	}
 }
 
@@ -223,6 +149,21 @@ void ScrapEngine::Core::SGameObject::remove_component(SComponent* component)
 		                         component),
 	                         object_components_.end());
 	component->owner_ = nullptr;
+	//The next component of the same family takes its place
+	const size_t family = static_cast<size_t>(component->family_);
+	if (family < component_family_count && family_components_[family] == component)
+	{
+		family_components_[family] = nullptr;
+		for (SComponent* other : object_components_)
+		{
+			if (other->family_ == component->family_)
+			{
+				family_components_[family] = other;
+				break;
+			}
+		}
+	}
+	TransformStore::get_instance()->set_parent(component->component_transform_id_, TransformStore::invalid_id);
 }
 
 const std::vector<ScrapEngine::Core::SComponent*>* ScrapEngine::Core::SGameObject::get_components() const
@@ -234,10 +175,7 @@ void ScrapEngine::Core::SGameObject::add_child(SGameObject* game_object)
 {
 	object_child_.push_back(game_object);
 	game_object->father_object_ = this;
-	//Update relative
-	game_object->update_relative_location();
-	game_object->update_relative_rotation();
-	game_object->update_relative_scale();
+	TransformStore::get_instance()->set_parent(game_object->object_transform_id_, object_transform_id_);
 }
 
 void ScrapEngine::Core::SGameObject::remove_child(SGameObject* game_object)
@@ -248,6 +186,7 @@ void ScrapEngine::Core::SGameObject::remove_child(SGameObject* game_object)
 		                    game_object),
 	                    object_child_.end());
 	game_object->father_object_ = nullptr;
+	TransformStore::get_instance()->set_parent(game_object->object_transform_id_, TransformStore::invalid_id);
 }
 
 const std::vector<ScrapEngine::Core::SGameObject*>* ScrapEngine::Core::SGameObject::get_child() const
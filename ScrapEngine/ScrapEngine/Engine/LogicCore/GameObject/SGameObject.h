@@ -2,7 +2,11 @@
 
 #include <Engine/LogicCore/SObject.h>
 #include <Engine/LogicCore/Math/Transform/STransform.h>
+#include <Engine/LogicCore/Math/Transform/TransformStore.h>
+#include <Engine/LogicCore/Components/ComponentPool.h>
 #include <vector>
+#include <array>
+#include <type_traits>
 
 namespace ScrapEngine
 {
@@ -13,15 +17,18 @@ namespace ScrapEngine
 
 		class SGameObject : public SObject
 		{
-			//Friend class to update relative transform
-			//Accessing private methods the user shouldn't see and use
+			//Friend class to attach the component transform to the object one
 			friend class SComponent;
 		private:
-			STransform object_transform_;
-			STransform object_relative_transform_;
+			//The transform is kept in the TransformStore, the children and the components world values
+			//are updated once per frame by TransformStore::update()
+			transform_id object_transform_id_;
 			bool should_update_ = true;
+			bool parallel_update_ = false;
 
 			std::vector<SComponent*> object_components_;
+			//First component of each family, so get_component() doesn't search the components
+			std::array<SComponent*, component_family_count> family_components_{};
 			std::vector<SGameObject*> object_child_;
 			SGameObject* father_object_ = nullptr;
 		public:
@@ -45,10 +52,18 @@ namespace ScrapEngine
 			void set_should_update(bool should_update);
 			bool get_should_update() const;
 
-			//The should_update_relative is false when the value is updated from an update() call
-			void set_object_location(const SVector3& location, bool should_update_relative = true);
-			void set_object_rotation(const SVector3& rotation, bool should_update_relative = true);
-			void set_object_scale(const SVector3& scale, bool should_update_relative = true);
+			//If true game_update() runs in a scheduler thread together with the other parallel objects
+			//It must change only this object and its components, without loading or creating resources
+			//Spawn, destroy and component changes must use the LogicManagerView deferred methods
+			//The world setters are applied after the parallel update, until then the getters of the other
+			//objects return the values of the last transform update
+			void set_parallel_update(bool parallel_update);
+			bool get_parallel_update() const;
+
+			//World values, the relative values to the father are computed by the TransformStore
+			void set_object_location(const SVector3& location);
+			void set_object_rotation(const SVector3& rotation);
+			void set_object_scale(const SVector3& scale);
 			void add_object_rotation(const SVector3& rotation);
 
 			SVector3 get_object_location() const;
@@ -60,23 +75,23 @@ namespace ScrapEngine
 			void add_component(SComponent* component, bool update_position = true);
 			void remove_component(SComponent* component);
 			const std::vector<SComponent*>* get_components() const;
+			//First component of the family T (ex: RigidBodyComponent), nullptr if the object doesn't have one
+			template <typename T>
+			T* get_component() const;
 
 			void add_child(SGameObject* game_object);
 			void remove_child(SGameObject* game_object);
 			const std::vector<SGameObject*>* get_child() const;
 
 			SGameObject* get_father() const;
-		private:
-			//Update the relative values based on father_object_ transform
-			virtual void update_relative_location();
-			virtual void update_relative_rotation();
-			virtual void update_relative_scale();
-
-		protected: //Because objects derived may need to re-define one of them
-			//Update world transform with the local transform data and owner_ transform
-			virtual void update_object_location();
-			virtual void update_object_rotation();
-			virtual void update_object_scale();
 		};
+
+		template <typename T>
+		T* SGameObject::get_component() const
+		{
+			static_assert(std::is_same<T, typename T::family_type>::value,
+			              "get_component() needs the family class, ex: RigidBodyComponent");
+			return static_cast<T*>(family_components_[static_cast<size_t>(T::family)]);
+		}
 	}
 }
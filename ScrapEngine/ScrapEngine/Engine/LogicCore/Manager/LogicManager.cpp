@@ -1,5 +1,28 @@
 #include <Engine/LogicCore/Manager/LogicManager.h>
 #include <Engine/LogicCore/GameObject/SGameObject.h>
+#include <Engine/LogicCore/Components/SComponent.h>
+#include <Engine/LogicCore/Math/Transform/TransformStore.h>
+#include <Engine/Debug/CpuProfiler.h>
+#include <algorithm>
+
+void ScrapEngine::Core::LogicManager::ParallelGameObjectUpdate::ExecuteRange(enki::TaskSetPartition range,
+                                                                           uint32_t threadnum)
+{
+	SCRAP_PROFILE_SCOPE("game_objects_update");
+	for (uint32_t i = range.start; i < range.end; i++)
+	{
+		owner->parallel_game_objects_[i]->game_update(time);
+	}
+}
+
+ScrapEngine::Core::LogicManager::LogicManager()
+	: deferred_commands_(1)
+{
+	parallel_update_task_ = new ParallelGameObjectUpdate();
+	parallel_update_task_->owner = this;
+	//Below the render tasks, see RenderManager
+	parallel_update_task_->m_Priority = enki::TASK_PRIORITY_MED;
+}
 
 ScrapEngine::Core::LogicManager::~LogicManager()
 {
@@ -7,16 +30,44 @@ ScrapEngine::Core::LogicManager::~LogicManager()
 	{
 		delete game_object;
 	}
+	delete parallel_update_task_;
+}
+
+void ScrapEngine::Core::LogicManager::set_task_scheduler(enki::TaskScheduler* task_scheduler)
+{
+	task_scheduler_ = task_scheduler;
+	if (task_scheduler_)
+	{
+		deferred_commands_.resize(std::max(task_scheduler_->GetNumTaskThreads(), 1u));
+	}
 }
 
 ScrapEngine::Core::SGameObject* ScrapEngine::Core::LogicManager::register_game_object(
 	SGameObject* input_game_object)
 {
+	if (iterating_)
+	{
+		deferred_command command;
+		command.type = deferred_command_type::spawn_game_object;
+		command.game_object = input_game_object;
+		record_command(std::move(command));
+		return input_game_object;
+	}
 	registered_game_objects_.push_back(input_game_object);
 	return registered_game_objects_.back();
 }
 
 void ScrapEngine::Core::LogicManager::un_register_game_object(SGameObject* input_game_object)
+{
+	if (iterating_)
+	{
+		destroy_game_object_deferred(input_game_object);
+		return;
+	}
+	destroy_game_object(input_game_object);
+}
+
+void ScrapEngine::Core::LogicManager::destroy_game_object(SGameObject* input_game_object)
 {
 	const std::vector<SGameObject*>::iterator element = find(registered_game_objects_.begin(),
 	                                                         registered_game_objects_.end(),
@@ -33,29 +84,148 @@ void ScrapEngine::Core::LogicManager::delete_game_object(SGameObject* input_game
 	delete input_game_object;
 }
 
+void ScrapEngine::Core::LogicManager::record_command(deferred_command&& command)
+{
+	//Each thread writes only its own command buffer
+	const uint32_t thread = task_scheduler_ ? task_scheduler_->GetThreadNum() : 0;
+	deferred_commands_[thread].push_back(std::move(command));
+}
+
+void ScrapEngine::Core::LogicManager::spawn_game_object_deferred(const std::function<SGameObject*()>& spawn_function)
+{
+	deferred_command command;
+	command.type = deferred_command_type::spawn_game_object;
+	command.spawn_function = spawn_function;
+	record_command(std::move(command));
+}
+
+void ScrapEngine::Core::LogicManager::destroy_game_object_deferred(SGameObject* input_game_object)
+{
+	deferred_command command;
+	command.type = deferred_command_type::destroy_game_object;
+	command.game_object = input_game_object;
+	record_command(std::move(command));
+}
+
+void ScrapEngine::Core::LogicManager::add_component_deferred(SGameObject* game_object,
+                                                             const std::function<SComponent*()>& component_function,
+                                                             const bool update_position)
+{
+	deferred_command command;
+	command.type = deferred_command_type::add_component;
+	command.game_object = game_object;
+	command.component_function = component_function;
+	command.update_position = update_position;
+	record_command(std::move(command));
+}
+
+void ScrapEngine::Core::LogicManager::remove_component_deferred(SGameObject* game_object, SComponent* component)
+{
+	deferred_command command;
+	command.type = deferred_command_type::remove_component;
+	command.game_object = game_object;
+	command.component = component;
+	record_command(std::move(command));
+}
+
+void ScrapEngine::Core::LogicManager::apply_deferred_commands()
+{
+	SCRAP_PROFILE_FUNCTION();
+	//The destroys are applied last, so the other commands never use a deleted object
+	for (std::vector<deferred_command>& commands : deferred_commands_)
+	{
+		for (deferred_command& command : commands)
+		{
+			switch (command.type)
+			{
+			case deferred_command_type::spawn_game_object:
+				registered_game_objects_.push_back(command.spawn_function
+					                                   ? command.spawn_function()
+					                                   : command.game_object);
+				break;
+			case deferred_command_type::add_component:
+				command.game_object->add_component(command.component_function(), command.update_position);
+				break;
+			case deferred_command_type::remove_component:
+				command.game_object->remove_component(command.component);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+	for (std::vector<deferred_command>& commands : deferred_commands_)
+	{
+		for (deferred_command& command : commands)
+		{
+			if (command.type == deferred_command_type::destroy_game_object)
+			{
+				//Searched by address, so destroying the same object twice is safe
+				destroy_game_object(command.game_object);
+			}
+		}
+		commands.clear();
+	}
+}
+
 void ScrapEngine::Core::LogicManager::execute_game_objects_start_event()
 {
+	iterating_ = true;
 	for (SGameObject* game_object : registered_game_objects_)
 	{
 		game_object->game_start();
 	}
+	iterating_ = false;
+	apply_deferred_commands();
 }
 
 void ScrapEngine::Core::LogicManager::execute_game_objects_update_event(const float time)
 {
+	iterating_ = true;
+	parallel_game_objects_.clear();
 	for (SGameObject* game_object : registered_game_objects_)
 	{
 		if (game_object->get_should_update())
 		{
-			game_object->game_update(time);
+			if (task_scheduler_ && game_object->get_parallel_update())
+			{
+				parallel_game_objects_.push_back(game_object);
+			}
+			else
+			{
+				game_object->game_update(time);
+			}
 		}
 	}
+	if (!parallel_game_objects_.empty())
+	{
+		parallel_update_task_->time = time;
+		parallel_update_task_->m_SetSize = static_cast<uint32_t>(parallel_game_objects_.size());
+		parallel_update_task_->m_MinRange = parallel_update_chunk_size;
+		//The objects moved in parallel don't read each other transforms, the writes are applied after the wait
+		TransformStore* transform_store = TransformStore::get_instance();
+		transform_store->begin_parallel_writes();
+		task_scheduler_->AddTaskSetToPipe(parallel_update_task_);
+		//The main thread runs ranges too while waiting
+		task_scheduler_->WaitforTask(parallel_update_task_);
+		transform_store->end_parallel_writes();
+	}
+	iterating_ = false;
+	apply_deferred_commands();
 }
 
 void ScrapEngine::Core::LogicManager::execute_game_objects_ongui_event()
 {
+	iterating_ = true;
 	for (SGameObject* game_object : registered_game_objects_)
 	{
 		game_object->on_gui();
 	}
+	iterating_ = false;
+	apply_deferred_commands();
+}
+
+void ScrapEngine::Core::LogicManager::update_transforms()
+{
+	TransformStore::get_instance()->update();
 }
@@ -1,29 +1,96 @@
 #pragma once
 
+#include <TaskScheduler.h>
 #include <vector>
+#include <functional>
 
 namespace ScrapEngine
 {
 	namespace Core
 	{
 		class SGameObject;
+		class SComponent;
 
 		class LogicManager
 		{
 		private:
 			std::vector<SGameObject*> registered_game_objects_;
+
+			//---parallel update
+			enki::TaskScheduler* task_scheduler_ = nullptr;
+			//Objects with the parallel update enabled, collected every update
+			std::vector<SGameObject*> parallel_game_objects_;
+			//Minimum number of objects updated by a task range
+			static const uint32_t parallel_update_chunk_size = 64;
+
+			//Parallel task used to call game_update() of the parallel objects
+			struct ParallelGameObjectUpdate : enki::ITaskSet
+			{
+				float time = 0;
+				LogicManager* owner;
+				void ExecuteRange(enki::TaskSetPartition range, uint32_t threadnum) override;
+			};
+
+			//I need to use a pointer because a ITaskSet cannot be copied
+			ParallelGameObjectUpdate* parallel_update_task_;
+
+			//---deferred commands
+			enum class deferred_command_type
+			{
+				spawn_game_object,
+				destroy_game_object,
+				add_component,
+				remove_component
+			};
+
+			struct deferred_command
+			{
+				deferred_command_type type;
+				SGameObject* game_object = nullptr;
+				SComponent* component = nullptr;
+				//If set, called at the sync point to create the object or the component
+				std::function<SGameObject*()> spawn_function;
+				std::function<SComponent*()> component_function;
+				bool update_position = true;
+			};
+
+			//One command buffer for each scheduler thread, so recording a command doesn't need a lock
+			//They are applied in thread order after the events
+			std::vector<std::vector<deferred_command>> deferred_commands_;
+			//True while the registered objects are iterated, the structural changes are deferred
+			bool iterating_ = false;
+
+			void record_command(deferred_command&& command);
+			void apply_deferred_commands();
+			void destroy_game_object(SGameObject* input_game_object);
 		public:
-			LogicManager() = default;
+			LogicManager();
 			~LogicManager();
 
+			//Without a scheduler every object is updated in the main thread
+			void set_task_scheduler(enki::TaskScheduler* task_scheduler);
+
+			//During the events the register and the un-register are deferred to the end of the event
 			SGameObject* register_game_object(SGameObject* input_game_object);
 			void un_register_game_object(SGameObject* input_game_object);
 			void delete_game_object(SGameObject* input_game_object);
 
+			//Structural changes safe to call from game_update() of the parallel objects
+			//They are applied once all the objects are updated, the destroys after everything else
+			void spawn_game_object_deferred(const std::function<SGameObject*()>& spawn_function);
+			void destroy_game_object_deferred(SGameObject* input_game_object);
+			void add_component_deferred(SGameObject* game_object, const std::function<SComponent*()>& component_function,
+			                            bool update_position = true);
+			void remove_component_deferred(SGameObject* game_object, SComponent* component);
+
 			//Events
 			void execute_game_objects_start_event();
+			//The objects in the main thread are updated first, then the parallel ones in the scheduler threads
 			void execute_game_objects_update_event(float time);
 			void execute_game_objects_ongui_event();
+
+			//Propagate the transforms changed during the frame to the children and the components
+			void update_transforms();
 		};
 	}
 }
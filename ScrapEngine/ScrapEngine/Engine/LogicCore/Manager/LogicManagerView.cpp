@@ -45,6 +45,31 @@ void ScrapEngine::Core::LogicManagerView::delete_game_object(SGameObject* input_
 	logic_manager_ref_->delete_game_object(input_game_object);
 }
 
+void ScrapEngine::Core::LogicManagerView::spawn_game_object_deferred(
+	const std::function<SGameObject*()>& spawn_function) const
+{
+	logic_manager_ref_->spawn_game_object_deferred(spawn_function);
+}
+
+void ScrapEngine::Core::LogicManagerView::destroy_game_object_deferred(SGameObject* input_game_object) const
+{
+	logic_manager_ref_->destroy_game_object_deferred(input_game_object);
+}
+
+void ScrapEngine::Core::LogicManagerView::add_component_deferred(SGameObject* game_object,
+                                                                 const std::function<SComponent*()>&
+                                                                 component_function,
+                                                                 const bool update_position) const
+{
+	logic_manager_ref_->add_component_deferred(game_object, component_function, update_position);
+}
+
+void ScrapEngine::Core::LogicManagerView::remove_component_deferred(SGameObject* game_object,
+                                                                    SComponent* component) const
+{
+	logic_manager_ref_->remove_component_deferred(game_object, component);
+}
+
 ScrapEngine::Core::ComponentsManager* ScrapEngine::Core::LogicManagerView::get_components_manager() const
 {
 	return component_manager_;
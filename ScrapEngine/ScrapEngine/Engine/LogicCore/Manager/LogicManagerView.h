@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 namespace ScrapEngine
 {
 	namespace Audio
@@ -29,6 +31,7 @@ namespace ScrapEngine
 	namespace Core
 	{
 		class SGameObject;
+		class SComponent;
 		class SceneManager;
 		class ComponentsManager;
 		class LogicManager;
@@ -52,6 +55,14 @@ namespace ScrapEngine
 			void un_register_game_object(SGameObject* input_game_object) const;
 			void delete_game_object(SGameObject* input_game_object) const;
 
+			//Deferred changes, use them from game_update() of the objects with the parallel update enabled
+			//They are applied after every object has been updated
+			void spawn_game_object_deferred(const std::function<SGameObject*()>& spawn_function) const;
+			void destroy_game_object_deferred(SGameObject* input_game_object) const;
+			void add_component_deferred(SGameObject* game_object, const std::function<SComponent*()>& component_function,
+			                            bool update_position = true) const;
+			void remove_component_deferred(SGameObject* game_object, SComponent* component) const;
+
 			ComponentsManager* get_components_manager() const;
 			SceneManager* get_scene_manager() const;
 		};
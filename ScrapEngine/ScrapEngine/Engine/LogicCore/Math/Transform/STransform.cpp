@@ -12,6 +12,11 @@ ScrapEngine::Core::SVector3 ScrapEngine::Core::STransform::get_position() const
 
 ScrapEngine::Core::SVector3 ScrapEngine::Core::STransform::get_rotation() const
 {
+	if (rotation_dirty_)
+	{
+		rotation_ = quaternion_rotation_.to_euler_angles();
+		rotation_dirty_ = false;
+	}
 	return rotation_;
 }
 
@@ -33,18 +38,19 @@ void ScrapEngine::Core::STransform::set_position(const SVector3& new_position)
 void ScrapEngine::Core::STransform::set_rotation(const SVector3& new_rotation)
 {
 	quaternion_rotation_ = SQuaternion(new_rotation);
-	rotation_ = quaternion_rotation_.to_euler_angles();
+	rotation_dirty_ = true;
 }
 
 void ScrapEngine::Core::STransform::set_rotation(const SQuaternion& new_rotation)
 {
-	quaternion_rotation_ = SQuaternion(new_rotation);
-	rotation_ = quaternion_rotation_.to_euler_angles();
+	quaternion_rotation_ = new_rotation;
+	rotation_dirty_ = true;
 }
 
 void ScrapEngine::Core::STransform::set_quat_rotation(const SQuaternion& new_rotation)
 {
 	quaternion_rotation_ = new_rotation;
+	rotation_dirty_ = true;
 }
 
 void ScrapEngine::Core::STransform::add_rotation(const SVector3& rotation)
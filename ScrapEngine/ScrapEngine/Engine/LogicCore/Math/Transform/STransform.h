@@ -11,7 +11,9 @@ namespace ScrapEngine
 		{
 		private:
 			SVector3 position_;
-			SVector3 rotation_;
+			//The euler angles are computed from the quaternion only when requested
+			mutable SVector3 rotation_;
+			mutable bool rotation_dirty_ = false;
 			SQuaternion quaternion_rotation_;
 			SVector3 scale_;
 		public:
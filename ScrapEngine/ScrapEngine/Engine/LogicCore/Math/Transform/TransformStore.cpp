@@ -0,0 +1,498 @@
+#include <Engine/LogicCore/Math/Transform/TransformStore.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+//Init static instance reference
+
+ScrapEngine::Core::TransformStore* ScrapEngine::Core::TransformStore::instance_ = nullptr;
+
+//Class
+
+ScrapEngine::Core::TransformStore* ScrapEngine::Core::TransformStore::get_instance()
+{
+	if (instance_ == nullptr)
+	{
+		instance_ = new TransformStore();
+	}
+	return instance_;
+}
+
+void ScrapEngine::Core::TransformStore::mark_dirty(const transform_id id, const uint8_t channels)
+{
+	if (dirty_[id] == 0)
+	{
+		dirty_count_++;
+	}
+	dirty_[id] |= channels;
+}
+
+bool ScrapEngine::Core::TransformStore::is_chain_dirty(transform_id id) const
+{
+	while (id != invalid_id)
+	{
+		if (dirty_[id] != 0)
+		{
+			return true;
+		}
+		id = parent_[id];
+	}
+	return false;
+}
+
+void ScrapEngine::Core::TransformStore::compute_world(const transform_id id, glm::vec3& position,
+                                                      glm::quat& rotation, glm::vec3& scale) const
+{
+	const transform_id parent = parent_[id];
+	if (parent == invalid_id)
+	{
+		position = local_position_[id];
+		rotation = local_rotation_[id];
+		scale = local_scale_[id];
+		return;
+	}
+	glm::vec3 parent_position;
+	glm::quat parent_rotation;
+	glm::vec3 parent_scale;
+	if (is_chain_dirty(parent))
+	{
+		compute_world(parent, parent_position, parent_rotation, parent_scale);
+	}
+	else
+	{
+		parent_position = world_position_[parent];
+		parent_rotation = world_rotation_[parent];
+		parent_scale = world_scale_[parent];
+	}
+	//The parent scale doesn't move the children, the scale is an offset from the parent one
+	position = parent_position + parent_rotation * local_position_[id];
+	rotation = parent_rotation * local_rotation_[id];
+	scale = parent_scale + local_scale_[id];
+}
+
+void ScrapEngine::Core::TransformStore::link_child(const transform_id id, const transform_id parent)
+{
+	parent_[id] = parent;
+	if (parent == invalid_id)
+	{
+		return;
+	}
+	const transform_id first = first_child_[parent];
+	next_sibling_[id] = first;
+	previous_sibling_[id] = invalid_id;
+	if (first != invalid_id)
+	{
+		previous_sibling_[first] = id;
+	}
+	first_child_[parent] = id;
+}
+
+void ScrapEngine::Core::TransformStore::unlink_child(const transform_id id)
+{
+	const transform_id parent = parent_[id];
+	if (parent == invalid_id)
+	{
+		return;
+	}
+	const transform_id next = next_sibling_[id];
+	const transform_id previous = previous_sibling_[id];
+	if (next != invalid_id)
+	{
+		previous_sibling_[next] = previous;
+	}
+	if (previous != invalid_id)
+	{
+		next_sibling_[previous] = next;
+	}
+	else
+	{
+		first_child_[parent] = next;
+	}
+	next_sibling_[id] = invalid_id;
+	previous_sibling_[id] = invalid_id;
+	parent_[id] = invalid_id;
+}
+
+void ScrapEngine::Core::TransformStore::defer_write(const transform_id id, const uint8_t channel)
+{
+	if (pending_[id] == 0)
+	{
+		pending_count_++;
+	}
+	pending_[id] |= channel;
+}
+
+void ScrapEngine::Core::TransformStore::rebuild_order()
+{
+	//Breadth first visit from the roots, every level comes after the previous one
+	order_.clear();
+	for (transform_id id = 0; id < parent_.size(); id++)
+	{
+		if (alive_[id] && parent_[id] == invalid_id)
+		{
+			order_.push_back(id);
+		}
+	}
+	for (size_t i = 0; i < order_.size(); i++)
+	{
+		for (transform_id child = first_child_[order_[i]]; child != invalid_id; child = next_sibling_[child])
+		{
+			order_.push_back(child);
+		}
+	}
+	order_dirty_ = false;
+}
+
+ScrapEngine::Core::transform_id ScrapEngine::Core::TransformStore::create(const glm::vec3& position,
+                                                                         const glm::quat& rotation,
+                                                                         const glm::vec3& scale,
+                                                                         TransformListener* listener)
+{
+	transform_id id;
+	if (!free_ids_.empty())
+	{
+		id = free_ids_.back();
+		free_ids_.pop_back();
+	}
+	else
+	{
+		id = static_cast<transform_id>(parent_.size());
+		local_position_.emplace_back();
+		local_rotation_.emplace_back();
+		local_scale_.emplace_back();
+		world_position_.emplace_back();
+		world_rotation_.emplace_back();
+		world_scale_.emplace_back();
+		world_matrix_.emplace_back();
+		parent_.emplace_back();
+		first_child_.emplace_back();
+		next_sibling_.emplace_back();
+		previous_sibling_.emplace_back();
+		dirty_.emplace_back();
+		alive_.emplace_back();
+		listener_.emplace_back();
+	}
+	local_position_[id] = world_position_[id] = position;
+	local_rotation_[id] = world_rotation_[id] = rotation;
+	local_scale_[id] = world_scale_[id] = scale;
+	world_matrix_[id] = glm::scale(glm::translate(glm::mat4(1.0f), position) * glm::mat4_cast(rotation), scale);
+	parent_[id] = invalid_id;
+	first_child_[id] = invalid_id;
+	next_sibling_[id] = invalid_id;
+	previous_sibling_[id] = invalid_id;
+	dirty_[id] = 0;
+	alive_[id] = 1;
+	listener_[id] = listener;
+	//The listener receives the initial values with the next update
+	mark_dirty(id, all);
+	order_dirty_ = true;
+
+	return id;
+}
+
+void ScrapEngine::Core::TransformStore::destroy(const transform_id id)
+{
+	transform_id child = first_child_[id];
+	while (child != invalid_id)
+	{
+		//set_parent() unlinks the child, so the next one is read before
+		const transform_id next = next_sibling_[child];
+		set_parent(child, invalid_id);
+		child = next;
+	}
+	unlink_child(id);
+	if (dirty_[id] != 0)
+	{
+		dirty_count_--;
+	}
+	dirty_[id] = 0;
+	alive_[id] = 0;
+	listener_[id] = nullptr;
+	free_ids_.push_back(id);
+	order_dirty_ = true;
+}
+
+void ScrapEngine::Core::TransformStore::set_parent(const transform_id id, const transform_id parent)
+{
+	if (parent_[id] == parent)
+	{
+		return;
+	}
+	const glm::vec3 position = get_world_position(id);
+	const glm::quat rotation = get_world_rotation(id);
+	const glm::vec3 scale = get_world_scale(id);
+
+	unlink_child(id);
+	link_child(id, parent);
+	order_dirty_ = true;
+
+	set_world_position(id, position);
+	set_world_rotation(id, rotation);
+	set_world_scale(id, scale);
+}
+
+ScrapEngine::Core::transform_id ScrapEngine::Core::TransformStore::get_parent(const transform_id id) const
+{
+	return parent_[id];
+}
+
+void ScrapEngine::Core::TransformStore::set_world_position(const transform_id id, const glm::vec3& position)
+{
+	if (parallel_writes_)
+	{
+		pending_position_[id] = position;
+		defer_write(id, location);
+		return;
+	}
+	const transform_id parent = parent_[id];
+	if (parent == invalid_id)
+	{
+		local_position_[id] = position;
+	}
+	else
+	{
+		local_position_[id] = glm::inverse(get_world_rotation(parent)) * (position - get_world_position(parent));
+	}
+	mark_dirty(id, location);
+}
+
+void ScrapEngine::Core::TransformStore::set_world_rotation(const transform_id id, const glm::quat& rotation)
+{
+	if (parallel_writes_)
+	{
+		pending_rotation_[id] = rotation;
+		defer_write(id, TransformStore::rotation);
+		return;
+	}
+	const transform_id parent = parent_[id];
+	if (parent == invalid_id)
+	{
+		local_rotation_[id] = rotation;
+	}
+	else
+	{
+		local_rotation_[id] = glm::inverse(get_world_rotation(parent)) * rotation;
+	}
+	mark_dirty(id, TransformStore::rotation);
+}
+
+void ScrapEngine::Core::TransformStore::set_world_scale(const transform_id id, const glm::vec3& scale)
+{
+	if (parallel_writes_)
+	{
+		pending_scale_[id] = scale;
+		defer_write(id, TransformStore::scale);
+		return;
+	}
+	const transform_id parent = parent_[id];
+	if (parent == invalid_id)
+	{
+		local_scale_[id] = scale;
+	}
+	else
+	{
+		local_scale_[id] = scale - get_world_scale(parent);
+	}
+	mark_dirty(id, TransformStore::scale);
+}
+
+glm::vec3 ScrapEngine::Core::TransformStore::get_world_position(const transform_id id) const
+{
+	if (parallel_writes_)
+	{
+		return pending_[id] & location ? pending_position_[id] : world_position_[id];
+	}
+	if (dirty_count_ == 0 || !is_chain_dirty(id))
+	{
+		return world_position_[id];
+	}
+	glm::vec3 position, scale;
+	glm::quat rotation;
+	compute_world(id, position, rotation, scale);
+	return position;
+}
+
+glm::quat ScrapEngine::Core::TransformStore::get_world_rotation(const transform_id id) const
+{
+	if (parallel_writes_)
+	{
+		return pending_[id] & rotation ? pending_rotation_[id] : world_rotation_[id];
+	}
+	if (dirty_count_ == 0 || !is_chain_dirty(id))
+	{
+		return world_rotation_[id];
+	}
+	glm::vec3 position, scale;
+	glm::quat rotation;
+	compute_world(id, position, rotation, scale);
+	return rotation;
+}
+
+glm::vec3 ScrapEngine::Core::TransformStore::get_world_scale(const transform_id id) const
+{
+	if (parallel_writes_)
+	{
+		return pending_[id] & scale ? pending_scale_[id] : world_scale_[id];
+	}
+	if (dirty_count_ == 0 || !is_chain_dirty(id))
+	{
+		return world_scale_[id];
+	}
+	glm::vec3 position, scale;
+	glm::quat rotation;
+	compute_world(id, position, rotation, scale);
+	return scale;
+}
+
+glm::mat4 ScrapEngine::Core::TransformStore::get_world_matrix(const transform_id id) const
+{
+	if (parallel_writes_)
+	{
+		if (pending_[id] == 0)
+		{
+			return world_matrix_[id];
+		}
+		return glm::scale(glm::translate(glm::mat4(1.0f), get_world_position(id)) *
+		                  glm::mat4_cast(get_world_rotation(id)), get_world_scale(id));
+	}
+	if (dirty_count_ == 0 || !is_chain_dirty(id))
+	{
+		return world_matrix_[id];
+	}
+	glm::vec3 position, scale;
+	glm::quat rotation;
+	compute_world(id, position, rotation, scale);
+	return glm::scale(glm::translate(glm::mat4(1.0f), position) * glm::mat4_cast(rotation), scale);
+}
+
+glm::vec3 ScrapEngine::Core::TransformStore::get_local_position(const transform_id id) const
+{
+	return local_position_[id];
+}
+
+glm::quat ScrapEngine::Core::TransformStore::get_local_rotation(const transform_id id) const
+{
+	return local_rotation_[id];
+}
+
+glm::vec3 ScrapEngine::Core::TransformStore::get_local_scale(const transform_id id) const
+{
+	return local_scale_[id];
+}
+
+void ScrapEngine::Core::TransformStore::update()
+{
+	if (order_dirty_)
+	{
+		rebuild_order();
+	}
+	if (dirty_count_ == 0)
+	{
+		return;
+	}
+	//The parents are before their children, so the parent world values and changes are already final
+	for (const transform_id id : order_)
+	{
+		const transform_id parent = parent_[id];
+		uint8_t changed = dirty_[id];
+		if (parent != invalid_id)
+		{
+			const uint8_t parent_changed = dirty_[parent];
+			if (parent_changed & location)
+			{
+				changed |= location;
+			}
+			//A rotated parent also moves its children
+			if (parent_changed & rotation)
+			{
+				changed |= rotation | location;
+			}
+			if (parent_changed & scale)
+			{
+				changed |= scale;
+			}
+		}
+		if (changed == 0)
+		{
+			continue;
+		}
+		dirty_[id] = changed;
+
+		if (parent == invalid_id)
+		{
+			world_position_[id] = local_position_[id];
+			world_rotation_[id] = local_rotation_[id];
+			world_scale_[id] = local_scale_[id];
+		}
+		else
+		{
+			world_position_[id] = world_position_[parent] + world_rotation_[parent] * local_position_[id];
+			world_rotation_[id] = world_rotation_[parent] * local_rotation_[id];
+			world_scale_[id] = world_scale_[parent] + local_scale_[id];
+		}
+		world_matrix_[id] = glm::scale(
+			glm::translate(glm::mat4(1.0f), world_position_[id]) * glm::mat4_cast(world_rotation_[id]),
+			world_scale_[id]);
+		changed_.emplace_back(id, changed);
+	}
+	for (const std::pair<transform_id, uint8_t>& node : changed_)
+	{
+		dirty_[node.first] = 0;
+	}
+	dirty_count_ = 0;
+	//Notify only when every world value is final, a listener may read other nodes
+	//Values set from a listener are applied with the next update
+	for (const std::pair<transform_id, uint8_t>& node : changed_)
+	{
+		if (listener_[node.first])
+		{
+			listener_[node.first]->on_world_transform_changed(node.second);
+		}
+	}
+	changed_.clear();
+}
+
+void ScrapEngine::Core::TransformStore::begin_parallel_writes()
+{
+	//Sized here so the threads never resize the pending arrays
+	pending_position_.resize(parent_.size());
+	pending_rotation_.resize(parent_.size());
+	pending_scale_.resize(parent_.size());
+	pending_.resize(parent_.size(), 0);
+	parallel_writes_ = true;
+}
+
+void ScrapEngine::Core::TransformStore::end_parallel_writes()
+{
+	parallel_writes_ = false;
+	if (pending_count_ == 0)
+	{
+		return;
+	}
+	if (order_dirty_)
+	{
+		rebuild_order();
+	}
+	//The parents are applied first, so the local values of their children use the new parent transform
+	for (const transform_id id : order_)
+	{
+		const uint8_t channels = pending_[id];
+		if (channels == 0)
+		{
+			continue;
+		}
+		pending_[id] = 0;
+		if (channels & location)
+		{
+			set_world_position(id, pending_position_[id]);
+		}
+		if (channels & rotation)
+		{
+			set_world_rotation(id, pending_rotation_[id]);
+		}
+		if (channels & scale)
+		{
+			set_world_scale(id, pending_scale_[id]);
+		}
+	}
+	pending_count_ = 0;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/ext/quaternion_float.hpp>
+#include <vector>
+#include <atomic>
+#include <utility>
+#include <cstdint>
+
+namespace ScrapEngine
+{
+	namespace Core
+	{
+		typedef uint32_t transform_id;
+
+		//Notified by the TransformStore when the world transform of its node changes
+		class TransformListener
+		{
+		public:
+			virtual ~TransformListener() = default;
+
+			//changed is a mask of TransformStore::transform_channel
+			virtual void on_world_transform_changed(uint8_t changed) = 0;
+		};
+
+		//Central storage of the game objects and components transforms
+		//The data is kept in parallel arrays, the world values are updated once per frame in hierarchy order
+		//Moving a parent only marks it as dirty, its children are updated by the same linear pass
+		//Between begin_parallel_writes() and end_parallel_writes() the world setters only store the value
+		//in the node pending slot, so the objects updated in parallel never read a node moved by another thread
+		class TransformStore
+		{
+		public:
+			static const transform_id invalid_id = UINT32_MAX;
+
+			enum transform_channel : uint8_t
+			{
+				location = 1,
+				rotation = 2,
+				scale = 4,
+				all = location | rotation | scale
+			};
+		private:
+			//Singleton static instance
+			static TransformStore* instance_;
+
+			//The constructor is private because this class is a Singleton
+			TransformStore() = default;
+
+			//Local values, relative to the parent or in world space for the roots
+			std::vector<glm::vec3> local_position_;
+			std::vector<glm::quat> local_rotation_;
+			std::vector<glm::vec3> local_scale_;
+			//Cached world values, valid after update() for the nodes not marked as dirty
+			std::vector<glm::vec3> world_position_;
+			std::vector<glm::quat> world_rotation_;
+			std::vector<glm::vec3> world_scale_;
+			std::vector<glm::mat4> world_matrix_;
+			std::vector<transform_id> parent_;
+			//Intrusive list of the children, so a node can be detached without searching its parent
+			std::vector<transform_id> first_child_;
+			std::vector<transform_id> next_sibling_;
+			std::vector<transform_id> previous_sibling_;
+			//Mask of the changed channels
+			std::vector<uint8_t> dirty_;
+			std::vector<uint8_t> alive_;
+			std::vector<TransformListener*> listener_;
+
+			std::vector<transform_id> free_ids_;
+			//Alive nodes sorted by depth, so every parent comes before its children
+			std::vector<transform_id> order_;
+			bool order_dirty_ = false;
+			//Nodes updated by the last update() with their changed channels
+			std::vector<std::pair<transform_id, uint8_t>> changed_;
+			//Atomic because the objects with the parallel update can move themselves at the same time
+			std::atomic<uint32_t> dirty_count_{0};
+			//World values set during the parallel writes, applied by end_parallel_writes()
+			//Every slot is written only by the thread that owns the node
+			std::vector<glm::vec3> pending_position_;
+			std::vector<glm::quat> pending_rotation_;
+			std::vector<glm::vec3> pending_scale_;
+			//Mask of the pending channels
+			std::vector<uint8_t> pending_;
+			std::atomic<uint32_t> pending_count_{0};
+			bool parallel_writes_ = false;
+
+			void mark_dirty(transform_id id, uint8_t channels);
+			void link_child(transform_id id, transform_id parent);
+			void unlink_child(transform_id id);
+			//Add the channel to the pending mask of the node
+			void defer_write(transform_id id, uint8_t channel);
+			bool is_chain_dirty(transform_id id) const;
+			void compute_world(transform_id id, glm::vec3& position, glm::quat& rotation, glm::vec3& scale) const;
+			void rebuild_order();
+		public:
+			~TransformStore() = default;
+
+			static TransformStore* get_instance();
+
+			transform_id create(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale,
+			                    TransformListener* listener = nullptr);
+			//The children of a destroyed node become roots, keeping their world transform
+			void destroy(transform_id id);
+
+			//The world transform of the node is kept, its local values are computed again
+			void set_parent(transform_id id, transform_id parent);
+			transform_id get_parent(transform_id id) const;
+
+			//The world setters compute the local value from the parent world transform
+			//During the parallel writes they are deferred, see begin_parallel_writes()
+			void set_world_position(transform_id id, const glm::vec3& position);
+			void set_world_rotation(transform_id id, const glm::quat& rotation);
+			void set_world_scale(transform_id id, const glm::vec3& scale);
+
+			//The world getters return the cached values, or walk the hierarchy if something above is dirty
+			//During the parallel writes they return the pending value of the node or the last update() one
+			glm::vec3 get_world_position(transform_id id) const;
+			glm::quat get_world_rotation(transform_id id) const;
+			glm::vec3 get_world_scale(transform_id id) const;
+			glm::mat4 get_world_matrix(transform_id id) const;
+
+			glm::vec3 get_local_position(transform_id id) const;
+			glm::quat get_local_rotation(transform_id id) const;
+			glm::vec3 get_local_scale(transform_id id) const;
+
+			//Update the world values of the dirty nodes and their descendants, then notify the listeners
+			void update();
+
+			//Called by the main thread around the parallel update of the game objects
+			//No node can be created, destroyed or parented in between
+			void begin_parallel_writes();
+			//Apply the pending world values in hierarchy order, so a child set with its parent keeps its value
+			void end_parallel_writes();
+		};
+	}
+}
@@ -6,8 +6,7 @@ namespace ScrapEngine
 {
 	namespace Render
 	{
-		class StandardShadowmapping;
-		class VulkanSkyboxInstance;
+		class RenderWorld;
 		class RenderManager;
 	}
 }
@@ -22,9 +21,9 @@ namespace ScrapEngine
 		{
 		private:
 			Render::RenderManager* render_manager_ref_ = nullptr;
-			Render::VulkanSkyboxInstance* current_skybox_ = nullptr;
 
-			Render::StandardShadowmapping* shadowmapping_manager_ = nullptr;
+			//The light is written in the game side of the render world, the shadowmapping gets it with the snapshot
+			Render::RenderWorld* render_world_ = nullptr;
 		public:
 			explicit SceneManager(Render::RenderManager* input_render_manager_ref);
 			~SceneManager() = default;
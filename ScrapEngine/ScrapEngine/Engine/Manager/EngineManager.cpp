@@ -1,6 +1,7 @@
 #include <Engine/Manager/EngineManager.h>
-#include <chrono>
+#include <Engine/Manager/FrameTaskGraph.h>
 #include <Engine/Debug/DebugLog.h>
+#include <Engine/Debug/CpuProfiler.h>
 #include <Engine/Input/Gui/GuiInput.h>
 #include <Engine/Rendering/Manager/RenderManager.h>
 #include <Engine/Rendering/Manager/RenderManagerView.h>
@@ -21,6 +22,12 @@ ScrapEngine::Manager::EngineManager::EngineManager(const std::string& app_name,
 	initialize_engine();
 }
 
+ScrapEngine::Manager::EngineManager::EngineManager(const game_base_info& game_info)
+	: received_base_game_info_(game_info)
+{
+	initialize_engine();
+}
+
 ScrapEngine::Manager::EngineManager::~EngineManager()
 {
 	if (!cleanup_done_)
@@ -32,10 +39,13 @@ ScrapEngine::Manager::EngineManager::~EngineManager()
 
 void ScrapEngine::Manager::EngineManager::start_game_loop()
 {
-	//Execute Game Objects start events
-	scrap_logic_manager_->execute_game_objects_start_event();
-	//Prepare draw frame
-	scrap_render_manager_->prepare_to_draw_frame();
+	{
+		SCRAP_PROFILE_SCOPE("game_start");
+		//Execute Game Objects start events
+		scrap_logic_manager_->execute_game_objects_start_event();
+		//Prepare draw frame
+		scrap_render_manager_->prepare_to_draw_frame();
+	}
 	//Execute game loop until end
 	main_game_loop();
 	//Execution ended, close the engine
@@ -45,35 +55,53 @@ void ScrapEngine::Manager::EngineManager::start_game_loop()
 
 void ScrapEngine::Manager::EngineManager::initialize_engine()
 {
+	//Enabled first, so the startup is recorded too
+	Debug::CpuProfiler::set_enabled(received_base_game_info_.cpu_profiler);
+	SCRAP_PROFILE_THREAD_NAME("main");
+	SCRAP_PROFILE_FUNCTION();
 	Debug::DebugLog::print_init_message();
 	Debug::DebugLog::print_to_console_log("---initializeEngine()---");
+	initialize_scheduler(); //Create the scheduler used by every module
 	initialize_render_manager(&received_base_game_info_); //Create the base rendering module
 	initialize_logic_manager(); //Create the base logic manager
 	initialize_physics_manager(); // Create the physics manager
 	initialize_audio_manager(); // Create the audio manager
 	initialize_views(); //Create the views for the user
+	initialize_frame_graph(); //Describe the work of each frame
 	Debug::DebugLog::print_to_console_log("---initializeEngine() completed---");
 }
 
+void ScrapEngine::Manager::EngineManager::initialize_scheduler()
+{
+	Debug::DebugLog::print_to_console_log("Creating scheduler...");
+	//Initialize enkiTS scheduler
+	task_scheduler_.Initialize();
+}
+
 void ScrapEngine::Manager::EngineManager::initialize_render_manager(const game_base_info* game_info)
 {
-	scrap_render_manager_ = new Render::RenderManager(game_info);
+	SCRAP_PROFILE_FUNCTION();
+	scrap_render_manager_ = new Render::RenderManager(game_info, &task_scheduler_);
 }
 
 void ScrapEngine::Manager::EngineManager::initialize_logic_manager()
 {
+	SCRAP_PROFILE_FUNCTION();
 	scrap_logic_manager_ = new Core::LogicManager();
+	scrap_logic_manager_->set_task_scheduler(&task_scheduler_);
 	//Reference to update gui input
 	scrap_input_manager_ = scrap_render_manager_->get_game_window()->create_window_input_manager();
 }
 
 void ScrapEngine::Manager::EngineManager::initialize_physics_manager()
 {
+	SCRAP_PROFILE_FUNCTION();
 	physics_manager_ = new Physics::PhysicsManager();
 }
 
 void ScrapEngine::Manager::EngineManager::initialize_audio_manager()
 {
+	SCRAP_PROFILE_FUNCTION();
 	audio_manager_ = new Audio::AudioManager();
 }
 
@@ -86,34 +114,79 @@ void ScrapEngine::Manager::EngineManager::initialize_views()
 	logic_manager_view->set_audio_manager(audio_manager_);
 }
 
+void ScrapEngine::Manager::EngineManager::initialize_frame_graph()
+{
+	frame_graph_ = new FrameTaskGraph();
+	//Execute objects update(), the parallel objects use the workers inside it
+	const FrameTaskGraph::node_id logic = frame_graph_->add_node("logic_update", [this]()
+	{
+		scrap_logic_manager_->execute_game_objects_update_event(frame_time_);
+	}, true);
+	//The physics world is not read by the render thread, so it steps while the previous frame is drawn
+	//It depends only on the logic, so it overlaps render_sync, the gui and the audio of the main thread
+	const FrameTaskGraph::node_id physics = frame_graph_->add_node("physics_step", [this]()
+	{
+		physics_step(frame_time_);
+	}, false, {logic});
+	//The gui and the cleanup use the render resources, the previous frame must be done
+	//The graph starts every node when its own dependencies are done, so this doesn't wait for the physics
+	const FrameTaskGraph::node_id render_sync = frame_graph_->add_node("render_sync", [this]()
+	{
+		scrap_render_manager_->wait_frame_render();
+	}, true, {logic});
+	//The gui and the audio use GLFW and OpenAL so they stay in the main thread
+	const FrameTaskGraph::node_id gui = frame_graph_->add_node("gui_update", [this]()
+	{
+		gui_update(frame_time_);
+	}, true, {render_sync});
+	const FrameTaskGraph::node_id audio = frame_graph_->add_node("audio_update", [this]()
+	{
+		audio_update();
+	}, true, {render_sync});
+	//First node that joins the physics with the main thread work
+	//Apply the transforms changed by the logic, the gui and the physics, then take the render snapshot
+	const FrameTaskGraph::node_id transform_sync = frame_graph_->add_node("transform_sync", [this]()
+	{
+		physics_sync();
+		scrap_logic_manager_->update_transforms();
+		scrap_render_manager_->extract_render_world();
+	}, true, {physics, gui, audio});
+	//Culling, uniform buffers update and submission run in the render thread until the next render_sync
+	frame_graph_->add_node("render_kick", [this]()
+	{
+		scrap_render_manager_->begin_frame_render();
+	}, true, {transform_sync});
+}
+
 void ScrapEngine::Manager::EngineManager::main_game_loop()
 {
 	Debug::DebugLog::print_to_console_log("---mainGameLoop() started---");
-	std::chrono::time_point<std::chrono::steady_clock> start_time, current_time;
 	const Render::GameWindow* window_ref = scrap_render_manager_->get_game_window();
-	while (!window_ref->check_window_should_close())
+	last_frame_time_ = std::chrono::steady_clock::now();
+	const uint32_t test_frame_count = received_base_game_info_.test_frame_count;
+	uint32_t frame_count = 0;
+	while (!window_ref->check_window_should_close() && (test_frame_count == 0 || frame_count < test_frame_count))
 	{
-		//Compute frame delta time
-		const float time = std::chrono::duration<float, std::chrono::seconds::period>
-			(current_time - start_time).count();
-		//Execute objects update()
-		scrap_logic_manager_->execute_game_objects_update_event(time);
-		//Gui data update
-		gui_update(time);
-		//Update physics
-		physics_update(time);
-		//Update audio
-		audio_update();
-		//Draw frame and compute new times
-		start_time = std::chrono::high_resolution_clock::now();
-		scrap_render_manager_->draw_frame();
-		current_time = std::chrono::high_resolution_clock::now();
+		SCRAP_PROFILE_SCOPE("frame");
+		//Compute frame delta time, the draw overlaps the game frame so the whole frame is measured
+		const std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+		frame_time_ = std::chrono::duration<float, std::chrono::seconds::period>(now - last_frame_time_).count();
+		last_frame_time_ = now;
+		frame_graph_->run(&task_scheduler_);
+		scrap_render_manager_->check_steady_frame_allocations();
+		frame_count++;
 	}
+	//The last frame could still be drawing
+	scrap_render_manager_->wait_frame_render();
 	scrap_render_manager_->wait_device_idle();
+	if (test_frame_count != 0 && received_base_game_info_.temporal_upscaling_check_frame != 0)
+	{
+		scrap_render_manager_->finish_temporal_upscaling_check();
+	}
 	Debug::DebugLog::print_to_console_log("---mainGameLoop() ended---");
 }
 
-void ScrapEngine::Manager::EngineManager::physics_update(const float delta_time)
+void ScrapEngine::Manager::EngineManager::physics_step(const float delta_time)
 {
 	accumulator_ += delta_time;
 	while (accumulator_ >= time_step_)
@@ -121,9 +194,14 @@ void ScrapEngine::Manager::EngineManager::physics_update(const float delta_time)
 		physics_manager_->update_physics(time_step_);
 		accumulator_ -= time_step_;
 	}
-	const float factor = accumulator_ / time_step_;
+	physics_factor_ = accumulator_ / time_step_;
+}
+
+void ScrapEngine::Manager::EngineManager::physics_sync() const
+{
+	SCRAP_PROFILE_FUNCTION();
 	//Once physics ended updating, update the rigidbody component position
-	logic_manager_view->get_components_manager()->update_rigidbody_physics(factor);
+	logic_manager_view->get_components_manager()->update_rigidbody_physics(physics_factor_);
 }
 
 void ScrapEngine::Manager::EngineManager::gui_update(const float time) const
@@ -160,13 +238,20 @@ void ScrapEngine::Manager::EngineManager::cleanup_engine()
 {
 	Debug::DebugLog::print_to_console_log("---cleanupEngine()---");
 
+	delete frame_graph_;
 	delete scrap_render_manager_;
 	delete render_manager_view;
 	delete logic_manager_view;
 	delete physics_manager_;
 	delete audio_manager_;
 	delete scrap_logic_manager_;
+	//Every module has been deleted, no task can use the scheduler anymore
+	task_scheduler_.WaitforAllAndShutdown();
 
 	cleanup_done_ = true;
+	if (!received_base_game_info_.cpu_profiler_trace_path.empty())
+	{
+		Debug::CpuProfiler::dump_chrome_trace(received_base_game_info_.cpu_profiler_trace_path);
+	}
 	Debug::DebugLog::print_to_console_log("---cleanupEngine() completed---");
 }
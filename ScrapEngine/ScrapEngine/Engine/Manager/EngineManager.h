@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Engine/Utility/UsefulTypes.h>
+#include <TaskScheduler.h>
+#include <chrono>
 
 namespace ScrapEngine
 {
@@ -48,6 +50,8 @@ namespace ScrapEngine
 {
 	namespace Manager
 	{
+		class FrameTaskGraph;
+
 		class EngineManager
 		{
 		private:
@@ -55,6 +59,16 @@ namespace ScrapEngine
 
 			game_base_info received_base_game_info_;
 
+			//Scheduler shared by every subsystem
+			enki::TaskScheduler task_scheduler_;
+			//Work of each frame: logic, then physics step || render sync, then audio || gui,
+			//then transform sync and render world extraction, then the render thread is started
+			//The render thread draws the frame while the game thread simulates the next one
+			FrameTaskGraph* frame_graph_ = nullptr;
+			//Delta time used by the nodes of the current frame
+			float frame_time_ = 0;
+			std::chrono::time_point<std::chrono::steady_clock> last_frame_time_;
+
 			Render::RenderManager* scrap_render_manager_ = nullptr;
 			Core::LogicManager* scrap_logic_manager_ = nullptr;
 			Input::InputManager* scrap_input_manager_ = nullptr;
@@ -65,6 +79,8 @@ namespace ScrapEngine
 			EngineManager(const std::string& app_name = "ScrapEngine Game", int app_version = 1,
 			              uint32_t window_width = 800,
 			              uint32_t window_height = 600, bool fullscreen = false, bool vsync = true);
+			//Use this to configure also the present mode, the swap chain images and the frames in flight
+			explicit EngineManager(const game_base_info& game_info);
 			~EngineManager();
 
 			void start_game_loop();
@@ -74,18 +90,26 @@ namespace ScrapEngine
 		private:
 			void initialize_engine();
 
+			void initialize_scheduler();
+
 			void initialize_render_manager(const game_base_info* game_info);
 			void initialize_logic_manager();
 			void initialize_physics_manager();
 			void initialize_audio_manager();
 			void initialize_views();
+			void initialize_frame_graph();
 
 			void main_game_loop();
 
 			//physics update frequency
 			const float time_step_ = 1.0f / 120.0f;
 			float accumulator_ = 0;
-			void physics_update(float delta_time);
+			//Interpolation factor between the last two physics steps
+			float physics_factor_ = 0;
+			//Step the physics world, it doesn't touch the components so it can run in a worker thread
+			void physics_step(float delta_time);
+			//Copy the interpolated rigidbodies transforms to the components
+			void physics_sync() const;
 
 			//Gui update
 			void gui_update(float time) const;
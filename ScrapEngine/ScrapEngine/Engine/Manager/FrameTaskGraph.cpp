@@ -0,0 +1,149 @@
+#include <Engine/Manager/FrameTaskGraph.h>
+#include <Engine/Debug/CpuProfiler.h>
+
+void ScrapEngine::Manager::FrameTaskGraph::node_state::execute()
+{
+	{
+		SCRAP_PROFILE_SCOPE(name);
+		function();
+	}
+	//The successors are started before the task is marked as completed by the scheduler
+	graph->complete_node(id);
+}
+
+void ScrapEngine::Manager::FrameTaskGraph::FunctionTask::ExecuteRange(enki::TaskSetPartition range,
+                                                                      uint32_t threadnum)
+{
+	execute();
+}
+
+void ScrapEngine::Manager::FrameTaskGraph::PinnedFunctionTask::Execute()
+{
+	execute();
+}
+
+void ScrapEngine::Manager::FrameTaskGraph::FrameEndTask::Execute()
+{
+	*frame_completed = true;
+}
+
+ScrapEngine::Manager::FrameTaskGraph::FrameTaskGraph()
+{
+	//The main thread is the scheduler thread 0
+	frame_end_task_.threadNum = 0;
+	frame_end_task_.frame_completed = &frame_completed_;
+}
+
+ScrapEngine::Manager::FrameTaskGraph::~FrameTaskGraph()
+{
+	for (const graph_node& node : nodes_)
+	{
+		delete node.task;
+		delete node.pinned_task;
+	}
+}
+
+ScrapEngine::Manager::FrameTaskGraph::node_state* ScrapEngine::Manager::FrameTaskGraph::get_state(
+	const node_id id) const
+{
+	if (nodes_[id].pinned_task)
+	{
+		return nodes_[id].pinned_task;
+	}
+	return nodes_[id].task;
+}
+
+ScrapEngine::Manager::FrameTaskGraph::node_id ScrapEngine::Manager::FrameTaskGraph::add_node(
+	const char* name, const std::function<void()>& function, const bool main_thread,
+	const std::vector<node_id>& dependencies)
+{
+	const node_id id = static_cast<node_id>(nodes_.size());
+	graph_node node;
+	node_state* state;
+	if (main_thread)
+	{
+		node.pinned_task = new PinnedFunctionTask();
+		//The main thread is the scheduler thread 0
+		node.pinned_task->threadNum = 0;
+		state = node.pinned_task;
+	}
+	else
+	{
+		node.task = new FunctionTask();
+		//Below the render tasks, see RenderManager
+		node.task->m_Priority = enki::TASK_PRIORITY_MED;
+		state = node.task;
+	}
+	state->graph = this;
+	state->id = id;
+	state->name = name;
+	state->function = function;
+	node.dependency_count = static_cast<uint32_t>(dependencies.size());
+	for (const node_id dependency : dependencies)
+	{
+		nodes_[dependency].successors.push_back(id);
+	}
+	nodes_.push_back(node);
+
+	return id;
+}
+
+void ScrapEngine::Manager::FrameTaskGraph::start_node(const node_id id)
+{
+	if (nodes_[id].pinned_task)
+	{
+		task_scheduler_->AddPinnedTask(nodes_[id].pinned_task);
+	}
+	else
+	{
+		task_scheduler_->AddTaskSetToPipe(nodes_[id].task);
+	}
+}
+
+void ScrapEngine::Manager::FrameTaskGraph::complete_node(const node_id id)
+{
+	for (const node_id successor : nodes_[id].successors)
+	{
+		if (get_state(successor)->remaining_dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			start_node(successor);
+		}
+	}
+	if (remaining_nodes_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		task_scheduler_->AddPinnedTask(&frame_end_task_);
+	}
+}
+
+void ScrapEngine::Manager::FrameTaskGraph::run(enki::TaskScheduler* task_scheduler)
+{
+	task_scheduler_ = task_scheduler;
+	if (nodes_.empty())
+	{
+		return;
+	}
+	frame_completed_ = false;
+	remaining_nodes_.store(static_cast<uint32_t>(nodes_.size()), std::memory_order_relaxed);
+	for (node_id id = 0; id < nodes_.size(); id++)
+	{
+		get_state(id)->remaining_dependencies.store(nodes_[id].dependency_count, std::memory_order_relaxed);
+	}
+	for (node_id id = 0; id < nodes_.size(); id++)
+	{
+		if (nodes_[id].dependency_count == 0)
+		{
+			start_node(id);
+		}
+	}
+	//Every node ready for the main thread is a pinned task, the last completed node adds the frame end task
+	//so the main thread always wakes up for its next work, without polling
+	while (true)
+	{
+		task_scheduler_->RunPinnedTasks();
+		if (frame_completed_)
+		{
+			break;
+		}
+		task_scheduler_->WaitForNewPinnedTasks();
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <TaskScheduler.h>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace ScrapEngine
+{
+	namespace Manager
+	{
+		//Work of a frame described as nodes with their dependencies, executed on the enkiTS scheduler
+		//Every node has a counter of the dependencies not completed yet, the last one to complete starts it
+		//so a node never waits for nodes it doesn't depend on
+		//The main thread nodes are pinned tasks, for the apis that must be called from the main thread (GLFW, OpenAL)
+		class FrameTaskGraph
+		{
+		public:
+			typedef uint32_t node_id;
+		private:
+			//Shared by the two kinds of task
+			struct node_state
+			{
+				FrameTaskGraph* graph = nullptr;
+				node_id id = 0;
+				const char* name = nullptr;
+				std::function<void()> function;
+				//Reset by run(), the node is started when it reaches 0
+				std::atomic<uint32_t> remaining_dependencies{0};
+
+				void execute();
+			};
+
+			struct FunctionTask : enki::ITaskSet, node_state
+			{
+				void ExecuteRange(enki::TaskSetPartition range, uint32_t threadnum) override;
+			};
+
+			struct PinnedFunctionTask : enki::IPinnedTask, node_state
+			{
+				void Execute() override;
+			};
+
+			//Added for the main thread by the last completed node, it wakes up run()
+			struct FrameEndTask : enki::IPinnedTask
+			{
+				bool* frame_completed = nullptr;
+				void Execute() override;
+			};
+
+			//Only one of the tasks is used
+			//I need to use pointers because the tasks cannot be copied
+			struct graph_node
+			{
+				FunctionTask* task = nullptr;
+				PinnedFunctionTask* pinned_task = nullptr;
+				uint32_t dependency_count = 0;
+				std::vector<node_id> successors;
+			};
+
+			std::vector<graph_node> nodes_;
+			enki::TaskScheduler* task_scheduler_ = nullptr;
+			//Nodes not completed in the current run
+			std::atomic<uint32_t> remaining_nodes_{0};
+			FrameEndTask frame_end_task_;
+			//Written and read only by the main thread
+			bool frame_completed_ = false;
+
+			node_state* get_state(node_id id) const;
+			//Called from the thread that completed the last dependency
+			void start_node(node_id id);
+			void complete_node(node_id id);
+		public:
+			FrameTaskGraph();
+			~FrameTaskGraph();
+			FrameTaskGraph(const FrameTaskGraph&) = delete;
+			FrameTaskGraph& operator=(const FrameTaskGraph&) = delete;
+
+			//The dependencies must already be in the graph
+			//The name must be a string literal, it's used as cpu profiler zone
+			node_id add_node(const char* name, const std::function<void()>& function, bool main_thread,
+			                 const std::vector<node_id>& dependencies = std::vector<node_id>());
+
+			//Execute all the nodes once, must be called from the main thread
+			//The main thread runs its nodes as soon as they are ready and sleeps in between
+			void run(enki::TaskScheduler* task_scheduler);
+		};
+	}
+}
@@ -47,6 +47,11 @@ void ScrapEngine::Physics::CollisionBody::update_trasform(const Core::STransform
 	body_->setTransform(ConversionUtils::convert_transform(trasform));
 }
 
+void ScrapEngine::Physics::CollisionBody::set_is_active(const bool active) const
+{
+	body_->setIsActive(active);
+}
+
 bool ScrapEngine::Physics::CollisionBody::test_collision(rp3d::CollisionBody* other_body) const
 {
 	return world_ref_->testOverlap(body_, other_body);
@@ -31,6 +31,8 @@ namespace ScrapEngine
 
 			rp3d::CollisionBody* get_collision_body() const;
 			void update_trasform(const Core::STransform& trasform) const;
+			//An inactive body stays in the world but is skipped by the collision detection
+			void set_is_active(bool active) const;
 
 			bool test_collision(rp3d::CollisionBody* other_body) const;
 			bool test_collision(CollisionBody* other_body) const;
@@ -1,33 +1,45 @@
 #include <Engine/Rendering/Base/Vertex.h>
 
-vk::VertexInputBindingDescription ScrapEngine::Render::Vertex::get_binding_description()
+std::array<vk::VertexInputBindingDescription, 2> ScrapEngine::Render::Vertex::get_binding_descriptions()
 {
-	return vk::VertexInputBindingDescription(0, sizeof(Vertex), vk::VertexInputRate::eVertex);
+	const std::array<vk::VertexInputBindingDescription, 2> binding_descriptions = {
+		vk::VertexInputBindingDescription(position_binding, sizeof(OffscreenVertex), vk::VertexInputRate::eVertex),
+		vk::VertexInputBindingDescription(attributes_binding, sizeof(VertexAttributes), vk::VertexInputRate::eVertex)
+	};
+
+	return binding_descriptions;
 }
 
 std::array<vk::VertexInputAttributeDescription, 4> ScrapEngine::Render::Vertex::get_attribute_descriptions()
 {
 	const std::array<vk::VertexInputAttributeDescription, 4> attribute_descriptions = {
-		vk::VertexInputAttributeDescription(0, 0, vk::Format::eR32G32B32Sfloat, offsetof(Vertex, pos)),
-		vk::VertexInputAttributeDescription(1, 0, vk::Format::eR32G32B32Sfloat, offsetof(Vertex, color)),
-		vk::VertexInputAttributeDescription(2, 0, vk::Format::eR32G32Sfloat, offsetof(Vertex, tex_coord)),
-		vk::VertexInputAttributeDescription(3, 0, vk::Format::eR32G32B32Sfloat, offsetof(Vertex, normal)),
+		vk::VertexInputAttributeDescription(0, position_binding, vk::Format::eR32G32B32Sfloat,
+		                                    offsetof(OffscreenVertex, pos)),
+		vk::VertexInputAttributeDescription(1, attributes_binding, vk::Format::eR32G32B32Sfloat,
+		                                    offsetof(VertexAttributes, color)),
+		vk::VertexInputAttributeDescription(2, attributes_binding, vk::Format::eR32G32Sfloat,
+		                                    offsetof(VertexAttributes, tex_coord)),
+		vk::VertexInputAttributeDescription(3, attributes_binding, vk::Format::eR32G32B32Sfloat,
+		                                    offsetof(VertexAttributes, normal)),
 	};
 
 	return attribute_descriptions;
 }
 
-vk::VertexInputBindingDescription ScrapEngine::Render::SkyboxVertex::get_binding_description()
+std::array<vk::VertexInputBindingDescription, 2> ScrapEngine::Render::SkyboxVertex::get_binding_descriptions()
 {
-	return vk::VertexInputBindingDescription(0, sizeof(SkyboxVertex), vk::VertexInputRate::eVertex);
+	return Vertex::get_binding_descriptions();
 }
 
 std::array<vk::VertexInputAttributeDescription, 3> ScrapEngine::Render::SkyboxVertex::get_attribute_descriptions()
 {
 	const std::array<vk::VertexInputAttributeDescription, 3> attribute_descriptions = {
-		vk::VertexInputAttributeDescription(0, 0, vk::Format::eR32G32B32Sfloat, offsetof(SkyboxVertex, pos)),
-		vk::VertexInputAttributeDescription(1, 0, vk::Format::eR32G32B32Sfloat, offsetof(SkyboxVertex, color)),
-		vk::VertexInputAttributeDescription(2, 0, vk::Format::eR32G32Sfloat, offsetof(SkyboxVertex, tex_coord))
+		vk::VertexInputAttributeDescription(0, Vertex::position_binding, vk::Format::eR32G32B32Sfloat,
+		                                    offsetof(OffscreenVertex, pos)),
+		vk::VertexInputAttributeDescription(1, Vertex::attributes_binding, vk::Format::eR32G32B32Sfloat,
+		                                    offsetof(VertexAttributes, color)),
+		vk::VertexInputAttributeDescription(2, Vertex::attributes_binding, vk::Format::eR32G32Sfloat,
+		                                    offsetof(VertexAttributes, tex_coord))
 	};
 
 	return attribute_descriptions;
@@ -35,13 +47,15 @@ std::array<vk::VertexInputAttributeDescription, 3> ScrapEngine::Render::SkyboxVe
 
 vk::VertexInputBindingDescription ScrapEngine::Render::OffscreenVertex::get_binding_description()
 {
-	return vk::VertexInputBindingDescription(0, sizeof(OffscreenVertex), vk::VertexInputRate::eVertex);
+	return vk::VertexInputBindingDescription(Vertex::position_binding, sizeof(OffscreenVertex),
+	                                         vk::VertexInputRate::eVertex);
 }
 
 std::array<vk::VertexInputAttributeDescription, 1> ScrapEngine::Render::OffscreenVertex::get_attribute_descriptions()
 {
 	const std::array<vk::VertexInputAttributeDescription, 1> attribute_descriptions = {
-		vk::VertexInputAttributeDescription(0, 0, vk::Format::eR32G32B32Sfloat, offsetof(OffscreenVertex, pos))
+		vk::VertexInputAttributeDescription(0, Vertex::position_binding, vk::Format::eR32G32B32Sfloat,
+		                                    offsetof(OffscreenVertex, pos))
 	};
 
 	return attribute_descriptions;
@@ -12,6 +12,9 @@ namespace ScrapEngine
 {
 	namespace Render
 	{
+		//The vertices are uploaded in two streams:
+		//binding 0 with only the positions (OffscreenVertex) and binding 1 with the other attributes (VertexAttributes)
+		//So the passes that need only the position fetch 12 bytes for each vertex
 		class Vertex
 		{
 		public:
@@ -20,33 +23,37 @@ namespace ScrapEngine
 			glm::vec2 tex_coord;
 			glm::vec3 normal;
 
-			static vk::VertexInputBindingDescription get_binding_description();
+			static const uint32_t position_binding = 0;
+			static const uint32_t attributes_binding = 1;
+
+			static std::array<vk::VertexInputBindingDescription, 2> get_binding_descriptions();
 
 			static std::array<vk::VertexInputAttributeDescription, 4> get_attribute_descriptions();
 		};
 
-		class SkyboxVertex
+		//Layout of the attributes stream
+		class VertexAttributes
 		{
 		public:
-			//The SkyboxVertex must have the same sizeof() of standard Vertex to not break the bindings
-			glm::vec3 pos;
 			glm::vec3 color;
 			glm::vec2 tex_coord;
 			glm::vec3 normal;
+		};
 
-			static vk::VertexInputBindingDescription get_binding_description();
+		class SkyboxVertex
+		{
+		public:
+			//The skybox uses the same streams of the standard Vertex, without the normal
+			static std::array<vk::VertexInputBindingDescription, 2> get_binding_descriptions();
 
 			static std::array<vk::VertexInputAttributeDescription, 3> get_attribute_descriptions();
 		};
 
+		//Layout of the position stream, bound alone by the shadow pass
 		class OffscreenVertex
 		{
 		public:
-			//The OffscreenVertex must have the same sizeof() of standard Vertex to not break the bindings
 			glm::vec3 pos;
-			glm::vec3 color;
-			glm::vec2 tex_coord;
-			glm::vec3 normal;
 
 			static vk::VertexInputBindingDescription get_binding_description();
 
@@ -1,11 +1,17 @@
 #include <Engine/Rendering/Buffer/BufferContainer/VertexBufferContainer/VertexBufferContainer.h>
 
-ScrapEngine::Render::VertexBufferContainer::VertexBufferContainer(vk::Buffer* input_buffer,
+ScrapEngine::Render::VertexBufferContainer::VertexBufferContainer(vk::Buffer* input_position_buffer,
+                                                                  vk::Buffer* input_attribute_buffer,
                                                                   const std::vector<Vertex>* input_vertices)
-	: BufferContainer(input_buffer), vertices_(input_vertices)
+	: BufferContainer(input_position_buffer), attribute_buffer_(input_attribute_buffer), vertices_(input_vertices)
 {
 }
 
+vk::Buffer* ScrapEngine::Render::VertexBufferContainer::get_attribute_buffer() const
+{
+	return attribute_buffer_;
+}
+
 const std::vector<ScrapEngine::Render::Vertex>* ScrapEngine::Render::VertexBufferContainer::get_vector() const
 {
 	return vertices_;
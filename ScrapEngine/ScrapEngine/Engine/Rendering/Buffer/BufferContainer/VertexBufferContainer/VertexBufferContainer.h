@@ -7,14 +7,18 @@ namespace ScrapEngine
 {
 	namespace Render
 	{
+		//The container buffer is the position stream, bound alone by the shadow pass
 		class VertexBufferContainer : public BufferContainer
 		{
 		private:
+			vk::Buffer* attribute_buffer_;
 			const std::vector<Vertex>* vertices_;
 		public:
-			VertexBufferContainer(vk::Buffer* input_buffer, const std::vector<Vertex>* input_vertices);
+			VertexBufferContainer(vk::Buffer* input_position_buffer, vk::Buffer* input_attribute_buffer,
+			                      const std::vector<Vertex>* input_vertices);
 			~VertexBufferContainer() = default;
 
+			vk::Buffer* get_attribute_buffer() const;
 			const std::vector<Vertex>* get_vector() const;
 		};
 	}
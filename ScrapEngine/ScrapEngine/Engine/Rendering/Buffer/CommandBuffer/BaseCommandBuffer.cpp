@@ -24,6 +24,12 @@ void ScrapEngine::Render::BaseCommandBuffer::begin_command_buffer(const vk::Comm
 	}
 }
 
+void ScrapEngine::Render::BaseCommandBuffer::begin_secondary_command_buffer(const vk::RenderPass render_pass,
+                                                                           const uint32_t subpass)
+{
+	begin_secondary_command_buffers(command_buffers_, render_pass, subpass);
+}
+
 void ScrapEngine::Render::BaseCommandBuffer::close_command_buffer()
 {
 	for (auto& command_buffer : command_buffers_)
@@ -64,3 +70,32 @@ const std::vector<vk::CommandBuffer>* ScrapEngine::Render::BaseCommandBuffer::ge
 {
 	return &command_buffers_;
 }
+
+void ScrapEngine::Render::BaseCommandBuffer::begin_secondary_command_buffers(
+	std::vector<vk::CommandBuffer>& command_buffers, const vk::RenderPass render_pass, const uint32_t subpass)
+{
+	//The command buffers are indexed by frame in flight, the swap chain image is known only at submit time
+	const vk::CommandBufferInheritanceInfo inheritance_info(
+		render_pass,
+		subpass,
+		vk::Framebuffer()
+	);
+
+	for (auto& command_buffer : command_buffers)
+	{
+
+		//Secondary command buffers can be executed by more frames at the same time
+		const vk::CommandBufferBeginInfo begin_info(
+			vk::CommandBufferUsageFlagBits::eRenderPassContinue | vk::CommandBufferUsageFlagBits::eSimultaneousUse,
+			&inheritance_info
+		);
+
+		const vk::Result result = command_buffer.begin(&begin_info);
+
+		if (result != vk::Result::eSuccess)
+		{
+			Debug::DebugLog::fatal_error(result,
+			                             "[VulkanCommandBuffer] Failed to begin recording secondary command buffer!");
+		}
+	}
+}
@@ -23,6 +23,10 @@ namespace ScrapEngine
 			void begin_command_buffer(vk::CommandBufferUsageFlagBits flag =
 				vk::CommandBufferUsageFlagBits::eSimultaneousUse);
 
+			//Begin the command buffers as secondary command buffers executed inside the given subpass
+			//The framebuffer is not specified, so they can be executed with any swap chain image
+			void begin_secondary_command_buffer(vk::RenderPass render_pass, uint32_t subpass);
+
 			void close_command_buffer();
 
 			void end_command_buffer_render_pass();
@@ -32,6 +36,9 @@ namespace ScrapEngine
 			void free_command_buffers();
 
 			const std::vector<vk::CommandBuffer>* get_command_buffers_vector() const;
+		protected:
+			static void begin_secondary_command_buffers(std::vector<vk::CommandBuffer>& command_buffers,
+			                                            vk::RenderPass render_pass, uint32_t subpass);
 		};
 	}
 }
@@ -0,0 +1,165 @@
+#include <Engine/Rendering/Buffer/CommandBuffer/FrameCommandBuffer/FrameCommandBuffer.h>
+#include <Engine/Rendering/Device/VulkanDevice.h>
+#include <Engine/Debug/DebugLog.h>
+#include <Engine/Rendering/RenderPass/StandardRenderPass/StandardRenderPass.h>
+#include <Engine/Rendering/RenderPass/GuiRenderPass/GuiRenderPass.h>
+#include <Engine/Rendering/RenderPass/ShadowmappingRenderPass/ShadowmappingRenderPass.h>
+#include <Engine/Rendering/Shadowmapping/Standard/StandardShadowmapping.h>
+#include <Engine/Rendering/Buffer/FrameBuffer/ShadowmappingFrameBuffer/ShadowmappingFrameBuffer.h>
+#include <Engine/Rendering/CommandPool/VulkanCommandPool.h>
+#include <Engine/Rendering/TemporalUpscaling/TemporalUpscaler.h>
+#include <array>
+
+ScrapEngine::Render::FrameCommandBuffer::FrameCommandBuffer(VulkanCommandPool* command_pool, const uint16_t cb_size)
+{
+	command_pool_ref_ = command_pool;
+
+	command_buffers_.resize(cb_size);
+
+	vk::CommandBufferAllocateInfo alloc_info(
+		*command_pool_ref_,
+		vk::CommandBufferLevel::ePrimary,
+		static_cast<uint32_t>(command_buffers_.size())
+	);
+
+	const vk::Result result = VulkanDevice::get_instance()->get_logical_device()->allocateCommandBuffers(
+		&alloc_info, command_buffers_.data());
+
+	if (result != vk::Result::eSuccess)
+	{
+		Debug::DebugLog::fatal_error(result, "[FrameCommandBuffer] Failed to allocate command buffers!");
+	}
+}
+
+vk::CommandBuffer ScrapEngine::Render::FrameCommandBuffer::begin_frame(const uint32_t frame_index)
+{
+	vk::CommandBuffer& command_buffer = command_buffers_[frame_index];
+
+	command_buffer.reset(vk::CommandBufferResetFlags());
+
+	vk::CommandBufferBeginInfo begin_info(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+
+	const vk::Result result = command_buffer.begin(&begin_info);
+
+	if (result != vk::Result::eSuccess)
+	{
+		Debug::DebugLog::fatal_error(result, "[FrameCommandBuffer] Failed to begin recording command buffer!");
+	}
+
+	return command_buffer;
+}
+
+void ScrapEngine::Render::FrameCommandBuffer::end_frame(const uint32_t frame_index)
+{
+	command_buffers_[frame_index].end();
+}
+
+void ScrapEngine::Render::FrameCommandBuffer::execute_shadow_pass(const uint32_t frame_index,
+                                                                  StandardShadowmapping* shadowmapping,
+                                                                  const vk::CommandBuffer shadow_command_buffer)
+{
+	std::array<vk::ClearValue, 1> clear_values = {
+		vk::ClearDepthStencilValue(1.0f, 0)
+	};
+
+	vk::RenderPassBeginInfo begin_info(
+		*shadowmapping->get_offscreen_render_pass()->get_render_pass(),
+		(*shadowmapping->get_offscreen_frame_buffer()->get_framebuffers_vector())[0],
+		vk::Rect2D(vk::Offset2D(), StandardShadowmapping::get_shadow_map_extent())
+	);
+
+	begin_info.clearValueCount = static_cast<uint32_t>(clear_values.size());
+	begin_info.pClearValues = clear_values.data();
+
+	command_buffers_[frame_index].beginRenderPass(&begin_info, vk::SubpassContents::eSecondaryCommandBuffers);
+	command_buffers_[frame_index].executeCommands(1, &shadow_command_buffer);
+	command_buffers_[frame_index].endRenderPass();
+}
+
+void ScrapEngine::Render::FrameCommandBuffer::execute_scene_pass(const uint32_t frame_index,
+                                                                 const vk::Framebuffer framebuffer,
+                                                                 const vk::Extent2D& render_extent,
+                                                                 const vk::CommandBuffer scene_command_buffer,
+                                                                 const vk::CommandBuffer gui_command_buffer)
+{
+	vk::CommandBuffer& command_buffer = command_buffers_[frame_index];
+
+	//The velocity is cleared only when the render pass has it, see StandardRenderPass::velocity_attachment
+	std::array<vk::ClearValue, 3> clear_values = {
+		vk::ClearColorValue(std::array<float, 4>{0.0f, 0.0f, 0.0f, 1.0f}),
+		vk::ClearDepthStencilValue(1.0f, 0),
+		vk::ClearColorValue(std::array<float, 4>{
+			StandardRenderPass::velocity_clear_value, StandardRenderPass::velocity_clear_value, 0.0f, 0.0f
+		})
+	};
+
+	render_pass_info_ = vk::RenderPassBeginInfo(
+		*StandardRenderPass::get_instance(),
+		framebuffer,
+		vk::Rect2D(vk::Offset2D(), render_extent)
+	);
+
+	render_pass_info_.clearValueCount = StandardRenderPass::get_instance()->has_velocity() ? 3 : 2;
+	render_pass_info_.pClearValues = clear_values.data();
+
+	//Scene subpass
+	command_buffer.beginRenderPass(&render_pass_info_, vk::SubpassContents::eSecondaryCommandBuffers);
+	command_buffer.executeCommands(1, &scene_command_buffer);
+
+	//Gui subpass
+	if (StandardRenderPass::get_instance()->has_gui_subpass())
+	{
+		command_buffer.nextSubpass(vk::SubpassContents::eSecondaryCommandBuffers);
+		command_buffer.executeCommands(1, &gui_command_buffer);
+	}
+
+	command_buffer.endRenderPass();
+}
+
+void ScrapEngine::Render::FrameCommandBuffer::execute_upscale(const uint32_t frame_index, const vk::Image src_image,
+                                                              const vk::Extent2D& src_extent,
+                                                              const vk::Image dst_image,
+                                                              const vk::Extent2D& dst_extent)
+{
+	const vk::ImageSubresourceLayers subresource(vk::ImageAspectFlagBits::eColor, 0, 0, 1);
+
+	vk::ImageBlit blit;
+	blit.setSrcSubresource(subresource);
+	blit.srcOffsets[1] = vk::Offset3D(static_cast<int32_t>(src_extent.width),
+	                                  static_cast<int32_t>(src_extent.height), 1);
+	blit.setDstSubresource(subresource);
+	blit.dstOffsets[1] = vk::Offset3D(static_cast<int32_t>(dst_extent.width),
+	                                  static_cast<int32_t>(dst_extent.height), 1);
+
+	//Linear filter, at full resolution it's a plain copy
+	command_buffers_[frame_index].blitImage(src_image, vk::ImageLayout::eTransferSrcOptimal,
+	                                        dst_image, vk::ImageLayout::eTransferDstOptimal,
+	                                        1, &blit, vk::Filter::eLinear);
+}
+
+void ScrapEngine::Render::FrameCommandBuffer::execute_temporal_resolve(const uint32_t frame_index,
+                                                                      TemporalUpscaler* temporal_upscaler,
+                                                                      const vk::Image dst_image,
+                                                                      const vk::Extent2D& render_extent)
+{
+	temporal_upscaler->record(command_buffers_[frame_index], dst_image, render_extent);
+}
+
+void ScrapEngine::Render::FrameCommandBuffer::execute_gui_pass(const uint32_t frame_index,
+                                                               const vk::Framebuffer framebuffer,
+                                                               const vk::Extent2D& extent,
+                                                               const vk::CommandBuffer gui_command_buffer)
+{
+	vk::CommandBuffer& command_buffer = command_buffers_[frame_index];
+
+	//The swap chain image is loaded, so no clear values
+	const vk::RenderPassBeginInfo begin_info(
+		*GuiRenderPass::get_instance(),
+		framebuffer,
+		vk::Rect2D(vk::Offset2D(), extent)
+	);
+
+	command_buffer.beginRenderPass(&begin_info, vk::SubpassContents::eSecondaryCommandBuffers);
+	command_buffer.executeCommands(1, &gui_command_buffer);
+	command_buffer.endRenderPass();
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Engine/Rendering/Buffer/CommandBuffer/BaseCommandBuffer.h>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		class StandardShadowmapping;
+		class TemporalUpscaler;
+
+		//Primary command buffers that execute the pre recorded secondary command buffers of every pass
+		//They are small, so they are recorded again every frame following the render graph
+		class FrameCommandBuffer : public BaseCommandBuffer
+		{
+		public:
+			//A command buffer is created for every frame in flight (cb_size)
+			//The command pool must be created with the eResetCommandBuffer flag
+			FrameCommandBuffer(VulkanCommandPool* command_pool, uint16_t cb_size);
+
+			~FrameCommandBuffer() = default;
+
+			//Reset and begin the command buffer of the frame
+			vk::CommandBuffer begin_frame(uint32_t frame_index);
+			void end_frame(uint32_t frame_index);
+
+			//Execute the shadow map secondary command buffer inside the offscreen render pass
+			void execute_shadow_pass(uint32_t frame_index, StandardShadowmapping* shadowmapping,
+			                         vk::CommandBuffer shadow_command_buffer);
+
+			//Execute the scene secondary command buffer inside the StandardRenderPass
+			//Only the render_extent part of the scene color is drawn, see DynamicResolution
+			//If the render pass has the gui subpass gui_command_buffer is executed in it, over the scene
+			void execute_scene_pass(uint32_t frame_index, vk::Framebuffer framebuffer,
+			                        const vk::Extent2D& render_extent, vk::CommandBuffer scene_command_buffer,
+			                        vk::CommandBuffer gui_command_buffer = vk::CommandBuffer());
+
+			//Scale the drawn part of the scene color to the whole swap chain image
+			//src_image must be in eTransferSrcOptimal and dst_image in eTransferDstOptimal
+			void execute_upscale(uint32_t frame_index, vk::Image src_image, const vk::Extent2D& src_extent,
+			                     vk::Image dst_image, const vk::Extent2D& dst_extent);
+
+			//Resolve the scene with the history of the TemporalUpscaler and copy it in dst_image
+			//dst_image must be in eTransferDstOptimal
+			void execute_temporal_resolve(uint32_t frame_index, TemporalUpscaler* temporal_upscaler,
+			                              vk::Image dst_image, const vk::Extent2D& render_extent);
+
+			//Execute the gui secondary command buffer inside the GuiRenderPass, at the swap chain resolution
+			void execute_gui_pass(uint32_t frame_index, vk::Framebuffer framebuffer, const vk::Extent2D& extent,
+			                      vk::CommandBuffer gui_command_buffer);
+		};
+	}
+}
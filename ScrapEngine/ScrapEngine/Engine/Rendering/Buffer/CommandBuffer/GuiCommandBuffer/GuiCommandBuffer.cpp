@@ -2,28 +2,29 @@
 #include <Engine/Rendering/Device/VulkanDevice.h>
 #include <imgui.h>
 #include <Engine/Debug/DebugLog.h>
-#include <Engine/Rendering/Buffer/FrameBuffer/BaseFrameBuffer.h>
 #include <Engine/Rendering/Gui/VulkanImGui.h>
 #include <Engine/Rendering/RenderPass/BaseRenderPass.h>
 #include <Engine/Rendering/CommandPool/VulkanCommandPool.h>
 #include <Engine/Rendering/Pipeline/GuiPipeline/GuiVulkanGraphicsPipeline.h>
 #include <Engine/Rendering/Buffer/GenericBuffer/GenericBuffer.h>
 #include <Engine/Rendering/Descriptor/DescriptorSet/GuiDescriptorSet/GuiDescriptorSet.h>
+#include <Engine/Rendering/Query/GpuPassProfiler.h>
 
-ScrapEngine::Render::GuiCommandBuffer::GuiCommandBuffer(BaseRenderPass* render_pass, VulkanCommandPool* command_pool)
-	: render_pass_ref_(render_pass)
+ScrapEngine::Render::GuiCommandBuffer::GuiCommandBuffer(BaseRenderPass* render_pass, const uint32_t subpass,
+                                                        VulkanCommandPool* command_pool, const uint16_t cb_size)
+	: render_pass_ref_(render_pass), subpass_(subpass)
 {
 	command_pool_ref_ = command_pool;
 
-	//Optimize the GuiCommandBuffer generating only 1 command buffer instead of 3
-	//This because the GuiCommandBuffer is rebuilt every frame
-	//So it has no sense to allocate and build 2 unused command buffers
-	command_buffers_.resize(1);
+	//One command buffer for each frame in flight
+	//This way the same recording can be executed again while the gui doesn't change
+	//They are secondary command buffers executed in the gui subpass of the StandardRenderPass or in the GuiRenderPass
+	command_buffers_.resize(cb_size);
 
 	vk::CommandBufferAllocateInfo alloc_info(
 		*command_pool_ref_,
-		vk::CommandBufferLevel::ePrimary,
-		static_cast<uint32_t>(1)
+		vk::CommandBufferLevel::eSecondary,
+		static_cast<uint32_t>(command_buffers_.size())
 	);
 
 	const vk::Result result = VulkanDevice::get_instance()->get_logical_device()->allocateCommandBuffers(
@@ -35,35 +36,23 @@ ScrapEngine::Render::GuiCommandBuffer::GuiCommandBuffer(BaseRenderPass* render_p
 	}
 }
 
-void ScrapEngine::Render::GuiCommandBuffer::init_command_buffer(
-	BaseFrameBuffer* swap_chain_frame_buffer,
-	const vk::Extent2D& input_swap_chain_extent_ref,
-	const uint32_t current_image)
+void ScrapEngine::Render::GuiCommandBuffer::init_command_buffer()
 {
-	const std::vector<vk::Framebuffer>* swap_chain_framebuffers = swap_chain_frame_buffer->
-		get_framebuffers_vector();
-
-	for (auto& command_buffer : command_buffers_)
+	begin_secondary_command_buffer(*render_pass_ref_, subpass_);
+	if (gpu_profiler_)
 	{
-		render_pass_info_ = vk::RenderPassBeginInfo(
-			*render_pass_ref_,
-			//So here i read the frame buffer corresponding to the next image frame
-			//It must be passed as parameter from the Render Manager
-			(*swap_chain_framebuffers)[current_image],
-			vk::Rect2D(vk::Offset2D(), input_swap_chain_extent_ref)
-		);
-
-		//Don't clear the frame
-		render_pass_info_.clearValueCount = 0;
-
-		command_buffer.beginRenderPass(&render_pass_info_, vk::SubpassContents::eInline);
+		for (size_t i = 0; i < command_buffers_.size(); i++)
+		{
+			gpu_profiler_->begin_zone(command_buffers_[i], static_cast<uint32_t>(i),
+			                          GpuPassProfiler::pass_zone::gui);
+		}
 	}
 }
 
-void ScrapEngine::Render::GuiCommandBuffer::load_ui(VulkanImGui* gui)
+void ScrapEngine::Render::GuiCommandBuffer::load_ui(VulkanImGui* gui, const uint32_t buffers_index)
 {
 	//Update buffers
-	gui->update_buffers();
+	gui->update_buffers(buffers_index);
 
 	ImGuiIO& io = ImGui::GetIO();
 
@@ -123,5 +112,15 @@ void ScrapEngine::Render::GuiCommandBuffer::load_ui(VulkanImGui* gui)
 				vertex_offset += cmd_list->VtxBuffer.Size;
 			}
 		}
+
+		if (gpu_profiler_)
+		{
+			gpu_profiler_->end_zone(command_buffers_[i], static_cast<uint32_t>(i), GpuPassProfiler::pass_zone::gui);
+		}
 	}
 }
+
+void ScrapEngine::Render::GuiCommandBuffer::set_gpu_profiler(GpuPassProfiler* gpu_profiler)
+{
+	gpu_profiler_ = gpu_profiler;
+}
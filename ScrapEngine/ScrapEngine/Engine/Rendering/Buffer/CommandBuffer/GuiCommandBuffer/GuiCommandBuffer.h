@@ -7,23 +7,32 @@ namespace ScrapEngine
 	namespace Render
 	{
 		class VulkanImGui;
-		class BaseFrameBuffer;
 		class BaseRenderPass;
+		class GpuPassProfiler;
 
 		class GuiCommandBuffer : public BaseCommandBuffer
 		{
 		private:
 			BaseRenderPass* render_pass_ref_ = nullptr;
+			uint32_t subpass_ = 0;
+			//If not nullptr the gui is bracketed by a profiler zone
+			GpuPassProfiler* gpu_profiler_ = nullptr;
 		public:
-			explicit GuiCommandBuffer(BaseRenderPass* render_pass, VulkanCommandPool* command_pool);
+			//A command buffer is created for every frame in flight (cb_size)
+			//The gui is drawn in the given subpass, see VulkanImGui::init_resources()
+			GuiCommandBuffer(BaseRenderPass* render_pass, uint32_t subpass, VulkanCommandPool* command_pool,
+			                 uint16_t cb_size);
 
 			~GuiCommandBuffer() = default;
 
-			void init_command_buffer(BaseFrameBuffer* swap_chain_frame_buffer,
-			                         const vk::Extent2D& input_swap_chain_extent_ref,
-			                         uint32_t current_image);
+			//Begin the secondary command buffers inside the gui subpass
+			void init_command_buffer();
 
-			void load_ui(VulkanImGui* gui);
+			//buffers_index select which gui buffers will be written and used
+			void load_ui(VulkanImGui* gui, uint32_t buffers_index);
+
+			//Used by the next recording
+			void set_gpu_profiler(GpuPassProfiler* gpu_profiler);
 		};
 	}
 }
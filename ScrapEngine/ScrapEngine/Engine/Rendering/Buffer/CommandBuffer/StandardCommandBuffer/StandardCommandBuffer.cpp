@@ -15,6 +15,13 @@
 #include <Engine/Rendering/Buffer/BufferContainer//VertexBufferContainer/VertexBufferContainer.h>
 #include <Engine/Rendering/Camera/Camera.h>
 #include <Engine/Rendering/Model/Material/BasicMaterial.h>
+#include <Engine/Rendering/Model/Material/StaticBatchMaterial/StaticBatchMaterial.h>
+#include <Engine/Rendering/Model/StaticBatch/StaticBatcher.h>
+#include <Engine/Rendering/Buffer/VertexBuffer/VertexBuffer.h>
+#include <Engine/Rendering/Buffer/IndexBuffer/IndexBuffer.h>
+#include <Engine/Rendering/Query/GpuPassProfiler.h>
+#include <glm/geometric.hpp>
+#include <algorithm>
 
 void ScrapEngine::Render::StandardCommandBuffer::pre_shadow_mesh_commands(StandardShadowmapping* shadowmapping)
 {
@@ -51,11 +58,12 @@ ScrapEngine::Render::StandardCommandBuffer::StandardCommandBuffer(VulkanCommandP
 {
 	command_pool_ref_ = command_pool;
 
+	//Shadow map secondary command buffers
 	command_buffers_.resize(cb_size);
 
 	vk::CommandBufferAllocateInfo alloc_info(
 		*command_pool_ref_,
-		vk::CommandBufferLevel::ePrimary,
+		vk::CommandBufferLevel::eSecondary,
 		static_cast<uint32_t>(command_buffers_.size())
 	);
 
@@ -66,33 +74,62 @@ ScrapEngine::Render::StandardCommandBuffer::StandardCommandBuffer(VulkanCommandP
 	{
 		Debug::DebugLog::fatal_error(result, "[VulkanCommandBuffer] Failed to allocate command buffers!");
 	}
-}
 
-void ScrapEngine::Render::StandardCommandBuffer::init_shadow_map(StandardShadowmapping* shadowmapping)
-{
-	std::array<vk::ClearValue, 1> clear_values = {
-		vk::ClearDepthStencilValue(1.0f, 0)
-	};
-	const std::vector<vk::Framebuffer>* offscreen_framebuffers = shadowmapping
-	                                                             ->get_offscreen_frame_buffer()->
-	                                                             get_framebuffers_vector();
-	const vk::Extent2D shadow_map_extent = StandardShadowmapping::get_shadow_map_extent();
-	const vk::Rect2D rect = vk::Rect2D(vk::Offset2D(), shadow_map_extent);
+	//Scene secondary command buffers
+	scene_command_buffers_.resize(cb_size);
 
-	for (auto& command_buffer : command_buffers_)
+	const vk::CommandBufferAllocateInfo scene_alloc_info(
+		*command_pool_ref_,
+		vk::CommandBufferLevel::eSecondary,
+		static_cast<uint32_t>(scene_command_buffers_.size())
+	);
+
+	const vk::Result scene_result = VulkanDevice::get_instance()->get_logical_device()->allocateCommandBuffers(
+		&scene_alloc_info, scene_command_buffers_.data());
+
+	if (scene_result != vk::Result::eSuccess)
 	{
-		//Begin
+		Debug::DebugLog::fatal_error(scene_result, "[VulkanCommandBuffer] Failed to allocate scene command buffers!");
+	}
+}
 
-		vk::RenderPassBeginInfo begin_info(
-			*shadowmapping->get_offscreen_render_pass()->get_render_pass(),
-			(*offscreen_framebuffers)[0],
-			rect
-		);
+ScrapEngine::Render::StandardCommandBuffer::~StandardCommandBuffer()
+{
+	if (!scene_command_buffers_.empty())
+	{
+		VulkanDevice::get_instance()->get_logical_device()->freeCommandBuffers(
+			*command_pool_ref_,
+			static_cast<uint32_t>(scene_command_buffers_.size()),
+			scene_command_buffers_.data());
+		scene_command_buffers_.clear();
+	}
+}
 
-		begin_info.clearValueCount = static_cast<uint32_t>(clear_values.size());
-		begin_info.pClearValues = clear_values.data();
+void ScrapEngine::Render::StandardCommandBuffer::init_shadow_map(StandardShadowmapping* shadowmapping)
+{
+	//The offscreen render pass is started by the frame command buffer
+	begin_secondary_command_buffers(command_buffers_,
+	                                *shadowmapping->get_offscreen_render_pass()->get_render_pass(),
+	                                0);
+	if (gpu_profiler_)
+	{
+		for (size_t i = 0; i < command_buffers_.size(); i++)
+		{
+			gpu_profiler_->begin_zone(command_buffers_[i], static_cast<uint32_t>(i),
+			                          GpuPassProfiler::pass_zone::shadow_map);
+		}
+	}
+}
 
-		command_buffer.beginRenderPass(&begin_info, vk::SubpassContents::eInline);
+void ScrapEngine::Render::StandardCommandBuffer::close_shadow_map()
+{
+	if (gpu_profiler_)
+	{
+		for (size_t i = 0; i < command_buffers_.size(); i++)
+		{
+			gpu_profiler_->end_zone(command_buffers_[i], static_cast<uint32_t>(i),
+			                        GpuPassProfiler::pass_zone::shadow_map);
+		}
 	}
 }
 
@@ -105,6 +142,11 @@ void ScrapEngine::Render::StandardCommandBuffer::load_mesh_shadow_map(StandardSh
 		//Do NOT increase the deletion counter in the shadow map loading
 		return;
 	}
+	//Drawn by its static batch
+	if (mesh->get_is_batched())
+	{
+		return;
+	}
 	//Check if the mesh is visible
 	if (!mesh->get_is_visible())
 	{
@@ -122,13 +164,14 @@ void ScrapEngine::Render::StandardCommandBuffer::load_mesh_shadow_map(StandardSh
 	}
 	//Add the drawcall for the mesh in the depth pass (shadow rendering)
 	const vk::DeviceSize offsets[] = {0};
-	auto buffers_vector = (*mesh->get_mesh_buffers());
+	//Read in place, the vectors are shared by the instances of the model
+	const auto& buffers_vector = *mesh->get_mesh_buffers();
 
 	pre_shadow_mesh_commands(shadowmapping);
 
 	for (size_t i = 0; i < command_buffers_.size(); i++)
 	{
-		for (const auto mesh_buffer : buffers_vector)
+		for (const auto& mesh_buffer : buffers_vector)
 		{
 			command_buffers_[i].bindPipeline(vk::PipelineBindPoint::eGraphics,
 			                                 *shadowmapping->get_offscreen_pipeline()->get_graphics_pipeline()
@@ -144,6 +187,7 @@ void ScrapEngine::Render::StandardCommandBuffer::load_mesh_shadow_map(StandardSh
 			                                       nullptr
 			);
 
+			//Only the position stream
 			vk::Buffer vertex_buffers[] = {*(mesh_buffer.first)};
 
 			command_buffers_[i].bindVertexBuffers(0, 1, vertex_buffers, offsets);
@@ -156,29 +200,84 @@ void ScrapEngine::Render::StandardCommandBuffer::load_mesh_shadow_map(StandardSh
 	}
 }
 
-void ScrapEngine::Render::StandardCommandBuffer::init_command_buffer(
-	const vk::Extent2D& input_swap_chain_extent_ref, BaseFrameBuffer* swap_chain_frame_buffer)
+void ScrapEngine::Render::StandardCommandBuffer::load_static_batches_shadow_map(
+	StandardShadowmapping* shadowmapping, const StaticBatcher* static_batcher)
 {
-	const std::vector<vk::Framebuffer>* swap_chain_framebuffers = swap_chain_frame_buffer->
-		get_framebuffers_vector();
-
-	std::array<vk::ClearValue, 2> clear_values = {
-		vk::ClearColorValue(std::array<float, 4>{0.0f, 0.0f, 0.0f, 1.0f}),
-		vk::ClearDepthStencilValue(1.0f, 0)
-	};
+	const vk::DeviceSize offsets[] = {0};
+	bool has_commands = false;
 
-	for (size_t i = 0; i < command_buffers_.size(); i++)
+	for (const StaticBatcher::cluster& cluster : *static_batcher->get_clusters())
 	{
-		render_pass_info_ = vk::RenderPassBeginInfo(
-			*StandardRenderPass::get_instance(),
-			(*swap_chain_framebuffers)[i],
-			vk::Rect2D(vk::Offset2D(), input_swap_chain_extent_ref)
-		);
+		if (!cluster.enabled || (cluster.frustum_check && !cluster.sun_shadow_is_in_current_frustum))
+		{
+			continue;
+		}
+		for (const StaticBatcher::batch& batch : cluster.batches)
+		{
+			if (!batch.cast_shadows)
+			{
+				continue;
+			}
+			if (!has_commands)
+			{
+				pre_shadow_mesh_commands(shadowmapping);
+				has_commands = true;
+			}
+			for (size_t i = 0; i < command_buffers_.size(); i++)
+			{
+				command_buffers_[i].bindPipeline(vk::PipelineBindPoint::eGraphics,
+				                                 *shadowmapping->get_offscreen_pipeline()->get_graphics_pipeline());
+
+				command_buffers_[i].bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+				                                       *shadowmapping->get_offscreen_pipeline()->get_pipeline_layout(),
+				                                       0,
+				                                       1,
+				                                       &(*static_batcher->get_shadowmapping_descriptor_set()->
+				                                                         get_descriptor_sets())[i],
+				                                       0,
+				                                       nullptr
+				);
+
+				//Only the position stream
+				vk::Buffer vertex_buffers[] = {*batch.vertex_buffer->get_position_buffer()};
+
+				command_buffers_[i].bindVertexBuffers(0, 1, vertex_buffers, offsets);
 
-		render_pass_info_.clearValueCount = static_cast<uint32_t>(clear_values.size());
-		render_pass_info_.pClearValues = clear_values.data();
+				command_buffers_[i].bindIndexBuffer(*batch.index_buffer->get_index_buffer(), 0,
+				                                    vk::IndexType::eUint32);
 
-		command_buffers_[i].beginRenderPass(&render_pass_info_, vk::SubpassContents::eInline);
+				command_buffers_[i].drawIndexed(batch.index_count, 1, 0, 0, 0);
+			}
+		}
+	}
+}
+
+void ScrapEngine::Render::StandardCommandBuffer::init_command_buffer(const vk::Extent2D& render_extent)
+{
+	render_queue_.clear();
+	render_extent_ = render_extent;
+	//The render pass is started by the frame command buffer, here the scene subpass is only continued
+	begin_secondary_command_buffers(scene_command_buffers_,
+	                                *StandardRenderPass::get_instance(),
+	                                StandardRenderPass::scene_subpass);
+
+	//The secondary command buffers don't inherit the dynamic state
+	vk::Viewport viewport;
+	viewport.setWidth(static_cast<float>(render_extent.width));
+	viewport.setHeight(static_cast<float>(render_extent.height));
+	viewport.setMinDepth(0.0f);
+	viewport.setMaxDepth(1.0f);
+	const vk::Rect2D scissor(vk::Offset2D(), render_extent);
+
+	for (size_t i = 0; i < scene_command_buffers_.size(); i++)
+	{
+		scene_command_buffers_[i].setViewport(0, 1, &viewport);
+		scene_command_buffers_[i].setScissor(0, 1, &scissor);
+		if (gpu_profiler_)
+		{
+			gpu_profiler_->begin_zone(scene_command_buffers_[i], static_cast<uint32_t>(i),
+			                          GpuPassProfiler::pass_zone::scene);
+		}
 	}
 }
 
@@ -189,30 +288,40 @@ void ScrapEngine::Render::StandardCommandBuffer::init_current_camera(Camera* cur
 
 void ScrapEngine::Render::StandardCommandBuffer::load_skybox(VulkanSkyboxInstance* skybox_ref)
 {
-	vk::DeviceSize offsets[] = {0};
-	for (size_t i = 0; i < command_buffers_.size(); i++)
+	vk::DeviceSize offsets[] = {0, 0};
+	for (size_t i = 0; i < scene_command_buffers_.size(); i++)
 	{
-		command_buffers_[i].bindPipeline(vk::PipelineBindPoint::eGraphics,
-		                                 *skybox_ref->get_skybox_material()->
-		                                              get_vulkan_render_graphics_pipeline()->
-		                                              get_graphics_pipeline());
-		const std::pair<VertexBufferContainer*, IndicesBufferContainer*>*
-			skybox_pair = skybox_ref->get_mesh_buffers();
-		vk::Buffer buff[] = {*(skybox_pair->first)};
-		command_buffers_[i].bindVertexBuffers(0, 1, buff, offsets);
-		command_buffers_[i].bindIndexBuffer(*(skybox_pair->second), 0, vk::IndexType::eUint32);
-		command_buffers_[i].bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+		if (gpu_profiler_)
+		{
+			gpu_profiler_->begin_zone(scene_command_buffers_[i], static_cast<uint32_t>(i),
+			                          GpuPassProfiler::pass_zone::skybox);
+		}
+		scene_command_buffers_[i].bindPipeline(vk::PipelineBindPoint::eGraphics,
 		                                       *skybox_ref->get_skybox_material()->
 		                                                    get_vulkan_render_graphics_pipeline()->
-		                                                    get_pipeline_layout(),
-		                                       0, 1, &(*skybox_ref
-		                                                ->get_skybox_material()->
-		                                                get_vulkan_render_descriptor_set()->get_descriptor_sets())
-		                                       [i],
-		                                       0, nullptr);
-		command_buffers_[i].drawIndexed(static_cast<uint32_t>(skybox_pair->second->get_vector()->size()),
-		                                1,
-		                                0, 0, 0);
+		                                                    get_graphics_pipeline());
+		const std::pair<VertexBufferContainer*, IndicesBufferContainer*>*
+			skybox_pair = skybox_ref->get_mesh_buffers();
+		vk::Buffer buff[] = {*(skybox_pair->first), *skybox_pair->first->get_attribute_buffer()};
+		scene_command_buffers_[i].bindVertexBuffers(0, 2, buff, offsets);
+		scene_command_buffers_[i].bindIndexBuffer(*(skybox_pair->second), 0, vk::IndexType::eUint32);
+		scene_command_buffers_[i].bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+		                                             *skybox_ref->get_skybox_material()->
+		                                                          get_vulkan_render_graphics_pipeline()->
+		                                                          get_pipeline_layout(),
+		                                             0, 1, &(*skybox_ref
+		                                                      ->get_skybox_material()->
+		                                                      get_vulkan_render_descriptor_set()->get_descriptor_sets())
+		                                             [i],
+		                                             0, nullptr);
+		scene_command_buffers_[i].drawIndexed(static_cast<uint32_t>(skybox_pair->second->get_vector()->size()),
+		                                      1,
+		                                      0, 0, 0);
+		if (gpu_profiler_)
+		{
+			gpu_profiler_->end_zone(scene_command_buffers_[i], static_cast<uint32_t>(i),
+			                        GpuPassProfiler::pass_zone::skybox);
+		}
 	}
 }
 
@@ -224,6 +333,11 @@ void ScrapEngine::Render::StandardCommandBuffer::load_mesh(VulkanMeshInstance* m
 		mesh->increase_deletion_counter();
 		return;
 	}
+	//Drawn by its static batch
+	if (mesh->get_is_batched())
+	{
+		return;
+	}
 	//Check if the mesh is visible
 	if (!mesh->get_is_visible())
 	{
@@ -234,51 +348,120 @@ void ScrapEngine::Render::StandardCommandBuffer::load_mesh(VulkanMeshInstance* m
 	{
 		return;
 	}
-	//Add the drawcall for the mesh
-	const vk::DeviceSize offsets[] = {0};
-	auto buffers_vector = (*mesh->get_mesh_buffers());
-	auto materials_vector = (*mesh->get_mesh_materials());
+	//Add the drawcalls for the mesh to the render queue
+	//Normalized distance from the camera, used to draw front to back
+	const float depth = current_camera_->get_camera_location().distance(mesh->get_mesh_location()) /
+		current_camera_->get_camera_max_draw_distance();
+
+	//Read in place, the recording runs for every mesh at every rebuild
+	const auto& buffers_vector = *mesh->get_mesh_buffers();
+	const std::vector<BasicMaterial*>& materials_vector = *mesh->get_mesh_materials();
+
+	bool mesh_has_multi_material = false;
+	auto materials_iterator = materials_vector.begin();
+	if (materials_vector.size() > 1)
+	{
+		mesh_has_multi_material = true;
+	}
+	BasicMaterial* current_mat = *materials_iterator;
+	for (const auto& mesh_buffer : buffers_vector)
+	{
+		RenderQueue::draw_call draw;
+		draw.pipeline = *current_mat->get_vulkan_render_graphics_pipeline()->get_graphics_pipeline();
+		draw.pipeline_layout = *current_mat->get_vulkan_render_graphics_pipeline()->get_pipeline_layout();
+		draw.descriptor_sets = current_mat->get_vulkan_render_descriptor_set()->get_descriptor_sets();
+		draw.position_buffer = *(mesh_buffer.first);
+		draw.attribute_buffer = *mesh_buffer.first->get_attribute_buffer();
+		draw.index_buffer = *(mesh_buffer.second);
+		draw.index_count = static_cast<uint32_t>(mesh_buffer.second->get_vector()->size());
+
+		const std::shared_ptr<BaseVulkanGraphicsPipeline>& depth_pipeline = current_mat->
+			get_vulkan_depth_prepass_pipeline();
+		render_queue_.add_draw(draw, depth_pipeline ? *depth_pipeline->get_graphics_pipeline() : vk::Pipeline(),
+		                       depth);
+
+		if (mesh_has_multi_material)
+		{
+			++materials_iterator;
+			if (materials_iterator != materials_vector.end())
+			{
+				current_mat = *materials_iterator;
+			}
+		}
+	}
+}
 
-	for (size_t i = 0; i < command_buffers_.size(); i++)
+void ScrapEngine::Render::StandardCommandBuffer::load_static_batches(const StaticBatcher* static_batcher)
+{
+	for (const StaticBatcher::cluster& cluster : *static_batcher->get_clusters())
 	{
-		bool mesh_has_multi_material = false;
-		auto materials_iterator = materials_vector.begin();
-		if (mesh->get_mesh_materials()->size() > 1)
+		if (!cluster.enabled || (cluster.frustum_check && !cluster.is_in_current_frustum))
 		{
-			mesh_has_multi_material = true;
+			continue;
 		}
-		BasicMaterial* current_mat = *materials_iterator;
-		for (const auto mesh_buffer : buffers_vector)
+		//Distance of the nearest point of the cluster
+		const float distance = std::max(
+			glm::distance(current_camera_->get_camera_location().get_glm_vector(), cluster.center) - cluster.radius,
+			0.0f);
+		const float depth = distance / current_camera_->get_camera_max_draw_distance();
+
+		for (const StaticBatcher::batch& batch : cluster.batches)
 		{
-			command_buffers_[i].bindPipeline(vk::PipelineBindPoint::eGraphics,
-			                                 *current_mat
-			                                  ->get_vulkan_render_graphics_pipeline()->get_graphics_pipeline());
+			RenderQueue::draw_call draw;
+			draw.pipeline = *batch.material->get_vulkan_render_graphics_pipeline()->get_graphics_pipeline();
+			draw.pipeline_layout = *batch.material->get_vulkan_render_graphics_pipeline()->get_pipeline_layout();
+			draw.descriptor_sets = batch.material->get_vulkan_render_descriptor_set()->get_descriptor_sets();
+			draw.position_buffer = *batch.vertex_buffer->get_position_buffer();
+			draw.attribute_buffer = *batch.vertex_buffer->get_attribute_buffer();
+			draw.index_buffer = *batch.index_buffer->get_index_buffer();
+			draw.index_count = batch.index_count;
+
+			const std::shared_ptr<BaseVulkanGraphicsPipeline>& depth_pipeline = batch.material->
+				get_vulkan_depth_prepass_pipeline();
+			render_queue_.add_draw(draw, depth_pipeline ? *depth_pipeline->get_graphics_pipeline() : vk::Pipeline(),
+			                       depth);
+		}
+	}
+}
 
-			vk::Buffer vertex_buffers[] = {*(mesh_buffer.first)};
+void ScrapEngine::Render::StandardCommandBuffer::close_scene_command_buffer()
+{
+	render_queue_.sort();
+	for (size_t i = 0; i < scene_command_buffers_.size(); i++)
+	{
+		render_queue_.record(scene_command_buffers_[i], static_cast<uint32_t>(i));
+		if (gpu_profiler_)
+		{
+			gpu_profiler_->end_zone(scene_command_buffers_[i], static_cast<uint32_t>(i),
+			                        GpuPassProfiler::pass_zone::scene);
+		}
+		scene_command_buffers_[i].end();
+	}
+}
 
-			command_buffers_[i].bindVertexBuffers(0, 1, vertex_buffers, offsets);
+void ScrapEngine::Render::StandardCommandBuffer::set_depth_prepass_enabled(const bool enabled)
+{
+	render_queue_.set_depth_prepass_enabled(enabled);
+}
 
-			command_buffers_[i].bindIndexBuffer(*(mesh_buffer.second), 0, vk::IndexType::eUint32);
+void ScrapEngine::Render::StandardCommandBuffer::set_gpu_profiler(GpuPassProfiler* gpu_profiler)
+{
+	gpu_profiler_ = gpu_profiler;
+}
 
-			command_buffers_[i].bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-			                                       *current_mat
-			                                        ->get_vulkan_render_graphics_pipeline()->get_pipeline_layout(), 0,
-			                                       1,
-			                                       &(*current_mat
-			                                          ->get_vulkan_render_descriptor_set()->get_descriptor_sets())[i],
-			                                       0, nullptr);
+const ScrapEngine::Render::RenderQueue::queue_stats& ScrapEngine::Render::StandardCommandBuffer::
+get_render_queue_stats() const
+{
+	return render_queue_.get_stats();
+}
 
-			command_buffers_[i].drawIndexed(static_cast<uint32_t>((mesh_buffer.second->get_vector()->size())), 1, 0, 0,
-			                                0);
+const std::vector<vk::CommandBuffer>* ScrapEngine::Render::StandardCommandBuffer::
+get_scene_command_buffers_vector() const
+{
+	return &scene_command_buffers_;
+}
 
-			if (mesh_has_multi_material)
-			{
-				++materials_iterator;
-				if (materials_iterator != materials_vector.end())
-				{
-					current_mat = *materials_iterator;
-				}
-			}
-		}
-	}
+vk::Extent2D ScrapEngine::Render::StandardCommandBuffer::get_render_extent() const
+{
+	return render_extent_;
 }
@@ -1,38 +1,71 @@
 #pragma once
 
 #include <Engine/Rendering/Buffer/CommandBuffer/BaseCommandBuffer.h>
+#include <Engine/Rendering/RenderQueue/RenderQueue.h>
 
 namespace ScrapEngine
 {
 	namespace Render
 	{
 		class VulkanSkyboxInstance;
-		class BaseFrameBuffer;
 		class VulkanMeshInstance;
+		class StaticBatcher;
 		class StandardShadowmapping;
 		class Camera;
+		class GpuPassProfiler;
 
 		class StandardCommandBuffer : public BaseCommandBuffer
 		{
 		private:
 			Camera* current_camera_ = nullptr;
 
+			//command_buffers_ are secondary command buffers with the shadow map pass
+			//The scene is recorded in these secondary command buffers, executed inside the StandardRenderPass
+			std::vector<vk::CommandBuffer> scene_command_buffers_;
+
+			//The meshes are not recorded directly, they are sorted by state and depth and recorded at the end
+			RenderQueue render_queue_;
+
+			//Part of the scene color used by the scene command buffers, see DynamicResolution
+			vk::Extent2D render_extent_;
+
+			//If not nullptr the passes are bracketed by profiler zones
+			GpuPassProfiler* gpu_profiler_ = nullptr;
+
 			void pre_shadow_mesh_commands(StandardShadowmapping* shadowmapping);
 		public:
 			explicit StandardCommandBuffer(VulkanCommandPool* command_pool, int16_t cb_size);
 
-			~StandardCommandBuffer() = default;
+			~StandardCommandBuffer();
 
 			void init_shadow_map(StandardShadowmapping* shadowmapping);
 			void load_mesh_shadow_map(StandardShadowmapping* shadowmapping,
 			                          VulkanMeshInstance* mesh);
+			void load_static_batches_shadow_map(StandardShadowmapping* shadowmapping,
+			                                    const StaticBatcher* static_batcher);
+			//After the last shadow map draw, the command buffers are ended with close_command_buffer()
+			void close_shadow_map();
 
-			void init_command_buffer(const vk::Extent2D& input_swap_chain_extent_ref,
-			                         BaseFrameBuffer* swap_chain_frame_buffer);
+			//Begin the scene secondary command buffers, drawing in the render_extent part of the scene color
+			void init_command_buffer(const vk::Extent2D& render_extent);
 			void init_current_camera(Camera* current_camera);
 
 			void load_skybox(VulkanSkyboxInstance* skybox_ref);
 			void load_mesh(VulkanMeshInstance* mesh);
+			//Add the enabled clusters in view to the render queue, their meshes are skipped by load_mesh()
+			void load_static_batches(const StaticBatcher* static_batcher);
+
+			//Record the render queue and end the scene command buffers
+			void close_scene_command_buffer();
+
+			void set_depth_prepass_enabled(bool enabled);
+			//Used by the next recording
+			void set_gpu_profiler(GpuPassProfiler* gpu_profiler);
+			//Draw calls and binds of the last recording
+			const RenderQueue::queue_stats& get_render_queue_stats() const;
+
+			const std::vector<vk::CommandBuffer>* get_scene_command_buffers_vector() const;
+			vk::Extent2D get_render_extent() const;
 		};
 	}
 }
@@ -0,0 +1,36 @@
+#include <Engine/Rendering/Buffer/FrameBuffer/GuiFrameBuffer/GuiFrameBuffer.h>
+#include <Engine/Rendering/RenderPass/GuiRenderPass/GuiRenderPass.h>
+#include <Engine/Rendering/Device/VulkanDevice.h>
+#include <Engine/Debug/DebugLog.h>
+#include <Engine/Rendering/SwapChain/VulkanImageView.h>
+
+ScrapEngine::Render::GuiFrameBuffer::GuiFrameBuffer(VulkanImageView* input_image_view_ref,
+                                                    const vk::Extent2D* input_swap_chain_extent)
+{
+	const std::vector<vk::ImageView>* swap_chain_image_views = input_image_view_ref->
+		get_swap_chain_image_views_vector();
+
+	framebuffers_.resize(swap_chain_image_views->size());
+
+	for (size_t i = 0; i < swap_chain_image_views->size(); i++)
+	{
+		vk::FramebufferCreateInfo framebuffer_info(
+			vk::FramebufferCreateFlags(),
+			*GuiRenderPass::get_instance(),
+			1,
+			&(*swap_chain_image_views)[i],
+			input_swap_chain_extent->width,
+			input_swap_chain_extent->height,
+			1
+		);
+
+		const vk::Result result = VulkanDevice::get_instance()->get_logical_device()->createFramebuffer(
+			&framebuffer_info, nullptr,
+			&framebuffers_[i]);
+
+		if (result != vk::Result::eSuccess)
+		{
+			Debug::DebugLog::fatal_error(result, "GuiFrameBuffer: Failed to create framebuffer!");
+		}
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Engine/Rendering/Buffer/FrameBuffer/BaseFrameBuffer.h>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		class VulkanImageView;
+
+		//Framebuffers of the GuiRenderPass, one for every swap chain image
+		class GuiFrameBuffer : public BaseFrameBuffer
+		{
+		public:
+			GuiFrameBuffer(VulkanImageView* input_image_view_ref, const vk::Extent2D* input_swap_chain_extent);
+
+			~GuiFrameBuffer() = default;
+		};
+	}
+}
@@ -1,35 +1,40 @@
 #include <Engine/Rendering/Buffer/FrameBuffer/StandardFrameBuffer/StandardFrameBuffer.h>
-#include <array>
 #include <Engine/Rendering/RenderPass/StandardRenderPass/StandardRenderPass.h>
 #include <Engine/Rendering/Device/VulkanDevice.h>
 #include <Engine/Debug/DebugLog.h>
-#include <Engine/Rendering/SwapChain/VulkanImageView.h>
 
-ScrapEngine::Render::StandardFrameBuffer::StandardFrameBuffer(VulkanImageView* input_image_view_ref,
-                                                              const vk::Extent2D* input_swap_chain_extent,
+ScrapEngine::Render::StandardFrameBuffer::StandardFrameBuffer(const vk::Extent2D* input_extent,
+                                                              const std::vector<vk::ImageView>& output_image_views,
                                                               vk::ImageView* depth_image_view,
-                                                              vk::ImageView* color_image_view)
+                                                              vk::ImageView* color_image_view,
+                                                              vk::ImageView* velocity_image_view)
 {
-	const std::vector<vk::ImageView>* swap_chain_image_views = input_image_view_ref->
-		get_swap_chain_image_views_vector();
+	framebuffers_.resize(output_image_views.size());
 
-	framebuffers_.resize(swap_chain_image_views->size());
-
-	for (size_t i = 0; i < swap_chain_image_views->size(); i++)
+	for (size_t i = 0; i < output_image_views.size(); i++)
 	{
-		std::array<vk::ImageView, 3> attachments = {
-			*color_image_view,
-			*depth_image_view,
-			(*swap_chain_image_views)[i]
-		};
+		//Without msaa there is no color image, the output image is the color attachment
+		std::vector<vk::ImageView> attachments;
+		if (color_image_view)
+		{
+			attachments = {*color_image_view, *depth_image_view, output_image_views[i]};
+		}
+		else
+		{
+			attachments = {output_image_views[i], *depth_image_view};
+		}
+		if (StandardRenderPass::get_instance()->has_velocity())
+		{
+			attachments.push_back(*velocity_image_view);
+		}
 
 		vk::FramebufferCreateInfo framebuffer_info(
 			vk::FramebufferCreateFlags(),
 			*StandardRenderPass::get_instance(),
 			static_cast<uint32_t>(attachments.size()),
 			attachments.data(),
-			input_swap_chain_extent->width,
-			input_swap_chain_extent->height,
+			input_extent->width,
+			input_extent->height,
 			1
 		);
 
@@ -1,19 +1,22 @@
 #pragma once
 
 #include <Engine/Rendering/Buffer/FrameBuffer/BaseFrameBuffer.h>
+#include <vector>
 
 namespace ScrapEngine
 {
 	namespace Render
 	{
-		class VulkanImageView;
-
+		//Framebuffers of the StandardRenderPass, one for every output image
 		class StandardFrameBuffer : public BaseFrameBuffer
 		{
 		public:
-			StandardFrameBuffer(VulkanImageView* input_image_view_ref,
-			                    const vk::Extent2D* input_swap_chain_extent,
-			                    vk::ImageView* depth_image_view, vk::ImageView* color_image_view);
+			//output_image_views are the swap chain images or, when the scene is scaled, the single scene color
+			//color_image_view is the multisampled color attachment, nullptr if msaa is disabled
+			//velocity_image_view is needed only if the render pass has the velocity
+			StandardFrameBuffer(const vk::Extent2D* input_extent, const std::vector<vk::ImageView>& output_image_views,
+			                    vk::ImageView* depth_image_view, vk::ImageView* color_image_view,
+			                    vk::ImageView* velocity_image_view = nullptr);
 
 			~StandardFrameBuffer() = default;
 		};
@@ -0,0 +1,102 @@
+#include <Engine/Rendering/Buffer/FrameBuffer/TemporalHistoryFrameBuffer/TemporalHistoryFrameBuffer.h>
+#include <Engine/Rendering/Device/VulkanDevice.h>
+#include <Engine/Rendering/Memory/VulkanMemoryAllocator.h>
+#include <Engine/Rendering/RenderPass/BaseRenderPass.h>
+#include <Engine/Rendering/Texture/TextureImageView/TextureImageView.h>
+#include <Engine/Rendering/Texture/Texture/BaseTexture.h>
+#include <Engine/Debug/DebugLog.h>
+
+ScrapEngine::Render::TemporalHistoryFrameBuffer::TemporalHistoryFrameBuffer(const vk::Extent2D& extent,
+                                                                            const vk::Format format,
+                                                                            BaseRenderPass* render_pass)
+	: format_(format)
+{
+	const vk::ImageCreateInfo image_info(
+		vk::ImageCreateFlags(),
+		vk::ImageType::e2D,
+		format,
+		vk::Extent3D(extent.width, extent.height, 1),
+		1,
+		1,
+		vk::SampleCountFlagBits::e1,
+		vk::ImageTiling::eOptimal,
+		vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eSampled |
+		vk::ImageUsageFlagBits::eTransferSrc,
+		vk::SharingMode::eExclusive
+	);
+
+	framebuffers_.resize(history_count);
+
+	for (uint32_t i = 0; i < history_count; i++)
+	{
+		VulkanMemoryAllocator::get_instance()->create_texture_image(&image_info, images_[i], images_memory_[i]);
+		image_views_[i] = TextureImageView::create_image_view(&images_[i], format, vk::ImageAspectFlagBits::eColor,
+		                                                      1);
+		BaseTexture::transition_image_layout(&images_[i], format, vk::ImageLayout::eUndefined,
+		                                     vk::ImageLayout::eShaderReadOnlyOptimal, 1);
+
+		vk::FramebufferCreateInfo create_info(
+			vk::FramebufferCreateFlags(),
+			*render_pass->get_render_pass(),
+			1,
+			&image_views_[i],
+			extent.width,
+			extent.height,
+			1
+		);
+
+		const vk::Result result = VulkanDevice::get_instance()->get_logical_device()->createFramebuffer(
+			&create_info, nullptr, &framebuffers_[i]);
+
+		if (result != vk::Result::eSuccess)
+		{
+			Debug::DebugLog::fatal_error(result, "TemporalHistoryFrameBuffer: Failed to create framebuffer!");
+		}
+	}
+
+	vk::SamplerCreateInfo sampler(
+		vk::SamplerCreateFlags(),
+		vk::Filter::eLinear,
+		vk::Filter::eLinear,
+		vk::SamplerMipmapMode::eNearest,
+		vk::SamplerAddressMode::eClampToEdge,
+		vk::SamplerAddressMode::eClampToEdge,
+		vk::SamplerAddressMode::eClampToEdge,
+		0.0f
+	);
+	sampler.setMaxAnisotropy(1.0f);
+	sampler.setMinLod(0.0f);
+	sampler.setMaxLod(0.0f);
+
+	VulkanDevice::get_instance()->get_logical_device()->createSampler(&sampler, nullptr, &sampler_);
+}
+
+ScrapEngine::Render::TemporalHistoryFrameBuffer::~TemporalHistoryFrameBuffer()
+{
+	VulkanDevice::get_instance()->get_logical_device()->destroySampler(sampler_);
+	for (uint32_t i = 0; i < history_count; i++)
+	{
+		VulkanDevice::get_instance()->get_logical_device()->destroyImageView(image_views_[i]);
+		VulkanMemoryAllocator::get_instance()->destroy_image(images_[i], images_memory_[i]);
+	}
+}
+
+vk::Image ScrapEngine::Render::TemporalHistoryFrameBuffer::get_image(const uint32_t index) const
+{
+	return images_[index];
+}
+
+vk::ImageView* ScrapEngine::Render::TemporalHistoryFrameBuffer::get_image_view(const uint32_t index)
+{
+	return &image_views_[index];
+}
+
+vk::Sampler* ScrapEngine::Render::TemporalHistoryFrameBuffer::get_sampler()
+{
+	return &sampler_;
+}
+
+vk::Format ScrapEngine::Render::TemporalHistoryFrameBuffer::get_format() const
+{
+	return format_;
+}
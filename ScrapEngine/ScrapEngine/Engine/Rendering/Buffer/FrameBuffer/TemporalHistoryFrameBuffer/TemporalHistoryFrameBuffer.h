@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Engine/Rendering/Buffer/FrameBuffer/BaseFrameBuffer.h>
+#include <array>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		class BaseRenderPass;
+
+		//Two history images used in ping pong by the temporal resolve, with a framebuffer for each one
+		//A frame writes an image and reads the other one written by the previous frame
+		class TemporalHistoryFrameBuffer : public BaseFrameBuffer
+		{
+		public:
+			static const uint32_t history_count = 2;
+		private:
+			vk::Format format_;
+			std::array<vk::Image, history_count> images_;
+			std::array<VmaAllocation, history_count> images_memory_;
+			std::array<vk::ImageView, history_count> image_views_;
+			vk::Sampler sampler_;
+		public:
+			//The images start in eShaderReadOnlyOptimal, so the first frame can read an history
+			TemporalHistoryFrameBuffer(const vk::Extent2D& extent, vk::Format format, BaseRenderPass* render_pass);
+			~TemporalHistoryFrameBuffer();
+
+			vk::Image get_image(uint32_t index) const;
+			vk::ImageView* get_image_view(uint32_t index);
+			//Linear and clamped to the edges
+			vk::Sampler* get_sampler();
+			vk::Format get_format() const;
+		};
+	}
+}
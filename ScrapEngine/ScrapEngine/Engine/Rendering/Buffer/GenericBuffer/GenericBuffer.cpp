@@ -16,13 +16,17 @@ void ScrapEngine::Render::GenericBuffer::create_buffer(const vk::BufferCreateInf
 		vk::SharingMode::eExclusive
 	);
 
+	//These buffers are written by the CPU every frame
 	VmaAllocationCreateInfo alloc_info = {};
 	alloc_info.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
-	alloc_info.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+	alloc_info.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+	alloc_info.preferredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
 	alloc_info.flags = VMA_ALLOCATION_CREATE_DONT_BIND_BIT;
 
 	VulkanMemoryAllocator::get_instance()->
 		create_generic_buffer(&buffer_info, &alloc_info, buffer_, buffer_memory_);
+	size_ = crate_info.size;
+	host_coherent_ = VulkanMemoryAllocator::get_instance()->is_allocation_host_coherent(buffer_memory_);
 
 	setup_descriptor();
 
@@ -66,6 +70,9 @@ void ScrapEngine::Render::GenericBuffer::destroy()
 	unmap();
 	//Destroy the buffer and its memory
 	VulkanMemoryAllocator::get_instance()->destroy_buffer(buffer_, buffer_memory_);
+	buffer_ = nullptr;
+	buffer_memory_ = nullptr;
+	size_ = 0;
 }
 
 vk::Buffer* ScrapEngine::Render::GenericBuffer::get_buffer()
@@ -77,3 +84,13 @@ void* ScrapEngine::Render::GenericBuffer::get_mapped_memory() const
 {
 	return mapped_memory_;
 }
+
+vk::DeviceSize ScrapEngine::Render::GenericBuffer::get_size() const
+{
+	return size_;
+}
+
+bool ScrapEngine::Render::GenericBuffer::is_host_coherent() const
+{
+	return host_coherent_;
+}
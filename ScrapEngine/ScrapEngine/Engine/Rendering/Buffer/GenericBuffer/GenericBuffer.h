@@ -11,7 +11,9 @@ namespace ScrapEngine
 		private:
 			vk::Buffer buffer_ = nullptr;
 			vk::DescriptorBufferInfo descriptor_;
-			VmaAllocation buffer_memory_;
+			VmaAllocation buffer_memory_ = nullptr;
+			vk::DeviceSize size_ = 0;
+			bool host_coherent_ = false;
 
 			void* mapped_memory_ = nullptr;
 		public:
@@ -29,6 +31,9 @@ namespace ScrapEngine
 
 			vk::Buffer* get_buffer();
 			void* get_mapped_memory() const;
+			vk::DeviceSize get_size() const;
+			//If true there's no need to flush() after writing the mapped memory
+			bool is_host_coherent() const;
 		};
 	}
 }
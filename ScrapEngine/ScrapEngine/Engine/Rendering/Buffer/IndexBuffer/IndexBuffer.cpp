@@ -13,7 +13,8 @@ ScrapEngine::Render::IndexBuffer::IndexBuffer(const std::vector<uint32_t>* indic
 	const vk::BufferCreateInfo buffer_info(
 		vk::BufferCreateFlags(),
 		buffer_size,
-		vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eIndexBuffer,
+		vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst |
+		vk::BufferUsageFlagBits::eIndexBuffer,
 		vk::SharingMode::eExclusive
 	);
 
@@ -21,10 +22,14 @@ ScrapEngine::Render::IndexBuffer::IndexBuffer(const std::vector<uint32_t>* indic
 		create_vertex_index_buffer(&buffer_info, index_buffer_, index_buffer_memory_);
 
 	BaseBuffer::copy_buffer(staging->get_staging_buffer(), index_buffer_, buffer_size);
+
+	//Static geometry can be moved by the defragmentation, that copies it to the new buffer
+	VulkanMemoryAllocator::get_instance()->register_defragmentable_buffer(&index_buffer_, &index_buffer_memory_, buffer_info);
 }
 
 ScrapEngine::Render::IndexBuffer::~IndexBuffer()
 {
+	VulkanMemoryAllocator::get_instance()->unregister_defragmentable_buffer(&index_buffer_);
 	VulkanMemoryAllocator::get_instance()->destroy_buffer(index_buffer_, index_buffer_memory_);
 }
 
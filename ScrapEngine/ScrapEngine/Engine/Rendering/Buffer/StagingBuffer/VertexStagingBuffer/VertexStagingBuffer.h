@@ -10,7 +10,8 @@ namespace ScrapEngine
 		class VertexStagingBuffer : public BaseStagingBuffer
 		{
 		public:
-			VertexStagingBuffer(const vk::DeviceSize& buffer_size, const std::vector<Vertex>* vector_data);
+			//vector_data is one of the vertex streams, buffer_size bytes are copied
+			VertexStagingBuffer(const vk::DeviceSize& buffer_size, const void* vector_data);
 
 			~VertexStagingBuffer() = default;
 		};
@@ -46,6 +46,16 @@ void ScrapEngine::Render::StandardUniformBuffer::update_uniform_buffer_camera_da
 	//Perspective and look stuff
 	ubo_.proj = render_camera->get_camera_projection_matrix();
 	ubo_.view = render_camera->get_camera_look_matrix();
+
+	//Velocity
+	if (!has_previous_model_)
+	{
+		previous_model_ = ubo_.model;
+		has_previous_model_ = true;
+	}
+	ubo_.unjittered_mvp = render_camera->get_camera_unjittered_projection_matrix() * ubo_.view * ubo_.model;
+	ubo_.previous_mvp = render_camera->get_previous_view_projection() * previous_model_;
+	previous_model_ = ubo_.model;
 }
 
 void ScrapEngine::Render::StandardUniformBuffer::update_uniform_buffer_light_data(const glm::vec3& light_pos,
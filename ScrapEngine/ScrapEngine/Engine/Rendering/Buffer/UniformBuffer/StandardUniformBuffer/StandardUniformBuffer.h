@@ -24,17 +24,25 @@ namespace ScrapEngine
 			glm::mat4 proj;
 			glm::mat4 depth_bias_mvp;
 			glm::vec3 light_pos;
+			//Clip positions without jitter of this frame and of the previous one, for the velocity
+			//Aligned as the std140 layout of the shader
+			alignas(16) glm::mat4 unjittered_mvp;
+			glm::mat4 previous_mvp;
 		};
 
 		class StandardUniformBuffer : public BaseUniformBuffer
 		{
 		private:
 			UniformBufferObject ubo_ = {};
+			//Model of the last update_uniform_buffer_camera_data() call
+			glm::mat4 previous_model_ = glm::mat4(1.0f);
+			bool has_previous_model_ = false;
 		public:
 			StandardUniformBuffer(size_t swap_chain_images_size);
 			~StandardUniformBuffer() = default;
 
 			void update_uniform_buffer_transform(const Core::STransform& object_transform);
+			//Called every frame after the transform, it also moves the model of this frame to the previous one
 			void update_uniform_buffer_camera_data(Camera* render_camera);
 			void update_uniform_buffer_light_data(const glm::vec3& light_pos, const glm::mat4& depth_bias_m);
 			void finish_update_uniform_buffer(uint32_t current_image) override;
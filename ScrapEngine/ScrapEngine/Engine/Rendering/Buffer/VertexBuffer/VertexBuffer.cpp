@@ -5,30 +5,78 @@
 
 ScrapEngine::Render::VertexBuffer::VertexBuffer(const std::vector<Vertex>* vertices)
 {
-	const vk::DeviceSize buffer_size(sizeof((*vertices)[0]) * vertices->size());
+	//Split the vertices in the two streams
+	std::vector<OffscreenVertex> positions(vertices->size());
+	std::vector<VertexAttributes> attributes(vertices->size());
+	for (size_t i = 0; i < vertices->size(); i++)
+	{
+		const Vertex& vertex = (*vertices)[i];
+		positions[i].pos = vertex.pos;
+		attributes[i].color = vertex.color;
+		attributes[i].tex_coord = vertex.tex_coord;
+		attributes[i].normal = vertex.normal;
+	}
 
-	//unique_ptr to be deleted after constructor
-	std::unique_ptr<BaseStagingBuffer> staging = std::make_unique<VertexStagingBuffer>(buffer_size, vertices);
+	create_stream(positions.data(), sizeof(OffscreenVertex) * positions.size(),
+	              position_buffer_, position_buffer_memory_);
+	create_stream(attributes.data(), sizeof(VertexAttributes) * attributes.size(),
+	              attribute_buffer_, attribute_buffer_memory_);
+
+	//Static geometry can be moved by the defragmentation, that copies it to the new buffer
+	const vk::BufferCreateInfo position_buffer_info(
+		vk::BufferCreateFlags(),
+		sizeof(OffscreenVertex) * positions.size(),
+		vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst |
+		vk::BufferUsageFlagBits::eVertexBuffer,
+		vk::SharingMode::eExclusive
+	);
+	const vk::BufferCreateInfo attribute_buffer_info(
+		vk::BufferCreateFlags(),
+		sizeof(VertexAttributes) * attributes.size(),
+		vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst |
+		vk::BufferUsageFlagBits::eVertexBuffer,
+		vk::SharingMode::eExclusive
+	);
+	VulkanMemoryAllocator::get_instance()->register_defragmentable_buffer(&position_buffer_, &position_buffer_memory_,
+	                                                                      position_buffer_info);
+	VulkanMemoryAllocator::get_instance()->register_defragmentable_buffer(&attribute_buffer_,
+	                                                                      &attribute_buffer_memory_,
+	                                                                      attribute_buffer_info);
+}
+
+void ScrapEngine::Render::VertexBuffer::create_stream(const void* data, const vk::DeviceSize buffer_size,
+                                                      vk::Buffer& buffer, VmaAllocation& buffer_memory)
+{
+	//unique_ptr to be deleted after the copy
+	std::unique_ptr<BaseStagingBuffer> staging = std::make_unique<VertexStagingBuffer>(buffer_size, data);
 
 	const vk::BufferCreateInfo buffer_info(
 		vk::BufferCreateFlags(),
 		buffer_size,
-		vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer,
+		vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst |
+		vk::BufferUsageFlagBits::eVertexBuffer,
 		vk::SharingMode::eExclusive
 	);
 
-	VulkanMemoryAllocator::get_instance()->
-		create_vertex_index_buffer(&buffer_info, vertex_buffer_, vertex_buffer_memory_);
+	VulkanMemoryAllocator::get_instance()->create_vertex_index_buffer(&buffer_info, buffer, buffer_memory);
 
-	BaseBuffer::copy_buffer(staging->get_staging_buffer(), vertex_buffer_, buffer_size);
+	BaseBuffer::copy_buffer(staging->get_staging_buffer(), buffer, buffer_size);
 }
 
 ScrapEngine::Render::VertexBuffer::~VertexBuffer()
 {
-	VulkanMemoryAllocator::get_instance()->destroy_buffer(vertex_buffer_, vertex_buffer_memory_);
+	VulkanMemoryAllocator::get_instance()->unregister_defragmentable_buffer(&position_buffer_);
+	VulkanMemoryAllocator::get_instance()->unregister_defragmentable_buffer(&attribute_buffer_);
+	VulkanMemoryAllocator::get_instance()->destroy_buffer(position_buffer_, position_buffer_memory_);
+	VulkanMemoryAllocator::get_instance()->destroy_buffer(attribute_buffer_, attribute_buffer_memory_);
+}
+
+vk::Buffer* ScrapEngine::Render::VertexBuffer::get_position_buffer()
+{
+	return &position_buffer_;
 }
 
-vk::Buffer* ScrapEngine::Render::VertexBuffer::get_vertex_buffer()
+vk::Buffer* ScrapEngine::Render::VertexBuffer::get_attribute_buffer()
 {
-	return &vertex_buffer_;
+	return &attribute_buffer_;
 }
@@ -8,16 +8,23 @@ namespace ScrapEngine
 {
 	namespace Render
 	{
+		//The vertices are split in a position stream and an attributes stream, see Vertex
 		class VertexBuffer
 		{
 		private:
-			vk::Buffer vertex_buffer_;
-			VmaAllocation vertex_buffer_memory_;
+			vk::Buffer position_buffer_;
+			VmaAllocation position_buffer_memory_;
+			vk::Buffer attribute_buffer_;
+			VmaAllocation attribute_buffer_memory_;
+
+			static void create_stream(const void* data, vk::DeviceSize buffer_size,
+			                          vk::Buffer& buffer, VmaAllocation& buffer_memory);
 		public:
 			VertexBuffer(const std::vector<Vertex>* vertices);
 			~VertexBuffer();
 
-			vk::Buffer* get_vertex_buffer();
+			vk::Buffer* get_position_buffer();
+			vk::Buffer* get_attribute_buffer();
 		};
 	}
 }
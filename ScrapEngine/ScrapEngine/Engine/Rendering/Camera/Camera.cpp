@@ -177,10 +177,39 @@ float ScrapEngine::Render::Camera::get_camera_aspect_ratio() const
 }
 
 glm::mat4 ScrapEngine::Render::Camera::get_camera_projection_matrix() const
+{
+	glm::mat4 jittered_projection = projection_matrix_;
+	//The clip w is -z of the view space, so the ndc offset is added through the z column
+	jittered_projection[2][0] -= projection_jitter_.x;
+	jittered_projection[2][1] -= projection_jitter_.y;
+	return jittered_projection;
+}
+
+glm::mat4 ScrapEngine::Render::Camera::get_camera_unjittered_projection_matrix() const
 {
 	return projection_matrix_;
 }
 
+void ScrapEngine::Render::Camera::set_projection_jitter(const glm::vec2& jitter)
+{
+	projection_jitter_ = jitter;
+}
+
+glm::vec2 ScrapEngine::Render::Camera::get_projection_jitter() const
+{
+	return projection_jitter_;
+}
+
+void ScrapEngine::Render::Camera::set_previous_view_projection(const glm::mat4& view_projection)
+{
+	previous_view_projection_ = view_projection;
+}
+
+glm::mat4 ScrapEngine::Render::Camera::get_previous_view_projection() const
+{
+	return previous_view_projection_;
+}
+
 glm::mat4 ScrapEngine::Render::Camera::get_camera_look_matrix() const
 {
 	return look_matrix_;
@@ -3,6 +3,7 @@
 #include <Engine/Rendering/VulkanInclude.h>
 #include <Engine/LogicCore/Math/Vector/SVector3.h>
 #include <Engine/Rendering/Camera/CameraFrustum.h>
+#include <glm/vec2.hpp>
 
 namespace ScrapEngine
 {
@@ -18,6 +19,10 @@ namespace ScrapEngine
 			//Camera matrices
 			glm::mat4 projection_matrix_;
 			glm::mat4 look_matrix_;
+			//Sub pixel offset in ndc added to the projection, used by the TemporalUpscaler
+			glm::vec2 projection_jitter_ = glm::vec2(0.0f);
+			//Unjittered view projection of the previous frame, used by the velocity of the meshes
+			glm::mat4 previous_view_projection_ = glm::mat4(1.0f);
 
 			float min_draw_distance_, max_draw_distance_;
 
@@ -78,9 +83,18 @@ namespace ScrapEngine
 
 			float get_camera_aspect_ratio() const;
 
+			//Projection used to draw, with the jitter
 			glm::mat4 get_camera_projection_matrix() const;
+			//Projection without the jitter, used by the frustum and the reprojection
+			glm::mat4 get_camera_unjittered_projection_matrix() const;
 			glm::mat4 get_camera_look_matrix() const;
 
+			void set_projection_jitter(const glm::vec2& jitter);
+			glm::vec2 get_projection_jitter() const;
+			//Set by the TemporalUpscaler, identity without it
+			void set_previous_view_projection(const glm::mat4& view_projection);
+			glm::mat4 get_previous_view_projection() const;
+
 			void set_swap_chain_extent(const vk::Extent2D& swap_chain_extent);
 			bool frustum_check_sphere(const glm::vec3& pos, float radius);
 		};
@@ -1,12 +1,12 @@
 #include <Engine/Rendering/DepthResources/VulkanDepthResources.h>
-#include <Engine/Rendering/Texture/Texture/BaseTexture.h>
 #include <Engine/Rendering/Texture/TextureImageView/TextureImageView.h>
 #include <Engine/Rendering/Device/VulkanDevice.h>
 #include <Engine/Rendering/Memory/VulkanMemoryAllocator.h>
 #include <Engine/Debug/DebugLog.h>
 
 ScrapEngine::Render::VulkanDepthResources::VulkanDepthResources(const vk::Extent2D* swap_chain_extent,
-                                                                const vk::SampleCountFlagBits msaa_samples)
+                                                                const vk::SampleCountFlagBits msaa_samples,
+                                                                const bool sampled)
 {
 	const vk::Format depth_format = find_depth_format();
 
@@ -19,19 +19,27 @@ ScrapEngine::Render::VulkanDepthResources::VulkanDepthResources(const vk::Extent
 		1,
 		msaa_samples,
 		vk::ImageTiling::eOptimal,
-		vk::ImageUsageFlagBits::eDepthStencilAttachment,
+		sampled
+			? vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eSampled
+			: vk::ImageUsageFlagBits::eTransientAttachment | vk::ImageUsageFlagBits::eDepthStencilAttachment,
 		vk::SharingMode::eExclusive
 	);
 
-	VulkanMemoryAllocator::get_instance()->
-		create_texture_image(&image_info, depth_image_, depth_image_memory_);
+	if (sampled)
+	{
+		VulkanMemoryAllocator::get_instance()->create_texture_image(&image_info, depth_image_, depth_image_memory_);
+	}
+	else
+	{
+		//The depth is cleared and never stored by the render pass, it can live in lazily allocated memory
+		VulkanMemoryAllocator::get_instance()->
+			create_transient_attachment_image(&image_info, depth_image_, depth_image_memory_);
+	}
 
+	//No layout transition, the render pass starts from eUndefined
 	depth_image_view_ = TextureImageView::create_image_view(&depth_image_, depth_format,
 	                                                        vk::ImageAspectFlagBits::eDepth,
 	                                                        1);
-
-	BaseTexture::transition_image_layout(&depth_image_, depth_format, vk::ImageLayout::eUndefined,
-	                                     vk::ImageLayout::eDepthStencilAttachmentOptimal, 1);
 }
 
 
@@ -14,7 +14,9 @@ namespace ScrapEngine
 			VmaAllocation depth_image_memory_;
 			vk::ImageView depth_image_view_;
 		public:
-			VulkanDepthResources(const vk::Extent2D* swap_chain_extent, vk::SampleCountFlagBits msaa_samples);
+			//If sampled the depth is stored by the render pass and can be read by a shader
+			VulkanDepthResources(const vk::Extent2D* swap_chain_extent, vk::SampleCountFlagBits msaa_samples,
+			                     bool sampled = false);
 			~VulkanDepthResources();
 
 			static vk::Format find_supported_format(const std::vector<vk::Format>& candidates, vk::ImageTiling tiling,
@@ -0,0 +1,104 @@
+#include <Engine/Rendering/Descriptor/DescriptorSet/TemporalResolveDescriptorSet/TemporalResolveDescriptorSet.h>
+#include <Engine/Rendering/Buffer/FrameBuffer/TemporalHistoryFrameBuffer/TemporalHistoryFrameBuffer.h>
+#include <Engine/Rendering/Device/VulkanDevice.h>
+#include <Engine/Debug/DebugLog.h>
+#include <array>
+
+ScrapEngine::Render::TemporalResolveDescriptorSet::TemporalResolveDescriptorSet() : BaseDescriptorSet()
+{
+	std::array<vk::DescriptorSetLayoutBinding, 4> bindings;
+	for (uint32_t i = 0; i < bindings.size(); i++)
+	{
+		bindings[i] = vk::DescriptorSetLayoutBinding(
+			i,
+			vk::DescriptorType::eCombinedImageSampler,
+			1,
+			vk::ShaderStageFlagBits::eFragment
+		);
+	}
+
+	vk::DescriptorSetLayoutCreateInfo layout_info(
+		vk::DescriptorSetLayoutCreateFlags(),
+		static_cast<uint32_t>(bindings.size()),
+		bindings.data()
+	);
+
+	const vk::Result result = VulkanDevice::get_instance()->get_logical_device()->createDescriptorSetLayout(
+		&layout_info, nullptr, &descriptor_set_layout_);
+
+	if (result != vk::Result::eSuccess)
+	{
+		Debug::DebugLog::fatal_error(result, "TemporalResolveDescriptorSet: Failed to create descriptor set layout!");
+	}
+}
+
+void ScrapEngine::Render::TemporalResolveDescriptorSet::create_descriptor_sets(vk::DescriptorPool* descriptor_pool,
+                                                                               const vk::ImageView
+                                                                               scene_color_image_view,
+                                                                               vk::ImageView* depth_image_view,
+                                                                               vk::Sampler* depth_sampler,
+                                                                               TemporalHistoryFrameBuffer* history,
+                                                                               const vk::ImageView velocity_image_view)
+{
+	const uint32_t set_count = TemporalHistoryFrameBuffer::history_count;
+	std::vector<vk::DescriptorSetLayout> layouts(set_count, descriptor_set_layout_);
+
+	vk::DescriptorSetAllocateInfo alloc_info(
+		*descriptor_pool,
+		set_count,
+		layouts.data()
+	);
+
+	descriptor_sets_.resize(set_count);
+
+	const vk::Result result = VulkanDevice::get_instance()->get_logical_device()->allocateDescriptorSets(
+		&alloc_info, &descriptor_sets_[0]);
+
+	if (result != vk::Result::eSuccess)
+	{
+		Debug::DebugLog::fatal_error(result, "TemporalResolveDescriptorSet: Failed to allocate descriptor sets!");
+	}
+
+	for (uint32_t i = 0; i < set_count; i++)
+	{
+		//The set used to write the history i reads the other one
+		const uint32_t previous_history = (i + 1) % set_count;
+
+		vk::DescriptorImageInfo scene_color_info(
+			*history->get_sampler(),
+			scene_color_image_view,
+			vk::ImageLayout::eShaderReadOnlyOptimal
+		);
+		vk::DescriptorImageInfo depth_info(
+			*depth_sampler,
+			*depth_image_view,
+			vk::ImageLayout::eDepthStencilReadOnlyOptimal
+		);
+		vk::DescriptorImageInfo history_info(
+			*history->get_sampler(),
+			*history->get_image_view(previous_history),
+			vk::ImageLayout::eShaderReadOnlyOptimal
+		);
+		//Not filtered, like the depth, the cleared value must not be mixed with the velocity of the edges
+		vk::DescriptorImageInfo velocity_info(
+			*depth_sampler,
+			velocity_image_view,
+			vk::ImageLayout::eShaderReadOnlyOptimal
+		);
+
+		std::array<vk::WriteDescriptorSet, 4> descriptor_writes = {
+			vk::WriteDescriptorSet(descriptor_sets_[i], 0, 0, 1, vk::DescriptorType::eCombinedImageSampler,
+			                       &scene_color_info),
+			vk::WriteDescriptorSet(descriptor_sets_[i], 1, 0, 1, vk::DescriptorType::eCombinedImageSampler,
+			                       &depth_info),
+			vk::WriteDescriptorSet(descriptor_sets_[i], 2, 0, 1, vk::DescriptorType::eCombinedImageSampler,
+			                       &history_info),
+			vk::WriteDescriptorSet(descriptor_sets_[i], 3, 0, 1, vk::DescriptorType::eCombinedImageSampler,
+			                       &velocity_info)
+		};
+
+		VulkanDevice::get_instance()->get_logical_device()->updateDescriptorSets(
+			static_cast<uint32_t>(descriptor_writes.size()),
+			descriptor_writes.data(), 0, nullptr);
+	}
+}
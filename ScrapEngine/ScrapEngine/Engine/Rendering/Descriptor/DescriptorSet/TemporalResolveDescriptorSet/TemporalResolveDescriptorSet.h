@@ -0,0 +1,25 @@
+#pragma once
+
+#include <Engine/Rendering/Descriptor/DescriptorSet/BaseDescriptorSet.h>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		class TemporalHistoryFrameBuffer;
+
+		//Scene color, scene depth, history and velocity read by the temporal resolve
+		//There's a descriptor set for every history image written, reading the other one
+		class TemporalResolveDescriptorSet : public BaseDescriptorSet
+		{
+		public:
+			TemporalResolveDescriptorSet();
+			~TemporalResolveDescriptorSet() = default;
+
+			void create_descriptor_sets(vk::DescriptorPool* descriptor_pool,
+			                            vk::ImageView scene_color_image_view, vk::ImageView* depth_image_view,
+			                            vk::Sampler* depth_sampler, TemporalHistoryFrameBuffer* history,
+			                            vk::ImageView velocity_image_view);
+		};
+	}
+}
@@ -9,9 +9,11 @@
 
 ScrapEngine::Render::VulkanDevice* ScrapEngine::Render::VulkanDevice::instance_ = nullptr;
 
-void ScrapEngine::Render::VulkanDevice::init(vk::SurfaceKHR* vulkan_surface_input_ref)
+void ScrapEngine::Render::VulkanDevice::init(vk::SurfaceKHR* vulkan_surface_input_ref,
+                                             const uint32_t requested_msaa_samples)
 {
 	vulkan_surface_ref_ = vulkan_surface_input_ref;
+	requested_msaa_samples_ = requested_msaa_samples;
 
 	choose_physical_device();
 	create_logical_device();
@@ -48,7 +50,7 @@ void ScrapEngine::Render::VulkanDevice::choose_physical_device()
 		if (is_device_suitable(&entry_device, vulkan_surface_ref_))
 		{
 			physical_device_ = entry_device;
-			msaa_samples_ = get_max_usable_sample_count();
+			msaa_samples_ = choose_msaa_samples(requested_msaa_samples_);
 			break;
 		}
 	}
@@ -78,9 +80,14 @@ void ScrapEngine::Render::VulkanDevice::create_logical_device()
 		queue_create_infos.push_back(queue_create_info);
 	}
 
+	select_device_extensions();
+
 	vk::PhysicalDeviceFeatures device_features;
 	device_features.setSamplerAnisotropy(true);
 	device_features.setSampleRateShading(true);
+	//Enabled when supported, the queries are used only if the profiler asks for them
+	pipeline_statistics_query_enabled_ = physical_device_.getFeatures().pipelineStatisticsQuery;
+	device_features.setPipelineStatisticsQuery(pipeline_statistics_query_enabled_);
 
 	vk::DeviceCreateInfo create_info(
 		vk::DeviceCreateFlags(),
@@ -88,11 +95,28 @@ void ScrapEngine::Render::VulkanDevice::create_logical_device()
 		queue_create_infos.data(),
 		0,
 		nullptr,
-		static_cast<uint32_t>(device_extensions_.size()),
-		device_extensions_.data(),
+		static_cast<uint32_t>(enabled_device_extensions_.size()),
+		enabled_device_extensions_.data(),
 		&device_features
 	);
 
+	//The timeline semaphore feature must be enabled too, not only the extension
+	vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR timeline_features;
+	if (is_extension_enabled(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+	{
+		const auto supported_features = physical_device_.getFeatures2<
+			vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>();
+		timeline_semaphore_enabled_ = supported_features.get<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>()
+		                                                .timelineSemaphore;
+		if (timeline_semaphore_enabled_)
+		{
+			timeline_features.setTimelineSemaphore(true);
+			create_info.setPNext(&timeline_features);
+		}
+	}
+	Debug::DebugLog::print_to_console_log(std::string("Timeline semaphores ") +
+		(timeline_semaphore_enabled_ ? "enabled" : "not supported, using fences"));
+
 	VulkanValidationLayers* validation_layers = VukanInstance::get_instance()->get_validation_layers_manager();
 	//Fill the vector only if the layers are enabled
 	if (validation_layers && validation_layers->are_validation_layers_enabled())
@@ -121,6 +145,9 @@ void ScrapEngine::Render::VulkanDevice::create_logical_device()
 			Debug::DebugLog::fatal_error(result, "VulkanDevice: Failed to create logical device!");
 		}
 	}
+
+	device_dispatcher_ = vk::DispatchLoaderDynamic(*VukanInstance::get_instance()->get_vulkan_instance(),
+	                                               vkGetInstanceProcAddr, device_, vkGetDeviceProcAddr);
 }
 
 vk::PhysicalDevice* ScrapEngine::Render::VulkanDevice::get_physical_device()
@@ -193,10 +220,58 @@ bool ScrapEngine::Render::VulkanDevice::check_device_extension_support(vk::Physi
 	return required_extensions.empty();
 }
 
+void ScrapEngine::Render::VulkanDevice::select_device_extensions()
+{
+	enabled_device_extensions_ = device_extensions_;
+
+	std::vector<vk::ExtensionProperties> available_extensions = physical_device_.enumerateDeviceExtensionProperties();
+
+	for (const char* optional_extension : optional_device_extensions_)
+	{
+		for (const auto& extension : available_extensions)
+		{
+			if (std::string(extension.extensionName) == optional_extension)
+			{
+				enabled_device_extensions_.push_back(optional_extension);
+				Debug::DebugLog::print_to_console_log("Enabled optional device extension: " +
+					std::string(optional_extension));
+				break;
+			}
+		}
+	}
+}
+
+bool ScrapEngine::Render::VulkanDevice::is_extension_enabled(const std::string& extension_name) const
+{
+	for (const char* extension : enabled_device_extensions_)
+	{
+		if (extension_name == extension)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ScrapEngine::Render::VulkanDevice::is_timeline_semaphore_enabled() const
+{
+	return timeline_semaphore_enabled_;
+}
+
+bool ScrapEngine::Render::VulkanDevice::is_pipeline_statistics_query_enabled() const
+{
+	return pipeline_statistics_query_enabled_;
+}
+
+const vk::DispatchLoaderDynamic* ScrapEngine::Render::VulkanDevice::get_device_dispatcher() const
+{
+	return &device_dispatcher_;
+}
+
 void ScrapEngine::Render::VulkanDevice::init_vulkan_allocator() const
 {
 	VulkanMemoryAllocator* allocator = VulkanMemoryAllocator::get_instance();
-	allocator->init(physical_device_, device_);
+	allocator->init(physical_device_, device_, is_extension_enabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME));
 	Debug::DebugLog::print_to_console_log("VulkanMemoryAllocator loaded!");
 }
 
@@ -241,6 +316,22 @@ vk::SampleCountFlagBits ScrapEngine::Render::VulkanDevice::get_max_usable_sample
 	return vk::SampleCountFlagBits::e1;
 }
 
+vk::SampleCountFlagBits ScrapEngine::Render::VulkanDevice::choose_msaa_samples(const uint32_t requested_samples) const
+{
+	const vk::SampleCountFlagBits max_samples = get_max_usable_sample_count();
+	if (requested_samples == 0 || requested_samples >= static_cast<uint32_t>(max_samples))
+	{
+		return max_samples;
+	}
+	//Sample counts are powers of two, every count lower than the max is supported
+	uint32_t samples = 1;
+	while (samples * 2 <= requested_samples)
+	{
+		samples *= 2;
+	}
+	return static_cast<vk::SampleCountFlagBits>(samples);
+}
+
 vk::SampleCountFlagBits ScrapEngine::Render::VulkanDevice::get_msaa_samples() const
 {
 	return msaa_samples_;
@@ -17,6 +17,8 @@ namespace ScrapEngine
 			vk::SurfaceKHR* vulkan_surface_ref_;
 
 			vk::SampleCountFlagBits msaa_samples_ = vk::SampleCountFlagBits::e1;
+			//Samples requested by the game, 0 means the maximum supported
+			uint32_t requested_msaa_samples_ = 0;
 
 			BaseQueue::QueueFamilyIndices cached_indices_;
 
@@ -34,11 +36,28 @@ namespace ScrapEngine
 				VK_KHR_SWAPCHAIN_EXTENSION_NAME
 			};
 
+			//List of Extensions enabled only if the device support them
+			const std::vector<const char*> optional_device_extensions_ = {
+				VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
+				VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME
+			};
+
+			//Extensions effectively enabled on the logical device
+			std::vector<const char*> enabled_device_extensions_;
+
+			//True if the extension is enabled and the device support the timelineSemaphore feature
+			bool timeline_semaphore_enabled_ = false;
+			//True if the device support the pipelineStatisticsQuery feature, used by the GpuPassProfiler
+			bool pipeline_statistics_query_enabled_ = false;
+
+			//Dispatcher used to call the device extension functions, not exported by the vulkan loader
+			vk::DispatchLoaderDynamic device_dispatcher_;
+
 			//The constructor is private because this class is a Singleton
 			VulkanDevice() = default;
 		public:
 			//Method used to init the class with parameters because the constructor is private
-			void init(vk::SurfaceKHR* vulkan_surface_input_ref);
+			void init(vk::SurfaceKHR* vulkan_surface_input_ref, uint32_t requested_msaa_samples = 0);
 
 			//Turn off the logical device
 			~VulkanDevice();
@@ -72,12 +91,26 @@ namespace ScrapEngine
 
 			vk::SampleCountFlagBits get_max_usable_sample_count() const;
 
+			//Highest sample count supported and not greater than requested_samples (0 means the maximum)
+			vk::SampleCountFlagBits choose_msaa_samples(uint32_t requested_samples) const;
+
 			vk::SampleCountFlagBits get_msaa_samples() const;
+
+			//Check if an extension has been enabled on the logical device
+			bool is_extension_enabled(const std::string& extension_name) const;
+
+			bool is_timeline_semaphore_enabled() const;
+
+			bool is_pipeline_statistics_query_enabled() const;
+
+			const vk::DispatchLoaderDynamic* get_device_dispatcher() const;
 		private:
 			bool is_device_suitable(vk::PhysicalDevice* physical_device_input, vk::SurfaceKHR* surface);
 
 			bool check_device_extension_support(vk::PhysicalDevice* device) const;
 
+			void select_device_extensions();
+
 			void init_vulkan_allocator() const;
 		};
 	}
@@ -0,0 +1,110 @@
+#include <Engine/Rendering/DynamicResolution/DynamicResolution.h>
+#include <algorithm>
+#include <cmath>
+
+ScrapEngine::Render::DynamicResolution::DynamicResolution(const settings& input_settings, const bool enabled)
+	: settings_(input_settings), enabled_(enabled), scale_(input_settings.max_scale)
+{
+	set_settings(input_settings);
+}
+
+float ScrapEngine::Render::DynamicResolution::clamp(const float value, const float min, const float max)
+{
+	return std::min(std::max(value, min), max);
+}
+
+void ScrapEngine::Render::DynamicResolution::add_gpu_frame_time(const float gpu_time_ms)
+{
+	gpu_time_ms_ = gpu_time_ms;
+	//Exponential moving average, the first sample is taken as it is
+	smoothed_gpu_time_ms_ = has_samples_
+		                        ? smoothed_gpu_time_ms_ + (gpu_time_ms - smoothed_gpu_time_ms_) * settings_.smoothing
+		                        : gpu_time_ms;
+	has_samples_ = true;
+	frames_since_change_++;
+
+	if (!enabled_ || !timer_available_ || frames_since_change_ < settings_.cooldown_frames ||
+		smoothed_gpu_time_ms_ <= 0.f)
+	{
+		return;
+	}
+
+	const float target = settings_.target_frame_time_ms;
+	const bool over_budget = smoothed_gpu_time_ms_ > target * (1.0f + settings_.hysteresis);
+	const bool under_budget = smoothed_gpu_time_ms_ < target * (1.0f - settings_.hysteresis);
+	if (!over_budget && !under_budget)
+	{
+		return;
+	}
+
+	//The gpu time is about proportional to the pixels, so to the square of the scale
+	const float desired_scale = scale_ * std::sqrt(target / smoothed_gpu_time_ms_);
+	const float step = clamp(desired_scale - scale_, -settings_.max_step, settings_.max_step);
+	const float new_scale = clamp(scale_ + step, settings_.min_scale, settings_.max_scale);
+	if (new_scale != scale_)
+	{
+		scale_ = new_scale;
+		frames_since_change_ = 0;
+		scale_changes_++;
+	}
+}
+
+vk::Extent2D ScrapEngine::Render::DynamicResolution::get_render_extent(const vk::Extent2D& full_extent) const
+{
+	const float scale = enabled_ && timer_available_ ? scale_ : 1.0f;
+	return vk::Extent2D(
+		std::max(1u, static_cast<uint32_t>(std::lround(full_extent.width * scale))),
+		std::max(1u, static_cast<uint32_t>(std::lround(full_extent.height * scale)))
+	);
+}
+
+void ScrapEngine::Render::DynamicResolution::set_enabled(const bool enabled)
+{
+	enabled_ = enabled;
+	frames_since_change_ = 0;
+}
+
+bool ScrapEngine::Render::DynamicResolution::is_enabled() const
+{
+	return enabled_;
+}
+
+void ScrapEngine::Render::DynamicResolution::set_timer_available(const bool available)
+{
+	timer_available_ = available;
+}
+
+void ScrapEngine::Render::DynamicResolution::set_settings(const settings& input_settings)
+{
+	settings_ = input_settings;
+	//The scene color has the swap chain size, so it can't be upscaled over 1
+	settings_.max_scale = clamp(settings_.max_scale, 0.1f, 1.0f);
+	settings_.min_scale = clamp(settings_.min_scale, 0.1f, settings_.max_scale);
+	settings_.smoothing = clamp(settings_.smoothing, 0.01f, 1.0f);
+	scale_ = clamp(scale_, settings_.min_scale, settings_.max_scale);
+}
+
+const ScrapEngine::Render::DynamicResolution::settings& ScrapEngine::Render::DynamicResolution::get_settings() const
+{
+	return settings_;
+}
+
+float ScrapEngine::Render::DynamicResolution::get_scale() const
+{
+	return enabled_ && timer_available_ ? scale_ : 1.0f;
+}
+
+ScrapEngine::Render::DynamicResolution::frame_stats ScrapEngine::Render::DynamicResolution::get_stats(
+	const vk::Extent2D& full_extent) const
+{
+	frame_stats stats;
+	stats.enabled = enabled_;
+	stats.timer_available = timer_available_;
+	stats.gpu_time_ms = gpu_time_ms_;
+	stats.smoothed_gpu_time_ms = smoothed_gpu_time_ms_;
+	stats.target_frame_time_ms = settings_.target_frame_time_ms;
+	stats.scale = get_scale();
+	stats.render_extent = get_render_extent(full_extent);
+	stats.scale_changes = scale_changes_;
+	return stats;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Engine/Rendering/VulkanInclude.h>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		//Choose the resolution of the scene from the measured gpu frame time
+		//The scene is drawn in a part of the scene color and upscaled to the swap chain, the gui stays at full resolution
+		//The scale is applied to both the axes, so the shaded pixels change with the square of the scale
+		class DynamicResolution
+		{
+		public:
+			struct settings
+			{
+				//Bounds of the scale of each axis
+				float min_scale = 0.5f;
+				float max_scale = 1.0f;
+				//Gpu frame time budget
+				float target_frame_time_ms = 16.6f;
+				//Weight of the new sample in the moving average of the gpu time, lower is smoother
+				float smoothing = 0.1f;
+				//The scale changes only if the average time is out of target * (1 +- hysteresis)
+				float hysteresis = 0.1f;
+				//Max change of the scale for each step
+				float max_step = 0.05f;
+				//Frames to wait after a change, the new resolution needs some frames to be measured
+				uint32_t cooldown_frames = 8;
+			};
+
+			struct frame_stats
+			{
+				bool enabled = false;
+				//False if the gpu time cannot be measured, the scene is drawn at full resolution
+				bool timer_available = false;
+				float gpu_time_ms = 0.f;
+				float smoothed_gpu_time_ms = 0.f;
+				float target_frame_time_ms = 0.f;
+				float scale = 1.0f;
+				vk::Extent2D render_extent;
+				//Number of times the scale changed
+				uint32_t scale_changes = 0;
+			};
+		private:
+			settings settings_;
+			bool enabled_;
+			bool timer_available_ = false;
+
+			float scale_;
+			float gpu_time_ms_ = 0.f;
+			float smoothed_gpu_time_ms_ = 0.f;
+			bool has_samples_ = false;
+			uint32_t frames_since_change_ = 0;
+			uint32_t scale_changes_ = 0;
+
+			static float clamp(float value, float min, float max);
+		public:
+			DynamicResolution(const settings& input_settings, bool enabled);
+			~DynamicResolution() = default;
+
+			//Add the gpu time of a completed frame and update the scale
+			void add_gpu_frame_time(float gpu_time_ms);
+
+			//Part of the full extent drawn with the current scale, at least 1x1
+			vk::Extent2D get_render_extent(const vk::Extent2D& full_extent) const;
+
+			void set_enabled(bool enabled);
+			bool is_enabled() const;
+			void set_timer_available(bool available);
+			//The current scale is clamped to the new bounds
+			void set_settings(const settings& input_settings);
+			const settings& get_settings() const;
+			float get_scale() const;
+			frame_stats get_stats(const vk::Extent2D& full_extent) const;
+		};
+	}
+}
@@ -5,7 +5,6 @@
 #include <Engine/Rendering/Device/VulkanDevice.h>
 #include <Engine/Rendering/Descriptor/DescriptorPool/GuiDescriptorPool/GuiDescriptorPool.h>
 #include <Engine/Rendering/Memory/VulkanMemoryAllocator.h>
-#include <Engine/Rendering/RenderPass/GuiRenderPass/GuiRenderPass.h>
 #include <Engine/Rendering/Texture/TextureImageView/TextureImageView.h>
 #include <Engine/Rendering/Texture/TextureSampler/TextureSampler.h>
 #include <Engine/Rendering/Descriptor/DescriptorPool/BaseDescriptorPool.h>
@@ -13,24 +12,27 @@
 #include <Engine/Rendering/Descriptor/DescriptorSet/GuiDescriptorSet/GuiDescriptorSet.h>
 #include <Engine/Rendering/Pipeline/GuiPipeline/GuiVulkanGraphicsPipeline.h>
 #include <Engine/Rendering/Buffer/GenericBuffer/GenericBuffer.h>
+#include <Engine/Debug/AllocationCounter.h>
+#include <cstring>
 
 ScrapEngine::Render::VulkanImGui::VulkanImGui()
 {
 	ImGui::CreateContext();
-
-	vertex_buffer_ = new GenericBuffer();
-	index_buffer_ = new GenericBuffer();
 }
 
 ScrapEngine::Render::VulkanImGui::~VulkanImGui()
 {
 	ImGui::DestroyContext();
 	// Release all Vulkan resources required for rendering imGui
-	//Delete render pass
-	delete gui_render_pass_;
 	//Clear buffers
-	delete vertex_buffer_;
-	delete index_buffer_;
+	for (GenericBuffer* buffer : vertex_buffers_)
+	{
+		delete buffer;
+	}
+	for (GenericBuffer* buffer : index_buffers_)
+	{
+		delete buffer;
+	}
 	//Clear other resources
 	delete front_view_;
 	VulkanMemoryAllocator::get_instance()->destroy_image(font_image_, font_memory_);
@@ -48,14 +50,12 @@ void ScrapEngine::Render::VulkanImGui::init(const float width, const float heigh
 	io.DisplayFramebufferScale = ImVec2(1.0f, 1.0f);
 }
 
-void ScrapEngine::Render::VulkanImGui::init_resources(VulkanSwapChain* swap_chain)
+void ScrapEngine::Render::VulkanImGui::init_resources(VulkanSwapChain* swap_chain, const uint32_t buffers_count,
+                                                     BaseRenderPass* render_pass, const uint32_t subpass,
+                                                     const vk::SampleCountFlagBits samples)
 {
 	ImGuiIO& io = ImGui::GetIO();
 
-	//Create render pass
-	gui_render_pass_ = new GuiRenderPass(swap_chain->get_swap_chain_image_format(),
-	                                     VulkanDevice::get_instance()->get_msaa_samples());
-
 	// Create font texture
 	unsigned char* font_data;
 	int tex_width, tex_height;
@@ -108,7 +108,13 @@ void ScrapEngine::Render::VulkanImGui::init_resources(VulkanSwapChain* swap_chai
 	                              vk::BorderColor::eFloatOpaqueWhite);
 
 	// Descriptor pool
-	const size_t size = swap_chain->get_swap_chain_images_vector()->size();
+	const size_t size = swap_chain->get_frames_in_flight();
+	//Buffers
+	for (uint32_t i = 0; i < buffers_count; i++)
+	{
+		vertex_buffers_.push_back(new GenericBuffer());
+		index_buffers_.push_back(new GenericBuffer());
+	}
 	descriptor_pool_ = new GuiDescriptorPool(size);
 	// Descriptor set
 	descriptor_set_ = new GuiDescriptorSet();
@@ -116,59 +122,41 @@ void ScrapEngine::Render::VulkanImGui::init_resources(VulkanSwapChain* swap_chai
 	                                        size,
 	                                        sampler_->get_texture_sampler(), front_view_->get_texture_image_view());
 
-	//Create pipeline
+	//Create pipeline, the gui is drawn at the swap chain resolution
+	//In the gui subpass of the StandardRenderPass or, when the scene is scaled, in the GuiRenderPass
 	pipeline_ = new GuiVulkanGraphicsPipeline("../assets/shader/compiled_shaders/ui.vert.spv",
 	                                          "../assets/shader/compiled_shaders/ui.frag.spv",
 	                                          descriptor_set_->get_descriptor_set_layout(), sizeof(PushConstBlock),
-	                                          gui_render_pass_);
+	                                          render_pass, subpass, samples);
 
 	//Empty frame initialization
 	generate_empty_gui_frame();
 }
 
-void ScrapEngine::Render::VulkanImGui::update_buffers()
+void ScrapEngine::Render::VulkanImGui::update_buffers(const uint32_t buffers_index)
 {
 	ImDrawData* im_draw_data = ImGui::GetDrawData();
 
 	const vk::DeviceSize vertex_buffer_size = im_draw_data->TotalVtxCount * sizeof(ImDrawVert);
 	const vk::DeviceSize index_buffer_size = im_draw_data->TotalIdxCount * sizeof(ImDrawIdx);
 
+	current_buffers_index_ = buffers_index % static_cast<uint32_t>(vertex_buffers_.size());
+
 	if (vertex_buffer_size == 0 || index_buffer_size == 0)
 	{
 		return;
 	}
 
-	// Vertex buffer
-	if ((vertex_buffer_->get_buffer() == nullptr) || (vertex_count_ != im_draw_data->TotalVtxCount))
-	{
-		vertex_buffer_->unmap();
-		vertex_buffer_->destroy();
-		//Create it
-		vk::BufferCreateInfo vertex_buffer_info;
-		vertex_buffer_info.setUsage(vk::BufferUsageFlagBits::eVertexBuffer);
-		vertex_buffer_info.setSize(vertex_buffer_size);
-		vertex_buffer_->create_buffer(vertex_buffer_info);
-		//Update data
-		vertex_count_ = im_draw_data->TotalVtxCount;
-		vertex_buffer_->map();
-	}
+	GenericBuffer* vertex_buffer = vertex_buffers_[current_buffers_index_];
+	GenericBuffer* index_buffer = index_buffers_[current_buffers_index_];
 
-	// Index buffer
-	if ((index_buffer_->get_buffer() == nullptr) || (index_count_ < im_draw_data->TotalIdxCount))
-	{
-		index_buffer_->unmap();
-		index_buffer_->destroy();
-		vk::BufferCreateInfo index_buffer_info;
-		index_buffer_info.setUsage(vk::BufferUsageFlagBits::eIndexBuffer);
-		index_buffer_info.setSize(index_buffer_size);
-		index_buffer_->create_buffer(index_buffer_info);
-		index_count_ = im_draw_data->TotalIdxCount;
-		index_buffer_->map();
-	}
+	//Grow the buffers only if they are too small
+	ensure_buffer_size(vertex_buffer, vertex_buffer_size, vk::BufferUsageFlagBits::eVertexBuffer);
+	ensure_buffer_size(index_buffer, index_buffer_size, vk::BufferUsageFlagBits::eIndexBuffer);
 
 	// Upload data
-	ImDrawVert* vtx_dst = reinterpret_cast<ImDrawVert*>(vertex_buffer_->get_mapped_memory());
-	ImDrawIdx* idx_dst = reinterpret_cast<ImDrawIdx*>(index_buffer_->get_mapped_memory());
+	ImDrawVert* vtx_dst = reinterpret_cast<ImDrawVert*>(vertex_buffer->get_mapped_memory());
+	ImDrawIdx* idx_dst = reinterpret_cast<ImDrawIdx*>(index_buffer->get_mapped_memory());
 
 	for (int n = 0; n < im_draw_data->CmdListsCount; n++)
 	{
@@ -179,9 +167,89 @@ void ScrapEngine::Render::VulkanImGui::update_buffers()
 		idx_dst += cmd_list->IdxBuffer.Size;
 	}
 
-	// Flush to make writes visible to GPU
-	vertex_buffer_->flush();
-	index_buffer_->flush();
+	// Flush to make writes visible to GPU, only if the memory is not coherent
+	if (!vertex_buffer->is_host_coherent())
+	{
+		vertex_buffer->flush();
+	}
+	if (!index_buffer->is_host_coherent())
+	{
+		index_buffer->flush();
+	}
+}
+
+void ScrapEngine::Render::VulkanImGui::ensure_buffer_size(GenericBuffer* buffer, const vk::DeviceSize required_size,
+                                                          const vk::BufferUsageFlagBits usage)
+{
+	if (buffer->get_size() >= required_size)
+	{
+		return;
+	}
+	//Grow geometrically to avoid reallocating when the gui size slowly increase
+	vk::DeviceSize new_size = buffer->get_size() > min_buffer_size_ ? buffer->get_size() : min_buffer_size_;
+	while (new_size < required_size)
+	{
+		new_size *= 2;
+	}
+	buffer->destroy();
+	vk::BufferCreateInfo buffer_info;
+	buffer_info.setUsage(usage);
+	buffer_info.setSize(new_size);
+	buffer->create_buffer(buffer_info);
+	//Keep it mapped for its entire life
+	buffer->map();
+}
+
+uint64_t ScrapEngine::Render::VulkanImGui::get_draw_data_hash() const
+{
+	ImDrawData* im_draw_data = ImGui::GetDrawData();
+
+	uint64_t hash = 14695981039346656037ull;
+	if (im_draw_data == nullptr)
+	{
+		return hash;
+	}
+	hash = hash_words(hash, &im_draw_data->DisplaySize, sizeof(ImVec2));
+	hash = hash_words(hash, &im_draw_data->CmdListsCount, sizeof(int));
+
+	for (int n = 0; n < im_draw_data->CmdListsCount; n++)
+	{
+		const ImDrawList* cmd_list = im_draw_data->CmdLists[n];
+		const int counts[3] = {cmd_list->CmdBuffer.Size, cmd_list->VtxBuffer.Size, cmd_list->IdxBuffer.Size};
+		hash = hash_words(hash, counts, sizeof(counts));
+		for (int j = 0; j < cmd_list->CmdBuffer.Size; j++)
+		{
+			const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[j];
+			hash = hash_words(hash, &pcmd->ClipRect, sizeof(ImVec4));
+			hash = hash_words(hash, &pcmd->ElemCount, sizeof(unsigned int));
+			hash = hash_words(hash, &pcmd->TextureId, sizeof(ImTextureID));
+		}
+		//Vertex and index checksum, a text can change without changing the counts
+		hash = hash_words(hash, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+		hash = hash_words(hash, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+	}
+
+	return hash;
+}
+
+uint64_t ScrapEngine::Render::VulkanImGui::hash_words(uint64_t hash, const void* data, const size_t size)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	const size_t word_bytes = size - size % sizeof(uint64_t);
+	for (size_t i = 0; i < word_bytes; i += sizeof(uint64_t))
+	{
+		//The vertices are not 8 bytes aligned
+		uint64_t word;
+		std::memcpy(&word, bytes + i, sizeof(uint64_t));
+		hash ^= word;
+		hash *= 1099511628211ull;
+	}
+	for (size_t i = word_bytes; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
 }
 
 void ScrapEngine::Render::VulkanImGui::generate_empty_gui_frame() const
@@ -235,6 +303,112 @@ void ScrapEngine::Render::VulkanImGui::loading_ui() const
 	}
 }
 
+void ScrapEngine::Render::VulkanImGui::render_stats_ui(const RenderQueue::queue_stats& stats,
+                                                      const bool depth_prepass,
+                                                      const DynamicResolution::frame_stats& resolution_stats,
+                                                      const uint64_t frame_allocations,
+                                                      const VulkanMemoryAllocator::memory_statistics& memory_stats,
+                                                      const bool defragmenting) const
+{
+	ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_Always);
+	ImGui::SetNextWindowBgAlpha(0.35f); // Transparent background
+
+	if (ImGui::Begin("Render Stats UI Overlay", nullptr,
+	                 ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+	                 ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs))
+	{
+		ImGui::Text("Draw calls: %u%s", stats.draw_calls, depth_prepass ? " (with depth prepass)" : "");
+		ImGui::Text("Binds unsorted: %u", stats.unsorted_binds);
+		ImGui::Text("Binds sorted: %u", stats.get_total_binds());
+		ImGui::Text("Pipelines: %u Descriptor sets: %u", stats.pipeline_binds, stats.descriptor_set_binds);
+		ImGui::Text("Vertex buffers: %u Index buffers: %u", stats.vertex_buffer_binds, stats.index_buffer_binds);
+
+		ImGui::Separator();
+		if (resolution_stats.timer_available)
+		{
+			ImGui::Text("Gpu time: %.2f ms (avg %.2f ms, target %.2f ms)", resolution_stats.gpu_time_ms,
+			            resolution_stats.smoothed_gpu_time_ms, resolution_stats.target_frame_time_ms);
+		}
+		else
+		{
+			ImGui::Text("Gpu time: not available");
+		}
+		ImGui::Text("Resolution: %ux%u (%.0f%%)%s", resolution_stats.render_extent.width,
+		            resolution_stats.render_extent.height, resolution_stats.scale * 100.0f,
+		            resolution_stats.enabled ? " dynamic" : "");
+		ImGui::Text("Resolution changes: %u", resolution_stats.scale_changes);
+
+		ImGui::Separator();
+		if (Debug::AllocationCounter::is_enabled())
+		{
+			ImGui::Text("Render thread allocations: %llu", static_cast<unsigned long long>(frame_allocations));
+		}
+		else
+		{
+			ImGui::Text("Render thread allocations: not counted");
+		}
+
+		ImGui::Separator();
+		const float mb = 1024.0f * 1024.0f;
+		ImGui::Text("Gpu memory: %.1f MB used, %.1f MB free", static_cast<float>(memory_stats.used_bytes) / mb,
+		            static_cast<float>(memory_stats.unused_bytes) / mb);
+		ImGui::Text("Allocations: %u Blocks: %u Fragmentation: %.0f%%%s", memory_stats.allocation_count,
+		            memory_stats.block_count, memory_stats.fragmentation * 100.0f,
+		            defragmenting ? " (defragmenting)" : "");
+		for (size_t i = 0; i < memory_stats.heaps.size(); i++)
+		{
+			const VulkanMemoryAllocator::memory_heap_budget& heap = memory_stats.heaps[i];
+			ImGui::Text("Heap %u%s: %.1f / %.1f MB", static_cast<uint32_t>(i), heap.device_local ? " (device)" : "",
+			            static_cast<float>(heap.usage) / mb, static_cast<float>(heap.budget) / mb);
+		}
+
+		ImGui::End();
+	}
+}
+
+void ScrapEngine::Render::VulkanImGui::render_gpu_profiler_ui(const std::vector<GpuPassProfiler::zone_stats>& zones,
+                                                             const bool pipeline_statistics) const
+{
+	ImGui::SetNextWindowPos(ImVec2(10.0f, 180.0f), ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowBgAlpha(0.35f); // Transparent background
+
+	if (ImGui::Begin("Gpu Profiler", nullptr,
+	                 ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoNav))
+	{
+		ImGui::Text("%-12s %8s %8s %8s %8s", "Pass", "Last", "Min", "Avg", "Max");
+		ImGui::Separator();
+		for (const GpuPassProfiler::zone_stats& zone : zones)
+		{
+			if (!zone.available)
+			{
+				ImGui::Text("%-12s not recorded", zone.name);
+				continue;
+			}
+			ImGui::Text("%-12s %8.3f %8.3f %8.3f %8.3f", zone.name, zone.last_ms, zone.min_ms, zone.avg_ms,
+			            zone.max_ms);
+		}
+
+		if (pipeline_statistics)
+		{
+			ImGui::Separator();
+			ImGui::Text("%-12s %14s %14s", "Pass", "Vertices", "Fragments");
+			for (const GpuPassProfiler::zone_stats& zone : zones)
+			{
+				//The nested zones have only the timestamps
+				if (zone.vertex_invocations == 0 && zone.fragment_invocations == 0)
+				{
+					continue;
+				}
+				ImGui::Text("%-12s %14llu %14llu", zone.name,
+				            static_cast<unsigned long long>(zone.vertex_invocations),
+				            static_cast<unsigned long long>(zone.fragment_invocations));
+			}
+		}
+
+		ImGui::End();
+	}
+}
+
 ScrapEngine::Render::GuiDescriptorSet* ScrapEngine::Render::VulkanImGui::get_descriptor_set() const
 {
 	return descriptor_set_;
@@ -247,20 +421,15 @@ ScrapEngine::Render::GuiVulkanGraphicsPipeline* ScrapEngine::Render::VulkanImGui
 
 ScrapEngine::Render::GenericBuffer* ScrapEngine::Render::VulkanImGui::get_vertex_buffer() const
 {
-	return vertex_buffer_;
+	return vertex_buffers_[current_buffers_index_];
 }
 
 ScrapEngine::Render::GenericBuffer* ScrapEngine::Render::VulkanImGui::get_index_buffer() const
 {
-	return index_buffer_;
+	return index_buffers_[current_buffers_index_];
 }
 
 ScrapEngine::Render::VulkanImGui::PushConstBlock* ScrapEngine::Render::VulkanImGui::get_push_const_block()
 {
 	return &push_const_block_;
 }
-
-ScrapEngine::Render::BaseRenderPass* ScrapEngine::Render::VulkanImGui::get_render_pass() const
-{
-	return gui_render_pass_;
-}
@@ -1,7 +1,12 @@
 #pragma once
 
 #include <Engine/Rendering/VulkanInclude.h>
+#include <Engine/Rendering/RenderQueue/RenderQueue.h>
+#include <Engine/Rendering/DynamicResolution/DynamicResolution.h>
+#include <Engine/Rendering/Query/GpuPassProfiler.h>
+#include <Engine/Rendering/Memory/VulkanMemoryAllocator.h>
 #include <glm/vec2.hpp>
+#include <vector>
 
 namespace ScrapEngine
 {
@@ -9,12 +14,12 @@ namespace ScrapEngine
 	{
 		class VulkanSwapChain;
 		class GenericBuffer;
-		class BaseRenderPass;
 		class GuiVulkanGraphicsPipeline;
 		class GuiDescriptorSet;
 		class BaseDescriptorPool;
 		class TextureSampler;
 		class TextureImageView;
+		class BaseRenderPass;
 
 		class VulkanImGui
 		{
@@ -26,6 +31,9 @@ namespace ScrapEngine
 			};
 
 		private:
+			//Minimum size of a gui buffer, avoid small reallocations during the first frames
+			static const vk::DeviceSize min_buffer_size_ = 64 * 1024;
+
 			vk::Image font_image_;
 			VmaAllocation font_memory_;
 			TextureImageView* front_view_ = nullptr;
@@ -33,23 +41,37 @@ namespace ScrapEngine
 			BaseDescriptorPool* descriptor_pool_ = nullptr;
 			GuiDescriptorSet* descriptor_set_ = nullptr;
 			GuiVulkanGraphicsPipeline* pipeline_ = nullptr;
-			BaseRenderPass* gui_render_pass_ = nullptr;
 			//Buffers
-			//I need vectors because i need one for each command buffer (2 in total)
-			GenericBuffer* vertex_buffer_;
-			GenericBuffer* index_buffer_;
-			int32_t vertex_count_;
-			int32_t index_count_;
+			//Sets of vertex and index buffers, one for each gui command buffer
+			//So new gui data never overwrites data in use by the GPU
+			//They are persistently mapped and only grow, never shrink
+			std::vector<GenericBuffer*> vertex_buffers_;
+			std::vector<GenericBuffer*> index_buffers_;
+			//Buffers used by the last update_buffers() call
+			uint32_t current_buffers_index_ = 0;
 
 			PushConstBlock push_const_block_;
+
+			static void ensure_buffer_size(GenericBuffer* buffer, vk::DeviceSize required_size,
+			                               vk::BufferUsageFlagBits usage);
+			//FNV-1a step on 8 bytes at a time, the remaining bytes are hashed one by one
+			//Every changed word changes the hash, the multiply by an odd prime is invertible
+			static uint64_t hash_words(uint64_t hash, const void* data, size_t size);
 		public:
 			explicit VulkanImGui();
 			~VulkanImGui();
 
 			void init(float width, float height);
-			void init_resources(VulkanSwapChain* swap_chain);
+			//The gui is drawn in the given subpass, with the samples of its color attachment
+			void init_resources(VulkanSwapChain* swap_chain, uint32_t buffers_count, BaseRenderPass* render_pass,
+			                    uint32_t subpass, vk::SampleCountFlagBits samples);
+
+			//Copy the current draw data in the given buffers set
+			void update_buffers(uint32_t buffers_index);
 
-			void update_buffers();
+			//Hash of the current draw data (clip rects, element counts, textures, vertices and indices)
+			//If it doesn't change the gui can be drawn with the previous recording
+			uint64_t get_draw_data_hash() const;
 
 			void generate_empty_gui_frame() const;
 			void generate_loading_gui_frame() const;
@@ -57,13 +79,23 @@ namespace ScrapEngine
 			void post_gui_frame() const;
 
 			void loading_ui() const;
+			//Overlay with the draw calls and binds recorded by the render queue
+			//frame_allocations are the heap allocations of the last frame drawn by the render thread
+			void render_stats_ui(const RenderQueue::queue_stats& stats, bool depth_prepass,
+			                     const DynamicResolution::frame_stats& resolution_stats,
+			                     uint64_t frame_allocations,
+			                     const VulkanMemoryAllocator::memory_statistics& memory_stats,
+			                     bool defragmenting) const;
+			//Panel with the rolling gpu times of the passes
+			void render_gpu_profiler_ui(const std::vector<GpuPassProfiler::zone_stats>& zones,
+			                            bool pipeline_statistics) const;
 
 			GuiDescriptorSet* get_descriptor_set() const;
 			GuiVulkanGraphicsPipeline* get_pipeline() const;
+			//Return the buffers filled by the last update_buffers() call
 			GenericBuffer* get_vertex_buffer() const;
 			GenericBuffer* get_index_buffer() const;
 			PushConstBlock* get_push_const_block();
-			BaseRenderPass* get_render_pass() const;
 		};
 	}
 }
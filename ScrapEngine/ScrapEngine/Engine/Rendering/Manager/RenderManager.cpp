@@ -1,5 +1,6 @@
 #include <Engine/Rendering/Manager/RenderManager.h>
 #include <Engine/Debug/DebugLog.h>
+#include <Engine/Debug/CpuProfiler.h>
 #include <Engine/Rendering/Queue/GraphicsQueue/GraphicsQueue.h>
 #include <Engine/Rendering/Queue/PresentationQueue/PresentQueue.h>
 #include <Engine/Rendering/Model/ObjectPool/VulkanModelBuffersPool/VulkanModelBuffersPool.h>
@@ -11,7 +12,14 @@
 #include <Engine/Rendering/RenderPass/StandardRenderPass/StandardRenderPass.h>
 #include <Engine/Rendering/Buffer/CommandBuffer/StandardCommandBuffer/StandardCommandBuffer.h>
 #include <Engine/Rendering/Buffer/CommandBuffer/GuiCommandBuffer/GuiCommandBuffer.h>
+#include <Engine/Rendering/Buffer/CommandBuffer/FrameCommandBuffer/FrameCommandBuffer.h>
 #include <Engine/Rendering/Buffer/FrameBuffer/StandardFrameBuffer/StandardFrameBuffer.h>
+#include <Engine/Rendering/Buffer/FrameBuffer/GuiFrameBuffer/GuiFrameBuffer.h>
+#include <Engine/Rendering/RenderPass/GuiRenderPass/GuiRenderPass.h>
+#include <Engine/Rendering/Query/GpuPassProfiler.h>
+#include <Engine/Rendering/DynamicResolution/DynamicResolution.h>
+#include <Engine/Rendering/TemporalUpscaling/TemporalUpscaler.h>
+#include <Engine/Rendering/TemporalUpscaling/TemporalImageCheck.h>
 #include <Engine/Rendering/Window/GameWindow.h>
 #include <Engine/Rendering/Window/VulkanSurface.h>
 #include <Engine/Rendering/Instance/VukanInstance.h>
@@ -21,6 +29,7 @@
 #include <Engine/Rendering/Buffer/FrameBuffer/BaseFrameBuffer.h>
 #include <Engine/Rendering/CommandPool/VulkanCommandPool.h>
 #include <Engine/Rendering/Semaphores/VulkanSemaphoresManager.h>
+#include <Engine/Rendering/Semaphores/VulkanFrameTimeline.h>
 #include <Engine/Rendering/DepthResources/VulkanDepthResources.h>
 #include <Engine/Rendering/Texture/ColorResources/VulkanColorResources.h>
 #include <Engine/Rendering/Model/MeshInstance/VulkanMeshInstance.h>
@@ -29,95 +38,110 @@
 #include <Engine/Rendering/Shadowmapping/Standard/StandardShadowmapping.h>
 #include <Engine/Rendering/Camera/Camera.h>
 #include <Engine/Rendering/Model/Material/BasicMaterial.h>
+#include <Engine/Rendering/Memory/VulkanMemoryAllocator.h>
+#include <Engine/Rendering/Memory/VulkanDeletionQueue.h>
+#include <Engine/Rendering/Memory/FrameArena.h>
+#include <Engine/Debug/AllocationCounter.h>
+#include <Engine/Rendering/RenderGraph/RenderGraph.h>
+#include <Engine/Rendering/Buffer/FrameBuffer/ShadowmappingFrameBuffer/ShadowmappingFrameBuffer.h>
+#include <Engine/Rendering/Buffer/FrameBuffer/ShadowmappingFrameBuffer/ShadowmappingFrameBufferAttachment.h>
+#include <Engine/Rendering/Model/StaticBatch/StaticBatcher.h>
+#include <Engine/Rendering/RenderWorld/RenderWorld.h>
+#include <Engine/Rendering/RenderWorld/SceneChangeQueue.h>
+#include <algorithm>
+#include <unordered_set>
 
 void ScrapEngine::Render::RenderManager::ParallelCommandBufferCreation::ExecuteRange(enki::TaskSetPartition range,
                                                                                      uint32_t threadnum)
 {
-	if (owner->waiting_fence_)
-	{
-		const vk::Result result = VulkanDevice::get_instance()->get_logical_device()
-		                                                      ->waitForFences(
-			                                                      1, owner->waiting_fence_, true,
-			                                                      std::numeric_limits<uint64_t>::max());
-		if (result == vk::Result::eSuccess)
-		{
-			owner->waiting_fence_ = nullptr;
-		}
-		else if (result == vk::Result::eTimeout)
-		{
-			Debug::DebugLog::fatal_error(result, "[ParallelCommandBufferCreation] Fence timeout");
-		}
-		else
-		{
-			Debug::DebugLog::fatal_error(
-				result, "[ParallelCommandBufferCreation] An error occurred while waiting a fence...");
-		}
-	}
+	SCRAP_PROFILE_SCOPE("command_buffer_creation");
+	//The task is started only when the gpu is not using the command buffer anymore, no need to wait
 	owner->create_command_buffer(flip_flop);
 }
 
 void ScrapEngine::Render::RenderManager::ParallelGuiCommandBufferCreation::ExecuteRange(enki::TaskSetPartition range,
                                                                                         uint32_t threadnum)
 {
-	if (owner->gui_waiting_fence_)
-	{
-		const vk::Result result = VulkanDevice::get_instance()->get_logical_device()
-		                                                      ->waitForFences(1, owner->gui_waiting_fence_,
-		                                                                      true,
-		                                                                      std::numeric_limits<uint64_t>::max());
-		if (result == vk::Result::eSuccess)
-		{
-			owner->gui_waiting_fence_ = nullptr;
-		}
-		else if (result == vk::Result::eTimeout)
-		{
-			Debug::DebugLog::fatal_error(result, "[ParallelGuiCommandBufferCreation] Fence timeout");
-		}
-		else
-		{
-			Debug::DebugLog::fatal_error(
-				result, "[ParallelGuiCommandBufferCreation] An error occurred while waiting a fence...");
-		}
-	}
-	owner->rebuild_gui_command_buffer();
+	SCRAP_PROFILE_SCOPE("gui_command_buffer_creation");
+	//The task is started only when the gpu is not using the command buffer anymore, no need to wait
+	owner->rebuild_gui_command_buffer(index);
 }
 
-void ScrapEngine::Render::RenderManager::ParallelMeshCleanup::ExecuteRange(enki::TaskSetPartition range,
-                                                                           uint32_t threadnum)
+void ScrapEngine::Render::RenderManager::ParallelFrameRender::Execute()
 {
-	owner->cleanup_meshes();
+	SCRAP_PROFILE_SCOPE("frame_render");
+	owner->draw_frame();
+}
+
+void ScrapEngine::Render::RenderManager::ParallelMeshFileReading::ExecuteRange(enki::TaskSetPartition range,
+                                                                               uint32_t threadnum)
+{
+	SCRAP_PROFILE_SCOPE("mesh_file_reading");
+	//Only the files, the pools and the device are used by the sync that loads the meshes
+	for (uint32_t i = range.start; i < range.end; i++)
+	{
+		owner->meshes_reading_[i]->read_files();
+	}
 }
 
-ScrapEngine::Render::RenderManager::RenderManager(const game_base_info* received_base_game_info)
+ScrapEngine::Render::RenderManager::RenderManager(const game_base_info* received_base_game_info,
+                                                  enki::TaskScheduler* task_scheduler)
+	: task_scheduler_(task_scheduler)
 {
 	game_window_ = new GameWindow(received_base_game_info->window_width,
 	                              received_base_game_info->window_height,
 	                              received_base_game_info->app_name);
 	Debug::DebugLog::print_to_console_log("GameWindow created");
 	initialize_vulkan(received_base_game_info);
-	Debug::DebugLog::print_to_console_log("Creating scheduler...");
-	initialize_scheduler();
 }
 
 ScrapEngine::Render::RenderManager::~RenderManager()
 {
 	Debug::DebugLog::print_to_console_log("Deleting ~RenderManager");
+	//The device is idle, the retired meshes can release their materials
+	VulkanDeletionQueue::get_instance()->flush();
+	//Buffers and copies of an unfinished defragmentation step
+	for (VulkanMemoryAllocator::moved_buffer& buffer : defragmentation_old_buffers_)
+	{
+		VulkanMemoryAllocator::get_instance()->destroy_buffer(buffer.buffer, buffer.allocation);
+	}
+	if (defragmentation_command_buffer_)
+	{
+		free_defragmentation_command_buffer();
+	}
 	//Delete queues
 	delete_queues();
 	//Delete swap chain
 	cleanup_swap_chain();
 	delete render_camera_;
+	delete render_thread_camera_;
+	delete frame_arena_;
+	delete render_world_;
+	delete scene_changes_;
+	delete frame_render_task_;
+	//The meshes being read are deleted with the others
+	task_scheduler_->WaitforTask(mesh_file_task_);
+	delete mesh_file_task_;
 	delete skybox_;
+	for (VulkanSkyboxInstance* skybox : retired_skyboxes_)
+	{
+		delete skybox;
+	}
 	for (auto current_model : loaded_models_)
 	{
 		delete current_model;
 	}
+	delete_gui_command_buffers();
 	delete gui_render_;
 	VulkanModelBuffersPool::get_instance()->clear_memory();
 	VulkanModelPool::get_instance()->clear_memory();
 	VulkanSimpleMaterialPool::get_instance()->clear_memory();
+	//The pools retire their resources too
+	VulkanDeletionQueue::get_instance()->flush();
+	delete dynamic_resolution_;
+	delete gpu_pass_profiler_;
+	delete frame_timeline_;
 	delete vulkan_render_semaphores_;
-	delete gui_buffer_command_pool_;
 	delete singleton_command_pool_;
 	delete vulkan_render_device_;
 	delete vulkan_window_surface_;
@@ -129,17 +153,24 @@ ScrapEngine::Render::RenderManager::~RenderManager()
 void ScrapEngine::Render::RenderManager::cleanup_swap_chain()
 {
 	Debug::DebugLog::print_to_console_log("---cleanupSwapChain()---");
-	//First stop the scheduler
-	if (g_TS.GetNumTaskThreads() != 0 || g_TS.GetThreadNum() != 0)
-	{
-		Debug::DebugLog::print_to_console_log("Threads > 0, shutting down scheduler...");
-		g_TS.WaitforAllAndShutdown();
-	}
+	//First wait the background tasks, the scheduler is shut down by the EngineManager
+	task_scheduler_->WaitforAll();
 	//Delete all the other stuff
+	//The scene framebuffer uses the scene color of the render graph
+	delete vulkan_render_frame_buffer_;
+	vulkan_render_frame_buffer_ = nullptr;
+	delete temporal_upscaler_;
+	temporal_upscaler_ = nullptr;
+	delete render_graph_;
+	render_graph_ = nullptr;
 	delete vulkan_render_color_;
+	vulkan_render_color_ = nullptr;
 	delete vulkan_render_depth_;
-	delete vulkan_render_frame_buffer_;
+	delete vulkan_gui_frame_buffer_;
 	delete_command_buffers();
+	//The batches share the pipelines of the meshes materials
+	delete static_batcher_;
+	static_batcher_ = nullptr;
 	for (auto& loaded_model : loaded_models_)
 	{
 		for (auto model_material : (*loaded_model->get_mesh_materials()))
@@ -149,6 +180,10 @@ void ScrapEngine::Render::RenderManager::cleanup_swap_chain()
 	}
 	ShaderManager::get_instance()->cleanup_shaders();
 	delete StandardRenderPass::get_instance();
+	if (scaled_scene_)
+	{
+		delete GuiRenderPass::get_instance();
+	}
 	delete vulkan_render_image_view_;
 	delete vulkan_render_swap_chain_;
 	//Delete shadowmapping stuff
@@ -169,9 +204,210 @@ void ScrapEngine::Render::RenderManager::delete_command_buffers() const
 		cb.command_buffer->free_command_buffers();
 		delete cb.command_buffer;
 		delete cb.command_pool;
+		delete cb.camera;
+	}
+	delete frame_command_buffer_;
+	delete frame_command_pool_;
+}
+
+void ScrapEngine::Render::RenderManager::create_render_graph()
+{
+	SCRAP_PROFILE_FUNCTION();
+	render_graph_ = new RenderGraph();
+	//Imported resources
+	const RenderGraph::resource_handle shadow_map = render_graph_->import_image(
+		"shadow_map", shadowmapping_->get_offscreen_frame_buffer()->get_depth_attachment()->get_image(),
+		vk::ImageAspectFlagBits::eDepth, vk::ImageLayout::eUndefined);
+	const RenderGraph::resource_handle backbuffer = render_graph_->import_image(
+		"backbuffer", vulkan_render_swap_chain_->get_swap_chain_images_vector(),
+		vk::ImageAspectFlagBits::eColor, vk::ImageLayout::eUndefined, vk::ImageLayout::ePresentSrcKHR);
+	render_graph_->mark_output(backbuffer);
+	//Shadow map pass, the meshes are recorded in the secondary command buffers of the standard command buffer
+	const RenderGraph::pass_handle shadow_pass = render_graph_->add_pass(
+		"shadow_map", [this](const RenderGraph::pass_context& context)
+		{
+			const StandardCommandBuffer* standard_command_buffer = command_buffers_[command_buffer_flip_flop_].
+				command_buffer;
+			frame_command_buffer_->execute_shadow_pass(
+				context.frame_index, shadowmapping_,
+				(*standard_command_buffer->get_command_buffers_vector())[context.frame_index]);
+		});
+	//The offscreen render pass dependencies already make the depth readable by the fragment shader
+	render_graph_->add_write(shadow_pass, shadow_map, RenderGraph::resource_usage::depth_attachment, true,
+	                         vk::ImageLayout::eDepthStencilReadOnlyOptimal);
+	const vk::Extent2D swap_chain_extent = vulkan_render_swap_chain_->get_swap_chain_extent();
+	if (!scaled_scene_)
+	{
+		//Scene and gui subpasses in the acquired swap chain image
+		const RenderGraph::pass_handle standard_pass = render_graph_->add_pass(
+			"standard", [this](const RenderGraph::pass_context& context)
+			{
+				const threaded_command_buffer& standard_command_buffer = command_buffers_[command_buffer_flip_flop_];
+				const GuiCommandBuffer* gui_command_buffer = gui_command_buffers_[gui_command_buffer_index_].
+					command_buffer;
+				frame_command_buffer_->execute_scene_pass(
+					context.frame_index,
+					(*vulkan_render_frame_buffer_->get_framebuffers_vector())[context.image_index],
+					standard_command_buffer.render_extent,
+					(*standard_command_buffer.command_buffer->get_scene_command_buffers_vector())[context.frame_index],
+					(*gui_command_buffer->get_command_buffers_vector())[context.frame_index]);
+			});
+		render_graph_->add_read(standard_pass, shadow_map, RenderGraph::resource_usage::depth_read, true);
+		render_graph_->add_write(standard_pass, backbuffer, RenderGraph::resource_usage::color_attachment, true,
+		                         vk::ImageLayout::ePresentSrcKHR);
+		render_graph_->compile();
+		vulkan_render_frame_buffer_ = new StandardFrameBuffer(&swap_chain_extent,
+		                                                      *vulkan_render_image_view_->
+		                                                      get_swap_chain_image_views_vector(),
+		                                                      vulkan_render_depth_->get_depth_image_view(),
+		                                                      vulkan_render_color_
+			                                                      ? vulkan_render_color_->get_color_image_view()
+			                                                      : nullptr);
+		return;
+	}
+	//Scene drawn offscreen, with dynamic resolution only a part of it is used
+	RenderGraph::image_description scene_color_description;
+	scene_color_description.format = vulkan_render_swap_chain_->get_swap_chain_image_format();
+	scene_color_description.extent = swap_chain_extent;
+	scene_color_description.usage = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc;
+	if (temporal_upscaling_enabled_)
+	{
+		scene_color_description.usage |= vk::ImageUsageFlagBits::eSampled;
+	}
+	const RenderGraph::resource_handle scene_color = render_graph_->create_transient_image(
+		"scene_color", scene_color_description);
+	//Velocity of the meshes, written with the scene color for the temporal resolve
+	const bool velocity_enabled = StandardRenderPass::get_instance()->has_velocity();
+	RenderGraph::resource_handle velocity = 0;
+	if (velocity_enabled)
+	{
+		RenderGraph::image_description velocity_description;
+		velocity_description.format = StandardRenderPass::velocity_format;
+		velocity_description.extent = swap_chain_extent;
+		velocity_description.usage = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eSampled;
+		velocity = render_graph_->create_transient_image("velocity", velocity_description);
+	}
+	//Scene pass, only the render extent of the current command buffer is drawn
+	const RenderGraph::pass_handle scene_pass = render_graph_->add_pass(
+		"scene", [this](const RenderGraph::pass_context& context)
+		{
+			const threaded_command_buffer& standard_command_buffer = command_buffers_[command_buffer_flip_flop_];
+			frame_command_buffer_->execute_scene_pass(
+				context.frame_index,
+				(*vulkan_render_frame_buffer_->get_framebuffers_vector())[0],
+				standard_command_buffer.render_extent,
+				(*standard_command_buffer.command_buffer->get_scene_command_buffers_vector())[context.frame_index]);
+		});
+	render_graph_->add_read(scene_pass, shadow_map, RenderGraph::resource_usage::depth_read, true);
+	//The render pass leaves the scene color (and the depth) ready for the pass that reads it
+	render_graph_->add_write(scene_pass, scene_color, RenderGraph::resource_usage::color_attachment, true,
+	                         temporal_upscaling_enabled_
+		                         ? vk::ImageLayout::eShaderReadOnlyOptimal
+		                         : vk::ImageLayout::eTransferSrcOptimal);
+	if (velocity_enabled)
+	{
+		render_graph_->add_write(scene_pass, velocity, RenderGraph::resource_usage::color_attachment, true,
+		                         vk::ImageLayout::eShaderReadOnlyOptimal);
+	}
+	if (temporal_upscaling_enabled_)
+	{
+		//Accumulate the jittered scene in the history and copy it to the acquired swap chain image
+		const RenderGraph::pass_handle resolve_pass = render_graph_->add_pass(
+			"temporal_resolve", [this](const RenderGraph::pass_context& context)
+			{
+				frame_command_buffer_->execute_temporal_resolve(
+					context.frame_index,
+					temporal_upscaler_,
+					(*vulkan_render_swap_chain_->get_swap_chain_images_vector())[context.image_index],
+					command_buffers_[command_buffer_flip_flop_].render_extent);
+			});
+		render_graph_->add_read(resolve_pass, scene_color, RenderGraph::resource_usage::sampled);
+		if (velocity_enabled)
+		{
+			render_graph_->add_read(resolve_pass, velocity, RenderGraph::resource_usage::sampled);
+		}
+		render_graph_->add_write(resolve_pass, backbuffer, RenderGraph::resource_usage::transfer_dst);
+	}
+	else
+	{
+		//Scale the scene to the acquired swap chain image
+		const RenderGraph::pass_handle upscale_pass = render_graph_->add_pass(
+			"upscale", [this, scene_color](const RenderGraph::pass_context& context)
+			{
+				frame_command_buffer_->execute_upscale(
+					context.frame_index,
+					render_graph_->get_transient_image(scene_color),
+					command_buffers_[command_buffer_flip_flop_].render_extent,
+					(*vulkan_render_swap_chain_->get_swap_chain_images_vector())[context.image_index],
+					vulkan_render_swap_chain_->get_swap_chain_extent());
+			});
+		render_graph_->add_read(upscale_pass, scene_color, RenderGraph::resource_usage::transfer_src);
+		render_graph_->add_write(upscale_pass, backbuffer, RenderGraph::resource_usage::transfer_dst);
+	}
+	//Gui at full resolution over the upscaled scene
+	const RenderGraph::pass_handle gui_pass = render_graph_->add_pass(
+		"gui", [this](const RenderGraph::pass_context& context)
+		{
+			const GuiCommandBuffer* gui_command_buffer = gui_command_buffers_[gui_command_buffer_index_].
+				command_buffer;
+			frame_command_buffer_->execute_gui_pass(
+				context.frame_index,
+				(*vulkan_gui_frame_buffer_->get_framebuffers_vector())[context.image_index],
+				vulkan_render_swap_chain_->get_swap_chain_extent(),
+				(*gui_command_buffer->get_command_buffers_vector())[context.frame_index]);
+		});
+	render_graph_->add_write(gui_pass, backbuffer, RenderGraph::resource_usage::color_attachment, true,
+	                         vk::ImageLayout::ePresentSrcKHR);
+	render_graph_->compile();
+	//The scene framebuffer uses the scene color (and the velocity) allocated by the graph
+	vk::ImageView velocity_view;
+	if (velocity_enabled)
+	{
+		velocity_view = render_graph_->get_transient_image_view(velocity);
+	}
+	vulkan_render_frame_buffer_ = new StandardFrameBuffer(&swap_chain_extent,
+	                                                      {render_graph_->get_transient_image_view(scene_color)},
+	                                                      vulkan_render_depth_->get_depth_image_view(),
+	                                                      vulkan_render_color_
+		                                                      ? vulkan_render_color_->get_color_image_view()
+		                                                      : nullptr,
+	                                                      &velocity_view);
+	if (temporal_upscaling_enabled_)
+	{
+		TemporalUpscaler::settings upscaler_settings;
+		upscaler_settings.render_scale = temporal_upscaling_scale_;
+		temporal_upscaler_ = new TemporalUpscaler(upscaler_settings, swap_chain_extent,
+		                                          render_graph_->get_transient_image_view(scene_color),
+		                                          vulkan_render_depth_->get_depth_image_view(), velocity_view);
+		Debug::DebugLog::print_to_console_log("TemporalUpscaler created");
 	}
 }
 
+vk::CommandBuffer ScrapEngine::Render::RenderManager::record_frame_command_buffer()
+{
+	SCRAP_PROFILE_FUNCTION();
+	const uint32_t frame_index = static_cast<uint32_t>(current_frame_);
+	const vk::CommandBuffer command_buffer = frame_command_buffer_->begin_frame(frame_index);
+	//The pass zones are written by the secondary command buffers, their queries are reset before the passes
+	gpu_pass_profiler_->reset(command_buffer, frame_index);
+	gpu_pass_profiler_->begin_zone(command_buffer, frame_index, GpuPassProfiler::pass_zone::frame);
+	//The graph executes the passes in order with the barriers between them
+	render_graph_->execute({command_buffer, frame_index, image_index_, frame_arena_});
+	gpu_pass_profiler_->end_zone(command_buffer, frame_index, GpuPassProfiler::pass_zone::frame);
+	frame_command_buffer_->end_frame(frame_index);
+	return command_buffer;
+}
+
+void ScrapEngine::Render::RenderManager::submit_frame(const vk::SubmitInfo& submit_info)
+{
+	SCRAP_PROFILE_FUNCTION();
+	const uint64_t frame_value = frame_timeline_->submit(*vulkan_graphics_queue_->get_queue(), submit_info,
+	                                                     static_cast<uint32_t>(current_frame_));
+	//The command buffers cannot be recorded again until this frame is completed
+	command_buffers_[command_buffer_flip_flop_].last_frame_value = frame_value;
+	gui_command_buffers_[gui_command_buffer_index_].last_frame_value = frame_value;
+}
+
 ScrapEngine::Render::GameWindow* ScrapEngine::Render::RenderManager::get_game_window() const
 {
 	return game_window_;
@@ -182,6 +418,21 @@ ScrapEngine::Render::StandardShadowmapping* ScrapEngine::Render::RenderManager::
 	return shadowmapping_;
 }
 
+ScrapEngine::Render::DynamicResolution* ScrapEngine::Render::RenderManager::get_dynamic_resolution() const
+{
+	return dynamic_resolution_;
+}
+
+ScrapEngine::Render::GpuPassProfiler* ScrapEngine::Render::RenderManager::get_gpu_pass_profiler() const
+{
+	return gpu_pass_profiler_;
+}
+
+ScrapEngine::Render::TemporalUpscaler* ScrapEngine::Render::RenderManager::get_temporal_upscaler() const
+{
+	return temporal_upscaler_;
+}
+
 ScrapEngine::Render::Camera* ScrapEngine::Render::RenderManager::get_render_camera() const
 {
 	return render_camera_;
@@ -192,10 +443,17 @@ ScrapEngine::Render::Camera* ScrapEngine::Render::RenderManager::get_default_ren
 	return default_camera_;
 }
 
+ScrapEngine::Render::RenderWorld* ScrapEngine::Render::RenderManager::get_render_world() const
+{
+	return render_world_;
+}
+
 void ScrapEngine::Render::RenderManager::set_render_camera(Camera* new_camera)
 {
 	render_camera_ = new_camera;
 	render_camera_->set_swap_chain_extent(vulkan_render_swap_chain_->get_swap_chain_extent());
+	//The render thread resets the temporal history when it gets the new camera
+	render_world_->set_camera_changed();
 }
 
 void ScrapEngine::Render::RenderManager::pre_gui_render() const
@@ -205,14 +463,62 @@ void ScrapEngine::Render::RenderManager::pre_gui_render() const
 
 void ScrapEngine::Render::RenderManager::post_gui_render()
 {
+	if (show_render_stats_)
+	{
+		gui_render_->render_stats_ui(command_buffers_[command_buffer_flip_flop_].command_buffer->
+		                             get_render_queue_stats(), depth_prepass_enabled_,
+		                             dynamic_resolution_->get_stats(
+			                             vulkan_render_swap_chain_->get_swap_chain_extent()),
+		                             frame_allocations_.load(std::memory_order_relaxed),
+		                             memory_statistics_, defragmentation_running_);
+	}
+	if (show_gpu_pass_profiler_ && gpu_pass_profiler_->is_enabled())
+	{
+		gui_render_->render_gpu_profiler_ui(gpu_pass_profiler_->get_stats(),
+		                                    gpu_pass_profiler_->is_statistics_enabled());
+	}
 	gui_render_->post_gui_frame();
-	//Start to rebuild the command buffer in background
-	g_TS.AddTaskSetToPipe(gui_command_buffer_task_);
+	//If the gui didn't change the current command buffer can be used again
+	const uint64_t draw_data_hash = gui_render_->get_draw_data_hash();
+	if (draw_data_hash == gui_command_buffers_[gui_command_buffer_index_].draw_data_hash)
+	{
+		return;
+	}
+	//Start to rebuild the other command buffer in background
+	const uint16_t next_index = static_cast<uint16_t>((gui_command_buffer_index_ + 1) % gui_command_buffers_.size());
+	//If the gpu is still using it, try again the next frame instead of waiting
+	if (!frame_timeline_->is_completed(gui_command_buffers_[next_index].last_frame_value))
+	{
+		return;
+	}
+	gui_command_buffers_[next_index].draw_data_hash = draw_data_hash;
+	gui_command_buffer_task_->index = next_index;
+	gui_command_buffer_rebuilding_ = true;
+	task_scheduler_->AddTaskSetToPipe(gui_command_buffer_task_);
+}
+
+void ScrapEngine::Render::RenderManager::set_show_render_stats(const bool show)
+{
+	show_render_stats_ = show;
 }
 
 void ScrapEngine::Render::RenderManager::initialize_vulkan(const game_base_info* received_base_game_info)
 {
+	SCRAP_PROFILE_FUNCTION();
 	Debug::DebugLog::print_to_console_log("---initializeVulkan()---");
+	depth_prepass_enabled_ = received_base_game_info->depth_prepass;
+	show_render_stats_ = received_base_game_info->show_render_stats;
+	temporal_upscaling_scale_ = received_base_game_info->temporal_upscaling_scale;
+	temporal_check_frame_ = received_base_game_info->temporal_upscaling_check_frame;
+	temporal_upscaling_enabled_ = received_base_game_info->temporal_upscaling;
+	if (temporal_upscaling_enabled_ && !TemporalUpscaler::is_supported())
+	{
+		Debug::DebugLog::print_to_console_log(
+			"[RenderManager] Temporal resolve shaders not found, using the plain upscale");
+		temporal_upscaling_enabled_ = false;
+	}
+	//At full resolution the scene and the gui are drawn directly in the swap chain image
+	scaled_scene_ = temporal_upscaling_enabled_ || received_base_game_info->dynamic_resolution;
 	vulkan_instance_ = VukanInstance::get_instance();
 	vulkan_instance_->init(received_base_game_info->app_name, received_base_game_info->app_version,
 	                       "ScrapEngine");
@@ -221,51 +527,98 @@ void ScrapEngine::Render::RenderManager::initialize_vulkan(const game_base_info*
 	vulkan_window_surface_->init(game_window_);
 	Debug::DebugLog::print_to_console_log("VulkanWindowSurface created");
 	vulkan_render_device_ = VulkanDevice::get_instance();
-	vulkan_render_device_->init(vulkan_window_surface_->get_surface());
+	//The temporal resolve already antialiases the scene, msaa would only add cost
+	vulkan_render_device_->init(vulkan_window_surface_->get_surface(),
+	                            temporal_upscaling_enabled_ ? 1 : received_base_game_info->msaa_samples);
 	Debug::DebugLog::print_to_console_log("VulkanRenderDevice created");
+	Debug::DebugLog::print_to_console_log(
+		"Using msaa samples:" + std::to_string(static_cast<uint32_t>(vulkan_render_device_->get_msaa_samples())));
 	create_queues();
 	vulkan_render_swap_chain_ = new VulkanSwapChain(
 		vulkan_render_device_->query_swap_chain_support(vulkan_render_device_->get_physical_device()),
 		vulkan_render_device_->get_cached_queue_family_indices(),
-		vulkan_window_surface_->get_surface(), received_base_game_info->window_width,
-		received_base_game_info->window_height, received_base_game_info->vsync);
+		vulkan_window_surface_->get_surface(), received_base_game_info);
 	image_count_ = vulkan_render_swap_chain_->get_image_count();
 	Debug::DebugLog::print_to_console_log("Using image_count:" + std::to_string(image_count_));
+	max_frames_in_flight_ = vulkan_render_swap_chain_->get_frames_in_flight();
+	Debug::DebugLog::print_to_console_log("Using max_frames_in_flight:" + std::to_string(max_frames_in_flight_));
 	Debug::DebugLog::print_to_console_log("VulkanSwapChain created");
 	vulkan_render_image_view_ = new VulkanImageView(vulkan_render_swap_chain_);
 	Debug::DebugLog::print_to_console_log("VulkanImageView created");
+	//Gpu time of the frames and the passes, the frame time is used to choose the scene resolution
+	gpu_pass_profiler_ = new GpuPassProfiler(max_frames_in_flight_,
+	                                         received_base_game_info->gpu_pass_profiler &&
+	                                         received_base_game_info->gpu_pass_profiler_statistics,
+	                                         task_scheduler_);
+	gpu_pass_profiler_->set_csv_output(received_base_game_info->gpu_pass_profiler_csv_path);
+	show_gpu_pass_profiler_ = received_base_game_info->gpu_pass_profiler;
+	Debug::DebugLog::print_to_console_log("GpuPassProfiler created");
+	DynamicResolution::settings resolution_settings;
+	resolution_settings.min_scale = received_base_game_info->dynamic_resolution_min_scale;
+	resolution_settings.max_scale = received_base_game_info->dynamic_resolution_max_scale;
+	resolution_settings.target_frame_time_ms = received_base_game_info->dynamic_resolution_target_ms;
+	dynamic_resolution_ = new DynamicResolution(resolution_settings, received_base_game_info->dynamic_resolution);
+	dynamic_resolution_->set_timer_available(gpu_pass_profiler_->is_enabled());
 	//Standard
 	StandardRenderPass* vulkan_rendering_pass = StandardRenderPass::get_instance();
+	StandardRenderPass::scene_output scene_output = StandardRenderPass::scene_output::swap_chain;
+	if (scaled_scene_)
+	{
+		scene_output = temporal_upscaling_enabled_
+			               ? StandardRenderPass::scene_output::sampled
+			               : StandardRenderPass::scene_output::transfer_source;
+	}
 	vulkan_rendering_pass->init(vulkan_render_swap_chain_->get_swap_chain_image_format(),
-	                            vulkan_render_device_->get_msaa_samples());
+	                            vulkan_render_device_->get_msaa_samples(), scene_output);
+	//The gui has its own render pass only when it's drawn after the upscale
+	if (scaled_scene_)
+	{
+		GuiRenderPass::get_instance()->init(vulkan_render_swap_chain_->get_swap_chain_image_format());
+	}
 	Debug::DebugLog::print_to_console_log("VulkanRenderPass created");
 	//Create command pools
 	//Main command pool used to generate resources
 	singleton_command_pool_ = SingletonCommandPool::get_instance();
 	singleton_command_pool_->init(vulkan_render_device_->get_cached_queue_family_indices(),
 	                              vk::CommandPoolCreateFlagBits::eTransient);
-	//Command pool for the GUI-CommandBuffer
-	gui_buffer_command_pool_ = new StandardCommandPool();
-	gui_buffer_command_pool_->init(vulkan_render_device_->get_cached_queue_family_indices());
 	Debug::DebugLog::print_to_console_log("VulkanCommandPool created");
-	vulkan_render_color_ = new VulkanColorResources(vulkan_render_device_->get_msaa_samples(),
-	                                                vulkan_render_swap_chain_);
-	Debug::DebugLog::print_to_console_log("VulkanRenderColor created");
+	//Without msaa the scene is drawn directly in the scene color
+	if (vulkan_rendering_pass->is_msaa_enabled())
+	{
+		vulkan_render_color_ = new VulkanColorResources(vulkan_render_device_->get_msaa_samples(),
+		                                                vulkan_render_swap_chain_);
+		Debug::DebugLog::print_to_console_log("VulkanRenderColor created");
+	}
 	const vk::Extent2D swap_chain_extent = vulkan_render_swap_chain_->get_swap_chain_extent();
 	vulkan_render_depth_ = new VulkanDepthResources(&swap_chain_extent,
-	                                                vulkan_render_device_->get_msaa_samples());
+	                                                vulkan_render_device_->get_msaa_samples(),
+	                                                temporal_upscaling_enabled_);
 	Debug::DebugLog::print_to_console_log("VulkanDepthResources created");
-	vulkan_render_frame_buffer_ = new StandardFrameBuffer(vulkan_render_image_view_,
-	                                                      &swap_chain_extent,
-	                                                      vulkan_render_depth_->get_depth_image_view(),
-	                                                      vulkan_render_color_->get_color_image_view());
-	Debug::DebugLog::print_to_console_log("VulkanFrameBuffer created");
+	//The scene framebuffer is created with the render graph, it can use the scene color allocated by the graph
+	if (scaled_scene_)
+	{
+		vulkan_gui_frame_buffer_ = new GuiFrameBuffer(vulkan_render_image_view_, &swap_chain_extent);
+		Debug::DebugLog::print_to_console_log("VulkanFrameBuffer created");
+	}
 	create_camera();
 	Debug::DebugLog::print_to_console_log("User View Camera created");
 	//Shadowmapping
 	Debug::DebugLog::print_to_console_log("Creating StandardShadowmapping...");
 	shadowmapping_ = new StandardShadowmapping(vulkan_render_swap_chain_);
 	Debug::DebugLog::print_to_console_log("StandardShadowmapping initialized!");
+	//Render state shared between the game thread and the render thread
+	render_world_ = new RenderWorld(shadowmapping_);
+	frame_arena_ = new FrameArena(64 * 1024);
+	scene_changes_ = new SceneChangeQueue();
+	mesh_file_task_ = new ParallelMeshFileReading();
+	mesh_file_task_->owner = this;
+	//Background reading, after the game and render tasks
+	mesh_file_task_->m_Priority = enki::TASK_PRIORITY_LOW;
+	frame_render_task_ = new ParallelFrameRender();
+	frame_render_task_->owner = this;
+	//The last worker acts as render thread, without workers the main thread draws while waiting
+	frame_render_task_->threadNum = task_scheduler_->GetNumTaskThreads() - 1;
+	Debug::DebugLog::print_to_console_log("RenderWorld created");
 	//Gui render
 	Debug::DebugLog::print_to_console_log("Creating gui render...");
 	initialize_gui(static_cast<float>(received_base_game_info->window_width),
@@ -276,35 +629,46 @@ void ScrapEngine::Render::RenderManager::initialize_vulkan(const game_base_info*
 	//Init objects and tasks
 	initialize_command_buffers();
 	initialize_gui_command_buffers();
-	//Create mesh cleanup task
-	mesh_cleanup_task_ = new ParallelMeshCleanup();
-	mesh_cleanup_task_->owner = this;
 	//Create empty command buffers
+	latch_render_extent(false);
+	latch_render_scene(false);
 	create_command_buffer(false);
-	rebuild_gui_command_buffer(false);
+	gui_command_buffers_[0].draw_data_hash = gui_render_->get_draw_data_hash();
+	rebuild_gui_command_buffer(0);
 	Debug::DebugLog::print_to_console_log("Command buffers created!");
 	//Vulkan Semaphores
-	vulkan_render_semaphores_ = new VulkanSemaphoresManager(image_count_);
+	vulkan_render_semaphores_ = new VulkanSemaphoresManager(max_frames_in_flight_);
 	image_available_semaphores_ref_ = vulkan_render_semaphores_->get_image_available_semaphores_vector();
 	render_finished_semaphores_ref_ = vulkan_render_semaphores_->get_render_finished_semaphores_vector();
 	in_flight_fences_ref_ = vulkan_render_semaphores_->get_in_flight_fences_vector();
 	Debug::DebugLog::print_to_console_log("VulkanSemaphoresManager created");
+	frame_timeline_ = new VulkanFrameTimeline(in_flight_fences_ref_);
+	VulkanDeletionQueue::get_instance()->init(frame_timeline_);
+	Debug::DebugLog::print_to_console_log("VulkanFrameTimeline created");
+	create_render_graph();
+	Debug::DebugLog::print_to_console_log("RenderGraph compiled");
 	//Draw a loading frame with UI
 	draw_loading_frame();
 	Debug::DebugLog::print_to_console_log("---initializeVulkan() completed---");
 }
 
-void ScrapEngine::Render::RenderManager::initialize_scheduler()
-{
-	//Initialize enkiTS scheduler
-	g_TS.Initialize();
-}
-
 void ScrapEngine::Render::RenderManager::initialize_gui(const float width, const float height)
 {
 	gui_render_ = new VulkanImGui();
 	gui_render_->init(width, height);
-	gui_render_->init_resources(vulkan_render_swap_chain_);
+	//One set of gui buffers for each gui command buffer
+	if (scaled_scene_)
+	{
+		gui_render_->init_resources(vulkan_render_swap_chain_, max_frames_in_flight_ + 1,
+		                            GuiRenderPass::get_instance(), GuiRenderPass::gui_subpass,
+		                            vk::SampleCountFlagBits::e1);
+	}
+	else
+	{
+		gui_render_->init_resources(vulkan_render_swap_chain_, max_frames_in_flight_ + 1,
+		                            StandardRenderPass::get_instance(), StandardRenderPass::gui_subpass,
+		                            vulkan_render_device_->get_msaa_samples());
+	}
 	gui_render_->generate_loading_gui_frame();
 }
 
@@ -318,26 +682,76 @@ void ScrapEngine::Render::RenderManager::initialize_command_buffers()
 		command_buffers_[i].command_pool = new StandardCommandPool();
 		command_buffers_[i].command_pool->init(vulkan_render_device_->get_cached_queue_family_indices());
 		//Command buffer
-		const int16_t cb_size = static_cast<int16_t>(vulkan_render_frame_buffer_->get_framebuffers_vector_size());
+		const int16_t cb_size = static_cast<int16_t>(max_frames_in_flight_);
 		command_buffers_[i].command_buffer = new StandardCommandBuffer(command_buffers_[i].command_pool, cb_size);
+		command_buffers_[i].command_buffer->set_depth_prepass_enabled(depth_prepass_enabled_);
+		command_buffers_[i].command_buffer->set_gpu_profiler(gpu_pass_profiler_);
+		command_buffers_[i].camera = new Camera();
 		//Add a task
 		command_buffers_tasks_.push_back(new ParallelCommandBufferCreation());
 		command_buffers_tasks_[i]->owner = this;
+		//The render tasks are the only ones run by the render thread while it waits, see render_task_priority
+		command_buffers_tasks_[i]->m_Priority = render_task_priority;
 	}
 	//Update flip flop for the second command buffer
 	command_buffers_tasks_[1]->flip_flop = true;
+	//Frame command buffers are recorded again every frame, so they must be resettable
+	frame_command_pool_ = new StandardCommandPool();
+	frame_command_pool_->init(vulkan_render_device_->get_cached_queue_family_indices(),
+	                          vk::CommandPoolCreateFlagBits::eResetCommandBuffer);
+	frame_command_buffer_ = new FrameCommandBuffer(frame_command_pool_, static_cast<uint16_t>(max_frames_in_flight_));
 }
 
 void ScrapEngine::Render::RenderManager::initialize_gui_command_buffers()
 {
-	gui_command_buffer_ = new GuiCommandBuffer(gui_render_->get_render_pass(), gui_buffer_command_pool_);
+	const uint16_t cb_size = static_cast<uint16_t>(max_frames_in_flight_);
+	//Same subpass of the gui pipeline, see initialize_gui()
+	BaseRenderPass* gui_render_pass = StandardRenderPass::get_instance();
+	uint32_t gui_subpass = StandardRenderPass::gui_subpass;
+	if (scaled_scene_)
+	{
+		gui_render_pass = GuiRenderPass::get_instance();
+		gui_subpass = GuiRenderPass::gui_subpass;
+	}
+	//With a command buffer more than the frames in flight the next one is usually not used by the gpu anymore
+	for (uint32_t i = 0; i < max_frames_in_flight_ + 1; i++)
+	{
+		gui_command_buffers_.emplace_back();
+		//Command pool
+		gui_command_buffers_[i].command_pool = new StandardCommandPool();
+		gui_command_buffers_[i].command_pool->init(vulkan_render_device_->get_cached_queue_family_indices());
+		//Command buffer
+		gui_command_buffers_[i].command_buffer = new GuiCommandBuffer(gui_render_pass, gui_subpass,
+		                                                              gui_command_buffers_[i].command_pool,
+		                                                              cb_size);
+		gui_command_buffers_[i].command_buffer->set_gpu_profiler(gpu_pass_profiler_);
+	}
 	gui_command_buffer_task_ = new ParallelGuiCommandBufferCreation();
 	gui_command_buffer_task_->owner = this;
+	gui_command_buffer_task_->m_Priority = render_task_priority;
 }
 
 void ScrapEngine::Render::RenderManager::prepare_to_draw_frame()
 {
+	SCRAP_PROFILE_FUNCTION();
+	//The command buffers could still be used by the loading frame or use the old static batches
+	wait_pre_frame_tasks();
+	frame_timeline_->wait(std::max(command_buffers_[0].last_frame_value, command_buffers_[1].last_frame_value));
+	//The batcher and the command buffers need the current state of the meshes, so it's applied now
+	extract_render_world();
+	render_world_->publish();
+	apply_render_world();
+	//Merge the static meshes loaded so far
+	delete static_batcher_;
+	static_batcher_ = new StaticBatcher(vulkan_render_swap_chain_, shadowmapping_);
+	static_batcher_->build(loaded_models_.values(), shadowmapping_);
+	//Both the command buffers, so the old batches are not used anymore
+	latch_render_extent(false);
+	latch_render_extent(true);
+	latch_render_scene(false);
+	latch_render_scene(true);
 	create_command_buffer(false);
+	create_command_buffer(true);
 }
 
 void ScrapEngine::Render::RenderManager::create_queues()
@@ -354,75 +768,88 @@ void ScrapEngine::Render::RenderManager::create_queues()
 	Debug::DebugLog::print_to_console_log("---Ended queues creation---");
 }
 
-void ScrapEngine::Render::RenderManager::rebuild_gui_command_buffer(const bool for_next_image) const
+void ScrapEngine::Render::RenderManager::rebuild_gui_command_buffer(const uint16_t index) const
 {
+	const gui_command_buffer_data& gui_data = gui_command_buffers_[index];
 	//Reset the whole pool
-	gui_buffer_command_pool_->reset_command_pool();
-	//Init the command buffer
-	uint32_t image_index_to_use;
-	if (for_next_image)
-	{
-		image_index_to_use = (last_image_index_ + 1) % image_count_;
-	}
-	else
-	{
-		image_index_to_use = last_image_index_;
-	}
-	gui_command_buffer_->begin_command_buffer(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
-	const vk::Extent2D swap_chain_extent = vulkan_render_swap_chain_->get_swap_chain_extent();
-	gui_command_buffer_->init_command_buffer(vulkan_render_frame_buffer_,
-	                                         swap_chain_extent,
-	                                         image_index_to_use);
-	//Load ui
-	gui_command_buffer_->load_ui(gui_render_);
+	gui_data.command_pool->reset_command_pool();
+	//Init the command buffers, one for each frame in flight
+	//They can be executed by more frames, so they are not one time submit
+	gui_data.command_buffer->init_command_buffer();
+	//Load ui in the buffers owned by this command buffer
+	gui_data.command_buffer->load_ui(gui_render_, index);
 	//close
-	gui_command_buffer_->end_command_buffer_render_pass();
-	gui_command_buffer_->close_command_buffer();
+	gui_data.command_buffer->close_command_buffer();
 }
 
-void ScrapEngine::Render::RenderManager::wait_cleanup_task()
+void ScrapEngine::Render::RenderManager::delete_gui_command_buffers() const
 {
-	g_TS.WaitforTask(mesh_cleanup_task_);
+	for (const gui_command_buffer_data& gui_data : gui_command_buffers_)
+	{
+		delete gui_data.command_buffer;
+		delete gui_data.command_pool;
+	}
 }
 
 void ScrapEngine::Render::RenderManager::wait_gui_commandbuffer_task()
 {
-	g_TS.WaitforTask(gui_command_buffer_task_);
+	SCRAP_PROFILE_FUNCTION();
+	//Called by the render thread, it must not pick up a game task while waiting
+	task_scheduler_->WaitforTask(gui_command_buffer_task_, render_task_priority);
 }
 
 void ScrapEngine::Render::RenderManager::wait_command_buffer_task()
 {
 	const short int index = command_buffer_flip_flop_ ? 0 : 1;
-	g_TS.WaitforTask(command_buffers_tasks_[index]);
+	task_scheduler_->WaitforTask(command_buffers_tasks_[index]);
 }
 
 void ScrapEngine::Render::RenderManager::wait_pre_frame_tasks()
 {
-	wait_cleanup_task();
+	//Also executes the cleanup requested by the render thread
+	wait_frame_render();
 	wait_gui_commandbuffer_task();
 	wait_command_buffer_task();
 }
 
 void ScrapEngine::Render::RenderManager::cleanup_meshes()
 {
-	std::list<VulkanMeshInstance*> loaded_models_copy;
-	//Create a list with non-deleted elements
-	for (auto& loaded_model : loaded_models_)
+	SCRAP_PROFILE_FUNCTION();
+	//Backwards, so the mesh moved in place of an erased one has already been checked
+	for (size_t i = loaded_models_.size(); i-- > 0;)
 	{
-		if (loaded_model->get_pending_deletion() && loaded_model->get_deletion_counter() >= 2)
+		VulkanMeshInstance* loaded_model = loaded_models_.values()[i];
+		if (!loaded_model->get_pending_deletion())
 		{
-			delete loaded_model;
+			continue;
 		}
-		else
+		//The mesh is deleted when the last frame submitted with a command buffer that recorded it is completed
+		uint64_t frame_value = 0;
+		bool still_recorded = false;
+		for (size_t index = 0; index < command_buffers_.size() && !still_recorded; index++)
 		{
-			loaded_models_copy.push_back(loaded_model);
+			const threaded_command_buffer& command_buffer = command_buffers_[index];
+			if (std::find(command_buffer.meshes.begin(), command_buffer.meshes.end(), loaded_model) ==
+				command_buffer.meshes.end())
+			{
+				continue;
+			}
+			//The current command buffer is submitted every frame, the one being recorded will be after the swap
+			if (command_buffer.is_running || index == static_cast<size_t>(command_buffer_flip_flop_))
+			{
+				still_recorded = true;
+			}
+			else
+			{
+				frame_value = std::max(frame_value, command_buffer.last_frame_value);
+			}
 		}
-	}
-	//Check if the new list has fewer elements than the old one
-	if (loaded_models_copy.size() != loaded_models_.size())
-	{
-		//Re-assign cleaned list
-		loaded_models_ = std::move(loaded_models_copy);
+		if (still_recorded)
+		{
+			continue;
+		}
+		VulkanDeletionQueue::get_instance()->retire_object(frame_value, loaded_model);
+		loaded_models_.erase_at(i);
 	}
 }
 
@@ -433,47 +860,87 @@ void ScrapEngine::Render::RenderManager::create_command_buffer(const bool flip_f
 	//Reset the whole pool and begin the command buffer
 	command_buffers_[index].command_pool->reset_command_pool();
 	//Set camera
-	command_buffers_[index].command_buffer->init_current_camera(render_camera_);
-	command_buffers_[index].command_buffer->begin_command_buffer();
+	command_buffers_[index].command_buffer->init_current_camera(command_buffers_[index].camera);
 	//Prepare shadow mapping
 	command_buffers_[index].command_buffer->init_shadow_map(shadowmapping_);
 	//Draw meshes for offscreen shadowmapping
-	for (auto mesh : loaded_models_)
+	for (auto mesh : command_buffers_[index].meshes)
 	{
 		command_buffers_[index].command_buffer->load_mesh_shadow_map(shadowmapping_, mesh);
 	}
-	//End the shadowmapping render pass
-	command_buffers_[index].command_buffer->end_command_buffer_render_pass();
-	//Re-init the standard command buffer render pass
-	const vk::Extent2D swap_chain_extent = vulkan_render_swap_chain_->get_swap_chain_extent();
-	command_buffers_[index].command_buffer->init_command_buffer(vulkan_render_swap_chain_->get_swap_chain_extent(),
-	                                                            vulkan_render_frame_buffer_);
+	if (static_batcher_)
+	{
+		command_buffers_[index].command_buffer->load_static_batches_shadow_map(shadowmapping_, static_batcher_);
+	}
+	command_buffers_[index].command_buffer->close_shadow_map();
+	//Begin the scene command buffers, executed in the standard render pass
+	command_buffers_[index].command_buffer->init_command_buffer(command_buffers_[index].render_extent);
 	//Skybox
-	if (skybox_)
+	if (command_buffers_[index].skybox)
 	{
-		command_buffers_[index].command_buffer->load_skybox(skybox_);
+		command_buffers_[index].command_buffer->load_skybox(command_buffers_[index].skybox);
 	}
 	//3D models
 	//Now render the meshes
-	for (auto mesh : loaded_models_)
+	for (auto mesh : command_buffers_[index].meshes)
 	{
 		command_buffers_[index].command_buffer->load_mesh(mesh);
 	}
-	//End the main render pass
-	command_buffers_[index].command_buffer->end_command_buffer_render_pass();
+	//Merged static meshes
+	if (static_batcher_)
+	{
+		command_buffers_[index].command_buffer->load_static_batches(static_batcher_);
+	}
 	//close
+	command_buffers_[index].command_buffer->close_scene_command_buffer();
 	command_buffers_[index].command_buffer->close_command_buffer();
 }
 
 void ScrapEngine::Render::RenderManager::check_start_new_thread()
 {
 	const short int index = command_buffer_flip_flop_ ? 0 : 1;
-	//If the thread is not already running, this function start it
-	if (!command_buffers_[index].is_running)
+	//If the thread is not already running and the gpu is done with the command buffer, this function start it
+	//Otherwise it will be checked again the next frame
+	if (!defragmentation_recording_paused_ && !command_buffers_[index].is_running && frame_timeline_->is_completed(command_buffers_[index].last_frame_value))
 	{
 		command_buffers_[index].is_running = true;
-		g_TS.AddTaskSetToPipe(command_buffers_tasks_[index]);
+		latch_render_extent(index == 1);
+		latch_render_scene(index == 1);
+		task_scheduler_->AddTaskSetToPipe(command_buffers_tasks_[index]);
+	}
+}
+
+void ScrapEngine::Render::RenderManager::latch_render_extent(const bool flip_flop)
+{
+	const short int index = flip_flop ? 1 : 0;
+	const vk::Extent2D full_extent = vulkan_render_swap_chain_->get_swap_chain_extent();
+	//Drawn directly in the swap chain image, it cannot be scaled
+	if (!scaled_scene_)
+	{
+		command_buffers_[index].render_extent = full_extent;
+		return;
+	}
+	//With the dynamic resolution enabled the temporal upscaler accumulates the resolution it chooses
+	command_buffers_[index].render_extent = temporal_upscaler_ && !dynamic_resolution_->is_enabled()
+		                                        ? temporal_upscaler_->get_render_extent(full_extent)
+		                                        : dynamic_resolution_->get_render_extent(full_extent);
+}
+
+void ScrapEngine::Render::RenderManager::latch_render_scene(const bool flip_flop)
+{
+	threaded_command_buffer& command_buffer = command_buffers_[flip_flop ? 1 : 0];
+	command_buffer.meshes.clear();
+	for (const auto& mesh : render_world_->get_render_snapshot()->meshes)
+	{
+		//Not recorded, so the cleanup doesn't wait for this command buffer to delete it
+		if (!mesh.first->get_pending_deletion())
+		{
+			command_buffer.meshes.push_back(mesh.first);
+		}
 	}
+	command_buffer.skybox = skybox_;
+	command_buffer.defragmentation_generation = defragmentation_generation_;
+	*command_buffer.camera = *render_thread_camera_;
 }
 
 bool ScrapEngine::Render::RenderManager::swap_command_buffers()
@@ -482,9 +949,7 @@ bool ScrapEngine::Render::RenderManager::swap_command_buffers()
 	//If the thread is done, swap the command buffers
 	if (command_buffers_[index].is_running && command_buffers_tasks_[index]->GetIsComplete())
 	{
-		//Take a reference to the fence we must wait before deleting the current command buffer
-		waiting_fence_ = &(*in_flight_fences_ref_)[current_frame_];
-		//And swap them
+		//Swap them, the old one will be recorded again when its last frame is completed
 		command_buffers_[index].is_running = false;
 		command_buffer_flip_flop_ = !command_buffer_flip_flop_;
 
@@ -493,44 +958,114 @@ bool ScrapEngine::Render::RenderManager::swap_command_buffers()
 	return false;
 }
 
-ScrapEngine::Render::VulkanMeshInstance* ScrapEngine::Render::RenderManager::load_mesh(
+ScrapEngine::slot_handle ScrapEngine::Render::RenderManager::load_mesh(
 	const std::string& vertex_shader_path, const std::string& fragment_shader_path, const std::string& model_path,
-	const std::vector<std::string>& textures_path)
+	const std::vector<std::string>& textures_path, VulkanMeshInstance** mesh_instance)
 {
-	//Read data from disk
+	//Only the paths are stored, the mesh is not drawn until it's loaded
 	VulkanMeshInstance* new_mesh = new VulkanMeshInstance(vertex_shader_path, fragment_shader_path,
-	                                                      model_path, textures_path, vulkan_render_swap_chain_);
-
-	//Wait and block if necessary until the list loaded_models_ is editable
-	wait_pre_frame_tasks();
-	//Write descriptor to mesh
-	new_mesh->init_shadowmapping_resources(shadowmapping_);
-	//Push mesh into vector and return it
-	loaded_models_.push_back(new_mesh);
-	return new_mesh;
+	                                                      model_path, textures_path);
+	//The slot map is edited only at the render sync, the reservation can run during it
+	const slot_handle handle = loaded_models_.reserve();
+	scene_changes_->push(SceneChangeQueue::change_type::add_mesh, new_mesh, handle);
+	if (mesh_instance)
+	{
+		*mesh_instance = new_mesh;
+	}
+	return handle;
 }
 
-ScrapEngine::Render::VulkanMeshInstance* ScrapEngine::Render::RenderManager::load_mesh(
-	const std::string& model_path, const std::vector<std::string>& textures_path)
+ScrapEngine::slot_handle ScrapEngine::Render::RenderManager::load_mesh(
+	const std::string& model_path, const std::vector<std::string>& textures_path,
+	VulkanMeshInstance** mesh_instance)
 {
 	return load_mesh("../assets/shader/compiled_shaders/shader_base_shadow.vert.spv",
-	                 "../assets/shader/compiled_shaders/shader_base_shadow.frag.spv", model_path, textures_path);
+	                 "../assets/shader/compiled_shaders/shader_base_shadow.frag.spv", model_path, textures_path,
+	                 mesh_instance);
 }
 
-ScrapEngine::Render::VulkanSkyboxInstance* ScrapEngine::Render::RenderManager::load_skybox(
-	const std::array<std::string, 6>& files_path)
+ScrapEngine::Render::VulkanMeshInstance* ScrapEngine::Render::RenderManager::get_mesh(const slot_handle& mesh) const
 {
-	delete skybox_;
+	VulkanMeshInstance* const* loaded_model = loaded_models_.get(mesh);
+	return loaded_model ? *loaded_model : nullptr;
+}
+
+bool ScrapEngine::Render::RenderManager::is_mesh_reserved(const slot_handle& mesh) const
+{
+	return loaded_models_.is_reserved(mesh);
+}
 
-	skybox_ = new VulkanSkyboxInstance("../assets/shader/compiled_shaders/skybox.vert.spv",
-	                                   "../assets/shader/compiled_shaders/skybox.frag.spv",
-	                                   "../assets/models/skybox_cube.obj",
-	                                   files_path, vulkan_render_swap_chain_);
-	return skybox_;
+void ScrapEngine::Render::RenderManager::unload_mesh(const slot_handle& mesh)
+{
+	//Resolved at the sync, after the add of the same mesh that was pushed before
+	scene_changes_->push(SceneChangeQueue::change_type::remove_mesh, nullptr, mesh);
+}
+
+void ScrapEngine::Render::RenderManager::load_skybox(const std::array<std::string, 6>& files_path)
+{
+	//The pools and the render thread are used by the skybox creation, it waits the render sync
+	requested_skybox_paths_ = files_path;
+	skybox_requested_ = true;
+}
+
+void ScrapEngine::Render::RenderManager::set_skybox_size(const unsigned int new_size)
+{
+	//The render thread reads the skybox transform
+	skybox_size_ = new_size;
+	skybox_size_changed_ = true;
+}
+
+void ScrapEngine::Render::RenderManager::apply_skybox_changes()
+{
+	SCRAP_PROFILE_FUNCTION();
+	if (skybox_requested_)
+	{
+		skybox_requested_ = false;
+		if (skybox_)
+		{
+			retired_skyboxes_.push_back(skybox_);
+		}
+		skybox_ = new VulkanSkyboxInstance("../assets/shader/compiled_shaders/skybox.vert.spv",
+		                                   "../assets/shader/compiled_shaders/skybox.frag.spv",
+		                                   "../assets/models/skybox_cube.obj",
+		                                   requested_skybox_paths_, vulkan_render_swap_chain_);
+		//Drawn once a command buffer latches it, the next recordings always do it
+		skybox_size_changed_ = skybox_size_ != 0;
+	}
+	if (skybox_size_changed_ && skybox_)
+	{
+		skybox_->set_cubemap_size(skybox_size_);
+		skybox_size_changed_ = false;
+	}
+	//The current command buffer is submitted every frame, the one being recorded will be after the swap
+	for (size_t i = retired_skyboxes_.size(); i-- > 0;)
+	{
+		VulkanSkyboxInstance* skybox = retired_skyboxes_[i];
+		bool still_recorded = false;
+		for (size_t index = 0; index < command_buffers_.size(); index++)
+		{
+			const threaded_command_buffer& command_buffer = command_buffers_[index];
+			if (command_buffer.skybox == skybox &&
+				(command_buffer.is_running || index == static_cast<size_t>(command_buffer_flip_flop_)))
+			{
+				still_recorded = true;
+			}
+		}
+		if (still_recorded)
+		{
+			continue;
+		}
+		//Every frame that drew it has already been submitted
+		VulkanDeletionQueue::get_instance()->retire_object(frame_timeline_->get_submitted_value(), skybox);
+		retired_skyboxes_[i] = retired_skyboxes_.back();
+		retired_skyboxes_.pop_back();
+	}
 }
 
 void ScrapEngine::Render::RenderManager::draw_loading_frame()
 {
+	//The render thread is not started yet, the arena can be used by the main thread
+	frame_arena_->reset();
 	result_ = VulkanDevice::get_instance()->get_logical_device()->acquireNextImageKHR(
 		vulkan_render_swap_chain_->get_swap_chain(),
 		std::numeric_limits<uint64_t>::max(),
@@ -550,7 +1085,10 @@ void ScrapEngine::Render::RenderManager::draw_loading_frame()
 	vk::SubmitInfo submit_info;
 
 	vk::Semaphore wait_semaphores[] = {(*image_available_semaphores_ref_)[current_frame_]};
-	vk::PipelineStageFlags wait_stages[] = {vk::PipelineStageFlagBits::eColorAttachmentOutput};
+	//The swap chain image is written by the standard render pass or, when the scene is scaled, by the upscale and the gui
+	vk::PipelineStageFlags wait_stages[] = {
+		vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eColorAttachmentOutput
+	};
 
 	submit_info.setWaitSemaphoreCount(1);
 	submit_info.setPWaitDstStageMask(wait_stages);
@@ -561,21 +1099,11 @@ void ScrapEngine::Render::RenderManager::draw_loading_frame()
 	submit_info.setPSignalSemaphores(signal_semaphores);
 
 	//Submit
-	submit_info.setCommandBufferCount(2);
-	vk::CommandBuffer command_buffers[2];
-	command_buffers[0] =
-		(*command_buffers_[command_buffer_flip_flop_].command_buffer->get_command_buffers_vector())[image_index_];
-	command_buffers[1] = (*gui_command_buffer_->get_command_buffers_vector())[0];
-	submit_info.setPCommandBuffers(&command_buffers[0]);
-
-	VulkanDevice::get_instance()->get_logical_device()->resetFences(1, &(*in_flight_fences_ref_)[current_frame_]);
+	const vk::CommandBuffer command_buffer = record_frame_command_buffer();
+	submit_info.setCommandBufferCount(1);
+	submit_info.setPCommandBuffers(&command_buffer);
 
-	result_ = vulkan_graphics_queue_->get_queue()->submit(1, &submit_info,
-	                                                      (*in_flight_fences_ref_)[current_frame_]);
-	if (result_ != vk::Result::eSuccess)
-	{
-		Debug::DebugLog::fatal_error(result_, "RenderManager: Failed to submit draw command buffer!");
-	}
+	submit_frame(submit_info);
 
 	vk::PresentInfoKHR present_info;
 
@@ -591,17 +1119,146 @@ void ScrapEngine::Render::RenderManager::draw_loading_frame()
 	result_ = vulkan_presentation_queue_->get_queue()->presentKHR(&present_info);
 }
 
+void ScrapEngine::Render::RenderManager::extract_render_world()
+{
+	SCRAP_PROFILE_FUNCTION();
+	//The game side camera keeps valid matrices and frustum for the game code too
+	render_camera_->execute_camera_update();
+	render_world_->extract(loaded_models_.values(), render_camera_);
+}
+
+void ScrapEngine::Render::RenderManager::begin_frame_render()
+{
+	render_world_->publish();
+	task_scheduler_->AddPinnedTask(frame_render_task_);
+}
+
+void ScrapEngine::Render::RenderManager::wait_frame_render()
+{
+	SCRAP_PROFILE_FUNCTION();
+	task_scheduler_->WaitforTask(frame_render_task_);
+	//The meshes not used by the command buffers anymore can be deleted, it's a swap-remove for each of them
+	if (mesh_cleanup_requested_)
+	{
+		mesh_cleanup_requested_ = false;
+		cleanup_meshes();
+	}
+	apply_scene_changes();
+	apply_skybox_changes();
+	if (defragmentation_running_)
+	{
+		defragment_memory_step();
+	}
+	if (temporal_upscaler_)
+	{
+		if (temporal_check_frame_ != 0 && frame_counter_ >= temporal_check_frame_)
+		{
+			temporal_check_frame_ = 0;
+			request_temporal_upscaling_check(TemporalImageCheck::default_frame_count,
+			                                 TemporalImageCheck::default_max_mean_error);
+		}
+		if (temporal_check_requested_)
+		{
+			temporal_check_requested_ = false;
+			temporal_upscaler_->start_image_check(temporal_check_frames_, temporal_check_max_error_);
+		}
+		temporal_upscaler_->update_image_check(frame_timeline_);
+	}
+	update_memory_statistics();
+}
+
+void ScrapEngine::Render::RenderManager::apply_scene_changes()
+{
+	SCRAP_PROFILE_FUNCTION();
+	//The files are read, create the gpu resources and write the descriptors
+	//A mesh removed in the meantime is loaded too, then the snapshot brings its deletion to the render side
+	if (!meshes_reading_.empty() && mesh_file_task_->GetIsComplete())
+	{
+		for (VulkanMeshInstance* mesh : meshes_reading_)
+		{
+			mesh->load(vulkan_render_swap_chain_, shadowmapping_);
+		}
+		meshes_reading_.clear();
+	}
+	//In push order, so a mesh is always inserted before its removal
+	while (SceneChangeQueue::scene_change* change = scene_changes_->pop())
+	{
+		switch (change->type)
+		{
+		case SceneChangeQueue::change_type::add_mesh:
+			loaded_models_.insert_reserved(change->handle, change->mesh);
+			meshes_to_read_.push_back(change->mesh);
+			break;
+		case SceneChangeQueue::change_type::remove_mesh:
+			if (VulkanMeshInstance* mesh = get_mesh(change->handle))
+			{
+				mesh->set_for_deletion();
+				//A mesh not recorded by the command buffers can be retired at the next sync
+				mesh_cleanup_requested_ = true;
+			}
+			break;
+		}
+		scene_changes_->release(change);
+	}
+	//Skipped if a change is being pushed by another thread
+	scene_changes_->recycle();
+	start_mesh_file_reading();
+}
+
+void ScrapEngine::Render::RenderManager::start_mesh_file_reading()
+{
+	if (!meshes_reading_.empty() || meshes_to_read_.empty())
+	{
+		return;
+	}
+	meshes_reading_.swap(meshes_to_read_);
+	//Chosen here because the pools are edited only by the sync, every missing file is read once
+	std::unordered_set<std::string> selected_files;
+	for (VulkanMeshInstance* mesh : meshes_reading_)
+	{
+		mesh->select_files_to_read(selected_files);
+	}
+	mesh_file_task_->m_SetSize = static_cast<uint32_t>(meshes_reading_.size());
+	task_scheduler_->AddTaskSetToPipe(mesh_file_task_);
+}
+
+void ScrapEngine::Render::RenderManager::apply_render_world()
+{
+	render_world_->apply(shadowmapping_);
+	const RenderWorld::frame_snapshot* snapshot = render_world_->get_render_snapshot();
+	*render_thread_camera_ = snapshot->camera;
+	//The history of the old camera cannot be reprojected
+	if (snapshot->camera_changed && temporal_upscaler_)
+	{
+		temporal_upscaler_->reset_history();
+	}
+}
+
 void ScrapEngine::Render::RenderManager::draw_frame()
 {
-	//Wait the cleanup before continuing
-	wait_cleanup_task();
+	//Once the scene is stable the frame should not touch the heap
+	const Debug::AllocationScope frame_allocations;
+	frame_arena_->reset();
+	//Take the state extracted at the end of the game frame
+	apply_render_world();
 	//Check if i can build another command buffer in background
 	check_start_new_thread();
 	//-----------------
 	//Prepare draw frame
-	VulkanDevice::get_instance()->get_logical_device()->waitForFences(1, &(*in_flight_fences_ref_)[current_frame_],
-	                                                                  true,
-	                                                                  std::numeric_limits<uint64_t>::max());
+	//Wait the previous frame that used the same resources
+	{
+		SCRAP_PROFILE_SCOPE("wait_frame");
+		frame_timeline_->wait_frame(static_cast<uint32_t>(current_frame_));
+	}
+	//Its gpu time is now available, the new scale is used by the next recorded command buffer
+	gpu_pass_profiler_->collect(static_cast<uint32_t>(current_frame_));
+	float gpu_time_ms;
+	if (gpu_pass_profiler_->get_collected_time(GpuPassProfiler::pass_zone::frame, gpu_time_ms))
+	{
+		dynamic_resolution_->add_gpu_frame_time(gpu_time_ms);
+	}
+	//Destroy the resources retired before the completed frames
+	VulkanDeletionQueue::get_instance()->collect();
 
 	result_ = VulkanDevice::get_instance()->get_logical_device()->acquireNextImageKHR(
 		vulkan_render_swap_chain_->get_swap_chain(),
@@ -618,6 +1275,8 @@ void ScrapEngine::Render::RenderManager::draw_frame()
 	{
 		Debug::DebugLog::fatal_error(result_, "RenderManager: Failed to acquire swap chain image!");
 	}
+	//Let the allocator know a new frame started to refresh the budget
+	VulkanMemoryAllocator::get_instance()->set_current_frame_index(frame_counter_++);
 	//-----------------
 	//Update objects and uniform buffers
 	update_objects_and_buffers();
@@ -627,7 +1286,10 @@ void ScrapEngine::Render::RenderManager::draw_frame()
 
 	vk::Semaphore wait_semaphores[] = {(*image_available_semaphores_ref_)[current_frame_]};
 
-	vk::PipelineStageFlags wait_stages[] = {vk::PipelineStageFlagBits::eColorAttachmentOutput};
+	//The swap chain image is written by the standard render pass or, when the scene is scaled, by the upscale and the gui
+	vk::PipelineStageFlags wait_stages[] = {
+		vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eColorAttachmentOutput
+	};
 
 	submit_info.setWaitSemaphoreCount(1);
 	submit_info.setPWaitSemaphores(wait_semaphores);
@@ -635,29 +1297,24 @@ void ScrapEngine::Render::RenderManager::draw_frame()
 
 	//Wait for the gui command buffer task to finish
 	wait_gui_commandbuffer_task();
+	//If a new gui command buffer has been recorded use it
+	if (gui_command_buffer_rebuilding_)
+	{
+		gui_command_buffer_index_ = gui_command_buffer_task_->index;
+		gui_command_buffer_rebuilding_ = false;
+	}
 	//Submit
-	vk::CommandBuffer command_buffers[2];
-	//Push main command buffer
-	command_buffers[0] =
-		(*command_buffers_[command_buffer_flip_flop_].command_buffer->get_command_buffers_vector())[image_index_];
-	//Push GUI command buffer
-	command_buffers[1] = (*gui_command_buffer_->get_command_buffers_vector())[0];
-	//Set command buffers size and array
-	submit_info.setCommandBufferCount(2);
-	submit_info.setPCommandBuffers(&command_buffers[0]);
+	//Record the frame command buffer with the passes of the render graph
+	const vk::CommandBuffer command_buffer = record_frame_command_buffer();
+	submit_info.setCommandBufferCount(1);
+	submit_info.setPCommandBuffers(&command_buffer);
 
 	vk::Semaphore signal_semaphores[] = {(*render_finished_semaphores_ref_)[current_frame_]};
 	submit_info.setSignalSemaphoreCount(1);
 	submit_info.setPSignalSemaphores(signal_semaphores);
-	VulkanDevice::get_instance()->get_logical_device()->resetFences(1, &(*in_flight_fences_ref_)[current_frame_]);
 	//-----------------
 	//Queue submit
-	result_ = vulkan_graphics_queue_->get_queue()->submit(1, &submit_info,
-	                                                      (*in_flight_fences_ref_)[current_frame_]);
-	if (result_ != vk::Result::eSuccess)
-	{
-		Debug::DebugLog::fatal_error(result_, "RenderManager: Failed to submit draw command buffer!");
-	}
+	submit_frame(submit_info);
 
 	vk::PresentInfoKHR present_info;
 
@@ -687,14 +1344,35 @@ void ScrapEngine::Render::RenderManager::draw_frame()
 	//If yes i can swap the command buffers
 	if (swap_command_buffers())
 	{
-		//If yes i can also start mesh cleanup
-		g_TS.AddTaskSetToPipe(mesh_cleanup_task_);
+		//If yes the game thread can also start the mesh cleanup
+		mesh_cleanup_requested_ = true;
+		frames_since_swap_ = 0;
+	}
+	else if (frames_since_swap_ < steady_frame_count)
+	{
+		frames_since_swap_++;
 	}
-	//Update gui fence to wait
-	gui_waiting_fence_ = &(*in_flight_fences_ref_)[current_frame_];
 	//Update the current frame index
-	current_frame_ = (current_frame_ + 1) % image_count_;
-	last_image_index_ = image_index_;
+	current_frame_ = (current_frame_ + 1) % max_frames_in_flight_;
+	const uint64_t allocation_count = frame_allocations.get_allocation_count();
+	frame_allocations_.store(allocation_count, std::memory_order_relaxed);
+	if (allocation_count > 0 && frames_since_swap_ >= steady_frame_count)
+	{
+		//Reported by the game thread, logging here would allocate again
+		uint64_t no_allocations = 0;
+		steady_frame_allocations_.compare_exchange_strong(no_allocations, allocation_count,
+		                                                  std::memory_order_relaxed);
+	}
+}
+
+void ScrapEngine::Render::RenderManager::check_steady_frame_allocations() const
+{
+	const uint64_t allocation_count = steady_frame_allocations_.load(std::memory_order_relaxed);
+	if (allocation_count > 0)
+	{
+		Debug::DebugLog::fatal_error(vk::Result(-13), "RenderManager: A steady frame made " +
+		                             std::to_string(allocation_count) + " heap allocations");
+	}
 }
 
 void ScrapEngine::Render::RenderManager::wait_device_idle() const
@@ -702,6 +1380,193 @@ void ScrapEngine::Render::RenderManager::wait_device_idle() const
 	vulkan_render_device_->get_logical_device()->waitIdle();
 }
 
+void ScrapEngine::Render::RenderManager::request_memory_defragmentation()
+{
+	if (!defragmentation_running_)
+	{
+		defragmentation_running_ = true;
+		defragmentation_steps_ = 0;
+		Debug::DebugLog::print_to_console_log("[RenderManager] Memory defragmentation started");
+	}
+}
+
+bool ScrapEngine::Render::RenderManager::is_memory_defragmentation_running() const
+{
+	return defragmentation_running_;
+}
+
+bool ScrapEngine::Render::RenderManager::request_temporal_upscaling_check(const uint32_t frame_count,
+                                                                        const float max_mean_error)
+{
+	if (!temporal_upscaler_)
+	{
+		return false;
+	}
+	temporal_check_requested_ = true;
+	temporal_check_frames_ = frame_count;
+	temporal_check_max_error_ = max_mean_error;
+	return true;
+}
+
+void ScrapEngine::Render::RenderManager::finish_temporal_upscaling_check()
+{
+	if (!temporal_upscaler_)
+	{
+		Debug::DebugLog::fatal_error(vk::Result(-13),
+		                             "RenderManager: The temporal upscaling check requires the temporal upscaling");
+	}
+	temporal_upscaler_->update_image_check(frame_timeline_);
+	switch (temporal_upscaler_->get_image_check_result())
+	{
+	case TemporalUpscaler::image_check_result::passed:
+		return;
+	case TemporalUpscaler::image_check_result::failed:
+		Debug::DebugLog::fatal_error(vk::Result(-13), "RenderManager: The temporal upscaling check failed");
+		break;
+	default:
+		Debug::DebugLog::fatal_error(vk::Result(-13),
+		                             "RenderManager: The temporal upscaling check didn't complete");
+		break;
+	}
+}
+
+const ScrapEngine::Render::VulkanMemoryAllocator::memory_statistics& ScrapEngine::Render::RenderManager::
+get_memory_statistics() const
+{
+	return memory_statistics_;
+}
+
+void ScrapEngine::Render::RenderManager::defragment_memory_step()
+{
+	SCRAP_PROFILE_FUNCTION();
+	//One step at a time, the old buffers of the previous step must be retired first
+	if (!retire_defragmented_buffers())
+	{
+		return;
+	}
+	//The recording reads the buffer handles, so the next step waits the one in progress at the next syncs
+	defragmentation_recording_paused_ = true;
+	for (size_t i = 0; i < command_buffers_.size(); i++)
+	{
+		if (command_buffers_[i].is_running && !command_buffers_tasks_[i]->GetIsComplete())
+		{
+			return;
+		}
+	}
+	//The command buffer of the previous copies is reused once they are completed
+	if (defragmentation_command_buffer_)
+	{
+		if (!frame_timeline_->is_completed(defragmentation_copy_value_))
+		{
+			return;
+		}
+		free_defragmentation_command_buffer();
+	}
+	defragmentation_recording_paused_ = false;
+
+	const vk::CommandBufferAllocateInfo alloc_info(*singleton_command_pool_, vk::CommandBufferLevel::ePrimary, 1);
+	VulkanDevice::get_instance()->get_logical_device()->allocateCommandBuffers(&alloc_info,
+	                                                                           &defragmentation_command_buffer_);
+	defragmentation_command_buffer_.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+
+	const bool moved = VulkanMemoryAllocator::get_instance()->defragment_buffers(
+		defragmentation_step_bytes, defragmentation_step_allocations, defragmentation_command_buffer_,
+		defragmentation_old_buffers_);
+	if (!moved)
+	{
+		defragmentation_command_buffer_.end();
+		free_defragmentation_command_buffer();
+		defragmentation_running_ = false;
+		//Show the result without waiting the next refresh
+		memory_statistics_age_ = memory_statistics_interval;
+		Debug::DebugLog::print_to_console_log("[RenderManager] Memory defragmentation completed in " +
+			std::to_string(defragmentation_steps_) + " steps");
+		return;
+	}
+	//The frames submitted after the copies read the new buffers
+	const vk::MemoryBarrier copy_barrier(vk::AccessFlagBits::eTransferWrite,
+	                                     vk::AccessFlagBits::eVertexAttributeRead | vk::AccessFlagBits::eIndexRead);
+	defragmentation_command_buffer_.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+	                                                vk::PipelineStageFlagBits::eVertexInput,
+	                                                vk::DependencyFlags(), 1, &copy_barrier, 0, nullptr, 0, nullptr);
+	defragmentation_command_buffer_.end();
+	//Not waited, the render thread is idle during the sync so the queue can be used
+	const vk::SubmitInfo submit_info(0, nullptr, nullptr, 1, &defragmentation_command_buffer_);
+	const vk::Result result = vulkan_graphics_queue_->get_queue()->submit(1, &submit_info, vk::Fence());
+	if (result != vk::Result::eSuccess)
+	{
+		Debug::DebugLog::fatal_error(result, "RenderManager: Failed to submit the defragmentation copies!");
+	}
+	//Completed when the next frame is
+	defragmentation_copy_value_ = frame_timeline_->get_submitted_value() + 1;
+	defragmentation_steps_++;
+	defragmentation_generation_++;
+}
+
+bool ScrapEngine::Render::RenderManager::retire_defragmented_buffers()
+{
+	if (defragmentation_old_buffers_.empty())
+	{
+		return true;
+	}
+	//The current command buffer is submitted every frame, the one being recorded will be after the swap
+	for (size_t index = 0; index < command_buffers_.size(); index++)
+	{
+		const threaded_command_buffer& command_buffer = command_buffers_[index];
+		if (command_buffer.defragmentation_generation < defragmentation_generation_ &&
+			(command_buffer.is_running || index == static_cast<size_t>(command_buffer_flip_flop_)))
+		{
+			return false;
+		}
+	}
+	//Every frame that read them has already been submitted
+	VulkanDeletionQueue::get_instance()->retire(
+		&destroy_moved_buffers,
+		new std::vector<VulkanMemoryAllocator::moved_buffer>(std::move(defragmentation_old_buffers_)));
+	defragmentation_old_buffers_.clear();
+	return true;
+}
+
+void ScrapEngine::Render::RenderManager::free_defragmentation_command_buffer()
+{
+	VulkanDevice::get_instance()->get_logical_device()->freeCommandBuffers(*singleton_command_pool_, 1,
+	                                                                        &defragmentation_command_buffer_);
+	defragmentation_command_buffer_ = vk::CommandBuffer();
+}
+
+void ScrapEngine::Render::RenderManager::destroy_moved_buffers(void* moved_buffers)
+{
+	std::vector<VulkanMemoryAllocator::moved_buffer>* buffers = static_cast<std::vector<
+		VulkanMemoryAllocator::moved_buffer>*>(moved_buffers);
+	for (VulkanMemoryAllocator::moved_buffer& buffer : *buffers)
+	{
+		VulkanMemoryAllocator::get_instance()->destroy_buffer(buffer.buffer, buffer.allocation);
+	}
+	delete buffers;
+}
+
+void ScrapEngine::Render::RenderManager::update_memory_statistics()
+{
+	if (++memory_statistics_age_ < memory_statistics_interval)
+	{
+		return;
+	}
+	SCRAP_PROFILE_FUNCTION();
+	memory_statistics_age_ = 0;
+	memory_statistics_ = VulkanMemoryAllocator::get_instance()->get_memory_statistics();
+}
+
+void ScrapEngine::Render::RenderManager::release_unused_resources()
+{
+	SCRAP_PROFILE_FUNCTION();
+	//The frames submitted so far must be known when the resources are retired
+	wait_pre_frame_tasks();
+	//Only the resources not referenced by a mesh anymore are released
+	VulkanModelBuffersPool::get_instance()->clear_memory();
+	VulkanModelPool::get_instance()->clear_memory();
+	VulkanSimpleMaterialPool::get_instance()->clear_memory();
+}
+
 void ScrapEngine::Render::RenderManager::recreate_swap_chain()
 {
 	VulkanDevice::get_instance()->get_logical_device()->waitIdle();
@@ -711,23 +1576,39 @@ void ScrapEngine::Render::RenderManager::recreate_swap_chain()
 
 void ScrapEngine::Render::RenderManager::update_objects_and_buffers()
 {
+	SCRAP_PROFILE_FUNCTION();
 	//Camera
-	render_camera_->execute_camera_update();
+	render_thread_camera_->execute_camera_update();
+	//Jitter of the frame, before the uniform buffers take the projection
+	if (temporal_upscaler_)
+	{
+		temporal_upscaler_->update(render_thread_camera_,
+		                           command_buffers_[command_buffer_flip_flop_].render_extent);
+	}
 	//Save current light pos
 	const glm::vec3 light_pos = shadowmapping_->get_light_pos();
 	//Models Shadowmapping update and standard update
-	for (auto& loaded_model : loaded_models_)
+	for (const auto& mesh : render_world_->get_render_snapshot()->meshes)
 	{
+		VulkanMeshInstance* loaded_model = mesh.first;
 		//Check and update model frustum according to current view
-		loaded_model->view_frustum_check(render_camera_);
+		loaded_model->view_frustum_check(render_thread_camera_);
 		//Checks to see if is necessary to update the buffers are inside each call
-		loaded_model->update_shadowmap_uniform_buffer(image_index_, shadowmapping_);
-		loaded_model->update_uniform_buffer(image_index_, render_camera_, light_pos);
+		loaded_model->update_shadowmap_uniform_buffer(static_cast<uint32_t>(current_frame_), shadowmapping_);
+		loaded_model->update_uniform_buffer(static_cast<uint32_t>(current_frame_), render_thread_camera_,
+		                                    light_pos);
 	}
-	//Skybox
-	if (skybox_)
+	//Static batches, after the meshes that could disable them
+	if (static_batcher_)
+	{
+		static_batcher_->update(static_cast<uint32_t>(current_frame_), render_thread_camera_, shadowmapping_,
+		                        light_pos);
+	}
+	//Skybox of the command buffer submitted by this frame
+	VulkanSkyboxInstance* skybox = command_buffers_[command_buffer_flip_flop_].skybox;
+	if (skybox)
 	{
-		skybox_->update_uniform_buffer(image_index_, render_camera_);
+		skybox->update_uniform_buffer(static_cast<uint32_t>(current_frame_), render_thread_camera_);
 	}
 }
 
@@ -736,4 +1617,6 @@ void ScrapEngine::Render::RenderManager::create_camera()
 	render_camera_ = new Camera();
 	default_camera_ = render_camera_;
 	render_camera_->set_swap_chain_extent(vulkan_render_swap_chain_->get_swap_chain_extent());
+	render_thread_camera_ = new Camera();
+	render_thread_camera_->set_swap_chain_extent(vulkan_render_swap_chain_->get_swap_chain_extent());
 }
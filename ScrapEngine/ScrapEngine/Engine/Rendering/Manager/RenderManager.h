@@ -2,17 +2,24 @@
 
 #include <Engine/Rendering/VulkanInclude.h>
 #include <Engine/Utility/UsefulTypes.h>
+#include <Engine/Utility/SlotMap.h>
+#include <Engine/Rendering/Memory/VulkanMemoryAllocator.h>
 #include <TaskScheduler.h>
-#include <list>
+#include <array>
+#include <atomic>
 
 namespace ScrapEngine
 {
 	namespace Render
 	{
 		class GuiCommandBuffer;
+		class FrameCommandBuffer;
 		class StandardCommandBuffer;
 		class StandardShadowmapping;
 		class VulkanMeshInstance;
+		class StaticBatcher;
+		class RenderWorld;
+		class SceneChangeQueue;
 		class VulkanSkyboxInstance;
 		class Camera;
 		class VulkanImGui;
@@ -20,6 +27,12 @@ namespace ScrapEngine
 		class VulkanColorResources;
 		class VulkanDepthResources;
 		class VulkanSemaphoresManager;
+		class VulkanFrameTimeline;
+		class RenderGraph;
+		class FrameArena;
+		class GpuPassProfiler;
+		class DynamicResolution;
+		class TemporalUpscaler;
 		class BaseQueue;
 		class VulkanCommandPool;
 		class BaseFrameBuffer;
@@ -37,41 +50,87 @@ namespace ScrapEngine
 			VulkanDevice* vulkan_render_device_ = nullptr;
 			VulkanSwapChain* vulkan_render_swap_chain_ = nullptr;
 			VulkanImageView* vulkan_render_image_view_ = nullptr;
+			//Framebuffers of the StandardRenderPass, one for every swap chain image
+			//When the scene is scaled a single one, drawn offscreen in the scene color of the render graph
 			BaseFrameBuffer* vulkan_render_frame_buffer_ = nullptr;
+			//Framebuffers of the gui, drawn in the swap chain images after the upscale of the scene
+			//nullptr if the scene is not scaled, the gui is drawn in the gui subpass of the StandardRenderPass
+			BaseFrameBuffer* vulkan_gui_frame_buffer_ = nullptr;
 			
 			VulkanCommandPool* singleton_command_pool_ = nullptr;
-			VulkanCommandPool* gui_buffer_command_pool_ = nullptr;
 			
 			BaseQueue* vulkan_graphics_queue_ = nullptr;
 			BaseQueue* vulkan_presentation_queue_ = nullptr;
 			
 			VulkanSemaphoresManager* vulkan_render_semaphores_ = nullptr;
+			//Gpu frame counter, used to know when the resources of a frame can be reused
+			VulkanFrameTimeline* frame_timeline_ = nullptr;
 			VulkanSurface* vulkan_window_surface_ = nullptr;
 			VulkanDepthResources* vulkan_render_depth_ = nullptr;
 			VulkanColorResources* vulkan_render_color_ = nullptr;
 			VulkanImGui* gui_render_ = nullptr;
 
+			//Game side camera, the render thread draws the copy taken by the RenderWorld snapshot
 			Camera* render_camera_ = nullptr;
 			Camera* default_camera_ = nullptr;
 
+			//Created at the render sync, the command buffers latch it like the meshes
 			VulkanSkyboxInstance* skybox_ = nullptr;
+			//Requested by load_skybox(), the skybox is created by the next render sync
+			std::array<std::string, 6> requested_skybox_paths_;
+			bool skybox_requested_ = false;
+			//0 to keep the size of the model
+			unsigned int skybox_size_ = 0;
+			bool skybox_size_changed_ = false;
+			//Replaced skyboxes still recorded by a command buffer
+			std::vector<VulkanSkyboxInstance*> retired_skyboxes_;
 
 			StandardShadowmapping* shadowmapping_ = nullptr;
 
-			std::list<VulkanMeshInstance*> loaded_models_;
+			DynamicResolution* dynamic_resolution_ = nullptr;
+			//Gpu time of the frames, used to choose the scene resolution, and of every pass
+			GpuPassProfiler* gpu_pass_profiler_ = nullptr;
+			//The panel of the pass times is shown only if requested
+			bool show_gpu_pass_profiler_ = false;
+			//Created with the render graph, nullptr if the temporal upscaling is disabled
+			TemporalUpscaler* temporal_upscaler_ = nullptr;
+			bool temporal_upscaling_enabled_ = false;
+			float temporal_upscaling_scale_ = 0.6f;
+			//Image check requested by the game, started at the next render sync
+			//Requested automatically at temporal_check_frame_ if not 0
+			uint32_t temporal_check_frame_ = 0;
+			bool temporal_check_requested_ = false;
+			uint32_t temporal_check_frames_ = 0;
+			float temporal_check_max_error_ = 0.f;
+			//With the dynamic resolution or the temporal upscaling the scene is drawn offscreen and upscaled
+			//Otherwise the scene and the gui are drawn directly in the swap chain image, without the blit
+			//Chosen at the initialization, the pipelines and the gui command buffers depend on it
+			bool scaled_scene_ = false;
+
+			//Contiguous for the per frame iterations, the game references the meshes with the handles
+			//The handles are reserved by load_mesh(), the meshes are inserted only at the render sync
+			SlotMap<VulkanMeshInstance*> loaded_models_;
+			//Static meshes merged at prepare_to_draw_frame()
+			StaticBatcher* static_batcher_ = nullptr;
 
 			size_t current_frame_ = 0;
+			//Total number of frames drawn, used by the memory allocator
+			uint32_t frame_counter_ = 0;
 			uint32_t image_index_;
 			vk::Result result_;
 
 			uint32_t image_count_ = -1;
+			//Resources written every frame (uniform buffers, command buffers, semaphores) are indexed by current_frame_
+			uint32_t max_frames_in_flight_ = 1;
 			bool framebuffer_resized_ = false;
+			bool depth_prepass_enabled_ = false;
+			bool show_render_stats_ = false;
 			const std::vector<vk::Semaphore>* image_available_semaphores_ref_;
 			const std::vector<vk::Semaphore>* render_finished_semaphores_ref_;
 			const std::vector<vk::Fence>* in_flight_fences_ref_;
 
-			//Scheduler tasks
-			enki::TaskScheduler g_TS;
+			//Scheduler owned by the EngineManager, shared with the other subsystems
+			enki::TaskScheduler* task_scheduler_;
 
 			//---standard command buffers
 			//Multi threaded command buffers
@@ -80,6 +139,18 @@ namespace ScrapEngine
 				bool is_running = false;
 				VulkanCommandPool* command_pool = nullptr;
 				StandardCommandBuffer* command_buffer = nullptr;
+				//Timeline value of the last frame that submitted this command buffer
+				//It can be recorded again only when the value is completed
+				uint64_t last_frame_value = 0;
+				//Part of the scene color drawn by this command buffer, chosen in the main thread before recording it
+				vk::Extent2D render_extent;
+				//Meshes and camera latched with the render extent, the recording doesn't read the snapshot
+				//because the render thread can apply the next one in the meantime
+				std::vector<VulkanMeshInstance*> meshes;
+				Camera* camera = nullptr;
+				VulkanSkyboxInstance* skybox = nullptr;
+				//Defragmentation generation of the buffers read by the recording
+				uint64_t defragmentation_generation = 0;
 			};
 
 			//Flag to know if i'm using the first or the second command buffer
@@ -97,49 +168,127 @@ namespace ScrapEngine
 			//I need to have a reference to know if is running or is done
 			//I need to use a pointer because a ITaskSet cannot be copied
 			std::vector<ParallelCommandBufferCreation*> command_buffers_tasks_;
-			//This is the fence used to wait that the previous command buffer has finished and can be deleted
-			const vk::Fence* waiting_fence_ = nullptr;
+
+			//---frame command buffers
+			//Primary command buffers recorded every frame, one for each frame in flight
+			//They execute the secondary command buffers of the passes in the render graph
+			VulkanCommandPool* frame_command_pool_ = nullptr;
+			FrameCommandBuffer* frame_command_buffer_ = nullptr;
+			//Passes executed by the frame command buffer, ordered with the barriers between them
+			RenderGraph* render_graph_ = nullptr;
 
 			//---gui
-			//The gui command buffer, is rebuilt every frame
-			GuiCommandBuffer* gui_command_buffer_;
+			//There is a gui command buffer more than the frames in flight: one is submitted while another can be recorded
+			//They are recorded again only when the gui draw data changes
+			struct gui_command_buffer_data
+			{
+				VulkanCommandPool* command_pool = nullptr;
+				GuiCommandBuffer* command_buffer = nullptr;
+				//Hash of the draw data recorded in the command buffer
+				uint64_t draw_data_hash = 0;
+				//Timeline value of the last frame that submitted this command buffer
+				//Must be completed before recording it again
+				uint64_t last_frame_value = 0;
+			};
+
+			std::vector<gui_command_buffer_data> gui_command_buffers_;
+			//Index of the gui command buffer used to draw
+			uint16_t gui_command_buffer_index_ = 0;
+			//True if the other gui command buffer is being recorded and must be swapped before drawing
+			bool gui_command_buffer_rebuilding_ = false;
 
 			//Parallel task used to create gui command buffer while other updates() execute
-			//It's started at post_gui_render() and run during audio and physics update
+			//It's started at post_gui_render() only if the gui changed and the command buffer is not used by the gpu
+			//It runs during audio and physics update
 			//Must be ready before draw frame() or will be waited
 			struct ParallelGuiCommandBufferCreation : enki::ITaskSet
 			{
+				uint16_t index = 0;
 				RenderManager* owner;
 				void ExecuteRange(enki::TaskSetPartition range, uint32_t threadnum) override;
 			};
 
 			ParallelGuiCommandBufferCreation* gui_command_buffer_task_;
 
-			//This is the fence used to wait that the previous command buffer has finished and can be deleted
-			const vk::Fence* gui_waiting_fence_ = nullptr;
-
-			//Necessary to rebuild the gui command buffer
-			//This because "image_index_" might be updated before the gui thread read it and this will lead to error
-			//So this variable is updated only at the end of the frame
-			uint32_t last_image_index_ = 0;
-
 			//---cleanup
-
-			//Parallel task used to delete meshes in background while other updates() execute
-			//Every mesh has a flag that say if it can be deleted or not
-			struct ParallelMeshCleanup : enki::ITaskSet
+			//Set by the render thread when the command buffers are swapped and when a mesh is removed
+			//The cleanup edits loaded_models_, so it's executed by the game thread at the next sync
+			//A removed mesh is retired with the last frame value of the command buffers that recorded it
+			bool mesh_cleanup_requested_ = false;
+
+			//---memory
+			//Cached because computing them walks every allocation, refreshed at the render sync
+			static const uint32_t memory_statistics_interval = 120;
+			VulkanMemoryAllocator::memory_statistics memory_statistics_;
+			//Refreshed at the first render sync
+			uint32_t memory_statistics_age_ = memory_statistics_interval;
+			//The defragmentation runs bounded steps at the render syncs until nothing moves
+			//A step runs when no command buffer is being recorded, then the recordings take the moved buffers
+			//and the old ones are retired once no command buffer recorded before the step is used anymore
+			bool defragmentation_running_ = false;
+			uint32_t defragmentation_steps_ = 0;
+			//Incremented by every step that moved something, latched by the command buffers
+			uint64_t defragmentation_generation_ = 0;
+			//No new recording starts while a step waits the one in progress
+			bool defragmentation_recording_paused_ = false;
+			std::vector<VulkanMemoryAllocator::moved_buffer> defragmentation_old_buffers_;
+			//Copy commands of the last step, freed once the frame submitted after them is completed
+			vk::CommandBuffer defragmentation_command_buffer_;
+			uint64_t defragmentation_copy_value_ = 0;
+			static const vk::DeviceSize defragmentation_step_bytes = 4 * 1024 * 1024;
+			static const uint32_t defragmentation_step_allocations = 16;
+
+			//---scene changes
+			//Meshes added and removed by the game, applied at the render sync when the render thread is idle
+			SceneChangeQueue* scene_changes_ = nullptr;
+
+			//Reads the model and texture files of the added meshes, the gpu resources are created at a sync
+			struct ParallelMeshFileReading : enki::ITaskSet
 			{
 				RenderManager* owner;
 				void ExecuteRange(enki::TaskSetPartition range, uint32_t threadnum) override;
 			};
 
-			ParallelMeshCleanup* mesh_cleanup_task_;
+			ParallelMeshFileReading* mesh_file_task_ = nullptr;
+			//Meshes read by mesh_file_task_, loaded at the first sync after it's completed
+			std::vector<VulkanMeshInstance*> meshes_reading_;
+			//Meshes added while the task is running, read by the next one
+			std::vector<VulkanMeshInstance*> meshes_to_read_;
+
+			//---render thread
+			//Render state extracted at the end of every game frame
+			RenderWorld* render_world_ = nullptr;
+			//Copy of the snapshot camera, updated and jittered by the render thread
+			Camera* render_thread_camera_ = nullptr;
+			//Transient memory of the frame drawn by the render thread, reset at the start of draw_frame()
+			FrameArena* frame_arena_ = nullptr;
+			//Heap allocations of the last drawn frame, always 0 without SCRAP_COUNT_ALLOCATIONS
+			std::atomic<uint64_t> frame_allocations_{0};
+			//Frames drawn since the last command buffer swap, after steady_frame_count the scene is steady
+			uint32_t frames_since_swap_ = 0;
+			static const uint32_t steady_frame_count = 60;
+			//Allocations of the first steady frame that allocated, checked by the game thread
+			std::atomic<uint64_t> steady_frame_allocations_{0};
+
+			//Priority of the command buffer recordings, the game tasks use a lower one
+			//The waits of the render thread run only the tasks of this priority, so a game task picked up
+			//while waiting can't delay the frame
+			static const enki::TaskPriority render_task_priority = enki::TASK_PRIORITY_HIGH;
+
+			//Draw the published snapshot while the game thread simulates the next frame
+			//Pinned to the last worker, so the main thread never picks it while waiting for other tasks
+			struct ParallelFrameRender : enki::IPinnedTask
+			{
+				RenderManager* owner;
+				void Execute() override;
+			};
+
+			ParallelFrameRender* frame_render_task_;
 		public:
-			RenderManager(const game_base_info* received_base_game_info);
+			RenderManager(const game_base_info* received_base_game_info, enki::TaskScheduler* task_scheduler);
 			~RenderManager();
 		private:
 			void initialize_vulkan(const game_base_info* received_base_game_info);
-			void initialize_scheduler();
 			void initialize_gui(float width, float height);
 			void initialize_command_buffers();
 			void initialize_gui_command_buffers();
@@ -147,18 +296,43 @@ namespace ScrapEngine
 			void create_queues();
 			void delete_queues() const;
 
-			void rebuild_gui_command_buffer(bool for_next_image = true) const;
+			void rebuild_gui_command_buffer(uint16_t index) const;
+			void delete_gui_command_buffers() const;
 
-			void wait_cleanup_task();
 			void wait_gui_commandbuffer_task();
 			void wait_command_buffer_task();
 			void wait_pre_frame_tasks();
 
 			void cleanup_meshes();
+			//Create the requested skybox and retire the old ones not recorded by the command buffers anymore
+			void apply_skybox_changes();
+			//Load the meshes read by the worker, insert the added ones and mark the removed ones for deletion
+			void apply_scene_changes();
+			//Start the worker on the meshes added so far, if it's not running
+			void start_mesh_file_reading();
+			//Move a few vertex and index buffers, executed at the render sync
+			//Only the frames in flight are waited, then the command buffers are recorded again if something moved
+			void defragment_memory_step();
+			//Retire the buffers moved by the last step if no command buffer in use reads them
+			bool retire_defragmented_buffers();
+			void free_defragmentation_command_buffer();
+			//Destroy a std::vector<VulkanMemoryAllocator::moved_buffer>, used by the deletion queue
+			static void destroy_moved_buffers(void* moved_buffers);
+			void update_memory_statistics();
 			void create_command_buffer(bool flip_flop);
+			//Take the current resolution of the DynamicResolution (or of the TemporalUpscaler when the dynamic
+			//resolution is disabled) for the next recording of the command buffer
+			void latch_render_extent(bool flip_flop);
+			//Take the meshes of the render snapshot, the skybox and the camera for the next recording of the command buffer
+			void latch_render_scene(bool flip_flop);
 			void check_start_new_thread();
 			bool swap_command_buffers();
 			void delete_command_buffers() const;
+			void create_render_graph();
+			//Record the primary command buffer of the current frame executing the render graph
+			vk::CommandBuffer record_frame_command_buffer();
+			//Submit the frame and keep track of the frame value used by the command buffers
+			void submit_frame(const vk::SubmitInfo& submit_info);
 
 			void cleanup_swap_chain();
 			void recreate_swap_chain();
@@ -166,8 +340,14 @@ namespace ScrapEngine
 			void update_objects_and_buffers();
 
 			void create_camera();
+
+			//Write the published snapshot in the render side of the meshes, the light and the camera
+			void apply_render_world();
+
+			//Standard draw frame call, executed by the render thread
+			void draw_frame();
 		public:
-			//Rebuild the command buffer
+			//Merge the static meshes and rebuild the command buffers
 			//Is better to call this before starting the main loop
 			//So there's a command buffer ready to use with all the objects loaded
 			void prepare_to_draw_frame();
@@ -177,26 +357,80 @@ namespace ScrapEngine
 			//Is useful because doesn't call multithreaded tasks
 			void draw_loading_frame();
 
-			//Standard draw frame call
-			void draw_frame();
+			//---game thread
+			//Copy the render relevant state of the game in the render world, at the end of the game frame
+			void extract_render_world();
+			//Publish the extracted state and start to draw it in the render thread
+			void begin_frame_render();
+			//Wait the render thread, after this the game can load and edit the render resources again
+			void wait_frame_render();
+			//Fatal error if a steady frame allocated, only with SCRAP_COUNT_ALLOCATIONS (AllocationCheck configuration)
+			void check_steady_frame_allocations() const;
 
 			//Wait for the render device to be in idle state
 			void wait_device_idle() const;
 
+			//Start the defragmentation of the vertex and index buffers (ex: after a level streaming)
+			//It runs in small steps at the next render syncs, the steps never wait the gpu
+			void request_memory_defragmentation();
+			bool is_memory_defragmentation_running() const;
+			//Compare the temporal resolve without history with the one after frame_count frames
+			//The camera must not move, the result is printed in the console log, see TemporalImageCheck
+			//Return false if the temporal upscaling is disabled
+			bool request_temporal_upscaling_check(uint32_t frame_count, float max_mean_error);
+			//Fatal error if the temporal upscaling check didn't pass, used by the test runs
+			//The device must be idle, a check waiting its last frame is completed here
+			void finish_temporal_upscaling_check();
+			//Refreshed every memory_statistics_interval frames
+			const VulkanMemoryAllocator::memory_statistics& get_memory_statistics() const;
+
+			//Release the pooled buffers, textures and pipelines not used by any mesh (ex: after unloading a level)
+			//They are destroyed when the frames that used them are completed, without waiting the device
+			//Called from the game thread, see RenderManagerView
+			void release_unused_resources();
+
 			//3D mesh and scene stuff
-			VulkanMeshInstance* load_mesh(const std::string& vertex_shader_path,
-			                              const std::string& fragment_shader_path,
-			                              const std::string& model_path,
-			                              const std::vector<std::string>& textures_path);
-			VulkanMeshInstance* load_mesh(const std::string& model_path,
-			                              const std::vector<std::string>& textures_path);
-			VulkanSkyboxInstance* load_skybox(const std::array<std::string, 6>& files_path);
+			//Can be called from the game thread and the parallel game objects, the handle is reserved atomically
+			//The mesh is inserted at the next render sync, then a worker reads its files and the following
+			//sync creates its gpu resources
+			//mesh_instance receives the new instance, its game state can be written while the handle is reserved
+			slot_handle load_mesh(const std::string& vertex_shader_path,
+			                      const std::string& fragment_shader_path,
+			                      const std::string& model_path,
+			                      const std::vector<std::string>& textures_path,
+			                      VulkanMeshInstance** mesh_instance = nullptr);
+			slot_handle load_mesh(const std::string& model_path,
+			                      const std::vector<std::string>& textures_path,
+			                      VulkanMeshInstance** mesh_instance = nullptr);
+			//Return nullptr if the mesh has been deleted or if it's not inserted yet
+			VulkanMeshInstance* get_mesh(const slot_handle& mesh) const;
+			//True from load_mesh() to the render sync that inserts the mesh
+			bool is_mesh_reserved(const slot_handle& mesh) const;
+			//The mesh is deleted when no command buffer uses it anymore, then the handle becomes stale
+			void unload_mesh(const slot_handle& mesh);
+			//The skybox replaces the current one at the next render sync, then the command buffers record it
+			//when they are recorded again, the old one is deleted once the frames that drew it are completed
+			//Called from the game thread
+			void load_skybox(const std::array<std::string, 6>& files_path);
+			//Applied at the next render sync, to the current skybox and the next loaded ones
+			void set_skybox_size(unsigned int new_size);
 
 			//User-Window stuff
 			GameWindow* get_game_window() const;
 
 			//Shadow manager
 			StandardShadowmapping* get_shadowmapping_manager() const;
+			//Game side of the render state, the light and the camera changes are written here
+			RenderWorld* get_render_world() const;
+
+			//Scene resolution scaling, the changes are used by the next recorded command buffer
+			//The scale is used only if the dynamic resolution (or the temporal upscaling) is enabled at the start,
+			//otherwise the scene is drawn directly in the swap chain image at full resolution
+			DynamicResolution* get_dynamic_resolution() const;
+			//Always created, the pass times are shown only if requested in game_base_info
+			GpuPassProfiler* get_gpu_pass_profiler() const;
+			//nullptr if the temporal upscaling is disabled
+			TemporalUpscaler* get_temporal_upscaler() const;
 
 			//View-Camera stuff
 			Camera* get_render_camera() const;
@@ -206,6 +440,8 @@ namespace ScrapEngine
 			//Gui stuff
 			void pre_gui_render() const;
 			void post_gui_render();
+			//Overlay with the draw calls and binds of the scene
+			void set_show_render_stats(bool show);
 		};
 	}
 }
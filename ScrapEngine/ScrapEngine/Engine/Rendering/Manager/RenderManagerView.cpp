@@ -11,3 +11,30 @@ ScrapEngine::Render::GameWindow* ScrapEngine::Render::RenderManagerView::get_gam
 {
 	return render_manager_ref_->get_game_window();
 }
+
+void ScrapEngine::Render::RenderManagerView::request_memory_defragmentation() const
+{
+	render_manager_ref_->request_memory_defragmentation();
+}
+
+bool ScrapEngine::Render::RenderManagerView::is_memory_defragmentation_running() const
+{
+	return render_manager_ref_->is_memory_defragmentation_running();
+}
+
+bool ScrapEngine::Render::RenderManagerView::request_temporal_upscaling_check(const uint32_t frame_count,
+                                                                            const float max_mean_error) const
+{
+	return render_manager_ref_->request_temporal_upscaling_check(frame_count, max_mean_error);
+}
+
+void ScrapEngine::Render::RenderManagerView::release_unused_resources() const
+{
+	render_manager_ref_->release_unused_resources();
+}
+
+const ScrapEngine::Render::VulkanMemoryAllocator::memory_statistics& ScrapEngine::Render::RenderManagerView::
+get_memory_statistics() const
+{
+	return render_manager_ref_->get_memory_statistics();
+}
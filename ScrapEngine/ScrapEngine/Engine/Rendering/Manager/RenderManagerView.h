@@ -1,5 +1,8 @@
 #pragma once
 
+#include <Engine/Rendering/Memory/VulkanMemoryAllocator.h>
+#include <Engine/Rendering/TemporalUpscaling/TemporalImageCheck.h>
+
 namespace ScrapEngine
 {
 	namespace Render
@@ -16,6 +19,20 @@ namespace ScrapEngine
 			~RenderManagerView() = default;
 
 			GameWindow* get_game_window() const;
+
+			//Defragment the vertex and index buffers in small steps during the next frames
+			//Useful after many meshes have been loaded and unloaded
+			void request_memory_defragmentation() const;
+			bool is_memory_defragmentation_running() const;
+			//Image diff check of the temporal upscaling, the camera must not move until the result is logged
+			bool request_temporal_upscaling_check(
+				uint32_t frame_count = TemporalImageCheck::default_frame_count,
+				float max_mean_error = TemporalImageCheck::default_max_mean_error) const;
+			//Release the pooled buffers, textures and pipelines not used by the loaded meshes
+			//Call it after unloading a level, the meshes removed in the same frame are released the next time
+			void release_unused_resources() const;
+			//Allocator statistics and heaps budget, refreshed every few seconds
+			const VulkanMemoryAllocator::memory_statistics& get_memory_statistics() const;
 		};
 	}
 }
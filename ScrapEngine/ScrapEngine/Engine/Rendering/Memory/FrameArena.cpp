@@ -0,0 +1,54 @@
+#include <Engine/Rendering/Memory/FrameArena.h>
+#include <algorithm>
+
+ScrapEngine::Render::FrameArena::FrameArena(const size_t capacity)
+	: block_(new uint8_t[capacity]), capacity_(capacity)
+{
+}
+
+void* ScrapEngine::Render::FrameArena::allocate(const size_t size, const size_t alignment)
+{
+	const uintptr_t base = reinterpret_cast<uintptr_t>(block_.get());
+	const uintptr_t aligned = (base + offset_ + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+	const size_t new_offset = static_cast<size_t>(aligned - base) + size;
+	if (new_offset <= capacity_)
+	{
+		offset_ = new_offset;
+		return reinterpret_cast<void*>(aligned);
+	}
+	//Out of space, this frame uses a dedicated block and the next reset() grows the main one
+	overflow_blocks_.emplace_back(new uint8_t[size + alignment]);
+	overflow_size_ += size + alignment;
+	const uintptr_t overflow_base = reinterpret_cast<uintptr_t>(overflow_blocks_.back().get());
+	return reinterpret_cast<void*>((overflow_base + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1));
+}
+
+void ScrapEngine::Render::FrameArena::reset()
+{
+	const size_t used_size = get_used_size();
+	peak_size_ = std::max(peak_size_, used_size);
+	if (!overflow_blocks_.empty())
+	{
+		overflow_blocks_.clear();
+		overflow_size_ = 0;
+		//The peak with some margin, so a slightly bigger frame doesn't overflow again
+		capacity_ = peak_size_ + peak_size_ / 2;
+		block_.reset(new uint8_t[capacity_]);
+	}
+	offset_ = 0;
+}
+
+size_t ScrapEngine::Render::FrameArena::get_capacity() const
+{
+	return capacity_;
+}
+
+size_t ScrapEngine::Render::FrameArena::get_used_size() const
+{
+	return offset_ + overflow_size_;
+}
+
+size_t ScrapEngine::Render::FrameArena::get_peak_size() const
+{
+	return peak_size_;
+}
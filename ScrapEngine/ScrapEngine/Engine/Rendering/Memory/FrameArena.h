@@ -0,0 +1,56 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <type_traits>
+#include <cstdint>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		//Linear allocator for the transient data of a frame, everything is released at once by reset()
+		//When a frame needs more than the capacity the extra memory comes from overflow blocks,
+		//then reset() grows the main block to the peak usage, so the following frames don't allocate
+		//Not thread safe, every thread that records a frame must use its own arena
+		class FrameArena
+		{
+		private:
+			std::unique_ptr<uint8_t[]> block_;
+			size_t capacity_ = 0;
+			size_t offset_ = 0;
+			//Used only by the frames bigger than the capacity
+			std::vector<std::unique_ptr<uint8_t[]>> overflow_blocks_;
+			size_t overflow_size_ = 0;
+			size_t peak_size_ = 0;
+		public:
+			explicit FrameArena(size_t capacity);
+			~FrameArena() = default;
+			FrameArena(const FrameArena&) = delete;
+			FrameArena& operator=(const FrameArena&) = delete;
+
+			//alignment must be a power of two
+			void* allocate(size_t size, size_t alignment);
+
+			//Uninitialized memory, the destructors are never called
+			template <typename T>
+			T* allocate_array(size_t count);
+
+			//Release all the allocations of the frame, called at the start of every frame
+			void reset();
+
+			size_t get_capacity() const;
+			//Memory used by the current frame, overflow included
+			size_t get_used_size() const;
+			//Biggest frame since the creation
+			size_t get_peak_size() const;
+		};
+
+		template <typename T>
+		T* FrameArena::allocate_array(const size_t count)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "FrameArena never calls the destructors");
+			return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+		}
+	}
+}
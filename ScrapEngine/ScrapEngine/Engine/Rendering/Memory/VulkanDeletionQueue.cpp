@@ -0,0 +1,137 @@
+#include <Engine/Rendering/Memory/VulkanDeletionQueue.h>
+#include <Engine/Rendering/Semaphores/VulkanFrameTimeline.h>
+#include <Engine/Debug/CpuProfiler.h>
+
+//Init static instance reference
+
+ScrapEngine::Render::VulkanDeletionQueue* ScrapEngine::Render::VulkanDeletionQueue::instance_ = nullptr;
+
+//Class
+
+void ScrapEngine::Render::VulkanDeletionQueue::init(VulkanFrameTimeline* frame_timeline)
+{
+	frame_timeline_ = frame_timeline;
+}
+
+ScrapEngine::Render::VulkanDeletionQueue::~VulkanDeletionQueue()
+{
+	flush();
+}
+
+ScrapEngine::Render::VulkanDeletionQueue* ScrapEngine::Render::VulkanDeletionQueue::get_instance()
+{
+	if (instance_ == nullptr)
+	{
+		instance_ = new VulkanDeletionQueue();
+	}
+	return instance_;
+}
+
+uint64_t ScrapEngine::Render::VulkanDeletionQueue::get_submitted_value() const
+{
+	//Without a timeline nothing has been submitted yet
+	return frame_timeline_ ? frame_timeline_->get_submitted_value() : 0;
+}
+
+void ScrapEngine::Render::VulkanDeletionQueue::push(retired_resource&& resource)
+{
+	std::lock_guard<std::mutex> lock(retired_mutex_);
+	retired_.push_back(std::move(resource));
+}
+
+void ScrapEngine::Render::VulkanDeletionQueue::destroy(retired_resource& resource)
+{
+	if (resource.destroy)
+	{
+		resource.destroy(resource.object);
+	}
+	resource.shared_object.reset();
+}
+
+void ScrapEngine::Render::VulkanDeletionQueue::retire(void (*destroy)(void*), void* object)
+{
+	retire(get_submitted_value(), destroy, object);
+}
+
+void ScrapEngine::Render::VulkanDeletionQueue::retire(const uint64_t frame_value, void (*destroy)(void*),
+                                                      void* object)
+{
+	retired_resource resource;
+	resource.frame_value = frame_value;
+	resource.destroy = destroy;
+	resource.object = object;
+	push(std::move(resource));
+}
+
+void ScrapEngine::Render::VulkanDeletionQueue::retire(std::shared_ptr<void> shared_object)
+{
+	retire(get_submitted_value(), std::move(shared_object));
+}
+
+void ScrapEngine::Render::VulkanDeletionQueue::retire(const uint64_t frame_value,
+                                                      std::shared_ptr<void> shared_object)
+{
+	retired_resource resource;
+	resource.frame_value = frame_value;
+	resource.shared_object = std::move(shared_object);
+	push(std::move(resource));
+}
+
+void ScrapEngine::Render::VulkanDeletionQueue::collect()
+{
+	SCRAP_PROFILE_FUNCTION();
+	{
+		std::lock_guard<std::mutex> lock(retired_mutex_);
+		if (retired_.empty())
+		{
+			return;
+		}
+		const uint64_t completed_value = frame_timeline_->get_completed_value();
+		//Keep the order of the pending ones, the completed are moved to completed_
+		size_t pending = 0;
+		for (retired_resource& resource : retired_)
+		{
+			if (resource.frame_value <= completed_value)
+			{
+				completed_.push_back(std::move(resource));
+			}
+			else
+			{
+				if (&retired_[pending] != &resource)
+				{
+					retired_[pending] = std::move(resource);
+				}
+				pending++;
+			}
+		}
+		retired_.resize(pending);
+	}
+	//The destroy calls can retire other resources
+	for (retired_resource& resource : completed_)
+	{
+		destroy(resource);
+	}
+	completed_.clear();
+}
+
+void ScrapEngine::Render::VulkanDeletionQueue::flush()
+{
+	std::vector<retired_resource> retired;
+	//Again until empty because the destroy calls can retire other resources
+	while (true)
+	{
+		{
+			std::lock_guard<std::mutex> lock(retired_mutex_);
+			if (retired_.empty())
+			{
+				return;
+			}
+			retired.swap(retired_);
+		}
+		for (retired_resource& resource : retired)
+		{
+			destroy(resource);
+		}
+		retired.clear();
+	}
+}
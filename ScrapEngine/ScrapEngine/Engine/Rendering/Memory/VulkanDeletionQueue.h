@@ -0,0 +1,89 @@
+#pragma once
+
+#include <Engine/Rendering/VulkanInclude.h>
+#include <memory>
+#include <vector>
+#include <mutex>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		class VulkanFrameTimeline;
+
+		/**
+		 * \brief Resources retired with the frame value that last used them
+		 * They are destroyed in bulk once the gpu completed that value, without waiting the device
+		 * This class is a Singleton
+		 */
+		class VulkanDeletionQueue
+		{
+		private:
+			//Singleton static instance
+			static VulkanDeletionQueue* instance_;
+
+			VulkanFrameTimeline* frame_timeline_ = nullptr;
+
+			//Plain record, retiring never allocates except when the vectors grow
+			struct retired_resource
+			{
+				uint64_t frame_value = 0;
+				void (*destroy)(void*) = nullptr;
+				void* object = nullptr;
+				//Kept alive until the value is completed, then released if it was the last reference
+				std::shared_ptr<void> shared_object;
+			};
+
+			//The resources can be retired from the game thread while the render thread collects them
+			std::mutex retired_mutex_;
+			std::vector<retired_resource> retired_;
+			//Filled by collect(), so the destroy calls run outside the lock
+			std::vector<retired_resource> completed_;
+
+			//The constructor is private because this class is a Singleton
+			VulkanDeletionQueue() = default;
+
+			uint64_t get_submitted_value() const;
+			void push(retired_resource&& resource);
+			static void destroy(retired_resource& resource);
+
+			template <typename T>
+			static void delete_object(void* object)
+			{
+				delete static_cast<T*>(object);
+			}
+		public:
+			//Method used to init the class with parameters because the constructor is private
+			void init(VulkanFrameTimeline* frame_timeline);
+
+			~VulkanDeletionQueue();
+
+			static VulkanDeletionQueue* get_instance();
+
+			//The resource is destroyed when every frame submitted so far is completed
+			//The frames submitted later must not use it anymore
+			void retire(void (*destroy)(void*), void* object);
+			void retire(uint64_t frame_value, void (*destroy)(void*), void* object);
+			void retire(std::shared_ptr<void> shared_object);
+			void retire(uint64_t frame_value, std::shared_ptr<void> shared_object);
+
+			//Delete the object when the frame value is completed
+			template <typename T>
+			void retire_object(T* object)
+			{
+				retire(&delete_object<T>, object);
+			}
+
+			template <typename T>
+			void retire_object(const uint64_t frame_value, T* object)
+			{
+				retire(frame_value, &delete_object<T>, object);
+			}
+
+			//Destroy the resources whose frame value is completed, called once per frame
+			void collect();
+			//Destroy everything, the device must be idle
+			void flush();
+		};
+	}
+}
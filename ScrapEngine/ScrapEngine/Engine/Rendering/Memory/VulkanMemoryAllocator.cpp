@@ -2,6 +2,9 @@
 
 #include <Engine/Rendering/Memory/VulkanMemoryAllocator.h>
 #include <Engine/Debug/DebugLog.h>
+#include <Engine/Rendering/Instance/VukanInstance.h>
+#include <algorithm>
+#include <unordered_map>
 
 //Init static instance reference
 
@@ -10,11 +13,22 @@ ScrapEngine::Render::VulkanMemoryAllocator* ScrapEngine::Render::VulkanMemoryAll
 //Class
 
 void ScrapEngine::Render::VulkanMemoryAllocator::init(const vk::PhysicalDevice physical_device,
-                                                      const vk::Device logical_device)
+                                                      const vk::Device logical_device,
+                                                      const bool memory_budget_enabled)
 {
+	device_ = logical_device;
+	memory_budget_enabled_ = memory_budget_enabled;
+
 	VmaAllocatorCreateInfo allocator_info = {};
 	allocator_info.physicalDevice = physical_device;
 	allocator_info.device = logical_device;
+	allocator_info.instance = *VukanInstance::get_instance()->get_vulkan_instance();
+	allocator_info.vulkanApiVersion = VK_API_VERSION_1_1;
+	if (memory_budget_enabled_)
+	{
+		//Query the real heap usage and budget from the driver
+		allocator_info.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+	}
 
 	vmaCreateAllocator(&allocator_info, &allocator_);
 }
@@ -43,6 +57,11 @@ void ScrapEngine::Render::VulkanMemoryAllocator::destroy_image(vk::Image& image,
 	vmaDestroyImage(allocator_, image, image_alloc);
 }
 
+void ScrapEngine::Render::VulkanMemoryAllocator::free_memory(VmaAllocation& alloc) const
+{
+	vmaFreeMemory(allocator_, alloc);
+}
+
 void ScrapEngine::Render::VulkanMemoryAllocator::map_buffer_allocation(VmaAllocation& buff_alloc, void** data) const
 {
 	const VkResult res = vmaMapMemory(allocator_, buff_alloc, &(*data));
@@ -76,6 +95,28 @@ void ScrapEngine::Render::VulkanMemoryAllocator::bind_buffer(vk::Buffer& buffer,
 	}
 }
 
+void ScrapEngine::Render::VulkanMemoryAllocator::bind_image(vk::Image& image, VmaAllocation& image_alloc,
+                                                            const vk::DeviceSize offset) const
+{
+	const VkResult res = vmaBindImageMemory2(allocator_, image_alloc, offset, image, nullptr);
+
+	if (res != VK_SUCCESS)
+	{
+		Debug::DebugLog::fatal_error(res, "[VulkanMemoryAllocator][bind_image] Unable to bind image memory!");
+	}
+}
+
+bool ScrapEngine::Render::VulkanMemoryAllocator::is_allocation_host_coherent(const VmaAllocation& buff_alloc) const
+{
+	VmaAllocationInfo alloc_info;
+	vmaGetAllocationInfo(allocator_, buff_alloc, &alloc_info);
+
+	VkMemoryPropertyFlags memory_flags;
+	vmaGetMemoryTypeProperties(allocator_, alloc_info.memoryType, &memory_flags);
+
+	return (memory_flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+}
+
 void ScrapEngine::Render::VulkanMemoryAllocator::create_generic_buffer(const vk::BufferCreateInfo* buff_info,
                                                                        const VmaAllocationCreateInfo* alloc_info,
                                                                        vk::Buffer& buffer,
@@ -99,8 +140,9 @@ void ScrapEngine::Render::VulkanMemoryAllocator::create_vertex_index_buffer(cons
                                                                             vk::Buffer& buffer,
                                                                             VmaAllocation& buff_alloc) const
 {
+	//Static geometry, written once with a staging buffer and only read by the GPU
+	//Don't require HOST_VISIBLE or the data will end up in slow host memory on discrete GPUs
 	VmaAllocationCreateInfo alloc_info = {};
-	alloc_info.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
 	alloc_info.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 	alloc_info.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
@@ -117,9 +159,11 @@ void ScrapEngine::Render::VulkanMemoryAllocator::create_uniform_buffer(const vk:
 		vk::SharingMode::eExclusive
 	);
 
+	//Dynamic data written by the CPU every frame
 	VmaAllocationCreateInfo alloc_info = {};
 	alloc_info.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-	alloc_info.preferredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+	alloc_info.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+	alloc_info.preferredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
 
 	create_generic_buffer(&buffer_info, &alloc_info, buffer, buff_alloc);
 }
@@ -135,9 +179,29 @@ void ScrapEngine::Render::VulkanMemoryAllocator::create_transfer_staging_buffer(
 		vk::SharingMode::eExclusive
 	);
 
+	//Written once by the CPU and read once by a transfer
 	VmaAllocationCreateInfo alloc_info = {};
 	alloc_info.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-	alloc_info.preferredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+	alloc_info.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+	create_generic_buffer(&buffer_info, &alloc_info, buffer, buff_alloc);
+}
+
+void ScrapEngine::Render::VulkanMemoryAllocator::create_readback_buffer(
+	const vk::DeviceSize size, vk::Buffer& buffer,
+	VmaAllocation& buff_alloc) const
+{
+	const vk::BufferCreateInfo buffer_info(
+		vk::BufferCreateFlags(),
+		size,
+		vk::BufferUsageFlagBits::eTransferDst,
+		vk::SharingMode::eExclusive
+	);
+
+	//Coherent, so the CPU doesn't need to invalidate it before reading
+	VmaAllocationCreateInfo alloc_info = {};
+	alloc_info.usage = VMA_MEMORY_USAGE_GPU_TO_CPU;
+	alloc_info.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
 
 	create_generic_buffer(&buffer_info, &alloc_info, buffer, buff_alloc);
 }
@@ -172,6 +236,207 @@ void ScrapEngine::Render::VulkanMemoryAllocator::create_texture_image(const vk::
 	create_generic_image(image_info, &alloc_info, image, image_alloc);
 }
 
+void ScrapEngine::Render::VulkanMemoryAllocator::create_transient_attachment_image(
+	const vk::ImageCreateInfo* image_info, vk::Image& image, VmaAllocation& image_alloc) const
+{
+	VmaAllocationCreateInfo alloc_info = {};
+	alloc_info.usage = VMA_MEMORY_USAGE_UNKNOWN;
+	alloc_info.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+
+	VkImage alloc_image;
+	const VkImageCreateInfo* conv_image_info = convert_image_create_info(image_info);
+
+	const VkResult res = vmaCreateImage(allocator_, conv_image_info, &alloc_info, &alloc_image, &image_alloc, nullptr);
+
+	if (res == VK_ERROR_FEATURE_NOT_PRESENT)
+	{
+		//No lazily allocated memory type (usually desktop gpus), use standard device memory
+		create_texture_image(image_info, image, image_alloc);
+		return;
+	}
+
+	if (res != VK_SUCCESS)
+	{
+		Debug::DebugLog::fatal_error(
+			res, "[VulkanMemoryAllocator][create_transient_attachment_image] Unable to create image!");
+	}
+
+	image = alloc_image;
+}
+
+void ScrapEngine::Render::VulkanMemoryAllocator::allocate_aliasable_memory(const vk::MemoryRequirements& requirements,
+                                                                           VmaAllocation& alloc) const
+{
+	VmaAllocationCreateInfo alloc_info = {};
+	alloc_info.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+	alloc_info.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+	const VkMemoryRequirements conv_requirements = requirements;
+
+	const VkResult res = vmaAllocateMemory(allocator_, &conv_requirements, &alloc_info, &alloc, nullptr);
+
+	if (res != VK_SUCCESS)
+	{
+		Debug::DebugLog::fatal_error(
+			res, "[VulkanMemoryAllocator][allocate_aliasable_memory] Unable to allocate memory!");
+	}
+}
+
+void ScrapEngine::Render::VulkanMemoryAllocator::set_current_frame_index(const uint32_t frame_index) const
+{
+	vmaSetCurrentFrameIndex(allocator_, frame_index);
+}
+
+bool ScrapEngine::Render::VulkanMemoryAllocator::is_memory_budget_enabled() const
+{
+	return memory_budget_enabled_;
+}
+
+std::vector<ScrapEngine::Render::VulkanMemoryAllocator::memory_heap_budget> ScrapEngine::Render::
+VulkanMemoryAllocator::get_heaps_budget() const
+{
+	const VkPhysicalDeviceMemoryProperties* memory_properties = nullptr;
+	vmaGetMemoryProperties(allocator_, &memory_properties);
+
+	VmaBudget budgets[VK_MAX_MEMORY_HEAPS] = {};
+	vmaGetBudget(allocator_, budgets);
+
+	std::vector<memory_heap_budget> heaps(memory_properties->memoryHeapCount);
+	for (uint32_t i = 0; i < memory_properties->memoryHeapCount; i++)
+	{
+		heaps[i].block_bytes = budgets[i].blockBytes;
+		heaps[i].allocation_bytes = budgets[i].allocationBytes;
+		heaps[i].usage = budgets[i].usage;
+		heaps[i].budget = budgets[i].budget;
+		heaps[i].device_local = (memory_properties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+	}
+
+	return heaps;
+}
+
+ScrapEngine::Render::VulkanMemoryAllocator::memory_statistics ScrapEngine::Render::VulkanMemoryAllocator::
+get_memory_statistics() const
+{
+	VmaStats stats;
+	vmaCalculateStats(allocator_, &stats);
+
+	memory_statistics statistics;
+	statistics.block_count = stats.total.blockCount;
+	statistics.allocation_count = stats.total.allocationCount;
+	statistics.unused_range_count = stats.total.unusedRangeCount;
+	statistics.used_bytes = stats.total.usedBytes;
+	statistics.unused_bytes = stats.total.unusedBytes;
+	//How much of the free memory is not in the biggest free range
+	if (stats.total.unusedBytes > 0)
+	{
+		statistics.fragmentation = 1.f - static_cast<float>(stats.total.unusedRangeSizeMax) /
+			static_cast<float>(stats.total.unusedBytes);
+	}
+	statistics.heaps = get_heaps_budget();
+
+	return statistics;
+}
+
+void ScrapEngine::Render::VulkanMemoryAllocator::register_defragmentable_buffer(vk::Buffer* buffer,
+                                                                                VmaAllocation* buff_alloc,
+                                                                                const vk::BufferCreateInfo&
+                                                                                buff_info)
+{
+	defragmentable_buffer entry;
+	entry.buffer = buffer;
+	entry.buff_alloc = buff_alloc;
+	entry.buff_info = buff_info;
+	//The buffer will be recreated later, don't keep pointers owned by the caller
+	entry.buff_info.setQueueFamilyIndexCount(0);
+	entry.buff_info.setPQueueFamilyIndices(nullptr);
+	entry.buff_info.setPNext(nullptr);
+
+	std::lock_guard<std::mutex> lock(defragmentable_buffers_mutex_);
+	defragmentable_buffers_.push_back(entry);
+}
+
+void ScrapEngine::Render::VulkanMemoryAllocator::unregister_defragmentable_buffer(const vk::Buffer* buffer)
+{
+	std::lock_guard<std::mutex> lock(defragmentable_buffers_mutex_);
+	defragmentable_buffers_.erase(std::remove_if(
+		                              defragmentable_buffers_.begin(),
+		                              defragmentable_buffers_.end(),
+		                              [buffer](const defragmentable_buffer& entry)
+		                              {
+			                              return entry.buffer == buffer;
+		                              }),
+	                              defragmentable_buffers_.end());
+}
+
+bool ScrapEngine::Render::VulkanMemoryAllocator::defragment_buffers(const vk::DeviceSize max_bytes_to_move,
+                                                                    const uint32_t max_allocations_to_move,
+                                                                    const vk::CommandBuffer command_buffer,
+                                                                    std::vector<moved_buffer>& old_buffers)
+{
+	std::lock_guard<std::mutex> lock(defragmentable_buffers_mutex_);
+	if (defragmentable_buffers_.empty())
+	{
+		return false;
+	}
+
+	//Bytes of the registered buffers in every memory block
+	std::vector<VmaAllocationInfo> allocations_info(defragmentable_buffers_.size());
+	std::unordered_map<VkDeviceMemory, vk::DeviceSize> block_usage;
+	for (size_t i = 0; i < defragmentable_buffers_.size(); i++)
+	{
+		vmaGetAllocationInfo(allocator_, *defragmentable_buffers_[i].buff_alloc, &allocations_info[i]);
+		block_usage[allocations_info[i].deviceMemory] += allocations_info[i].size;
+	}
+	//The buffers of the emptiest blocks are moved first, so those blocks can be released
+	std::vector<size_t> order(defragmentable_buffers_.size());
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), [&allocations_info, &block_usage](const size_t a, const size_t b)
+	{
+		return block_usage[allocations_info[a].deviceMemory] < block_usage[allocations_info[b].deviceMemory];
+	});
+
+	vk::DeviceSize moved_bytes = 0;
+	uint32_t moved_allocations = 0;
+	for (const size_t index : order)
+	{
+		if (moved_allocations >= max_allocations_to_move || moved_bytes >= max_bytes_to_move)
+		{
+			break;
+		}
+		defragmentable_buffer& entry = defragmentable_buffers_[index];
+		const VmaAllocationInfo& old_info = allocations_info[index];
+
+		moved_buffer new_buffer;
+		create_vertex_index_buffer(&entry.buff_info, new_buffer.buffer, new_buffer.allocation);
+		VmaAllocationInfo new_info;
+		vmaGetAllocationInfo(allocator_, new_buffer.allocation, &new_info);
+		//Only towards a fuller block, so the steps always end
+		if (new_info.deviceMemory == old_info.deviceMemory ||
+			block_usage[new_info.deviceMemory] <= block_usage[old_info.deviceMemory])
+		{
+			destroy_buffer(new_buffer.buffer, new_buffer.allocation);
+			continue;
+		}
+		block_usage[old_info.deviceMemory] -= old_info.size;
+		block_usage[new_info.deviceMemory] += new_info.size;
+
+		const vk::BufferCopy copy_region(0, 0, entry.buff_info.size);
+		command_buffer.copyBuffer(*entry.buffer, new_buffer.buffer, 1, &copy_region);
+
+		old_buffers.push_back({*entry.buffer, *entry.buff_alloc});
+		*entry.buffer = new_buffer.buffer;
+		*entry.buff_alloc = new_buffer.allocation;
+
+		moved_bytes += old_info.size;
+		moved_allocations++;
+	}
+
+	return moved_allocations > 0;
+}
+
 const VkBufferCreateInfo* ScrapEngine::Render::VulkanMemoryAllocator::convert_buffer_create_info(
 	const vk::BufferCreateInfo* buffer_info)
 {
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Engine/Rendering/VulkanInclude.h>
+#include <vector>
+#include <mutex>
 
 namespace ScrapEngine
 {
@@ -13,17 +15,67 @@ namespace ScrapEngine
 		 */
 		class VulkanMemoryAllocator
 		{
+		public:
+			//Budget of a single memory heap, all values are in bytes
+			struct memory_heap_budget
+			{
+				//Memory allocated from vulkan (blocks)
+				vk::DeviceSize block_bytes = 0;
+				//Memory used by the allocations inside the blocks
+				vk::DeviceSize allocation_bytes = 0;
+				//Estimated usage of the heap by this process (requires VK_EXT_memory_budget to be exact)
+				vk::DeviceSize usage = 0;
+				//Estimated amount of memory this process can use before going over the limit
+				vk::DeviceSize budget = 0;
+				bool device_local = false;
+			};
+
+			//Global statistics of the allocator
+			struct memory_statistics
+			{
+				uint32_t block_count = 0;
+				uint32_t allocation_count = 0;
+				uint32_t unused_range_count = 0;
+				vk::DeviceSize used_bytes = 0;
+				vk::DeviceSize unused_bytes = 0;
+				//0 means all the free memory is in a single range, 1 means it is completely fragmented
+				float fragmentation = 0.f;
+				std::vector<memory_heap_budget> heaps;
+			};
+
+			//Buffer and memory replaced by the defragmentation, still readable by the work recorded before the move
+			struct moved_buffer
+			{
+				vk::Buffer buffer;
+				VmaAllocation allocation = nullptr;
+			};
 		private:
 			//Singleton static instance
 			static VulkanMemoryAllocator* instance_;
 
 			VmaAllocator allocator_;
+			vk::Device device_;
+			bool memory_budget_enabled_ = false;
+
+			//Buffers that the defragmentation is allowed to move
+			//The new handle and allocation are written in place, so who holds the vk::Buffer* will see them
+			struct defragmentable_buffer
+			{
+				vk::Buffer* buffer = nullptr;
+				VmaAllocation* buff_alloc = nullptr;
+				vk::BufferCreateInfo buff_info;
+			};
+
+			//The meshes are loaded by other threads while a defragmentation step can run
+			std::mutex defragmentable_buffers_mutex_;
+			std::vector<defragmentable_buffer> defragmentable_buffers_;
 
 			//The constructor is private because this class is a Singleton
 			VulkanMemoryAllocator() = default;
 		public:
 			//Method used to init the class with parameters because the constructor is private
-			void init(vk::PhysicalDevice physical_device, vk::Device logical_device);
+			//If memory_budget_enabled is true VK_EXT_memory_budget must be enabled on the logical device
+			void init(vk::PhysicalDevice physical_device, vk::Device logical_device, bool memory_budget_enabled = false);
 
 			~VulkanMemoryAllocator();
 
@@ -35,6 +87,7 @@ namespace ScrapEngine
 
 			void destroy_buffer(vk::Buffer& buffer, VmaAllocation& buff_alloc) const;
 			void destroy_image(vk::Image& image, VmaAllocation& image_alloc) const;
+			void free_memory(VmaAllocation& alloc) const;
 
 			//-----------------------------------
 			// Utils to bind, map and unmap memory
@@ -45,6 +98,9 @@ namespace ScrapEngine
 			void flush_buffer_allocation(VmaAllocation& buff_alloc, vk::DeviceSize size,
 			                             vk::DeviceSize offset) const;
 			void bind_buffer(vk::Buffer& buffer, VmaAllocation& buff_alloc, vk::DeviceSize offset = 0) const;
+			void bind_image(vk::Image& image, VmaAllocation& image_alloc, vk::DeviceSize offset = 0) const;
+			//Return true if the memory doesn't need to be flushed after a write
+			bool is_allocation_host_coherent(const VmaAllocation& buff_alloc) const;
 
 			//-----------------------------------
 			// Calls to create buffers
@@ -62,6 +118,10 @@ namespace ScrapEngine
 			void create_transfer_staging_buffer(vk::DeviceSize size, vk::Buffer& buffer,
 			                                    VmaAllocation& buff_alloc) const;
 
+			//Written by a transfer and read back by the CPU, host coherent
+			void create_readback_buffer(vk::DeviceSize size, vk::Buffer& buffer,
+			                            VmaAllocation& buff_alloc) const;
+
 			//-----------------------------------
 			// Calls to create images
 			//-----------------------------------
@@ -71,6 +131,47 @@ namespace ScrapEngine
 
 			void create_texture_image(const vk::ImageCreateInfo* image_info,
 			                          vk::Image& image, VmaAllocation& image_alloc) const;
+
+			//Attachments used only inside a render pass (created with eTransientAttachment)
+			//Lazily allocated memory is used if available, so tiled gpus may never back them with memory
+			void create_transient_attachment_image(const vk::ImageCreateInfo* image_info,
+			                                       vk::Image& image, VmaAllocation& image_alloc) const;
+
+			//Allocate device memory not bound to any resource
+			//Used to alias more images with bind_image(), the caller must synchronize their usage
+			void allocate_aliasable_memory(const vk::MemoryRequirements& requirements,
+			                               VmaAllocation& alloc) const;
+
+			//-----------------------------------
+			// Budget and statistics
+			//-----------------------------------
+
+			//Must be called once per frame, used to refresh the budget values
+			void set_current_frame_index(uint32_t frame_index) const;
+
+			bool is_memory_budget_enabled() const;
+			std::vector<memory_heap_budget> get_heaps_budget() const;
+			//This is slow, don't call it every frame
+			memory_statistics get_memory_statistics() const;
+
+			//-----------------------------------
+			// Defragmentation
+			//-----------------------------------
+
+			//The buffer must be created with create_vertex_index_buffer(), with eTransferSrc, and must not be mapped
+			void register_defragmentable_buffer(vk::Buffer* buffer, VmaAllocation* buff_alloc,
+			                                    const vk::BufferCreateInfo& buff_info);
+			void unregister_defragmentable_buffer(const vk::Buffer* buffer);
+
+			//Run a bounded defragmentation step on the registered buffers
+			//The buffers of the emptiest memory blocks are copied to new allocations in fuller blocks, the copies
+			//are recorded in command_buffer and the old buffers are appended to old_buffers
+			//The old buffers are not overwritten, the gpu can keep reading them until they are destroyed
+			//No command buffer must be recorded with the registered buffers while this is executed
+			//The registration is blocked until the step ends
+			//Return true if at least one buffer was moved, so the command buffers using it must be recorded again
+			bool defragment_buffers(vk::DeviceSize max_bytes_to_move, uint32_t max_allocations_to_move,
+			                        vk::CommandBuffer command_buffer, std::vector<moved_buffer>& old_buffers);
 		private:
 			//-----------------------------------
 			// Conversion utils because vma allocator want vk types not vk::
@@ -10,14 +10,21 @@ ScrapEngine::Render::BasicMaterial::~BasicMaterial()
 void ScrapEngine::Render::BasicMaterial::delete_graphics_pipeline()
 {
 	vulkan_render_graphics_pipeline_ = nullptr;
+	vulkan_depth_prepass_pipeline_ = nullptr;
 }
 
-std::shared_ptr<ScrapEngine::Render::BaseVulkanGraphicsPipeline> ScrapEngine::Render::BasicMaterial::
+const std::shared_ptr<ScrapEngine::Render::BaseVulkanGraphicsPipeline>& ScrapEngine::Render::BasicMaterial::
 get_vulkan_render_graphics_pipeline() const
 {
 	return vulkan_render_graphics_pipeline_;
 }
 
+const std::shared_ptr<ScrapEngine::Render::BaseVulkanGraphicsPipeline>& ScrapEngine::Render::BasicMaterial::
+get_vulkan_depth_prepass_pipeline() const
+{
+	return vulkan_depth_prepass_pipeline_;
+}
+
 ScrapEngine::Render::BaseDescriptorSet* ScrapEngine::Render::BasicMaterial::get_vulkan_render_descriptor_set() const
 {
 	return vulkan_render_descriptor_set_;
@@ -12,6 +12,8 @@ namespace ScrapEngine
 		{
 		protected:
 			std::shared_ptr<BaseVulkanGraphicsPipeline> vulkan_render_graphics_pipeline_ = nullptr;
+			//Depth only pipeline, nullptr if the material cannot be drawn in the depth prepass
+			std::shared_ptr<BaseVulkanGraphicsPipeline> vulkan_depth_prepass_pipeline_ = nullptr;
 			BaseDescriptorSet* vulkan_render_descriptor_set_ = nullptr;
 		public:
 			BasicMaterial() = default;
@@ -19,7 +21,9 @@ namespace ScrapEngine
 
 			void delete_graphics_pipeline();
 
-			std::shared_ptr<BaseVulkanGraphicsPipeline> get_vulkan_render_graphics_pipeline() const;
+			//By reference, the recording reads them for every draw
+			const std::shared_ptr<BaseVulkanGraphicsPipeline>& get_vulkan_render_graphics_pipeline() const;
+			const std::shared_ptr<BaseVulkanGraphicsPipeline>& get_vulkan_depth_prepass_pipeline() const;
 
 			BaseDescriptorSet* get_vulkan_render_descriptor_set() const;
 		};
@@ -26,6 +26,10 @@ void ScrapEngine::Render::SimpleMaterial::create_pipeline(const std::string& ver
 		fragment_shader_path,
 		swap_chain,
 		vulkan_render_descriptor_set_->get_descriptor_set_layout());
+	//Position only, shared by all the materials
+	vulkan_depth_prepass_pipeline_ = VulkanSimpleMaterialPool::get_instance()->get_depth_prepass_pipeline(
+		swap_chain,
+		vulkan_render_descriptor_set_->get_descriptor_set_layout());
 }
 
 void ScrapEngine::Render::SimpleMaterial::create_texture(const std::string& texture_path)
@@ -38,7 +42,7 @@ void ScrapEngine::Render::SimpleMaterial::create_texture(const std::string& text
 void ScrapEngine::Render::SimpleMaterial::create_descriptor_sets(VulkanSwapChain* swap_chain,
                                                                  StandardUniformBuffer* uniform_buffer)
 {
-	const size_t size = swap_chain->get_swap_chain_images_vector()->size();
+	const size_t size = swap_chain->get_frames_in_flight();
 	//A standard model has two images, one for the depth pass and one texture, so double the size of possible descriptors
 	vulkan_render_descriptor_pool_ = new StandardDescriptorPool(size * 2);
 	StandardDescriptorSet* standard_descriptor_set = static_cast<StandardDescriptorSet*>(vulkan_render_descriptor_set_);
@@ -48,3 +52,19 @@ void ScrapEngine::Render::SimpleMaterial::create_descriptor_sets(VulkanSwapChain
 	                                                vulkan_texture_image_view_->get_texture_image_view(),
 	                                                vulkan_texture_sampler_->get_texture_sampler());
 }
+
+std::shared_ptr<ScrapEngine::Render::BaseTexture> ScrapEngine::Render::SimpleMaterial::get_texture() const
+{
+	return vulkan_texture_image_;
+}
+
+std::shared_ptr<ScrapEngine::Render::TextureImageView> ScrapEngine::Render::SimpleMaterial::
+get_texture_image_view() const
+{
+	return vulkan_texture_image_view_;
+}
+
+std::shared_ptr<ScrapEngine::Render::TextureSampler> ScrapEngine::Render::SimpleMaterial::get_texture_sampler() const
+{
+	return vulkan_texture_sampler_;
+}
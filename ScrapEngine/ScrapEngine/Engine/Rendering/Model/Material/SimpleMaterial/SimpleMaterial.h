@@ -31,6 +31,10 @@ namespace ScrapEngine
 
 			void create_descriptor_sets(VulkanSwapChain* swap_chain,
 			                            StandardUniformBuffer* uniform_buffer);
+
+			std::shared_ptr<BaseTexture> get_texture() const;
+			std::shared_ptr<TextureImageView> get_texture_image_view() const;
+			std::shared_ptr<TextureSampler> get_texture_sampler() const;
 		};
 	}
 }
@@ -59,7 +59,7 @@ void ScrapEngine::Render::SkyboxMaterial::create_skybox_texture(const std::array
 void ScrapEngine::Render::SkyboxMaterial::create_descriptor_sets(VulkanSwapChain* swap_chain,
                                                                  SkyboxUniformBuffer* uniform_buffer)
 {
-	const size_t size = swap_chain->get_swap_chain_images_vector()->size();
+	const size_t size = swap_chain->get_frames_in_flight();
 	vulkan_render_descriptor_pool_ = new StandardDescriptorPool(size);
 	SkyboxDescriptorSet* skybox_descriptor_set = static_cast<SkyboxDescriptorSet*>(vulkan_render_descriptor_set_);
 	skybox_descriptor_set->create_descriptor_sets(vulkan_render_descriptor_pool_->get_descriptor_pool(),
@@ -0,0 +1,35 @@
+#include <Engine/Rendering/Model/Material/StaticBatchMaterial/StaticBatchMaterial.h>
+#include <Engine/Rendering/Model/Material/SimpleMaterial/SimpleMaterial.h>
+#include <Engine/Rendering/Descriptor/DescriptorPool/StandardDescriptorPool/StandardDescriptorPool.h>
+#include <Engine/Rendering/Descriptor/DescriptorSet/StandardDescriptorSet/StandardDescriptorSet.h>
+#include <Engine/Rendering/SwapChain/VulkanSwapChain.h>
+#include <Engine/Rendering/Buffer/UniformBuffer/StandardUniformBuffer/StandardUniformBuffer.h>
+
+ScrapEngine::Render::StaticBatchMaterial::StaticBatchMaterial(const SimpleMaterial* source_material,
+                                                              VulkanSwapChain* swap_chain,
+                                                              StandardUniformBuffer* uniform_buffer)
+{
+	vulkan_render_graphics_pipeline_ = source_material->get_vulkan_render_graphics_pipeline();
+	vulkan_depth_prepass_pipeline_ = source_material->get_vulkan_depth_prepass_pipeline();
+	vulkan_texture_image_ = source_material->get_texture();
+	vulkan_texture_image_view_ = source_material->get_texture_image_view();
+	vulkan_texture_sampler_ = source_material->get_texture_sampler();
+
+	//Same layout of the source material, so the shared pipelines are compatible with these sets
+	StandardDescriptorSet* standard_descriptor_set = new StandardDescriptorSet();
+	vulkan_render_descriptor_set_ = standard_descriptor_set;
+
+	const size_t size = swap_chain->get_frames_in_flight();
+	//Texture and depth pass images, like the SimpleMaterial
+	vulkan_render_descriptor_pool_ = new StandardDescriptorPool(size * 2);
+	standard_descriptor_set->create_descriptor_sets(vulkan_render_descriptor_pool_->get_descriptor_pool(),
+	                                                size,
+	                                                uniform_buffer->get_uniform_buffers(),
+	                                                vulkan_texture_image_view_->get_texture_image_view(),
+	                                                vulkan_texture_sampler_->get_texture_sampler());
+}
+
+ScrapEngine::Render::StaticBatchMaterial::~StaticBatchMaterial()
+{
+	delete vulkan_render_descriptor_pool_;
+}
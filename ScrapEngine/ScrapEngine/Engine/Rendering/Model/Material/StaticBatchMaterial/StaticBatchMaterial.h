@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Engine/Rendering/Model/Material/BasicMaterial.h>
+#include <Engine/Rendering/Texture/TextureSampler/TextureSampler.h>
+#include <Engine/Rendering/Texture/TextureImageView/TextureImageView.h>
+#include <Engine/Rendering/Texture/Texture/BaseTexture.h>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		class SimpleMaterial;
+		class StandardUniformBuffer;
+		class VulkanSwapChain;
+		class BaseDescriptorPool;
+
+		//Material of a static batch, it shares pipelines and texture with the SimpleMaterial of the merged meshes
+		//The descriptor sets point to the uniform buffer of the batcher, where the model matrix is the identity
+		class StaticBatchMaterial : public BasicMaterial
+		{
+		private:
+			std::shared_ptr<BaseTexture> vulkan_texture_image_ = nullptr;
+			std::shared_ptr<TextureImageView> vulkan_texture_image_view_ = nullptr;
+			std::shared_ptr<TextureSampler> vulkan_texture_sampler_ = nullptr;
+			BaseDescriptorPool* vulkan_render_descriptor_pool_ = nullptr;
+		public:
+			StaticBatchMaterial(const SimpleMaterial* source_material, VulkanSwapChain* swap_chain,
+			                    StandardUniformBuffer* uniform_buffer);
+			~StaticBatchMaterial();
+		};
+	}
+}
@@ -2,6 +2,7 @@
 #include <Engine/Debug/DebugLog.h>
 #include <Engine/Rendering/Model/ObjectPool/VulkanModelPool/VulkanModelPool.h>
 #include <Engine/Rendering/Model/ObjectPool/VulkanModelBuffersPool/VulkanModelBuffersPool.h>
+#include <Engine/Rendering/Model/ObjectPool/VulkanSimpleMaterialPool/VulkanSimpleMaterialPool.h>
 #include <Engine/Rendering/SwapChain/VulkanSwapChain.h>
 #include <Engine/Rendering/Buffer/BufferContainer/VertexBufferContainer/VertexBufferContainer.h>
 #include <Engine/Rendering/Buffer/BufferContainer/IndicesBufferContainer/IndicesBufferContainer.h>
@@ -14,35 +15,98 @@
 #include <Engine/Rendering/Descriptor/DescriptorPool/StandardDescriptorPool/StandardDescriptorPool.h>
 #include <Engine/Rendering/Buffer/FrameBuffer/ShadowmappingFrameBuffer/ShadowmappingFrameBuffer.h>
 #include <Engine/Rendering/Camera/Camera.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/quaternion.hpp>
 
 ScrapEngine::Render::VulkanMeshInstance::VulkanMeshInstance(const std::string& vertex_shader_path,
                                                             const std::string& fragment_shader_path,
                                                             const std::string& model_path,
-                                                            const std::vector<std::string>& textures_path,
-                                                            VulkanSwapChain* swap_chain)
+                                                            const std::vector<std::string>& textures_path)
+	: vertex_shader_path_(vertex_shader_path), fragment_shader_path_(fragment_shader_path),
+	  model_path_(model_path), textures_path_(textures_path)
 {
+}
+
+void ScrapEngine::Render::VulkanMeshInstance::select_files_to_read(std::unordered_set<std::string>& selected_files)
+{
+	read_model_ = !VulkanModelPool::get_instance()->has_model(model_path_) &&
+		selected_files.insert(model_path_).second;
+	read_textures_.assign(textures_path_.size(), false);
+	for (size_t i = 0; i < textures_path_.size(); i++)
+	{
+		read_textures_[i] = !VulkanSimpleMaterialPool::get_instance()->has_standard_texture(textures_path_[i]) &&
+			selected_files.insert(textures_path_[i]).second;
+	}
+}
+
+void ScrapEngine::Render::VulkanMeshInstance::read_files()
+{
+	if (read_model_)
+	{
+		model_file_ = std::make_shared<VulkanModel>(model_path_);
+	}
+	texture_files_.resize(read_textures_.size());
+	for (size_t i = 0; i < read_textures_.size(); i++)
+	{
+		if (read_textures_[i])
+		{
+			texture_files_[i] = StandardTexture::decode(textures_path_[i]);
+		}
+	}
+}
+
+void ScrapEngine::Render::VulkanMeshInstance::load(VulkanSwapChain* swap_chain, StandardShadowmapping* shadowmapping)
+{
+	//The files read by the worker go in the pools, so the lookups below find them
+	if (model_file_)
+	{
+		VulkanModelPool::get_instance()->add_model(model_path_, model_file_);
+		model_file_ = nullptr;
+	}
+	for (size_t i = 0; i < texture_files_.size(); i++)
+	{
+		if (texture_files_[i].pixels)
+		{
+			VulkanSimpleMaterialPool::get_instance()->add_standard_texture(
+				textures_path_[i], std::make_shared<StandardTexture>(textures_path_[i], texture_files_[i]));
+		}
+	}
+	texture_files_.clear();
 	//CREATE UNIFORM BUFFER
-	vulkan_render_uniform_buffer_ = new StandardUniformBuffer(swap_chain->get_swap_chain_images_vector()->size());
-	vulkan_render_model_ = VulkanModelPool::get_instance()->get_model(model_path);
-	if (vulkan_render_model_->get_meshes()->size() != textures_path.size() && textures_path.size() > 1)
+	vulkan_render_uniform_buffer_ = new StandardUniformBuffer(swap_chain->get_frames_in_flight());
+	vulkan_render_model_ = VulkanModelPool::get_instance()->get_model(model_path_);
+	if (vulkan_render_model_->get_meshes()->size() != textures_path_.size() && textures_path_.size() > 1)
 	{
 		Debug::DebugLog::fatal_error(vk::Result(-13), "The texture array must have size 1 or equal number of meshes ("
 		                             + std::to_string(vulkan_render_model_->get_meshes()->size()) + ")");
 	}
-	for (const auto& texture_path : textures_path)
+	for (const auto& texture_path : textures_path_)
 	{
 		//CREATE MATERIAL(S)
 		SimpleMaterial* material = new SimpleMaterial();
-		material->create_pipeline(vertex_shader_path, fragment_shader_path, swap_chain);
+		material->create_pipeline(vertex_shader_path_, fragment_shader_path_, swap_chain);
 		material->create_texture(texture_path);
 		material->create_descriptor_sets(swap_chain, vulkan_render_uniform_buffer_);
 		model_materials_.push_back(material);
 	}
-	mesh_buffers_ = VulkanModelBuffersPool::get_instance()->get_model_buffers(model_path, vulkan_render_model_);
+	mesh_buffers_ = VulkanModelBuffersPool::get_instance()->get_model_buffers(model_path_, vulkan_render_model_);
+	//Write descriptor to mesh
+	init_shadowmapping_resources(shadowmapping);
+	is_loaded_ = true;
+}
+
+bool ScrapEngine::Render::VulkanMeshInstance::get_is_loaded() const
+{
+	return is_loaded_;
 }
 
 ScrapEngine::Render::VulkanMeshInstance::~VulkanMeshInstance()
 {
+	//Decoded but never loaded
+	for (StandardTexture::decoded_image& texture_file : texture_files_)
+	{
+		StandardTexture::release(texture_file);
+	}
 	// Delete the textures
 	for (auto material : model_materials_)
 	{
@@ -56,6 +120,22 @@ ScrapEngine::Render::VulkanMeshInstance::~VulkanMeshInstance()
 	delete shadowmapping_uniform_buffer_;
 }
 
+ScrapEngine::Render::VulkanMeshInstance::game_state* ScrapEngine::Render::VulkanMeshInstance::get_game_state()
+{
+	return &game_state_;
+}
+
+void ScrapEngine::Render::VulkanMeshInstance::apply_game_state(const game_state& state)
+{
+	object_location_ = state.transform;
+	is_visible_ = state.is_visible;
+	cast_shadows_ = state.cast_shadows;
+	is_static_ = state.is_static;
+	frustum_check_ = state.frustum_check;
+	frustum_sphere_radius_multiplier_ = state.frustum_check_radius;
+	pending_deletion_ = state.pending_deletion;
+}
+
 void ScrapEngine::Render::VulkanMeshInstance::set_mesh_location(const Core::SVector3& location)
 {
 	object_location_.set_position(location);
@@ -136,24 +216,24 @@ void ScrapEngine::Render::VulkanMeshInstance::set_frustum_check_radius(const flo
 	frustum_sphere_radius_multiplier_ = radius;
 }
 
-void ScrapEngine::Render::VulkanMeshInstance::set_for_deletion()
+bool ScrapEngine::Render::VulkanMeshInstance::get_is_batched() const
 {
-	pending_deletion_ = true;
+	return is_batched_;
 }
 
-bool ScrapEngine::Render::VulkanMeshInstance::get_pending_deletion() const
+void ScrapEngine::Render::VulkanMeshInstance::set_is_batched(const bool batched)
 {
-	return pending_deletion_;
+	is_batched_ = batched;
 }
 
-void ScrapEngine::Render::VulkanMeshInstance::increase_deletion_counter()
+void ScrapEngine::Render::VulkanMeshInstance::set_for_deletion()
 {
-	deletion_counter_++;
+	game_state_.pending_deletion = true;
 }
 
-uint16_t ScrapEngine::Render::VulkanMeshInstance::get_deletion_counter() const
+bool ScrapEngine::Render::VulkanMeshInstance::get_pending_deletion() const
 {
-	return deletion_counter_;
+	return pending_deletion_;
 }
 
 void ScrapEngine::Render::VulkanMeshInstance::view_frustum_check(Camera* render_camera)
@@ -190,6 +270,13 @@ bool ScrapEngine::Render::VulkanMeshInstance::get_sun_shadow_is_in_current_frust
 	return sun_shadow_is_in_current_frustum_;
 }
 
+glm::mat4 ScrapEngine::Render::VulkanMeshInstance::get_model_matrix() const
+{
+	glm::mat4 model = translate(glm::mat4(1.0f), object_location_.get_position().get_glm_vector());
+	model = model * toMat4(object_location_.get_quat_rotation().get_glm_quat());
+	return scale(model, object_location_.get_scale().get_glm_vector());
+}
+
 void ScrapEngine::Render::VulkanMeshInstance::init_shadowmapping_resources(StandardShadowmapping* shadowmapping)
 {
 	const size_t size = vulkan_render_uniform_buffer_->get_uniform_buffers()->size();
@@ -323,11 +410,11 @@ get_shadowmapping_descriptor_set() const
 	return shadowmapping_descriptor_set_;
 }
 
-std::shared_ptr<std::vector<
+const std::vector<
 	std::pair<
 		ScrapEngine::Render::VertexBufferContainer*,
 		ScrapEngine::Render::IndicesBufferContainer*>
->> ScrapEngine::Render::VulkanMeshInstance::get_mesh_buffers() const
+>* ScrapEngine::Render::VulkanMeshInstance::get_mesh_buffers() const
 {
-	return mesh_buffers_;
+	return mesh_buffers_.get();
 }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <Engine/Rendering/Model/Model/VulkanModel.h>
+#include <Engine/Rendering/Texture/Texture/StandardTexture/StandardTexture.h>
 #include <Engine/LogicCore/Math/Transform/STransform.h>
+#include <unordered_set>
 
 namespace ScrapEngine
 {
@@ -20,7 +22,34 @@ namespace ScrapEngine
 
 		class VulkanMeshInstance
 		{
+		public:
+			//Values written by the game thread, copied by the RenderWorld at the end of the game frame
+			//The render thread only sees them when the snapshot is applied
+			struct game_state
+			{
+				Core::STransform transform;
+				bool is_visible = true;
+				bool cast_shadows = true;
+				bool is_static = false;
+				bool frustum_check = true;
+				float frustum_check_radius = 20.f;
+				bool pending_deletion = false;
+			};
 		private:
+			game_state game_state_;
+
+			//Resources requested by the game, loaded by load() at the render sync
+			std::string vertex_shader_path_;
+			std::string fragment_shader_path_;
+			std::string model_path_;
+			std::vector<std::string> textures_path_;
+			bool is_loaded_ = false;
+			//Files chosen by select_files_to_read() and read by read_files(), given to the pools by load()
+			bool read_model_ = false;
+			std::vector<bool> read_textures_;
+			std::shared_ptr<VulkanModel> model_file_;
+			std::vector<StandardTexture::decoded_image> texture_files_;
+
 			std::shared_ptr<VulkanModel> vulkan_render_model_ = nullptr;
 			StandardUniformBuffer* vulkan_render_uniform_buffer_ = nullptr;
 			std::vector<BasicMaterial*> model_materials_;
@@ -44,6 +73,9 @@ namespace ScrapEngine
 			bool is_static_ = false;
 			bool transform_dirty_ = true;
 
+			//Value that set if the mesh is drawn by a StaticBatcher cluster instead of its own draw calls
+			bool is_batched_ = false;
+
 			//Value to set if the mesh should be hidden when out of view or not
 			//Remember that a mesh with this value set to false will be always drawn
 			bool frustum_check_ = true;
@@ -59,29 +91,49 @@ namespace ScrapEngine
 			//Set that the mesh will be deleted as soon as possible
 			//During command buffer re-creation
 			//This is necessary because the mesh can't be deleted during command buffer creation
+			//When only the command buffers not submitted anymore contain it, the mesh is retired to the
+			//VulkanDeletionQueue with their last frame value, see RenderManager::cleanup_meshes()
 			bool pending_deletion_ = false;
 
-			//I also need a deletion counter, to know how many command buffers read this mesh
-			//When i'm sure no command buffer contain it this mesh can be deleted
-			uint16_t deletion_counter_ = 0;
-
 			//Shadowmapping stuff to draw mesh shadows
 			ShadowmappingUniformBuffer* shadowmapping_uniform_buffer_ = nullptr;
 			ShadowmappingDescriptorSet* shadowmapping_descriptor_set_ = nullptr;
 			StandardDescriptorPool* shadowmapping_descriptor_pool_ = nullptr;
 			
+			void init_shadowmapping_resources(StandardShadowmapping* shadowmapping);
 			void write_depth_descriptor(StandardShadowmapping* shadowmapping);
 			void directional_light_frustum_check(Camera* render_camera);
 		public:
+			//Only store the paths, the resources are created by load()
 			VulkanMeshInstance(const std::string& vertex_shader_path, const std::string& fragment_shader_path,
-			                   const std::string& model_path, const std::vector<std::string>& textures_path,
-			                   VulkanSwapChain* swap_chain);
+			                   const std::string& model_path, const std::vector<std::string>& textures_path);
 			~VulkanMeshInstance();
 
+			//Choose the files not in the pools and not selected by another mesh yet, called at the render sync
+			void select_files_to_read(std::unordered_set<std::string>& selected_files);
+			//Read and decode the selected files, called by a worker, it doesn't use the pools or the device
+			void read_files();
+			//Create the gpu resources, the files not read by read_files() are read here
+			//The uploads use the graphics queue, so the render thread must not be running
+			void load(VulkanSwapChain* swap_chain, StandardShadowmapping* shadowmapping);
+			//The game state can be written before, but the mesh is drawn only when it's loaded
+			bool get_is_loaded() const;
+
 			//-------------------------------------
-			//USER FEATURES
+			//GAME THREAD
 			//-------------------------------------
-			
+
+			game_state* get_game_state();
+			//Mark the mesh to be deleted as soon as no command buffer uses it
+			void set_for_deletion();
+
+			//-------------------------------------
+			//RENDER THREAD
+			//-------------------------------------
+
+			//Copy the values of a snapshot in the render side of the mesh
+			void apply_game_state(const game_state& state);
+
 			void set_mesh_location(const Core::SVector3& location);
 			void set_mesh_rotation(const Core::SVector3& rotation);
 			void set_mesh_scale(const Core::SVector3& scale);
@@ -105,20 +157,21 @@ namespace ScrapEngine
 			float get_frustum_check_radius() const;
 			void set_frustum_check_radius(float radius);
 
+			bool get_is_batched() const;
+			void set_is_batched(bool batched);
+
 			//-------------------------------------
 			//ENGINE UTILS
 			//-------------------------------------
 			
-			void set_for_deletion();
 			bool get_pending_deletion() const;
-			void increase_deletion_counter();
-			uint16_t get_deletion_counter() const;
 
 			void view_frustum_check(Camera* render_camera);
 			bool get_is_in_current_frustum() const;
 			bool get_sun_shadow_is_in_current_frustum() const;
 
-			void init_shadowmapping_resources(StandardShadowmapping* shadowmapping);
+			//Same matrix written in the uniform buffer
+			glm::mat4 get_model_matrix() const;
 
 			void update_uniform_buffer(uint32_t current_image, Camera* render_camera,
 			                           const glm::vec3& light_pos);
@@ -127,11 +180,12 @@ namespace ScrapEngine
 			const std::vector<BasicMaterial*>* get_mesh_materials() const;
 			ShadowmappingDescriptorSet* get_shadowmapping_descriptor_set() const;
 
-			std::shared_ptr<std::vector<
+			//The buffers are shared with the other instances of the model, nullptr until the mesh is loaded
+			const std::vector<
 				std::pair<
 					VertexBufferContainer*,
 					IndicesBufferContainer*>
-			>> get_mesh_buffers() const;
+			>* get_mesh_buffers() const;
 		};
 	}
 }
@@ -1,5 +1,6 @@
 #include <Engine/Rendering/Model/Model/VulkanModel.h>
 #include <Engine/Debug/DebugLog.h>
+#include <Engine/Debug/CpuProfiler.h>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h> // Post processing flags
@@ -7,6 +8,7 @@
 
 ScrapEngine::Render::VulkanModel::VulkanModel(const std::string& input_model_path)
 {
+	SCRAP_PROFILE_SCOPE("load_model");
 	Debug::DebugLog::print_to_console_log("[VulkanModel] Loading 3D model '" + input_model_path + "'");
 	Debug::DebugLog::print_to_console_log("[VulkanModel] Loading assimp...");
 	Assimp::Importer importer;
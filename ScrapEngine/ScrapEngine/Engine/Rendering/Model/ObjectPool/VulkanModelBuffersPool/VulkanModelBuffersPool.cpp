@@ -7,6 +7,7 @@
 #include <Engine/Rendering/Buffer/BufferContainer/IndicesBufferContainer/IndicesBufferContainer.h>
 #include <Engine/Rendering/Model/Model/VulkanModel.h>
 #include <Engine/Rendering/Model/Model/Mesh/Mesh.h>
+#include <Engine/Rendering/Memory/VulkanDeletionQueue.h>
 
 //Init static instance reference
 
@@ -56,7 +57,8 @@ std::shared_ptr<std::vector<
 			//VertexBuffer and container
 			concrete_buffer_pair.first = new VertexBuffer(mesh->get_vertices());
 			buffer_pair.first = new VertexBufferContainer(
-				concrete_buffer_pair.first->get_vertex_buffer(),
+				concrete_buffer_pair.first->get_position_buffer(),
+				concrete_buffer_pair.first->get_attribute_buffer(),
 				mesh->get_vertices());
 			Debug::DebugLog::print_to_console_log("[VulkanModelBuffersPool] VertexBuffer created");
 
@@ -96,12 +98,12 @@ void ScrapEngine::Render::VulkanModelBuffersPool::clear_memory()
 		Debug::DebugLog::print_to_console_log("[VulkanModelBuffersPool] Removing '"
 			+ model_key + "' buffers from pool memory");
 		//Clear concrete_buffers_
+		//The buffers are deleted when the frames submitted so far are completed
 		for (const auto& model_pair : concrete_buffers_[model_key])
 		{
-			delete model_pair.first;
-			delete model_pair.second;
+			VulkanDeletionQueue::get_instance()->retire_object(model_pair.first);
+			VulkanDeletionQueue::get_instance()->retire_object(model_pair.second);
 		}
-		concrete_buffers_[model_key].clear();
 		concrete_buffers_.erase(model_key);
 		//Clear model_buffers_pool_
 		model_buffers_pool_[model_key]->clear();
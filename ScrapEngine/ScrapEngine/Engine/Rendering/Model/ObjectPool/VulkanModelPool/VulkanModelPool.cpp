@@ -27,6 +27,17 @@ std::shared_ptr<ScrapEngine::Render::VulkanModel> ScrapEngine::Render::VulkanMod
 	return model_pool_[model_path];
 }
 
+bool ScrapEngine::Render::VulkanModelPool::has_model(const std::string& model_path) const
+{
+	return model_pool_.find(model_path) != model_pool_.end();
+}
+
+void ScrapEngine::Render::VulkanModelPool::add_model(const std::string& model_path,
+                                                     const std::shared_ptr<VulkanModel>& model)
+{
+	model_pool_.insert({model_path, model});
+}
+
 ScrapEngine::Render::VulkanModelPool::~VulkanModelPool()
 {
 	clear_memory();
@@ -24,6 +24,9 @@ namespace ScrapEngine
 			static VulkanModelPool* get_instance();
 
 			std::shared_ptr<VulkanModel> get_model(const std::string& model_path);
+			bool has_model(const std::string& model_path) const;
+			//Add a model read outside the pool (ex: by a worker), ignored if the path is already loaded
+			void add_model(const std::string& model_path, const std::shared_ptr<VulkanModel>& model);
 
 			~VulkanModelPool();
 
@@ -5,11 +5,16 @@
 #include <Engine/Rendering/Texture/Texture/StandardTexture/StandardTexture.h>
 #include <Engine/Rendering/Pipeline/StandardPipeline/StandardVulkanGraphicsPipeline.h>
 #include <Engine/Rendering/Device/VulkanDevice.h>
+#include <Engine/Rendering/Memory/VulkanDeletionQueue.h>
 
 //Init static instance reference
 
 ScrapEngine::Render::VulkanSimpleMaterialPool* ScrapEngine::Render::VulkanSimpleMaterialPool::instance_ = nullptr;
 
+const std::string ScrapEngine::Render::VulkanSimpleMaterialPool::depth_prepass_key_ = "depth_prepass";
+const std::string ScrapEngine::Render::VulkanSimpleMaterialPool::depth_prepass_shader_path_ =
+	"../assets/shader/compiled_shaders/depth_prepass.vert.spv";
+
 ScrapEngine::Render::VulkanSimpleMaterialPool* ScrapEngine::Render::VulkanSimpleMaterialPool::get_instance()
 {
 	if (instance_ == nullptr)
@@ -41,6 +46,27 @@ get_pipeline(const std::string& vertex_shader_path, const std::string& fragment_
 	return pipeline_pool_[key_string];
 }
 
+std::shared_ptr<ScrapEngine::Render::BaseVulkanGraphicsPipeline> ScrapEngine::Render::VulkanSimpleMaterialPool::
+get_depth_prepass_pipeline(VulkanSwapChain* swap_chain, vk::DescriptorSetLayout* descriptor_set_layout)
+{
+	const std::string& key_string = depth_prepass_key_;
+	if (pipeline_pool_.find(key_string) == pipeline_pool_.end())
+	{
+		// Pipeline not found, create it
+		const vk::Extent2D swap_chain_extent = swap_chain->get_swap_chain_extent();
+		pipeline_pool_[key_string] = std::make_shared<StandardVulkanGraphicsPipeline>(
+			depth_prepass_shader_path_.c_str(),
+			nullptr,
+			swap_chain_extent,
+			descriptor_set_layout,
+			VulkanDevice::get_instance()->
+			get_msaa_samples(),
+			true);
+		Debug::DebugLog::print_to_console_log("[VulkanSimpleMaterialPool] Depth prepass pipeline loaded and created");
+	}
+	return pipeline_pool_[key_string];
+}
+
 std::shared_ptr<ScrapEngine::Render::BaseTexture> ScrapEngine::Render::VulkanSimpleMaterialPool::get_standard_texture(
 	const std::string& texture_path)
 {
@@ -53,6 +79,17 @@ std::shared_ptr<ScrapEngine::Render::BaseTexture> ScrapEngine::Render::VulkanSim
 	return base_texture_pool_[texture_path];
 }
 
+bool ScrapEngine::Render::VulkanSimpleMaterialPool::has_standard_texture(const std::string& texture_path) const
+{
+	return base_texture_pool_.find(texture_path) != base_texture_pool_.end();
+}
+
+void ScrapEngine::Render::VulkanSimpleMaterialPool::add_standard_texture(const std::string& texture_path,
+                                                                         const std::shared_ptr<BaseTexture>& texture)
+{
+	base_texture_pool_.insert({texture_path, texture});
+}
+
 std::shared_ptr<ScrapEngine::Render::TextureSampler> ScrapEngine::Render::VulkanSimpleMaterialPool::get_texture_sampler(
 	const std::string& texture_path)
 {
@@ -100,6 +137,10 @@ void ScrapEngine::Render::VulkanSimpleMaterialPool::clear_memory()
 	{
 		Debug::DebugLog::print_to_console_log("[VulkanSimpleMaterialPool] Removing '"
 			+ texture_key + "' shared material from pool memory");
+		//The last frames submitted could still sample the texture, the queue keeps it alive until they are completed
+		VulkanDeletionQueue::get_instance()->retire(base_texture_pool_[texture_key]);
+		VulkanDeletionQueue::get_instance()->retire(texture_image_view_pool_[texture_key]);
+		VulkanDeletionQueue::get_instance()->retire(texture_sampler_pool_[texture_key]);
 		base_texture_pool_.erase(texture_key);
 		texture_image_view_pool_.erase(texture_key);
 		texture_sampler_pool_.erase(texture_key);
@@ -116,6 +157,7 @@ void ScrapEngine::Render::VulkanSimpleMaterialPool::clear_memory()
 	for (const auto& pipeline_key : pipeline_to_erase)
 	{
 		Debug::DebugLog::print_to_console_log("[VulkanSimpleMaterialPool] Removing shared pipeline from pool memory");
+		VulkanDeletionQueue::get_instance()->retire(pipeline_pool_[pipeline_key]);
 		pipeline_pool_.erase(pipeline_key);
 	}
 }
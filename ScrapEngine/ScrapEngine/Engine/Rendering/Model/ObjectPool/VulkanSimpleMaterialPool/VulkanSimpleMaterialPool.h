@@ -40,10 +40,15 @@ namespace ScrapEngine
 			//This is the pool of the Pipelines
 			//Currently made only of StandardVulkanGraphicsPipeline
 			//The key of this pool is the string vertex_shader_path+fragment_shader_path
+			//The depth prepass pipeline is shared by every material, its key is depth_prepass_key_
 			std::unordered_map<
 				std::string,
 				std::shared_ptr<BaseVulkanGraphicsPipeline>
 			> pipeline_pool_;
+
+			static const std::string depth_prepass_key_;
+			//Position only vertex shader, the depth prepass binds only the position stream
+			static const std::string depth_prepass_shader_path_;
 		public:
 			//Singleton static function to get or create a class instance
 			static VulkanSimpleMaterialPool* get_instance();
@@ -54,8 +59,17 @@ namespace ScrapEngine
 				VulkanSwapChain* swap_chain,
 				vk::DescriptorSetLayout* descriptor_set_layout);
 
+			//Return or create the depth only pipeline used by the depth prepass
+			//The descriptor set layout must be compatible with the standard one, only the binding 0 is used
+			std::shared_ptr<BaseVulkanGraphicsPipeline> get_depth_prepass_pipeline(
+				VulkanSwapChain* swap_chain,
+				vk::DescriptorSetLayout* descriptor_set_layout);
+
 			//Return or create the shared_ptr of the BaseTexture
 			std::shared_ptr<BaseTexture> get_standard_texture(const std::string& texture_path);
+			bool has_standard_texture(const std::string& texture_path) const;
+			//Add a texture created from an image decoded outside the pool, ignored if the path is already loaded
+			void add_standard_texture(const std::string& texture_path, const std::shared_ptr<BaseTexture>& texture);
 
 			//Return or create the shared_ptr of the TextureSampler
 			std::shared_ptr<TextureSampler> get_texture_sampler(const std::string& texture_path);
@@ -15,7 +15,7 @@ ScrapEngine::Render::VulkanSkyboxInstance::VulkanSkyboxInstance(const std::strin
                                                                 VulkanSwapChain* swap_chain)
 {
 	//CREATE UNIFORM BUFFER
-	vulkan_render_uniform_buffer_ = new SkyboxUniformBuffer(swap_chain->get_swap_chain_images_vector()->size());
+	vulkan_render_uniform_buffer_ = new SkyboxUniformBuffer(swap_chain->get_frames_in_flight());
 	Debug::DebugLog::print_to_console_log("UniformBuffer created");
 	//CREATE MATERIAL(S)
 	skybox_material_ = new SkyboxMaterial();
@@ -0,0 +1,291 @@
+#include <Engine/Rendering/Model/StaticBatch/StaticBatcher.h>
+#include <Engine/Debug/DebugLog.h>
+#include <Engine/Rendering/Model/MeshInstance/VulkanMeshInstance.h>
+#include <Engine/Rendering/Model/Material/SimpleMaterial/SimpleMaterial.h>
+#include <Engine/Rendering/Model/Material/StaticBatchMaterial/StaticBatchMaterial.h>
+#include <Engine/Rendering/SwapChain/VulkanSwapChain.h>
+#include <Engine/Rendering/Buffer/VertexBuffer/VertexBuffer.h>
+#include <Engine/Rendering/Buffer/IndexBuffer/IndexBuffer.h>
+#include <Engine/Rendering/Buffer/BufferContainer/VertexBufferContainer/VertexBufferContainer.h>
+#include <Engine/Rendering/Buffer/BufferContainer/IndicesBufferContainer/IndicesBufferContainer.h>
+#include <Engine/Rendering/Buffer/UniformBuffer/StandardUniformBuffer/StandardUniformBuffer.h>
+#include <Engine/Rendering/Buffer/UniformBuffer/ShadowmappingUniformBuffer/ShadowmappingUniformBuffer.h>
+#include <Engine/Rendering/Buffer/FrameBuffer/ShadowmappingFrameBuffer/ShadowmappingFrameBuffer.h>
+#include <Engine/Rendering/Buffer/FrameBuffer/ShadowmappingFrameBuffer/ShadowmappingFrameBufferAttachment.h>
+#include <Engine/Rendering/Descriptor/DescriptorSet/ShadowmappingDescriptorSet/ShadowmappingDescriptorSet.h>
+#include <Engine/Rendering/Descriptor/DescriptorPool/StandardDescriptorPool/StandardDescriptorPool.h>
+#include <Engine/Rendering/Descriptor/DescriptorSet/BaseDescriptorSet.h>
+#include <Engine/Rendering/Shadowmapping/Standard/StandardShadowmapping.h>
+#include <Engine/Rendering/Camera/Camera.h>
+#include <Engine/LogicCore/Math/Transform/STransform.h>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/mat3x3.hpp>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+
+ScrapEngine::Render::StaticBatcher::StaticBatcher(VulkanSwapChain* swap_chain, StandardShadowmapping* shadowmapping,
+                                                  const float cluster_size)
+	: swap_chain_ref_(swap_chain), cluster_size_(cluster_size)
+{
+	const size_t size = swap_chain->get_frames_in_flight();
+
+	//The model matrix is the identity, it's written only once
+	const Core::STransform identity_transform;
+	uniform_buffer_ = new StandardUniformBuffer(size);
+	uniform_buffer_->update_uniform_buffer_transform(identity_transform);
+
+	shadowmapping_uniform_buffer_ = new ShadowmappingUniformBuffer(size);
+	shadowmapping_uniform_buffer_->update_uniform_buffer_transform(identity_transform);
+
+	shadowmapping_descriptor_set_ = new ShadowmappingDescriptorSet();
+	shadowmapping_descriptor_pool_ = new StandardDescriptorPool(size);
+	shadowmapping_descriptor_set_->create_descriptor_sets(
+		shadowmapping_descriptor_pool_->get_descriptor_pool(),
+		size,
+		shadowmapping_uniform_buffer_->get_uniform_buffers(),
+		sizeof(OffscreenUniformBufferObject)
+	);
+}
+
+ScrapEngine::Render::StaticBatcher::~StaticBatcher()
+{
+	for (cluster& current_cluster : clusters_)
+	{
+		for (const auto& mesh : current_cluster.meshes)
+		{
+			mesh.first->set_is_batched(false);
+		}
+		for (const batch& current_batch : current_cluster.batches)
+		{
+			delete current_batch.material;
+			delete current_batch.vertex_buffer;
+			delete current_batch.index_buffer;
+		}
+	}
+	clusters_.clear();
+	delete uniform_buffer_;
+	delete shadowmapping_descriptor_set_;
+	delete shadowmapping_descriptor_pool_;
+	delete shadowmapping_uniform_buffer_;
+}
+
+bool ScrapEngine::Render::StaticBatcher::can_be_batched(const VulkanMeshInstance* mesh)
+{
+	if (!mesh->get_is_loaded() || !mesh->get_is_static() || !mesh->get_is_visible() || mesh->get_pending_deletion())
+	{
+		return false;
+	}
+	if (mesh->get_mesh_materials()->empty() || mesh->get_mesh_buffers()->empty())
+	{
+		return false;
+	}
+	//The batch material is created from the texture of a SimpleMaterial
+	for (BasicMaterial* material : *mesh->get_mesh_materials())
+	{
+		if (!dynamic_cast<SimpleMaterial*>(material))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void ScrapEngine::Render::StaticBatcher::build(const std::vector<VulkanMeshInstance*>& meshes,
+                                               StandardShadowmapping* shadowmapping)
+{
+	//Group the meshes by the grid cell of their location
+	std::map<std::array<int, 3>, std::vector<VulkanMeshInstance*>> cells;
+	for (VulkanMeshInstance* mesh : meshes)
+	{
+		mesh->set_is_batched(false);
+		if (!can_be_batched(mesh))
+		{
+			continue;
+		}
+		const glm::vec3 cell = glm::floor(mesh->get_mesh_location().get_glm_vector() / cluster_size_);
+		cells[{static_cast<int>(cell.x), static_cast<int>(cell.y), static_cast<int>(cell.z)}].push_back(mesh);
+	}
+
+	size_t batched_meshes = 0;
+	size_t batches_count = 0;
+	for (const auto& cell : cells)
+	{
+		//Merging a mesh alone would only duplicate its buffers
+		if (cell.second.size() < 2)
+		{
+			continue;
+		}
+		clusters_.emplace_back();
+		cluster& new_cluster = clusters_.back();
+		for (VulkanMeshInstance* mesh : cell.second)
+		{
+			new_cluster.meshes.emplace_back(mesh, mesh->get_cast_shadows());
+		}
+		build_cluster(new_cluster, shadowmapping);
+
+		batched_meshes += new_cluster.meshes.size();
+		batches_count += new_cluster.batches.size();
+	}
+
+	Debug::DebugLog::print_to_console_log("[StaticBatcher] " + std::to_string(batched_meshes) +
+		" static meshes merged in " + std::to_string(batches_count) + " batches (" +
+		std::to_string(clusters_.size()) + " clusters)");
+}
+
+void ScrapEngine::Render::StaticBatcher::build_cluster(cluster& new_cluster, StandardShadowmapping* shadowmapping)
+{
+	struct batch_geometry
+	{
+		const SimpleMaterial* material;
+		bool cast_shadows;
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+	};
+	std::vector<batch_geometry> geometries;
+
+	glm::vec3 bounds_min(std::numeric_limits<float>::max());
+	glm::vec3 bounds_max(std::numeric_limits<float>::lowest());
+
+	for (const auto& mesh : new_cluster.meshes)
+	{
+		const glm::mat4 model = mesh.first->get_model_matrix();
+		//Same normal transformation of the vertex shader
+		const glm::mat3 normal_model = glm::mat3(model);
+		const std::vector<BasicMaterial*>* materials = mesh.first->get_mesh_materials();
+
+		const auto& mesh_buffers = *mesh.first->get_mesh_buffers();
+		for (size_t i = 0; i < mesh_buffers.size(); i++)
+		{
+			//With more materials each mesh has its own one, like in the command buffer
+			const SimpleMaterial* material = static_cast<const SimpleMaterial*>(
+				(*materials)[std::min(i, materials->size() - 1)]);
+
+			//Materials with the same pipeline and texture are merged
+			auto geometry = std::find_if(geometries.begin(), geometries.end(), [&](const batch_geometry& other)
+			{
+				return other.cast_shadows == mesh.second &&
+					other.material->get_vulkan_render_graphics_pipeline() == material->
+					get_vulkan_render_graphics_pipeline() &&
+					other.material->get_texture_image_view() == material->get_texture_image_view();
+			});
+			if (geometry == geometries.end())
+			{
+				geometries.push_back({material, mesh.second, {}, {}});
+				geometry = geometries.end() - 1;
+			}
+
+			const std::vector<Vertex>* vertices = mesh_buffers[i].first->get_vector();
+			const std::vector<uint32_t>* indices = mesh_buffers[i].second->get_vector();
+			const uint32_t base_vertex = static_cast<uint32_t>(geometry->vertices.size());
+
+			for (const Vertex& vertex : *vertices)
+			{
+				Vertex world_vertex = vertex;
+				world_vertex.pos = glm::vec3(model * glm::vec4(vertex.pos, 1.0f));
+				world_vertex.normal = normal_model * vertex.normal;
+				geometry->vertices.push_back(world_vertex);
+
+				bounds_min = glm::min(bounds_min, world_vertex.pos);
+				bounds_max = glm::max(bounds_max, world_vertex.pos);
+			}
+			for (const uint32_t index : *indices)
+			{
+				geometry->indices.push_back(base_vertex + index);
+			}
+		}
+		new_cluster.frustum_check = new_cluster.frustum_check && mesh.first->get_frustum_check();
+		mesh.first->set_is_batched(true);
+	}
+
+	new_cluster.center = (bounds_min + bounds_max) * 0.5f;
+	new_cluster.radius = glm::length(bounds_max - bounds_min) * 0.5f;
+
+	//Shadow map image of the materials, like VulkanMeshInstance::write_depth_descriptor()
+	const vk::DescriptorImageInfo depth_image_info(
+		*shadowmapping->get_offscreen_frame_buffer()->get_depth_sampler(),
+		*shadowmapping->get_offscreen_frame_buffer()->get_depth_attachment()->get_image_view(),
+		vk::ImageLayout::eDepthStencilReadOnlyOptimal
+	);
+
+	for (const batch_geometry& geometry : geometries)
+	{
+		batch new_batch;
+		new_batch.material = new StaticBatchMaterial(geometry.material, swap_chain_ref_, uniform_buffer_);
+		new_batch.material->get_vulkan_render_descriptor_set()->write_image_info(depth_image_info, 1);
+		new_batch.vertex_buffer = new VertexBuffer(&geometry.vertices);
+		new_batch.index_buffer = new IndexBuffer(&geometry.indices);
+		new_batch.index_count = static_cast<uint32_t>(geometry.indices.size());
+		new_batch.cast_shadows = geometry.cast_shadows;
+		new_cluster.batches.push_back(new_batch);
+	}
+}
+
+void ScrapEngine::Render::StaticBatcher::disable_cluster(cluster& old_cluster)
+{
+	old_cluster.enabled = false;
+	for (const auto& mesh : old_cluster.meshes)
+	{
+		mesh.first->set_is_batched(false);
+	}
+	//The meshes can be deleted from now on
+	old_cluster.meshes.clear();
+}
+
+void ScrapEngine::Render::StaticBatcher::update(const uint32_t current_image, Camera* render_camera,
+                                                StandardShadowmapping* shadowmapping, const glm::vec3& light_pos)
+{
+	for (cluster& current_cluster : clusters_)
+	{
+		if (!current_cluster.enabled)
+		{
+			continue;
+		}
+		//The merged geometry can't follow the meshes, so the changed cluster is split again
+		for (const auto& mesh : current_cluster.meshes)
+		{
+			if (!can_be_batched(mesh.first) || mesh.first->get_cast_shadows() != mesh.second)
+			{
+				disable_cluster(current_cluster);
+				break;
+			}
+		}
+		if (!current_cluster.enabled || !current_cluster.frustum_check)
+		{
+			continue;
+		}
+		current_cluster.is_in_current_frustum = render_camera->frustum_check_sphere(
+			current_cluster.center, current_cluster.radius);
+		//Doubled like the meshes, to keep the shadows of the objects just outside the view
+		current_cluster.sun_shadow_is_in_current_frustum = render_camera->frustum_check_sphere(
+			current_cluster.center, current_cluster.radius * 2);
+	}
+
+	//Shadow map uniform buffer first, it updates the depth bias
+	shadowmapping_uniform_buffer_->update_uniform_buffer_light(
+		shadowmapping->get_light_fov(),
+		shadowmapping->get_light_pos(),
+		shadowmapping->get_light_look_at(),
+		shadowmapping->get_z_near(),
+		shadowmapping->get_z_far()
+	);
+	shadowmapping_uniform_buffer_->finish_update_uniform_buffer(current_image);
+
+	uniform_buffer_->update_uniform_buffer_camera_data(render_camera);
+	uniform_buffer_->update_uniform_buffer_light_data(light_pos, shadowmapping_uniform_buffer_->get_depth_bias());
+	uniform_buffer_->finish_update_uniform_buffer(current_image);
+}
+
+const std::vector<ScrapEngine::Render::StaticBatcher::cluster>* ScrapEngine::Render::StaticBatcher::
+get_clusters() const
+{
+	return &clusters_;
+}
+
+ScrapEngine::Render::ShadowmappingDescriptorSet* ScrapEngine::Render::StaticBatcher::
+get_shadowmapping_descriptor_set() const
+{
+	return shadowmapping_descriptor_set_;
+}
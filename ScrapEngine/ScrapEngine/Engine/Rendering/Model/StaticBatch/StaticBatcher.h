@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Engine/Rendering/VulkanInclude.h>
+#include <glm/vec3.hpp>
+#include <vector>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		class VulkanMeshInstance;
+		class VulkanSwapChain;
+		class VertexBuffer;
+		class IndexBuffer;
+		class StaticBatchMaterial;
+		class StandardUniformBuffer;
+		class ShadowmappingUniformBuffer;
+		class ShadowmappingDescriptorSet;
+		class StandardDescriptorPool;
+		class StandardShadowmapping;
+		class Camera;
+
+		//Merge the static meshes in world space, so the meshes with the same material are drawn with a single draw call
+		//The meshes are split in clusters of a world grid, the frustum culling is done for each cluster
+		class StaticBatcher
+		{
+		public:
+			//Merged geometry of the meshes of a cluster with the same material
+			struct batch
+			{
+				StaticBatchMaterial* material = nullptr;
+				VertexBuffer* vertex_buffer = nullptr;
+				IndexBuffer* index_buffer = nullptr;
+				uint32_t index_count = 0;
+				bool cast_shadows = true;
+			};
+
+			struct cluster
+			{
+				//Merged meshes and the cast shadows value used by the batch
+				std::vector<std::pair<VulkanMeshInstance*, bool>> meshes;
+				std::vector<batch> batches;
+				//Bounding sphere in world space
+				glm::vec3 center = glm::vec3(0.0f);
+				float radius = 0.f;
+				//False if a mesh of the cluster has the frustum check disabled
+				bool frustum_check = true;
+				bool is_in_current_frustum = true;
+				bool sun_shadow_is_in_current_frustum = true;
+				//A cluster is disabled when one of its meshes changes, its meshes are drawn alone again
+				bool enabled = true;
+			};
+		private:
+			VulkanSwapChain* swap_chain_ref_;
+			//Size of a cell of the clusters grid
+			float cluster_size_;
+
+			std::vector<cluster> clusters_;
+
+			//The merged vertices are in world space, the uniform buffer has only the camera and light data
+			StandardUniformBuffer* uniform_buffer_ = nullptr;
+			ShadowmappingUniformBuffer* shadowmapping_uniform_buffer_ = nullptr;
+			ShadowmappingDescriptorSet* shadowmapping_descriptor_set_ = nullptr;
+			StandardDescriptorPool* shadowmapping_descriptor_pool_ = nullptr;
+
+			static bool can_be_batched(const VulkanMeshInstance* mesh);
+			void build_cluster(cluster& new_cluster, StandardShadowmapping* shadowmapping);
+			void disable_cluster(cluster& old_cluster);
+		public:
+			StaticBatcher(VulkanSwapChain* swap_chain, StandardShadowmapping* shadowmapping,
+			              float cluster_size = 100.f);
+			//The gpu must not use the batches anymore
+			~StaticBatcher();
+
+			//Merge the visible static meshes, the meshes alone in their cluster are not merged
+			void build(const std::vector<VulkanMeshInstance*>& meshes, StandardShadowmapping* shadowmapping);
+
+			//Disable the clusters with changed meshes, update the frustum checks and the uniform buffers
+			//The disabled clusters are kept in memory, a command buffer could still use them
+			void update(uint32_t current_image, Camera* render_camera, StandardShadowmapping* shadowmapping,
+			            const glm::vec3& light_pos);
+
+			const std::vector<cluster>* get_clusters() const;
+			ShadowmappingDescriptorSet* get_shadowmapping_descriptor_set() const;
+		};
+	}
+}
@@ -10,7 +10,9 @@ ScrapEngine::Render::GuiVulkanGraphicsPipeline::GuiVulkanGraphicsPipeline(const
                                                                           vk::DescriptorSetLayout*
                                                                           descriptor_set_layout,
                                                                           size_t block_size,
-                                                                          BaseRenderPass* render_pass)
+                                                                          BaseRenderPass* render_pass,
+                                                                          const uint32_t subpass,
+                                                                          const vk::SampleCountFlagBits samples)
 {
 	// Pipeline layout
 	vk::PushConstantRange push_constant_range;
@@ -117,9 +119,10 @@ ScrapEngine::Render::GuiVulkanGraphicsPipeline::GuiVulkanGraphicsPipeline(const
 	dynamic_state.setDynamicStateCount(static_cast<uint32_t>(dynamic_state_enables.size()));
 	dynamic_state.setPDynamicStates(dynamic_state_enables.data());
 
+	//Multisampled only in the gui subpass of the StandardRenderPass
 	vk::PipelineMultisampleStateCreateInfo multisampling(
 		vk::PipelineMultisampleStateCreateFlags(),
-		VulkanDevice::get_instance()->get_msaa_samples()
+		samples
 	);
 
 	vk::PipelineDepthStencilStateCreateInfo depth_stencil(
@@ -144,7 +147,7 @@ ScrapEngine::Render::GuiVulkanGraphicsPipeline::GuiVulkanGraphicsPipeline(const
 		&dynamic_state,
 		pipeline_layout_,
 		*render_pass,
-		0
+		subpass
 	);
 
 	const vk::Result result = VulkanDevice::get_instance()->get_logical_device()->createGraphicsPipelines(
@@ -11,9 +11,11 @@ namespace ScrapEngine
 		class GuiVulkanGraphicsPipeline : public BaseVulkanGraphicsPipeline
 		{
 		public:
+			//samples must match the color attachment of the subpass
 			GuiVulkanGraphicsPipeline(const char* vertex_shader, const char* fragment_shader,
 			                          vk::DescriptorSetLayout* descriptor_set_layout, size_t block_size,
-			                          BaseRenderPass* render_pass);
+			                          BaseRenderPass* render_pass, uint32_t subpass,
+			                          vk::SampleCountFlagBits samples);
 			~GuiVulkanGraphicsPipeline() = default;
 		};
 	}
@@ -4,6 +4,7 @@
 #include <Engine/Rendering/Device/VulkanDevice.h>
 #include <Engine/Rendering/RenderPass/StandardRenderPass/StandardRenderPass.h>
 #include <Engine/Debug/DebugLog.h>
+#include <array>
 
 ScrapEngine::Render::SkyboxVulkanGraphicsPipeline::SkyboxVulkanGraphicsPipeline(const char* vertex_shader,
                                                                                 const char* fragment_shader,
@@ -33,12 +34,12 @@ ScrapEngine::Render::SkyboxVulkanGraphicsPipeline::SkyboxVulkanGraphicsPipeline(
 	vk::PipelineShaderStageCreateInfo shader_stages[] = {vert_shader_stage_info, frag_shader_stage_info};
 
 	auto attribute_descriptions = SkyboxVertex::get_attribute_descriptions();
-	auto binding_description = SkyboxVertex::get_binding_description();
+	auto binding_descriptions = SkyboxVertex::get_binding_descriptions();
 
 	vk::PipelineVertexInputStateCreateInfo vertex_input_info(
 		vk::PipelineVertexInputStateCreateFlags(),
-		1,
-		&binding_description,
+		static_cast<uint32_t>(binding_descriptions.size()),
+		binding_descriptions.data(),
 		static_cast<uint32_t>(attribute_descriptions.size()),
 		attribute_descriptions.data()
 	);
@@ -92,8 +93,9 @@ ScrapEngine::Render::SkyboxVulkanGraphicsPipeline::SkyboxVulkanGraphicsPipeline(
 		vk::CompareOp::eLessOrEqual
 	);
 
-	vk::PipelineColorBlendAttachmentState color_blend_attachment;
-	color_blend_attachment.setColorWriteMask(
+	//The velocity is not written, the temporal resolve reprojects the sky with the depth
+	std::array<vk::PipelineColorBlendAttachmentState, 2> color_blend_attachments;
+	color_blend_attachments[0].setColorWriteMask(
 		vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::
 		ColorComponentFlagBits::eA);
 
@@ -101,8 +103,8 @@ ScrapEngine::Render::SkyboxVulkanGraphicsPipeline::SkyboxVulkanGraphicsPipeline(
 		vk::PipelineColorBlendStateCreateFlags(),
 		false,
 		vk::LogicOp::eCopy,
-		1,
-		&color_blend_attachment
+		StandardRenderPass::get_instance()->get_scene_color_attachment_count(),
+		color_blend_attachments.data()
 	);
 
 	vk::PipelineLayoutCreateInfo pipeline_layout_info(
@@ -119,6 +121,17 @@ ScrapEngine::Render::SkyboxVulkanGraphicsPipeline::SkyboxVulkanGraphicsPipeline(
 		Debug::DebugLog::fatal_error(result_layout, "SkyboxVulkanGraphicsPipeline: Failed to create pipeline layout!");
 	}
 
+	//The scene is drawn in a part of the attachments when the resolution is scaled, see DynamicResolution
+	std::vector<vk::DynamicState> dynamic_states_enable;
+	dynamic_states_enable.push_back(vk::DynamicState::eViewport);
+	dynamic_states_enable.push_back(vk::DynamicState::eScissor);
+
+	vk::PipelineDynamicStateCreateInfo dynamic_state_create_info(
+		vk::PipelineDynamicStateCreateFlags(),
+		static_cast<uint32_t>(dynamic_states_enable.size()),
+		dynamic_states_enable.data()
+	);
+
 	vk::GraphicsPipelineCreateInfo pipeline_info(
 		vk::PipelineCreateFlags(),
 		2,
@@ -131,7 +144,7 @@ ScrapEngine::Render::SkyboxVulkanGraphicsPipeline::SkyboxVulkanGraphicsPipeline(
 		&multisampling,
 		&depth_stencil,
 		&color_blending,
-		nullptr,
+		&dynamic_state_create_info,
 		pipeline_layout_,
 		*StandardRenderPass::get_instance(),
 		0
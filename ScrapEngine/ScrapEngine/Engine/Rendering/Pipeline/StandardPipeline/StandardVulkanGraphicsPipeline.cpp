@@ -4,6 +4,7 @@
 #include <Engine/Rendering/Device/VulkanDevice.h>
 #include <Engine/Rendering/RenderPass/StandardRenderPass/StandardRenderPass.h>
 #include <Engine/Debug/DebugLog.h>
+#include <array>
 
 ScrapEngine::Render::StandardVulkanGraphicsPipeline::StandardVulkanGraphicsPipeline(const char* vertex_shader,
                                                                                     const char* fragment_shader,
@@ -11,11 +12,16 @@ ScrapEngine::Render::StandardVulkanGraphicsPipeline::StandardVulkanGraphicsPipel
                                                                                     vk::DescriptorSetLayout*
                                                                                     descriptor_set_layout,
                                                                                     vk::SampleCountFlagBits
-                                                                                    msaa_samples)
+                                                                                    msaa_samples,
+                                                                                    const bool depth_only)
 {
 	vk::ShaderModule vert_shader_module = ShaderManager::get_instance()->get_shader_module(vertex_shader);
 
-	vk::ShaderModule frag_shader_module = ShaderManager::get_instance()->get_shader_module(fragment_shader);
+	vk::ShaderModule frag_shader_module;
+	if (!depth_only)
+	{
+		frag_shader_module = ShaderManager::get_instance()->get_shader_module(fragment_shader);
+	}
 
 	vk::PipelineShaderStageCreateInfo vert_shader_stage_info(
 		vk::PipelineShaderStageCreateFlags(),
@@ -41,16 +47,30 @@ ScrapEngine::Render::StandardVulkanGraphicsPipeline::StandardVulkanGraphicsPipel
 	shader_stages[1].setPSpecializationInfo(&specialization_info);
 
 	auto attribute_descriptions = Vertex::get_attribute_descriptions();
-	auto binding_description = Vertex::get_binding_description();
+	auto binding_descriptions = Vertex::get_binding_descriptions();
 
 	vk::PipelineVertexInputStateCreateInfo vertex_input_info(
 		vk::PipelineVertexInputStateCreateFlags(),
-		1,
-		&binding_description,
+		static_cast<uint32_t>(binding_descriptions.size()),
+		binding_descriptions.data(),
 		static_cast<uint32_t>(attribute_descriptions.size()),
 		attribute_descriptions.data()
 	);
 
+	//The depth prepass fetches only the positions
+	auto position_attribute_descriptions = OffscreenVertex::get_attribute_descriptions();
+	auto position_binding_description = OffscreenVertex::get_binding_description();
+	if (depth_only)
+	{
+		vertex_input_info = vk::PipelineVertexInputStateCreateInfo(
+			vk::PipelineVertexInputStateCreateFlags(),
+			1,
+			&position_binding_description,
+			static_cast<uint32_t>(position_attribute_descriptions.size()),
+			position_attribute_descriptions.data()
+		);
+	}
+
 	vk::PipelineInputAssemblyStateCreateInfo input_assembly(
 		vk::PipelineInputAssemblyStateCreateFlags(),
 		vk::PrimitiveTopology::eTriangleList,
@@ -100,17 +120,22 @@ ScrapEngine::Render::StandardVulkanGraphicsPipeline::StandardVulkanGraphicsPipel
 		vk::CompareOp::eLessOrEqual
 	);
 
-	vk::PipelineColorBlendAttachmentState color_blend_attachment;
-	color_blend_attachment.setColorWriteMask(
-		vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::
-		ColorComponentFlagBits::eA);
+	//Scene color and, with the temporal resolve, the velocity
+	std::array<vk::PipelineColorBlendAttachmentState, 2> color_blend_attachments;
+	if (!depth_only)
+	{
+		color_blend_attachments[0].setColorWriteMask(
+			vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::
+			ColorComponentFlagBits::eA);
+		color_blend_attachments[1].setColorWriteMask(vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG);
+	}
 
 	vk::PipelineColorBlendStateCreateInfo color_blending(
 		vk::PipelineColorBlendStateCreateFlags(),
 		false,
 		vk::LogicOp::eCopy,
-		1,
-		&color_blend_attachment
+		StandardRenderPass::get_instance()->get_scene_color_attachment_count(),
+		color_blend_attachments.data()
 	);
 
 	vk::PipelineLayoutCreateInfo pipeline_layout_info(
@@ -127,9 +152,20 @@ ScrapEngine::Render::StandardVulkanGraphicsPipeline::StandardVulkanGraphicsPipel
 		Debug::DebugLog::fatal_error(result_layout, "StandardVulkanGraphicsPipeline: Failed to create pipeline layout!");
 	}
 
+	//The scene is drawn in a part of the attachments when the resolution is scaled, see DynamicResolution
+	std::vector<vk::DynamicState> dynamic_states_enable;
+	dynamic_states_enable.push_back(vk::DynamicState::eViewport);
+	dynamic_states_enable.push_back(vk::DynamicState::eScissor);
+
+	vk::PipelineDynamicStateCreateInfo dynamic_state_create_info(
+		vk::PipelineDynamicStateCreateFlags(),
+		static_cast<uint32_t>(dynamic_states_enable.size()),
+		dynamic_states_enable.data()
+	);
+
 	vk::GraphicsPipelineCreateInfo pipeline_info(
 		vk::PipelineCreateFlags(),
-		2,
+		depth_only ? 1 : 2,
 		shader_stages,
 		&vertex_input_info,
 		&input_assembly,
@@ -139,7 +175,7 @@ ScrapEngine::Render::StandardVulkanGraphicsPipeline::StandardVulkanGraphicsPipel
 		&multisampling,
 		&depth_stencil,
 		&color_blending,
-		nullptr,
+		&dynamic_state_create_info,
 		pipeline_layout_,
 		*StandardRenderPass::get_instance(),
 		0
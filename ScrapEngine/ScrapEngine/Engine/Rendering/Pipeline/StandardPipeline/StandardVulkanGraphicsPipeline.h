@@ -6,13 +6,16 @@ namespace ScrapEngine
 {
 	namespace Render
 	{
+		//With depth_only the pipeline has no fragment shader and doesn't write the color, used by the depth prepass
+		//The depth only pipeline reads only the position stream, see OffscreenVertex
 		class StandardVulkanGraphicsPipeline : public BaseVulkanGraphicsPipeline
 		{
 		public:
 			StandardVulkanGraphicsPipeline(const char* vertex_shader, const char* fragment_shader,
 			                               const vk::Extent2D& swap_chain_extent,
 			                               vk::DescriptorSetLayout* descriptor_set_layout,
-			                               vk::SampleCountFlagBits msaa_samples);
+			                               vk::SampleCountFlagBits msaa_samples,
+			                               bool depth_only = false);
 			~StandardVulkanGraphicsPipeline() = default;
 		};
 	}
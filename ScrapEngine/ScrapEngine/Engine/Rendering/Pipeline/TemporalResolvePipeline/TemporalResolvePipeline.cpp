@@ -0,0 +1,134 @@
+#include <Engine/Rendering/Pipeline/TemporalResolvePipeline/TemporalResolvePipeline.h>
+#include <Engine/Rendering/Shader/ShaderManager.h>
+#include <Engine/Rendering/Device/VulkanDevice.h>
+#include <Engine/Rendering/RenderPass/BaseRenderPass.h>
+#include <Engine/Debug/DebugLog.h>
+
+ScrapEngine::Render::TemporalResolvePipeline::TemporalResolvePipeline(const char* vertex_shader,
+                                                                      const char* fragment_shader,
+                                                                      vk::DescriptorSetLayout* descriptor_set_layout,
+                                                                      const vk::Extent2D& extent,
+                                                                      BaseRenderPass* render_pass)
+{
+	vk::ShaderModule vert_shader_module = ShaderManager::get_instance()->get_shader_module(vertex_shader);
+
+	vk::ShaderModule frag_shader_module = ShaderManager::get_instance()->get_shader_module(fragment_shader);
+
+	vk::PipelineShaderStageCreateInfo shader_stages[] = {
+		vk::PipelineShaderStageCreateInfo(
+			vk::PipelineShaderStageCreateFlags(),
+			vk::ShaderStageFlagBits::eVertex,
+			vert_shader_module,
+			"main"
+		),
+		vk::PipelineShaderStageCreateInfo(
+			vk::PipelineShaderStageCreateFlags(),
+			vk::ShaderStageFlagBits::eFragment,
+			frag_shader_module,
+			"main"
+		)
+	};
+
+	//The vertices are generated from gl_VertexIndex
+	vk::PipelineVertexInputStateCreateInfo vertex_input_info;
+
+	vk::PipelineInputAssemblyStateCreateInfo input_assembly(
+		vk::PipelineInputAssemblyStateCreateFlags(),
+		vk::PrimitiveTopology::eTriangleList,
+		false
+	);
+
+	vk::Viewport viewport(
+		0,
+		0,
+		static_cast<float>(extent.width),
+		static_cast<float>(extent.height),
+		0.0f,
+		1.0f);
+
+	vk::Rect2D scissor(
+		vk::Offset2D(),
+		extent
+	);
+
+	vk::PipelineViewportStateCreateInfo viewport_state(
+		vk::PipelineViewportStateCreateFlags(),
+		1,
+		&viewport,
+		1,
+		&scissor
+	);
+
+	vk::PipelineRasterizationStateCreateInfo rasterizer(
+		vk::PipelineRasterizationStateCreateFlags(),
+		false,
+		false,
+		vk::PolygonMode::eFill,
+		vk::CullModeFlagBits::eNone,
+		vk::FrontFace::eCounterClockwise
+	);
+	rasterizer.setLineWidth(1.0f);
+
+	vk::PipelineMultisampleStateCreateInfo multisampling(
+		vk::PipelineMultisampleStateCreateFlags(),
+		vk::SampleCountFlagBits::e1
+	);
+
+	vk::PipelineColorBlendAttachmentState color_blend_attachment;
+	color_blend_attachment.setColorWriteMask(
+		vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::
+		ColorComponentFlagBits::eA);
+
+	vk::PipelineColorBlendStateCreateInfo color_blending(
+		vk::PipelineColorBlendStateCreateFlags(),
+		false,
+		vk::LogicOp::eCopy,
+		1,
+		&color_blend_attachment
+	);
+
+	vk::PushConstantRange push_constant_range;
+	push_constant_range.stageFlags = vk::ShaderStageFlagBits::eFragment;
+	push_constant_range.offset = 0;
+	push_constant_range.setSize(sizeof(push_constant_block));
+
+	vk::PipelineLayoutCreateInfo pipeline_layout_info;
+	pipeline_layout_info.setPSetLayouts(descriptor_set_layout);
+	pipeline_layout_info.setSetLayoutCount(1);
+	pipeline_layout_info.setPushConstantRangeCount(1);
+	pipeline_layout_info.setPPushConstantRanges(&push_constant_range);
+
+	const vk::Result result_layout = VulkanDevice::get_instance()->get_logical_device()->createPipelineLayout(
+		&pipeline_layout_info, nullptr, &pipeline_layout_);
+
+	if (result_layout != vk::Result::eSuccess)
+	{
+		Debug::DebugLog::fatal_error(result_layout, "TemporalResolvePipeline: Failed to create pipeline layout!");
+	}
+
+	vk::GraphicsPipelineCreateInfo pipeline_info(
+		vk::PipelineCreateFlags(),
+		2,
+		shader_stages,
+		&vertex_input_info,
+		&input_assembly,
+		nullptr,
+		&viewport_state,
+		&rasterizer,
+		&multisampling,
+		nullptr,
+		&color_blending,
+		nullptr,
+		pipeline_layout_,
+		*render_pass->get_render_pass(),
+		0
+	);
+
+	const vk::Result result = VulkanDevice::get_instance()->get_logical_device()->createGraphicsPipelines(
+		nullptr, 1, &pipeline_info, nullptr, &graphics_pipeline_);
+
+	if (result != vk::Result::eSuccess)
+	{
+		Debug::DebugLog::fatal_error(result, "TemporalResolvePipeline: Failed to create graphics pipeline!");
+	}
+}
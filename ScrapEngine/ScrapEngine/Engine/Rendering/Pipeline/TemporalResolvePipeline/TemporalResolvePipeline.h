@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Engine/Rendering/Pipeline/BaseVulkanGraphicsPipeline.h>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		class BaseRenderPass;
+
+		//Fullscreen triangle without vertex buffers, the parameters are push constants
+		class TemporalResolvePipeline : public BaseVulkanGraphicsPipeline
+		{
+		public:
+			//Same layout of the push constants of taa_resolve.frag
+			struct push_constant_block
+			{
+				//Current clip space (without jitter) to the previous clip space
+				glm::mat4 reprojection = glm::mat4(1.0f);
+				//xy: jitter of the current frame in uv, zw: render extent / output extent
+				glm::vec4 jitter_scale = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+				//x: weight of the history, 0 when the history is not valid
+				glm::vec4 params = glm::vec4(0.0f);
+			};
+
+			TemporalResolvePipeline(const char* vertex_shader, const char* fragment_shader,
+			                        vk::DescriptorSetLayout* descriptor_set_layout, const vk::Extent2D& extent,
+			                        BaseRenderPass* render_pass);
+			~TemporalResolvePipeline() = default;
+		};
+	}
+}
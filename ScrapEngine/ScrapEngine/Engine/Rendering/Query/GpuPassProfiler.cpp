@@ -0,0 +1,379 @@
+#include <Engine/Rendering/Query/GpuPassProfiler.h>
+#include <Engine/Rendering/Device/VulkanDevice.h>
+#include <Engine/Debug/DebugLog.h>
+#include <Engine/Debug/CpuProfiler.h>
+#include <algorithm>
+
+void ScrapEngine::Render::GpuPassProfiler::CsvWriteTask::ExecuteRange(enki::TaskSetPartition range,
+                                                                     uint32_t threadnum)
+{
+	SCRAP_PROFILE_SCOPE("gpu_profiler_csv_write");
+	owner->write_csv_rows(batch);
+}
+
+ScrapEngine::Render::GpuPassProfiler::GpuPassProfiler(const uint32_t frames_in_flight, const bool pipeline_statistics,
+                                                      enki::TaskScheduler* task_scheduler)
+	: frames_(frames_in_flight), task_scheduler_(task_scheduler)
+{
+	csv_write_task_.owner = this;
+	//File output, after the game and render tasks
+	csv_write_task_.m_Priority = enki::TASK_PRIORITY_LOW;
+
+	VulkanDevice* device = VulkanDevice::get_instance();
+	const vk::PhysicalDeviceProperties properties = device->get_physical_device()->getProperties();
+	const std::vector<vk::QueueFamilyProperties> queue_families = device->get_physical_device()->
+	                                                                      getQueueFamilyProperties();
+	const uint32_t valid_bits = queue_families[device->get_cached_queue_family_indices().graphics_family].
+		timestampValidBits;
+
+	if (valid_bits == 0 || properties.limits.timestampPeriod <= 0.0f)
+	{
+		Debug::DebugLog::print_to_console_log("[GpuPassProfiler] Timestamps not supported, profiler disabled");
+		return;
+	}
+	timestamp_period_ = properties.limits.timestampPeriod;
+	timestamp_mask_ = valid_bits >= 64 ? ~0ull : (1ull << valid_bits) - 1;
+
+	statistics_enabled_ = pipeline_statistics && device->is_pipeline_statistics_query_enabled();
+	if (pipeline_statistics && !statistics_enabled_)
+	{
+		Debug::DebugLog::print_to_console_log("[GpuPassProfiler] Pipeline statistics not supported");
+	}
+
+	//Two timestamps and one statistics query for each zone
+	const vk::QueryPoolCreateInfo timestamp_info(vk::QueryPoolCreateFlags(), vk::QueryType::eTimestamp,
+	                                             zone_count * 2);
+	vk::QueryPoolCreateInfo statistics_info(vk::QueryPoolCreateFlags(), vk::QueryType::ePipelineStatistics,
+	                                        zone_count);
+	statistics_info.setPipelineStatistics(vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations |
+		vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations);
+
+	for (frame_queries& frame : frames_)
+	{
+		vk::Result result = device->get_logical_device()->createQueryPool(&timestamp_info, nullptr,
+		                                                                  &frame.timestamp_pool);
+		if (result != vk::Result::eSuccess)
+		{
+			Debug::DebugLog::fatal_error(result, "[GpuPassProfiler] Failed to create the timestamp query pool!");
+		}
+		if (statistics_enabled_)
+		{
+			result = device->get_logical_device()->createQueryPool(&statistics_info, nullptr,
+			                                                       &frame.statistics_pool);
+			if (result != vk::Result::eSuccess)
+			{
+				Debug::DebugLog::fatal_error(result, "[GpuPassProfiler] Failed to create the statistics query pool!");
+			}
+		}
+	}
+	enabled_ = true;
+}
+
+ScrapEngine::Render::GpuPassProfiler::~GpuPassProfiler()
+{
+	//Write the last rows and close the file
+	set_csv_output("");
+	if (!enabled_)
+	{
+		return;
+	}
+	for (const frame_queries& frame : frames_)
+	{
+		VulkanDevice::get_instance()->get_logical_device()->destroyQueryPool(frame.timestamp_pool);
+		if (statistics_enabled_)
+		{
+			VulkanDevice::get_instance()->get_logical_device()->destroyQueryPool(frame.statistics_pool);
+		}
+	}
+}
+
+const char* ScrapEngine::Render::GpuPassProfiler::get_zone_name(const pass_zone zone)
+{
+	switch (zone)
+	{
+	case pass_zone::frame:
+		return "frame";
+	case pass_zone::shadow_map:
+		return "shadow_map";
+	case pass_zone::scene:
+		return "scene";
+	case pass_zone::skybox:
+		return "skybox";
+	case pass_zone::gui:
+		return "gui";
+	default:
+		return "unknown";
+	}
+}
+
+bool ScrapEngine::Render::GpuPassProfiler::has_statistics(const pass_zone zone)
+{
+	//Two pipeline statistics queries cannot be active at the same time
+	return zone != pass_zone::frame && zone != pass_zone::skybox;
+}
+
+void ScrapEngine::Render::GpuPassProfiler::reset(const vk::CommandBuffer command_buffer, const uint32_t frame_index)
+{
+	if (!enabled_)
+	{
+		return;
+	}
+	frame_queries& frame = frames_[frame_index];
+	command_buffer.resetQueryPool(frame.timestamp_pool, 0, zone_count * 2);
+	if (statistics_enabled_)
+	{
+		command_buffer.resetQueryPool(frame.statistics_pool, 0, zone_count);
+	}
+	frame.written = true;
+}
+
+void ScrapEngine::Render::GpuPassProfiler::begin_zone(const vk::CommandBuffer command_buffer,
+                                                      const uint32_t frame_index, const pass_zone zone) const
+{
+	if (!enabled_)
+	{
+		return;
+	}
+	const frame_queries& frame = frames_[frame_index];
+	const uint32_t index = static_cast<uint32_t>(zone);
+	command_buffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, frame.timestamp_pool, index * 2);
+	if (statistics_enabled_ && has_statistics(zone))
+	{
+		command_buffer.beginQuery(frame.statistics_pool, index, vk::QueryControlFlags());
+	}
+}
+
+void ScrapEngine::Render::GpuPassProfiler::end_zone(const vk::CommandBuffer command_buffer,
+                                                    const uint32_t frame_index, const pass_zone zone) const
+{
+	if (!enabled_)
+	{
+		return;
+	}
+	const frame_queries& frame = frames_[frame_index];
+	const uint32_t index = static_cast<uint32_t>(zone);
+	if (statistics_enabled_ && has_statistics(zone))
+	{
+		command_buffer.endQuery(frame.statistics_pool, index);
+	}
+	command_buffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, frame.timestamp_pool, index * 2 + 1);
+}
+
+void ScrapEngine::Render::GpuPassProfiler::collect(const uint32_t frame_index)
+{
+	frame_queries& frame = frames_[frame_index];
+	if (!enabled_ || !frame.written)
+	{
+		//Nothing measured, the previous results are not returned again
+		for (zone_history& zone : zones_)
+		{
+			zone.collected = false;
+		}
+		return;
+	}
+	frame.written = false;
+
+	//Value and availability of every query, the zones not recorded in the frame are not available
+	//eNotReady is expected when a zone is missing, so the result is not checked
+	uint64_t timestamps[zone_count * 2][2] = {};
+	VulkanDevice::get_instance()->get_logical_device()->getQueryPoolResults(
+		frame.timestamp_pool, 0, zone_count * 2, sizeof(timestamps), timestamps, sizeof(timestamps[0]),
+		vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability);
+
+	//Vertex invocations, fragment invocations and availability
+	uint64_t statistics[zone_count][3] = {};
+	if (statistics_enabled_)
+	{
+		VulkanDevice::get_instance()->get_logical_device()->getQueryPoolResults(
+			frame.statistics_pool, 0, zone_count, sizeof(statistics), statistics, sizeof(statistics[0]),
+			vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability);
+	}
+
+	csv_row* row = nullptr;
+	if (csv_enabled_)
+	{
+		std::vector<csv_row>& batch = csv_batches_[csv_filling_batch_];
+		batch.emplace_back();
+		row = &batch.back();
+		row->frame = collected_frames_;
+	}
+	collected_frames_++;
+
+	for (uint32_t i = 0; i < zone_count; i++)
+	{
+		zone_history& zone = zones_[i];
+		const bool available = timestamps[i * 2][1] != 0 && timestamps[i * 2 + 1][1] != 0;
+		zone.collected = available;
+		if (available)
+		{
+			const uint64_t ticks = ((timestamps[i * 2 + 1][0] & timestamp_mask_) -
+				(timestamps[i * 2][0] & timestamp_mask_)) & timestamp_mask_;
+			zone.last_ms = static_cast<float>(static_cast<double>(ticks) * timestamp_period_ / 1000000.0);
+			zone.samples[zone.next] = zone.last_ms;
+			zone.next = (zone.next + 1) % history_length;
+			zone.count = std::min(zone.count + 1, history_length);
+		}
+		const bool statistics_available = statistics_enabled_ && statistics[i][2] != 0;
+		if (statistics_available)
+		{
+			zone.vertex_invocations = statistics[i][0];
+			zone.fragment_invocations = statistics[i][1];
+		}
+
+		if (row)
+		{
+			row->ms[i] = zone.last_ms;
+			row->vertex_invocations[i] = zone.vertex_invocations;
+			row->fragment_invocations[i] = zone.fragment_invocations;
+			row->available |= (available ? 1u << i : 0u) | (statistics_available ? 1u << (zone_count + i) : 0u);
+		}
+	}
+
+	//The full batch is written by a worker, collect() fills the other one
+	if (csv_enabled_ && csv_batches_[csv_filling_batch_].size() == csv_batch_rows)
+	{
+		//Waits only if the previous batch is still being written, 256 frames later
+		//Called by the render thread, it doesn't run other tasks while waiting
+		task_scheduler_->WaitforTask(&csv_write_task_, enki::TASK_PRIORITY_HIGH);
+		csv_write_task_.batch = csv_filling_batch_;
+		task_scheduler_->AddTaskSetToPipe(&csv_write_task_);
+		csv_filling_batch_ = 1 - csv_filling_batch_;
+	}
+}
+
+bool ScrapEngine::Render::GpuPassProfiler::get_collected_time(const pass_zone zone, float& time_ms) const
+{
+	const zone_history& history = zones_[static_cast<uint32_t>(zone)];
+	if (!history.collected)
+	{
+		return false;
+	}
+	time_ms = history.last_ms;
+	return true;
+}
+
+void ScrapEngine::Render::GpuPassProfiler::write_csv_rows(const uint32_t batch)
+{
+	for (const csv_row& row : csv_batches_[batch])
+	{
+		csv_ << row.frame;
+		for (uint32_t i = 0; i < zone_count; i++)
+		{
+			//Empty cells for the zones not recorded in the frame
+			csv_ << ',';
+			if (row.available & 1u << i)
+			{
+				csv_ << row.ms[i];
+			}
+			if (statistics_enabled_)
+			{
+				const bool statistics_available = (row.available & 1u << (zone_count + i)) != 0;
+				csv_ << ',';
+				if (statistics_available)
+				{
+					csv_ << row.vertex_invocations[i];
+				}
+				csv_ << ',';
+				if (statistics_available)
+				{
+					csv_ << row.fragment_invocations[i];
+				}
+			}
+		}
+		csv_ << '\n';
+	}
+	csv_.flush();
+	//Capacity is kept for the next rows
+	csv_batches_[batch].clear();
+}
+
+void ScrapEngine::Render::GpuPassProfiler::flush_csv()
+{
+	task_scheduler_->WaitforTask(&csv_write_task_);
+	write_csv_rows(csv_filling_batch_);
+}
+
+void ScrapEngine::Render::GpuPassProfiler::write_csv_header()
+{
+	csv_ << "frame";
+	for (uint32_t i = 0; i < zone_count; i++)
+	{
+		const char* name = get_zone_name(static_cast<pass_zone>(i));
+		csv_ << ',' << name << "_ms";
+		if (statistics_enabled_)
+		{
+			csv_ << ',' << name << "_vertex_invocations," << name << "_fragment_invocations";
+		}
+	}
+	csv_ << '\n';
+}
+
+bool ScrapEngine::Render::GpuPassProfiler::set_csv_output(const std::string& path)
+{
+	if (csv_enabled_)
+	{
+		flush_csv();
+		csv_enabled_ = false;
+	}
+	if (csv_.is_open())
+	{
+		csv_.close();
+	}
+	if (path.empty() || !enabled_)
+	{
+		return false;
+	}
+	csv_.open(path, std::ios::out | std::ios::trunc);
+	if (!csv_.is_open())
+	{
+		Debug::DebugLog::print_to_console_log("[GpuPassProfiler] Cannot open the csv file " + path);
+		return false;
+	}
+	write_csv_header();
+	for (std::vector<csv_row>& batch : csv_batches_)
+	{
+		batch.reserve(csv_batch_rows);
+	}
+	csv_enabled_ = true;
+	return true;
+}
+
+std::vector<ScrapEngine::Render::GpuPassProfiler::zone_stats> ScrapEngine::Render::GpuPassProfiler::get_stats() const
+{
+	std::vector<zone_stats> stats(zone_count);
+	for (uint32_t i = 0; i < zone_count; i++)
+	{
+		const zone_history& zone = zones_[i];
+		zone_stats& zone_stat = stats[i];
+		zone_stat.name = get_zone_name(static_cast<pass_zone>(i));
+		zone_stat.available = zone.count > 0;
+		zone_stat.vertex_invocations = zone.vertex_invocations;
+		zone_stat.fragment_invocations = zone.fragment_invocations;
+		if (!zone_stat.available)
+		{
+			continue;
+		}
+		zone_stat.last_ms = zone.last_ms;
+		zone_stat.min_ms = zone.samples[0];
+		zone_stat.max_ms = zone.samples[0];
+		float sum = 0.f;
+		for (uint32_t sample = 0; sample < zone.count; sample++)
+		{
+			zone_stat.min_ms = std::min(zone_stat.min_ms, zone.samples[sample]);
+			zone_stat.max_ms = std::max(zone_stat.max_ms, zone.samples[sample]);
+			sum += zone.samples[sample];
+		}
+		zone_stat.avg_ms = sum / static_cast<float>(zone.count);
+	}
+	return stats;
+}
+
+bool ScrapEngine::Render::GpuPassProfiler::is_enabled() const
+{
+	return enabled_;
+}
+
+bool ScrapEngine::Render::GpuPassProfiler::is_statistics_enabled() const
+{
+	return statistics_enabled_;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <Engine/Rendering/VulkanInclude.h>
+#include <TaskScheduler.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		//Measure the gpu time of the whole frame and of the passes with timestamps written in their command buffers
+		//Every frame in flight has its own query pools, read when that frame is waited, so it never stalls
+		//The frame zone is the gpu time used by the dynamic resolution
+		//The pipeline statistics (vertex and fragment shader invocations) are opt-in
+		class GpuPassProfiler
+		{
+		public:
+			enum class pass_zone
+			{
+				//The frame command buffer, every other zone is inside it so it has only the timestamps
+				frame,
+				shadow_map,
+				scene,
+				//Inside the scene zone, so it has only the timestamps
+				skybox,
+				gui,
+				count
+			};
+
+			static const uint32_t zone_count = static_cast<uint32_t>(pass_zone::count);
+			//Samples used by the rolling min, avg and max
+			static const uint32_t history_length = 120;
+			//Frames buffered before a batch of csv rows is written by a worker
+			static const uint32_t csv_batch_rows = 256;
+
+			struct zone_stats
+			{
+				const char* name = "";
+				//False if the zone has never been measured
+				bool available = false;
+				float last_ms = 0.f;
+				float min_ms = 0.f;
+				float avg_ms = 0.f;
+				float max_ms = 0.f;
+				//Only with the pipeline statistics
+				uint64_t vertex_invocations = 0;
+				uint64_t fragment_invocations = 0;
+			};
+		private:
+			struct frame_queries
+			{
+				vk::QueryPool timestamp_pool;
+				vk::QueryPool statistics_pool;
+				//True if the pools of the frame have been reset and not read yet
+				bool written = false;
+			};
+
+			struct zone_history
+			{
+				float samples[history_length] = {};
+				uint32_t count = 0;
+				uint32_t next = 0;
+				float last_ms = 0.f;
+				//True if the last collected frame measured the zone
+				bool collected = false;
+				uint64_t vertex_invocations = 0;
+				uint64_t fragment_invocations = 0;
+			};
+
+			std::vector<frame_queries> frames_;
+			zone_history zones_[zone_count];
+			//False if the graphics queue doesn't support timestamps
+			bool enabled_ = false;
+			bool statistics_enabled_ = false;
+			//Nanoseconds for each timestamp tick
+			float timestamp_period_ = 1.0f;
+			uint64_t timestamp_mask_ = ~0ull;
+
+			//Results of a collected frame, formatted only when its batch is written
+			struct csv_row
+			{
+				uint64_t frame = 0;
+				float ms[zone_count] = {};
+				uint64_t vertex_invocations[zone_count] = {};
+				uint64_t fragment_invocations[zone_count] = {};
+				//Bit i for the timestamps of the zone i, bit zone_count + i for its statistics
+				uint32_t available = 0;
+			};
+
+			//Write a batch of rows in the csv file, out of the render thread
+			struct CsvWriteTask : enki::ITaskSet
+			{
+				GpuPassProfiler* owner = nullptr;
+				uint32_t batch = 0;
+				void ExecuteRange(enki::TaskSetPartition range, uint32_t threadnum) override;
+			};
+
+			enki::TaskScheduler* task_scheduler_;
+			std::ofstream csv_;
+			bool csv_enabled_ = false;
+			//Two batches: one is filled by collect() while the other one is written
+			//Reserved once, so collecting a frame doesn't allocate
+			std::vector<csv_row> csv_batches_[2];
+			uint32_t csv_filling_batch_ = 0;
+			CsvWriteTask csv_write_task_;
+			uint64_t collected_frames_ = 0;
+
+			static bool has_statistics(pass_zone zone);
+			void write_csv_header();
+			void write_csv_rows(uint32_t batch);
+			//Write the buffered rows, waiting the batch in progress
+			void flush_csv();
+		public:
+			//The pipeline statistics are used only if requested and supported by the device
+			//The csv rows are written in batches by the tasks of task_scheduler
+			GpuPassProfiler(uint32_t frames_in_flight, bool pipeline_statistics, enki::TaskScheduler* task_scheduler);
+			~GpuPassProfiler();
+
+			static const char* get_zone_name(pass_zone zone);
+
+			//Reset the queries of the frame, must be recorded in the frame command buffer before the passes
+			void reset(vk::CommandBuffer command_buffer, uint32_t frame_index);
+			//Bracket a zone in the command buffer executed by frame_index
+			void begin_zone(vk::CommandBuffer command_buffer, uint32_t frame_index, pass_zone zone) const;
+			void end_zone(vk::CommandBuffer command_buffer, uint32_t frame_index, pass_zone zone) const;
+
+			//Read the results of the last frame submitted with frame_index, it must be already completed
+			//The zones not recorded in that frame are skipped
+			void collect(uint32_t frame_index);
+			//Gpu time of the zone in the last collected frame, false if the zone wasn't measured by it
+			bool get_collected_time(pass_zone zone, float& time_ms) const;
+
+			//Write a row for every collected frame, an empty path stops the export
+			//The rows are buffered, they are in the file after csv_batch_rows frames or when the export stops
+			bool set_csv_output(const std::string& path);
+
+			std::vector<zone_stats> get_stats() const;
+			bool is_enabled() const;
+			bool is_statistics_enabled() const;
+		};
+	}
+}
@@ -0,0 +1,764 @@
+#include <Engine/Rendering/RenderGraph/RenderGraph.h>
+#include <Engine/Rendering/Device/VulkanDevice.h>
+#include <Engine/Rendering/Memory/FrameArena.h>
+#include <Engine/Debug/DebugLog.h>
+#include <algorithm>
+
+ScrapEngine::Render::RenderGraph::~RenderGraph()
+{
+	destroy_transient_resources();
+}
+
+ScrapEngine::Render::RenderGraph::resource_handle ScrapEngine::Render::RenderGraph::import_image(
+	const std::string& name, const std::vector<vk::Image>* images, const vk::ImageAspectFlags aspect,
+	const vk::ImageLayout initial_layout, const vk::ImageLayout final_layout)
+{
+	const resource_handle handle = import_image(name, images->data(), aspect, initial_layout, final_layout);
+	resources_[handle].imported_image_count = images->size();
+	return handle;
+}
+
+ScrapEngine::Render::RenderGraph::resource_handle ScrapEngine::Render::RenderGraph::import_image(
+	const std::string& name, const vk::Image* image, const vk::ImageAspectFlags aspect,
+	const vk::ImageLayout initial_layout, const vk::ImageLayout final_layout)
+{
+	graph_resource resource;
+	resource.name = name;
+	resource.type = resource_type::image;
+	resource.imported_images = image;
+	resource.imported_image_count = 1;
+	resource.description.aspect = aspect;
+	resource.initial_layout = initial_layout;
+	resource.final_layout = final_layout;
+	resources_.push_back(resource);
+	compiled_ = false;
+	return static_cast<resource_handle>(resources_.size() - 1);
+}
+
+ScrapEngine::Render::RenderGraph::resource_handle ScrapEngine::Render::RenderGraph::import_buffer(
+	const std::string& name, const vk::Buffer buffer)
+{
+	graph_resource resource;
+	resource.name = name;
+	resource.type = resource_type::buffer;
+	resource.imported_buffer = buffer;
+	resources_.push_back(resource);
+	compiled_ = false;
+	return static_cast<resource_handle>(resources_.size() - 1);
+}
+
+ScrapEngine::Render::RenderGraph::resource_handle ScrapEngine::Render::RenderGraph::create_transient_image(
+	const std::string& name, const image_description& description)
+{
+	graph_resource resource;
+	resource.name = name;
+	resource.type = resource_type::image;
+	resource.transient = true;
+	resource.description = description;
+	resources_.push_back(resource);
+	compiled_ = false;
+	return static_cast<resource_handle>(resources_.size() - 1);
+}
+
+void ScrapEngine::Render::RenderGraph::mark_output(const resource_handle resource)
+{
+	resources_[resource].output = true;
+	compiled_ = false;
+}
+
+ScrapEngine::Render::RenderGraph::pass_handle ScrapEngine::Render::RenderGraph::add_pass(
+	const std::string& name, const pass_callback& callback)
+{
+	graph_pass pass;
+	pass.name = name;
+	pass.callback = callback;
+	passes_.push_back(pass);
+	compiled_ = false;
+	return static_cast<pass_handle>(passes_.size() - 1);
+}
+
+void ScrapEngine::Render::RenderGraph::add_read(const pass_handle pass, const resource_handle resource,
+                                                const resource_usage usage, const bool render_pass_synchronized)
+{
+	resource_access access;
+	access.resource = resource;
+	access.usage = usage;
+	access.write = false;
+	access.render_pass_synchronized = render_pass_synchronized;
+	passes_[pass].accesses.push_back(access);
+	compiled_ = false;
+}
+
+void ScrapEngine::Render::RenderGraph::add_write(const pass_handle pass, const resource_handle resource,
+                                                 const resource_usage usage, const bool render_pass_synchronized,
+                                                 const vk::ImageLayout end_layout)
+{
+	resource_access access;
+	access.resource = resource;
+	access.usage = usage;
+	access.write = true;
+	access.render_pass_synchronized = render_pass_synchronized;
+	access.end_layout = end_layout;
+	passes_[pass].accesses.push_back(access);
+	compiled_ = false;
+}
+
+void ScrapEngine::Render::RenderGraph::compile()
+{
+	destroy_transient_resources();
+	compiled_passes_.clear();
+	final_barriers_ = compiled_pass();
+
+	//Order, then remove the passes not needed for the outputs
+	const std::vector<pass_handle> sorted_passes = sort_passes();
+	cull_passes();
+
+	for (pass_handle pass : sorted_passes)
+	{
+		if (passes_[pass].alive)
+		{
+			compiled_pass compiled;
+			compiled.pass = pass;
+			compiled_passes_.push_back(compiled);
+		}
+		else
+		{
+			Debug::DebugLog::print_to_console_log("[RenderGraph] Culled pass " + passes_[pass].name);
+		}
+	}
+
+	//Lifetime of every resource in the compiled order
+	for (graph_resource& resource : resources_)
+	{
+		resource.first_use = -1;
+		resource.last_use = -1;
+	}
+	for (size_t i = 0; i < compiled_passes_.size(); i++)
+	{
+		for (const resource_access& access : passes_[compiled_passes_[i].pass].accesses)
+		{
+			graph_resource& resource = resources_[access.resource];
+			if (resource.first_use == -1)
+			{
+				resource.first_use = static_cast<int32_t>(i);
+			}
+			resource.last_use = static_cast<int32_t>(i);
+		}
+	}
+
+	allocate_transient_images();
+	compute_barriers();
+	compiled_ = true;
+}
+
+std::vector<ScrapEngine::Render::RenderGraph::pass_handle> ScrapEngine::Render::RenderGraph::sort_passes() const
+{
+	//A pass reading a resource depends on all the passes writing it
+	//Passes writing the same resource keep the order in which they were added
+	std::vector<std::vector<pass_handle>> dependencies(passes_.size());
+	std::vector<std::vector<pass_handle>> writers(resources_.size());
+
+	for (pass_handle pass = 0; pass < passes_.size(); pass++)
+	{
+		for (const resource_access& access : passes_[pass].accesses)
+		{
+			if (access.write)
+			{
+				std::vector<pass_handle>& resource_writers = writers[access.resource];
+				if (std::find(resource_writers.begin(), resource_writers.end(), pass) == resource_writers.end())
+				{
+					resource_writers.push_back(pass);
+				}
+			}
+		}
+	}
+
+	for (pass_handle pass = 0; pass < passes_.size(); pass++)
+	{
+		for (const resource_access& access : passes_[pass].accesses)
+		{
+			for (pass_handle writer : writers[access.resource])
+			{
+				//A writer depends only on the previous writers
+				if (writer == pass || (access.write && writer > pass))
+				{
+					continue;
+				}
+				//A pass that reads and writes the same resource only depends on the previous writers
+				if (!access.write && writer > pass &&
+					std::find(writers[access.resource].begin(), writers[access.resource].end(), pass) !=
+					writers[access.resource].end())
+				{
+					continue;
+				}
+				dependencies[pass].push_back(writer);
+			}
+		}
+	}
+
+	//Topological sort, when more passes are ready the first added is used
+	std::vector<pass_handle> sorted;
+	std::vector<bool> emitted(passes_.size(), false);
+	while (sorted.size() < passes_.size())
+	{
+		bool found = false;
+		for (pass_handle pass = 0; pass < passes_.size() && !found; pass++)
+		{
+			if (emitted[pass])
+			{
+				continue;
+			}
+			bool ready = true;
+			for (pass_handle dependency : dependencies[pass])
+			{
+				if (!emitted[dependency])
+				{
+					ready = false;
+					break;
+				}
+			}
+			if (ready)
+			{
+				emitted[pass] = true;
+				sorted.push_back(pass);
+				found = true;
+			}
+		}
+		if (!found)
+		{
+			Debug::DebugLog::fatal_error(vk::Result(-13), "[RenderGraph] The passes have a circular dependency!");
+			break;
+		}
+	}
+	return sorted;
+}
+
+void ScrapEngine::Render::RenderGraph::cull_passes()
+{
+	//Start from the passes writing an output
+	std::vector<pass_handle> to_visit;
+	for (pass_handle pass = 0; pass < passes_.size(); pass++)
+	{
+		passes_[pass].alive = false;
+		for (const resource_access& access : passes_[pass].accesses)
+		{
+			if (access.write && resources_[access.resource].output)
+			{
+				passes_[pass].alive = true;
+				to_visit.push_back(pass);
+				break;
+			}
+		}
+	}
+
+	//Then keep alive every pass writing something read by an alive pass
+	while (!to_visit.empty())
+	{
+		const pass_handle pass = to_visit.back();
+		to_visit.pop_back();
+		for (const resource_access& access : passes_[pass].accesses)
+		{
+			for (pass_handle writer = 0; writer < passes_.size(); writer++)
+			{
+				if (passes_[writer].alive)
+				{
+					continue;
+				}
+				for (const resource_access& writer_access : passes_[writer].accesses)
+				{
+					if (writer_access.write && writer_access.resource == access.resource)
+					{
+						passes_[writer].alive = true;
+						to_visit.push_back(writer);
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+void ScrapEngine::Render::RenderGraph::allocate_transient_images()
+{
+	vk::Device* device = VulkanDevice::get_instance()->get_logical_device();
+
+	//Visit the transient images in order of first use
+	std::vector<resource_handle> transient_resources;
+	for (resource_handle handle = 0; handle < resources_.size(); handle++)
+	{
+		if (resources_[handle].transient && resources_[handle].first_use != -1)
+		{
+			transient_resources.push_back(handle);
+		}
+	}
+	std::sort(transient_resources.begin(), transient_resources.end(),
+	          [this](const resource_handle a, const resource_handle b)
+	          {
+		          return resources_[a].first_use < resources_[b].first_use;
+	          });
+
+	for (resource_handle handle : transient_resources)
+	{
+		graph_resource& resource = resources_[handle];
+
+		const vk::ImageCreateInfo image_info(
+			vk::ImageCreateFlags(),
+			vk::ImageType::e2D,
+			resource.description.format,
+			vk::Extent3D(resource.description.extent.width, resource.description.extent.height, 1),
+			1,
+			1,
+			resource.description.samples,
+			vk::ImageTiling::eOptimal,
+			resource.description.usage,
+			vk::SharingMode::eExclusive
+		);
+
+		const vk::Result result = device->createImage(&image_info, nullptr, &resource.transient_image);
+		if (result != vk::Result::eSuccess)
+		{
+			Debug::DebugLog::fatal_error(result, "[RenderGraph] Failed to create transient image " + resource.name);
+		}
+
+		const vk::MemoryRequirements requirements = device->getImageMemoryRequirements(resource.transient_image);
+
+		//Reuse the smallest compatible memory that is not used anymore
+		int32_t best_slot = -1;
+		for (size_t i = 0; i < memory_slots_.size(); i++)
+		{
+			const memory_slot& slot = memory_slots_[i];
+			if (slot.last_use >= resource.first_use || !(slot.requirements.memoryTypeBits & requirements.
+				memoryTypeBits))
+			{
+				continue;
+			}
+			if (best_slot == -1 || slot.requirements.size < memory_slots_[best_slot].requirements.size)
+			{
+				best_slot = static_cast<int32_t>(i);
+			}
+		}
+
+		if (best_slot == -1)
+		{
+			memory_slot slot;
+			slot.requirements = requirements;
+			memory_slots_.push_back(slot);
+			best_slot = static_cast<int32_t>(memory_slots_.size() - 1);
+			//The first image waits the last one of the previous frame, set when all the slot is known
+			resource.previous_alias = -1;
+		}
+		else
+		{
+			memory_slot& slot = memory_slots_[best_slot];
+			slot.requirements.size = std::max(slot.requirements.size, requirements.size);
+			slot.requirements.alignment = std::max(slot.requirements.alignment, requirements.alignment);
+			slot.requirements.memoryTypeBits &= requirements.memoryTypeBits;
+			resource.previous_alias = static_cast<int32_t>(slot.last_resource);
+		}
+
+		memory_slot& slot = memory_slots_[best_slot];
+		slot.last_use = resource.last_use;
+		slot.last_resource = handle;
+		resource.memory_slot = best_slot;
+	}
+
+	//The first image of every memory must wait the last image of the previous frame using the same memory
+	for (resource_handle handle : transient_resources)
+	{
+		graph_resource& resource = resources_[handle];
+		if (resource.previous_alias == -1)
+		{
+			resource.previous_alias = static_cast<int32_t>(memory_slots_[resource.memory_slot].last_resource);
+		}
+	}
+
+	//Allocate the memory and bind the images
+	VulkanMemoryAllocator* allocator = VulkanMemoryAllocator::get_instance();
+	for (memory_slot& slot : memory_slots_)
+	{
+		allocator->allocate_aliasable_memory(slot.requirements, slot.allocation);
+	}
+	for (resource_handle handle : transient_resources)
+	{
+		graph_resource& resource = resources_[handle];
+		allocator->bind_image(resource.transient_image, memory_slots_[resource.memory_slot].allocation);
+
+		const vk::ImageViewCreateInfo view_info(
+			vk::ImageViewCreateFlags(),
+			resource.transient_image,
+			vk::ImageViewType::e2D,
+			resource.description.format,
+			vk::ComponentMapping(),
+			vk::ImageSubresourceRange(resource.description.aspect, 0, 1, 0, 1)
+		);
+
+		const vk::Result result = device->createImageView(&view_info, nullptr, &resource.transient_image_view);
+		if (result != vk::Result::eSuccess)
+		{
+			Debug::DebugLog::fatal_error(result, "[RenderGraph] Failed to create transient image view " +
+			                             resource.name);
+		}
+	}
+
+	if (!transient_resources.empty())
+	{
+		Debug::DebugLog::print_to_console_log("[RenderGraph] " + std::to_string(transient_resources.size()) +
+			" transient images in " + std::to_string(memory_slots_.size()) + " allocations");
+	}
+}
+
+void ScrapEngine::Render::RenderGraph::compute_barriers()
+{
+	struct resource_state
+	{
+		vk::ImageLayout layout = vk::ImageLayout::eUndefined;
+		vk::PipelineStageFlags stages;
+		vk::AccessFlags access;
+	};
+
+	//Merge the accesses of a pass to the same resource
+	struct merged_access
+	{
+		resource_handle resource = 0;
+		vk::PipelineStageFlags stages;
+		vk::AccessFlags access;
+		vk::ImageLayout layout = vk::ImageLayout::eUndefined;
+		vk::ImageLayout end_layout = vk::ImageLayout::eUndefined;
+		bool render_pass_synchronized = true;
+	};
+
+	std::vector<std::vector<merged_access>> pass_accesses(compiled_passes_.size());
+	//Last usage of every resource, used for the aliased images
+	std::vector<resource_state> last_states(resources_.size());
+
+	for (size_t i = 0; i < compiled_passes_.size(); i++)
+	{
+		for (const resource_access& access : passes_[compiled_passes_[i].pass].accesses)
+		{
+			vk::PipelineStageFlags stages;
+			vk::AccessFlags access_flags;
+			vk::ImageLayout layout;
+			get_usage_info(access.usage, stages, access_flags, layout);
+			if (!access.write)
+			{
+				//Remove the write bits
+				access_flags &= ~(vk::AccessFlagBits::eColorAttachmentWrite |
+					vk::AccessFlagBits::eDepthStencilAttachmentWrite | vk::AccessFlagBits::eShaderWrite |
+					vk::AccessFlagBits::eTransferWrite);
+			}
+
+			auto merged = std::find_if(pass_accesses[i].begin(), pass_accesses[i].end(),
+			                           [&access](const merged_access& m) { return m.resource == access.resource; });
+			if (merged == pass_accesses[i].end())
+			{
+				merged_access new_access;
+				new_access.resource = access.resource;
+				new_access.layout = layout;
+				pass_accesses[i].push_back(new_access);
+				merged = pass_accesses[i].end() - 1;
+			}
+			merged->stages |= stages;
+			merged->access |= access_flags;
+			merged->render_pass_synchronized = merged->render_pass_synchronized && access.render_pass_synchronized;
+			if (access.write)
+			{
+				merged->layout = layout;
+				merged->end_layout = access.end_layout;
+			}
+
+			last_states[access.resource].stages = merged->stages;
+			last_states[access.resource].access = merged->access;
+		}
+	}
+
+	//Initial state
+	std::vector<resource_state> states(resources_.size());
+	for (resource_handle handle = 0; handle < resources_.size(); handle++)
+	{
+		const graph_resource& resource = resources_[handle];
+		if (resource.transient && resource.previous_alias != -1)
+		{
+			//The content is discarded, but the previous user of the memory must be done
+			states[handle].stages = last_states[resource.previous_alias].stages;
+			states[handle].access = last_states[resource.previous_alias].access;
+		}
+		else
+		{
+			states[handle].layout = resource.initial_layout;
+		}
+	}
+
+	for (size_t i = 0; i < compiled_passes_.size(); i++)
+	{
+		compiled_pass& compiled = compiled_passes_[i];
+		for (const merged_access& access : pass_accesses[i])
+		{
+			resource_state& state = states[access.resource];
+			const bool is_image = resources_[access.resource].type == resource_type::image;
+			const bool layout_change = is_image && state.layout != access.layout;
+			const bool hazard = is_write_access(state.access) || is_write_access(access.access);
+
+			if (!access.render_pass_synchronized && (layout_change || (hazard && state.stages)))
+			{
+				pass_barrier barrier;
+				barrier.resource = access.resource;
+				barrier.src_access = state.access;
+				barrier.dst_access = access.access;
+				barrier.old_layout = state.layout;
+				barrier.new_layout = access.layout;
+				compiled.barriers.push_back(barrier);
+				//On the first use the barrier waits the stages of the pass itself
+				//So the layout transition is chained to a semaphore waited at those stages (ex: the acquired image)
+				compiled.src_stages |= state.stages ? state.stages : access.stages;
+				compiled.dst_stages |= access.stages;
+			}
+
+			state.layout = access.end_layout != vk::ImageLayout::eUndefined ? access.end_layout : access.layout;
+			state.stages = access.stages;
+			state.access = access.access;
+		}
+	}
+
+	//Move the imported images to their final layout
+	for (resource_handle handle = 0; handle < resources_.size(); handle++)
+	{
+		const graph_resource& resource = resources_[handle];
+		if (resource.type != resource_type::image || resource.transient ||
+			resource.final_layout == vk::ImageLayout::eUndefined || resource.final_layout == states[handle].layout)
+		{
+			continue;
+		}
+		pass_barrier barrier;
+		barrier.resource = handle;
+		barrier.src_access = states[handle].access;
+		barrier.old_layout = states[handle].layout;
+		barrier.new_layout = resource.final_layout;
+		final_barriers_.barriers.push_back(barrier);
+		final_barriers_.src_stages |= states[handle].stages
+			                              ? states[handle].stages
+			                              : vk::PipelineStageFlagBits::eTopOfPipe;
+		final_barriers_.dst_stages |= vk::PipelineStageFlagBits::eBottomOfPipe;
+	}
+}
+
+void ScrapEngine::Render::RenderGraph::get_usage_info(const resource_usage usage, vk::PipelineStageFlags& stages,
+                                                      vk::AccessFlags& access, vk::ImageLayout& layout)
+{
+	layout = vk::ImageLayout::eUndefined;
+	switch (usage)
+	{
+	case resource_usage::color_attachment:
+		stages = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+		access = vk::AccessFlagBits::eColorAttachmentRead | vk::AccessFlagBits::eColorAttachmentWrite;
+		layout = vk::ImageLayout::eColorAttachmentOptimal;
+		break;
+	case resource_usage::depth_attachment:
+		stages = vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests;
+		access = vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite;
+		layout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
+		break;
+	case resource_usage::depth_read:
+		stages = vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests |
+			vk::PipelineStageFlagBits::eFragmentShader;
+		access = vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eShaderRead;
+		layout = vk::ImageLayout::eDepthStencilReadOnlyOptimal;
+		break;
+	case resource_usage::sampled:
+		stages = vk::PipelineStageFlagBits::eFragmentShader;
+		access = vk::AccessFlagBits::eShaderRead;
+		layout = vk::ImageLayout::eShaderReadOnlyOptimal;
+		break;
+	case resource_usage::storage_read:
+		stages = vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eFragmentShader;
+		access = vk::AccessFlagBits::eShaderRead;
+		layout = vk::ImageLayout::eGeneral;
+		break;
+	case resource_usage::storage_write:
+		stages = vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eFragmentShader;
+		access = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+		layout = vk::ImageLayout::eGeneral;
+		break;
+	case resource_usage::transfer_src:
+		stages = vk::PipelineStageFlagBits::eTransfer;
+		access = vk::AccessFlagBits::eTransferRead;
+		layout = vk::ImageLayout::eTransferSrcOptimal;
+		break;
+	case resource_usage::transfer_dst:
+		stages = vk::PipelineStageFlagBits::eTransfer;
+		access = vk::AccessFlagBits::eTransferWrite;
+		layout = vk::ImageLayout::eTransferDstOptimal;
+		break;
+	case resource_usage::present:
+		stages = vk::PipelineStageFlagBits::eBottomOfPipe;
+		access = vk::AccessFlags();
+		layout = vk::ImageLayout::ePresentSrcKHR;
+		break;
+	case resource_usage::vertex_buffer:
+		stages = vk::PipelineStageFlagBits::eVertexInput;
+		access = vk::AccessFlagBits::eVertexAttributeRead;
+		break;
+	case resource_usage::index_buffer:
+		stages = vk::PipelineStageFlagBits::eVertexInput;
+		access = vk::AccessFlagBits::eIndexRead;
+		break;
+	case resource_usage::uniform_buffer:
+		stages = vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader;
+		access = vk::AccessFlagBits::eUniformRead;
+		break;
+	}
+}
+
+bool ScrapEngine::Render::RenderGraph::is_write_access(const vk::AccessFlags access)
+{
+	return static_cast<bool>(access & (vk::AccessFlagBits::eColorAttachmentWrite |
+		vk::AccessFlagBits::eDepthStencilAttachmentWrite | vk::AccessFlagBits::eShaderWrite |
+		vk::AccessFlagBits::eTransferWrite));
+}
+
+void ScrapEngine::Render::RenderGraph::execute(const pass_context& context) const
+{
+	if (!compiled_)
+	{
+		Debug::DebugLog::fatal_error(vk::Result(-13), "[RenderGraph] The graph must be compiled before the execution!");
+	}
+	for (size_t i = 0; i < compiled_passes_.size(); i++)
+	{
+		execute_pass(i, context);
+	}
+	execute_final_barriers(context);
+}
+
+size_t ScrapEngine::Render::RenderGraph::get_compiled_pass_count() const
+{
+	return compiled_passes_.size();
+}
+
+const std::string& ScrapEngine::Render::RenderGraph::get_compiled_pass_name(const size_t index) const
+{
+	return passes_[compiled_passes_[index].pass].name;
+}
+
+void ScrapEngine::Render::RenderGraph::execute_pass(const size_t index, const pass_context& context) const
+{
+	const compiled_pass& compiled = compiled_passes_[index];
+	record_barriers(compiled, context);
+	passes_[compiled.pass].callback(context);
+}
+
+void ScrapEngine::Render::RenderGraph::execute_final_barriers(const pass_context& context) const
+{
+	record_barriers(final_barriers_, context);
+}
+
+bool ScrapEngine::Render::RenderGraph::is_pass_culled(const pass_handle pass) const
+{
+	return !passes_[pass].alive;
+}
+
+vk::Image ScrapEngine::Render::RenderGraph::get_transient_image(const resource_handle resource) const
+{
+	return resources_[resource].transient_image;
+}
+
+vk::ImageView ScrapEngine::Render::RenderGraph::get_transient_image_view(const resource_handle resource) const
+{
+	return resources_[resource].transient_image_view;
+}
+
+size_t ScrapEngine::Render::RenderGraph::get_transient_memory_count() const
+{
+	return memory_slots_.size();
+}
+
+void ScrapEngine::Render::RenderGraph::destroy_transient_resources()
+{
+	vk::Device* device = VulkanDevice::get_instance()->get_logical_device();
+	for (graph_resource& resource : resources_)
+	{
+		if (resource.transient_image_view)
+		{
+			device->destroyImageView(resource.transient_image_view);
+			resource.transient_image_view = vk::ImageView();
+		}
+		if (resource.transient_image)
+		{
+			device->destroyImage(resource.transient_image);
+			resource.transient_image = vk::Image();
+		}
+		resource.memory_slot = -1;
+		resource.previous_alias = -1;
+	}
+	for (memory_slot& slot : memory_slots_)
+	{
+		if (slot.allocation)
+		{
+			VulkanMemoryAllocator::get_instance()->free_memory(slot.allocation);
+		}
+	}
+	memory_slots_.clear();
+}
+
+void ScrapEngine::Render::RenderGraph::record_barriers(const compiled_pass& pass, const pass_context& context) const
+{
+	if (pass.barriers.empty())
+	{
+		return;
+	}
+
+	//Sized for the worst case, the memory is released with the frame
+	vk::ImageMemoryBarrier* image_barriers = context.arena->allocate_array<vk::ImageMemoryBarrier>(
+		pass.barriers.size());
+	vk::BufferMemoryBarrier* buffer_barriers = context.arena->allocate_array<vk::BufferMemoryBarrier>(
+		pass.barriers.size());
+	uint32_t image_barrier_count = 0;
+	uint32_t buffer_barrier_count = 0;
+
+	for (const pass_barrier& barrier : pass.barriers)
+	{
+		const graph_resource& resource = resources_[barrier.resource];
+		if (resource.type == resource_type::image)
+		{
+			image_barriers[image_barrier_count++] = vk::ImageMemoryBarrier(
+				barrier.src_access,
+				barrier.dst_access,
+				barrier.old_layout,
+				barrier.new_layout,
+				VK_QUEUE_FAMILY_IGNORED,
+				VK_QUEUE_FAMILY_IGNORED,
+				get_image(barrier.resource, context.image_index),
+				vk::ImageSubresourceRange(resource.description.aspect, 0, 1, 0, 1)
+			);
+		}
+		else
+		{
+			buffer_barriers[buffer_barrier_count++] = vk::BufferMemoryBarrier(
+				barrier.src_access,
+				barrier.dst_access,
+				VK_QUEUE_FAMILY_IGNORED,
+				VK_QUEUE_FAMILY_IGNORED,
+				resource.imported_buffer,
+				0,
+				VK_WHOLE_SIZE
+			);
+		}
+	}
+
+	context.command_buffer.pipelineBarrier(pass.src_stages, pass.dst_stages, vk::DependencyFlags(),
+	                                       0, nullptr,
+	                                       buffer_barrier_count, buffer_barriers,
+	                                       image_barrier_count, image_barriers);
+}
+
+vk::Image ScrapEngine::Render::RenderGraph::get_image(const resource_handle resource, const uint32_t image_index) const
+{
+	const graph_resource& graph_res = resources_[resource];
+	if (graph_res.transient)
+	{
+		return graph_res.transient_image;
+	}
+	if (graph_res.imported_image_count > 1)
+	{
+		return graph_res.imported_images[image_index];
+	}
+	return graph_res.imported_images[0];
+}
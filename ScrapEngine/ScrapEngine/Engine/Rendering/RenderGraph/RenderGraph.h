@@ -0,0 +1,209 @@
+#pragma once
+
+#include <Engine/Rendering/VulkanInclude.h>
+#include <Engine/Rendering/Memory/VulkanMemoryAllocator.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		class FrameArena;
+
+		//Small frame graph
+		//Passes declare the images and buffers they read and write, then compile() does the following:
+		//orders the passes by their dependencies, removes the passes that don't contribute to an output,
+		//computes the barriers between the passes and allocates the transient images,
+		//aliasing the memory of the ones whose lifetimes don't overlap
+		//The graph is compiled once and executed every frame
+		class RenderGraph
+		{
+		public:
+			typedef uint32_t resource_handle;
+			typedef uint32_t pass_handle;
+
+			enum class resource_usage
+			{
+				color_attachment,
+				depth_attachment,
+				//Depth used as attachment and sampled at the same time (read only)
+				depth_read,
+				sampled,
+				storage_read,
+				storage_write,
+				transfer_src,
+				transfer_dst,
+				present,
+				vertex_buffer,
+				index_buffer,
+				uniform_buffer
+			};
+
+			struct image_description
+			{
+				vk::Format format = vk::Format::eUndefined;
+				vk::Extent2D extent;
+				vk::SampleCountFlagBits samples = vk::SampleCountFlagBits::e1;
+				vk::ImageUsageFlags usage;
+				vk::ImageAspectFlags aspect = vk::ImageAspectFlagBits::eColor;
+			};
+
+			//Data passed to the passes when they are executed
+			struct pass_context
+			{
+				vk::CommandBuffer command_buffer;
+				uint32_t frame_index = 0;
+				uint32_t image_index = 0;
+				//Transient memory of the frame, reset before the graph is executed
+				FrameArena* arena = nullptr;
+			};
+
+			typedef std::function<void(const pass_context&)> pass_callback;
+		private:
+			enum class resource_type
+			{
+				image,
+				buffer
+			};
+
+			struct resource_access
+			{
+				resource_handle resource = 0;
+				resource_usage usage = resource_usage::sampled;
+				bool write = false;
+				//The layout transition and the dependency are done by the vk::RenderPass used by the pass
+				//(initial/final layouts and external subpass dependencies), so the graph doesn't add a barrier
+				bool render_pass_synchronized = false;
+				//Layout of the image after the pass, eUndefined means the layout of the usage
+				vk::ImageLayout end_layout = vk::ImageLayout::eUndefined;
+			};
+
+			struct graph_resource
+			{
+				std::string name;
+				resource_type type = resource_type::image;
+				bool transient = false;
+				bool output = false;
+				image_description description;
+				//Imported resources, indexed by the swap chain image if there's more than one
+				const vk::Image* imported_images = nullptr;
+				size_t imported_image_count = 0;
+				vk::Buffer imported_buffer;
+				vk::ImageLayout initial_layout = vk::ImageLayout::eUndefined;
+				vk::ImageLayout final_layout = vk::ImageLayout::eUndefined;
+				//Transient images, created by compile()
+				vk::Image transient_image;
+				vk::ImageView transient_image_view;
+				int32_t memory_slot = -1;
+				//Previous image in the same memory, its last usage must complete before the first usage of this one
+				int32_t previous_alias = -1;
+				//First and last position in the compiled passes
+				int32_t first_use = -1;
+				int32_t last_use = -1;
+			};
+
+			struct graph_pass
+			{
+				std::string name;
+				pass_callback callback;
+				std::vector<resource_access> accesses;
+				bool alive = false;
+			};
+
+			//A barrier computed at compile time, the image or buffer is resolved when executed
+			struct pass_barrier
+			{
+				resource_handle resource = 0;
+				vk::AccessFlags src_access;
+				vk::AccessFlags dst_access;
+				vk::ImageLayout old_layout = vk::ImageLayout::eUndefined;
+				vk::ImageLayout new_layout = vk::ImageLayout::eUndefined;
+			};
+
+			struct compiled_pass
+			{
+				pass_handle pass = 0;
+				vk::PipelineStageFlags src_stages;
+				vk::PipelineStageFlags dst_stages;
+				std::vector<pass_barrier> barriers;
+			};
+
+			//Memory shared by the transient images that are never used at the same time
+			struct memory_slot
+			{
+				vk::MemoryRequirements requirements;
+				VmaAllocation allocation = nullptr;
+				int32_t last_use = -1;
+				resource_handle last_resource = 0;
+			};
+
+			std::vector<graph_resource> resources_;
+			std::vector<graph_pass> passes_;
+			std::vector<compiled_pass> compiled_passes_;
+			compiled_pass final_barriers_;
+			std::vector<memory_slot> memory_slots_;
+			bool compiled_ = false;
+		public:
+			RenderGraph() = default;
+			~RenderGraph();
+
+			//Resources created outside the graph, ex: the swap chain images
+			//If final_layout is not eUndefined the image is transitioned to it at the end of the graph
+			resource_handle import_image(const std::string& name, const std::vector<vk::Image>* images,
+			                             vk::ImageAspectFlags aspect, vk::ImageLayout initial_layout,
+			                             vk::ImageLayout final_layout = vk::ImageLayout::eUndefined);
+			resource_handle import_image(const std::string& name, const vk::Image* image,
+			                             vk::ImageAspectFlags aspect, vk::ImageLayout initial_layout,
+			                             vk::ImageLayout final_layout = vk::ImageLayout::eUndefined);
+			resource_handle import_buffer(const std::string& name, vk::Buffer buffer);
+
+			//Images owned by the graph, their content is not preserved between frames
+			resource_handle create_transient_image(const std::string& name, const image_description& description);
+
+			//The passes writing an output (and the passes they depend on) are never culled
+			void mark_output(resource_handle resource);
+
+			pass_handle add_pass(const std::string& name, const pass_callback& callback);
+			void add_read(pass_handle pass, resource_handle resource, resource_usage usage,
+			              bool render_pass_synchronized = false);
+			void add_write(pass_handle pass, resource_handle resource, resource_usage usage,
+			               bool render_pass_synchronized = false,
+			               vk::ImageLayout end_layout = vk::ImageLayout::eUndefined);
+
+			void compile();
+
+			//Record all the passes in a command buffer
+			void execute(const pass_context& context) const;
+
+			//Record a single compiled pass with its barriers
+			//The passes can be recorded in parallel in different command buffers, submitted in the compiled order
+			size_t get_compiled_pass_count() const;
+			const std::string& get_compiled_pass_name(size_t index) const;
+			void execute_pass(size_t index, const pass_context& context) const;
+			//Record the final layout transitions, after the last pass
+			void execute_final_barriers(const pass_context& context) const;
+
+			bool is_pass_culled(pass_handle pass) const;
+			vk::Image get_transient_image(resource_handle resource) const;
+			vk::ImageView get_transient_image_view(resource_handle resource) const;
+			//Number of memory allocations used by the transient images
+			size_t get_transient_memory_count() const;
+		private:
+			void destroy_transient_resources();
+
+			std::vector<pass_handle> sort_passes() const;
+			void cull_passes();
+			void allocate_transient_images();
+			void compute_barriers();
+
+			static void get_usage_info(resource_usage usage, vk::PipelineStageFlags& stages, vk::AccessFlags& access,
+			                           vk::ImageLayout& layout);
+			static bool is_write_access(vk::AccessFlags access);
+
+			void record_barriers(const compiled_pass& pass, const pass_context& context) const;
+			vk::Image get_image(resource_handle resource, uint32_t image_index) const;
+		};
+	}
+}
@@ -1,47 +1,26 @@
 #include <Engine/Rendering/RenderPass/GuiRenderPass/GuiRenderPass.h>
 #include <array>
-#include <Engine/Rendering/DepthResources/VulkanDepthResources.h>
 #include <Engine/Rendering/Device/VulkanDevice.h>
 #include <Engine/Debug/DebugLog.h>
 
+//Init static instance reference
+
+ScrapEngine::Render::GuiRenderPass* ScrapEngine::Render::GuiRenderPass::instance_ = nullptr;
+
 //Class
 
-ScrapEngine::Render::GuiRenderPass::GuiRenderPass(const vk::Format& swap_chain_image_format,
-                                                  const vk::SampleCountFlagBits msaa_samples)
+void ScrapEngine::Render::GuiRenderPass::init(const vk::Format& swap_chain_image_format)
 {
+	//The upscaled scene is kept, the gui blends over it
 	const vk::AttachmentDescription color_attachment(
-		vk::AttachmentDescriptionFlags(),
-		swap_chain_image_format,
-		msaa_samples,
-		vk::AttachmentLoadOp::eLoad,
-		vk::AttachmentStoreOp::eStore,
-		vk::AttachmentLoadOp::eDontCare,
-		vk::AttachmentStoreOp::eDontCare,
-		vk::ImageLayout::eColorAttachmentOptimal,
-		vk::ImageLayout::eColorAttachmentOptimal
-	);
-
-	const vk::AttachmentDescription depth_attachment(
-		vk::AttachmentDescriptionFlags(),
-		VulkanDepthResources::find_depth_format(),
-		msaa_samples,
-		vk::AttachmentLoadOp::eDontCare,
-		vk::AttachmentStoreOp::eDontCare,
-		vk::AttachmentLoadOp::eDontCare,
-		vk::AttachmentStoreOp::eDontCare,
-		vk::ImageLayout::eUndefined,
-		vk::ImageLayout::eDepthStencilAttachmentOptimal
-	);
-
-	const vk::AttachmentDescription color_attachment_resolve(
 		vk::AttachmentDescriptionFlags(),
 		swap_chain_image_format,
 		vk::SampleCountFlagBits::e1,
-		vk::AttachmentLoadOp::eDontCare,
+		vk::AttachmentLoadOp::eLoad,
 		vk::AttachmentStoreOp::eStore,
 		vk::AttachmentLoadOp::eDontCare,
 		vk::AttachmentStoreOp::eDontCare,
-		vk::ImageLayout::eUndefined,
+		vk::ImageLayout::eTransferDstOptimal,
 		vk::ImageLayout::ePresentSrcKHR
 	);
 
@@ -50,52 +29,54 @@ ScrapEngine::Render::GuiRenderPass::GuiRenderPass(const vk::Format& swap_chain_i
 		vk::ImageLayout::eColorAttachmentOptimal
 	);
 
-	vk::AttachmentReference depth_attachment_ref(
-		1,
-		vk::ImageLayout::eDepthStencilAttachmentOptimal
-	);
-
-	vk::AttachmentReference color_attachment_resolve_ref(
-		2,
-		vk::ImageLayout::eColorAttachmentOptimal
-	);
-
 	vk::SubpassDescription subpass(
 		vk::SubpassDescriptionFlags(),
 		vk::PipelineBindPoint::eGraphics,
 		0, nullptr,
-		1, &color_attachment_ref,
-		&color_attachment_resolve_ref,
-		&depth_attachment_ref
+		1, &color_attachment_ref
 	);
 
-	vk::SubpassDependency dependency(
-		VK_SUBPASS_EXTERNAL,
-		0,
-		vk::PipelineStageFlagBits::eColorAttachmentOutput,
-		vk::PipelineStageFlagBits::eColorAttachmentOutput,
-		vk::AccessFlags(),
-		vk::AccessFlagBits::eColorAttachmentRead | vk::AccessFlagBits::eColorAttachmentWrite
-	);
+	std::array<vk::SubpassDependency, 2> dependencies;
+
+	//Wait the upscale blit
+	dependencies[0].setSrcSubpass(VK_SUBPASS_EXTERNAL);
+	dependencies[0].setDstSubpass(gui_subpass);
+	dependencies[0].setSrcStageMask(vk::PipelineStageFlagBits::eTransfer);
+	dependencies[0].setDstStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+	dependencies[0].setSrcAccessMask(vk::AccessFlagBits::eTransferWrite);
+	dependencies[0].setDstAccessMask(vk::AccessFlagBits::eColorAttachmentRead | vk::AccessFlagBits::eColorAttachmentWrite);
 
-	std::array<vk::AttachmentDescription, 3> attachments = {
-		color_attachment, depth_attachment, color_attachment_resolve
-	};
+	dependencies[1].setSrcSubpass(gui_subpass);
+	dependencies[1].setDstSubpass(VK_SUBPASS_EXTERNAL);
+	dependencies[1].setSrcStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+	dependencies[1].setDstStageMask(vk::PipelineStageFlagBits::eBottomOfPipe);
+	dependencies[1].setSrcAccessMask(vk::AccessFlagBits::eColorAttachmentRead | vk::AccessFlagBits::eColorAttachmentWrite);
+	dependencies[1].setDstAccessMask(vk::AccessFlagBits::eMemoryRead);
 
 	vk::RenderPassCreateInfo render_pass_info(
 		vk::RenderPassCreateFlags(),
-		static_cast<uint32_t>(attachments.size()),
-		attachments.data(),
 		1,
-		&subpass,
+		&color_attachment,
 		1,
-		&dependency
+		&subpass,
+		static_cast<uint32_t>(dependencies.size()),
+		dependencies.data()
 	);
 
-	const vk::Result result = VulkanDevice::get_instance()->get_logical_device()->createRenderPass(&render_pass_info, nullptr, &render_pass_);
+	const vk::Result result = VulkanDevice::get_instance()->get_logical_device()->createRenderPass(
+		&render_pass_info, nullptr, &render_pass_);
 
 	if (result != vk::Result::eSuccess)
 	{
-		Debug::DebugLog::fatal_error(result, "VulkanRenderPass: Failed to create render pass!");
+		Debug::DebugLog::fatal_error(result, "GuiRenderPass: Failed to create render pass!");
+	}
+}
+
+ScrapEngine::Render::GuiRenderPass* ScrapEngine::Render::GuiRenderPass::get_instance()
+{
+	if (instance_ == nullptr)
+	{
+		instance_ = new GuiRenderPass();
 	}
+	return instance_;
 }
@@ -6,12 +6,25 @@ namespace ScrapEngine
 {
 	namespace Render
 	{
+		//The gui is drawn at the swap chain resolution over the upscaled scene, only when the scene is scaled
+		//Attachments: the swap chain image, already written by the upscale
 		class GuiRenderPass : public BaseRenderPass
 		{
+		private:
+			//Singleton static instance
+			static GuiRenderPass* instance_;
+
+			//The constructor is private because this class is a Singleton
+			GuiRenderPass() = default;
 		public:
-			GuiRenderPass(const vk::Format& swap_chain_image_format, vk::SampleCountFlagBits msaa_samples);
+			static const uint32_t gui_subpass = 0;
+
+			//Method used to init the class with parameters because the constructor is private
+			void init(const vk::Format& swap_chain_image_format);
 
 			~GuiRenderPass() = default;
+
+			static GuiRenderPass* get_instance();
 		};
 	}
 }
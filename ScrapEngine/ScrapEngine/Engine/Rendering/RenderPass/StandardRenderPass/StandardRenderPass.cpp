@@ -1,5 +1,6 @@
 #include <Engine/Rendering/RenderPass/StandardRenderPass/StandardRenderPass.h>
 #include <array>
+#include <vector>
 #include <Engine/Rendering/DepthResources/VulkanDepthResources.h>
 #include <Engine/Rendering/Device/VulkanDevice.h>
 #include <Engine/Debug/DebugLog.h>
@@ -11,32 +12,53 @@ ScrapEngine::Render::StandardRenderPass* ScrapEngine::Render::StandardRenderPass
 //Class
 
 void ScrapEngine::Render::StandardRenderPass::init(const vk::Format& swap_chain_image_format,
-                                                   const vk::SampleCountFlagBits msaa_samples)
+                                                   const vk::SampleCountFlagBits msaa_samples,
+                                                   const scene_output output)
 {
 	msaa_samples_ = msaa_samples;
+	output_ = output;
+	const bool msaa_enabled = is_msaa_enabled();
+	const bool gui_subpass_enabled = has_gui_subpass();
+	const bool sampled_output = output == scene_output::sampled;
+	velocity_ = sampled_output && !msaa_enabled;
+	//The swap chain image is presented, the scene color is blitted by the upscale or sampled by the temporal resolve
+	vk::ImageLayout output_layout = vk::ImageLayout::ePresentSrcKHR;
+	if (output == scene_output::transfer_source)
+	{
+		output_layout = vk::ImageLayout::eTransferSrcOptimal;
+	}
+	else if (sampled_output)
+	{
+		output_layout = vk::ImageLayout::eShaderReadOnlyOptimal;
+	}
 	
+	//With msaa the color attachment is resolved inside the render pass, its content is never needed after it
+	//Without msaa the output image is used directly
 	const vk::AttachmentDescription color_attachment(
 		vk::AttachmentDescriptionFlags(),
 		swap_chain_image_format,
 		msaa_samples,
 		vk::AttachmentLoadOp::eClear,
-		vk::AttachmentStoreOp::eStore,
+		msaa_enabled ? vk::AttachmentStoreOp::eDontCare : vk::AttachmentStoreOp::eStore,
 		vk::AttachmentLoadOp::eDontCare,
 		vk::AttachmentStoreOp::eDontCare,
 		vk::ImageLayout::eUndefined,
-		vk::ImageLayout::eColorAttachmentOptimal
+		msaa_enabled ? vk::ImageLayout::eColorAttachmentOptimal : output_layout
 	);
 
+	//The depth is stored only for the temporal resolve, that reprojects the history with it
 	const vk::AttachmentDescription depth_attachment(
 		vk::AttachmentDescriptionFlags(),
 		VulkanDepthResources::find_depth_format(),
 		msaa_samples,
 		vk::AttachmentLoadOp::eClear,
-		vk::AttachmentStoreOp::eStore,
-		vk::AttachmentLoadOp::eClear,
+		sampled_output ? vk::AttachmentStoreOp::eStore : vk::AttachmentStoreOp::eDontCare,
+		vk::AttachmentLoadOp::eDontCare,
 		vk::AttachmentStoreOp::eDontCare,
 		vk::ImageLayout::eUndefined,
-		vk::ImageLayout::eDepthStencilAttachmentOptimal
+		sampled_output
+			? vk::ImageLayout::eDepthStencilReadOnlyOptimal
+			: vk::ImageLayout::eDepthStencilAttachmentOptimal
 	);
 
 	const vk::AttachmentDescription color_attachment_resolve(
@@ -48,7 +70,7 @@ void ScrapEngine::Render::StandardRenderPass::init(const vk::Format& swap_chain_
 		vk::AttachmentLoadOp::eDontCare,
 		vk::AttachmentStoreOp::eDontCare,
 		vk::ImageLayout::eUndefined,
-		vk::ImageLayout::ePresentSrcKHR
+		output_layout
 	);
 
 	vk::AttachmentReference color_attachment_ref(
@@ -66,43 +88,116 @@ void ScrapEngine::Render::StandardRenderPass::init(const vk::Format& swap_chain_
 		vk::ImageLayout::eColorAttachmentOptimal
 	);
 
-	vk::SubpassDescription subpass(
+	//Cleared to velocity_clear_value, the temporal resolve uses the depth where no mesh is drawn
+	const vk::AttachmentDescription velocity_attachment_description(
+		vk::AttachmentDescriptionFlags(),
+		velocity_format,
+		vk::SampleCountFlagBits::e1,
+		vk::AttachmentLoadOp::eClear,
+		vk::AttachmentStoreOp::eStore,
+		vk::AttachmentLoadOp::eDontCare,
+		vk::AttachmentStoreOp::eDontCare,
+		vk::ImageLayout::eUndefined,
+		vk::ImageLayout::eShaderReadOnlyOptimal
+	);
+
+	std::vector<vk::AttachmentReference> scene_color_refs = {color_attachment_ref};
+	if (velocity_)
+	{
+		scene_color_refs.push_back(vk::AttachmentReference(
+			velocity_attachment,
+			vk::ImageLayout::eColorAttachmentOptimal
+		));
+	}
+
+	std::vector<vk::SubpassDescription> subpasses;
+
+	//Scene subpass, resolved at the end of the last subpass
+	subpasses.push_back(vk::SubpassDescription(
 		vk::SubpassDescriptionFlags(),
 		vk::PipelineBindPoint::eGraphics,
 		0, nullptr,
-		1, &color_attachment_ref,
-		&color_attachment_resolve_ref,
+		static_cast<uint32_t>(scene_color_refs.size()), scene_color_refs.data(),
+		msaa_enabled && !gui_subpass_enabled ? &color_attachment_resolve_ref : nullptr,
 		&depth_attachment_ref
-	);
+	));
 
-	std::array<vk::AttachmentDescription, 3> attachments = {
-		color_attachment, depth_attachment, color_attachment_resolve
+	//Gui subpass, draw over the scene and resolve the result to the swap chain image
+	if (gui_subpass_enabled)
+	{
+		subpasses.push_back(vk::SubpassDescription(
+			vk::SubpassDescriptionFlags(),
+			vk::PipelineBindPoint::eGraphics,
+			0, nullptr,
+			1, &color_attachment_ref,
+			msaa_enabled ? &color_attachment_resolve_ref : nullptr,
+			nullptr
+		));
+	}
+
+	std::vector<vk::AttachmentDescription> attachments = {
+		color_attachment, depth_attachment
 	};
+	if (msaa_enabled)
+	{
+		attachments.push_back(color_attachment_resolve);
+	}
+	if (velocity_)
+	{
+		attachments.push_back(velocity_attachment_description);
+	}
 
-	std::array< vk::SubpassDependency, 2> dependencies;
+	std::vector<vk::SubpassDependency> dependencies(gui_subpass_enabled ? 3 : 2);
 
+	//The output image (and the depth with the temporal resolve) of the previous frame could still be read
 	dependencies[0].setSrcSubpass(VK_SUBPASS_EXTERNAL);
-	dependencies[0].setDstSubpass(0);
+	dependencies[0].setDstSubpass(scene_subpass);
 	dependencies[0].setSrcStageMask(vk::PipelineStageFlagBits::eBottomOfPipe);
-	dependencies[0].setDstStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+	dependencies[0].setDstStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput |
+		vk::PipelineStageFlagBits::eEarlyFragmentTests);
 	dependencies[0].setSrcAccessMask(vk::AccessFlagBits::eMemoryRead);
-	dependencies[0].setDstAccessMask(vk::AccessFlagBits::eColorAttachmentRead | vk::AccessFlagBits::eColorAttachmentWrite);
+	dependencies[0].setDstAccessMask(vk::AccessFlagBits::eColorAttachmentRead | vk::AccessFlagBits::eColorAttachmentWrite |
+		vk::AccessFlagBits::eDepthStencilAttachmentWrite);
 	dependencies[0].setDependencyFlags(vk::DependencyFlagBits::eByRegion);
 
-	dependencies[1].setSrcSubpass(0);
-	dependencies[1].setDstSubpass(VK_SUBPASS_EXTERNAL);
-	dependencies[1].setSrcStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput);
-	dependencies[1].setDstStageMask(vk::PipelineStageFlagBits::eBottomOfPipe);
-	dependencies[1].setSrcAccessMask(vk::AccessFlagBits::eColorAttachmentRead | vk::AccessFlagBits::eColorAttachmentWrite);
-	dependencies[0].setDstAccessMask(vk::AccessFlagBits::eMemoryRead);
-	dependencies[1].setDependencyFlags(vk::DependencyFlagBits::eByRegion);
+	if (gui_subpass_enabled)
+	{
+		//The gui blends over the scene color
+		dependencies[1].setSrcSubpass(scene_subpass);
+		dependencies[1].setDstSubpass(gui_subpass);
+		dependencies[1].setSrcStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+		dependencies[1].setDstStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+		dependencies[1].setSrcAccessMask(vk::AccessFlagBits::eColorAttachmentWrite);
+		dependencies[1].setDstAccessMask(vk::AccessFlagBits::eColorAttachmentRead | vk::AccessFlagBits::eColorAttachmentWrite);
+		dependencies[1].setDependencyFlags(vk::DependencyFlagBits::eByRegion);
+
+		dependencies[2].setSrcSubpass(gui_subpass);
+		dependencies[2].setDstSubpass(VK_SUBPASS_EXTERNAL);
+		dependencies[2].setSrcStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+		dependencies[2].setDstStageMask(vk::PipelineStageFlagBits::eBottomOfPipe);
+		dependencies[2].setSrcAccessMask(vk::AccessFlagBits::eColorAttachmentRead | vk::AccessFlagBits::eColorAttachmentWrite);
+		dependencies[2].setDstAccessMask(vk::AccessFlagBits::eMemoryRead);
+		dependencies[2].setDependencyFlags(vk::DependencyFlagBits::eByRegion);
+	}
+	else
+	{
+		//The scene color is read by the upscale blit, or the scene color, the depth and the velocity by the temporal resolve
+		dependencies[1].setSrcSubpass(scene_subpass);
+		dependencies[1].setDstSubpass(VK_SUBPASS_EXTERNAL);
+		dependencies[1].setSrcStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput |
+			vk::PipelineStageFlagBits::eLateFragmentTests);
+		dependencies[1].setDstStageMask(vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eFragmentShader);
+		dependencies[1].setSrcAccessMask(vk::AccessFlagBits::eColorAttachmentWrite |
+			vk::AccessFlagBits::eDepthStencilAttachmentWrite);
+		dependencies[1].setDstAccessMask(vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eShaderRead);
+	}
 
 	vk::RenderPassCreateInfo render_pass_info(
 		vk::RenderPassCreateFlags(),
 		static_cast<uint32_t>(attachments.size()),
 		attachments.data(),
-		1,
-		&subpass,
+		static_cast<uint32_t>(subpasses.size()),
+		subpasses.data(),
 		static_cast<uint32_t>(dependencies.size()),
 		dependencies.data()
 	);
@@ -128,3 +223,23 @@ vk::SampleCountFlagBits ScrapEngine::Render::StandardRenderPass::get_msaa_sample
 {
 	return msaa_samples_;
 }
+
+bool ScrapEngine::Render::StandardRenderPass::is_msaa_enabled() const
+{
+	return msaa_samples_ != vk::SampleCountFlagBits::e1;
+}
+
+bool ScrapEngine::Render::StandardRenderPass::has_gui_subpass() const
+{
+	return output_ == scene_output::swap_chain;
+}
+
+bool ScrapEngine::Render::StandardRenderPass::has_velocity() const
+{
+	return velocity_;
+}
+
+uint32_t ScrapEngine::Render::StandardRenderPass::get_scene_color_attachment_count() const
+{
+	return velocity_ ? 2 : 1;
+}
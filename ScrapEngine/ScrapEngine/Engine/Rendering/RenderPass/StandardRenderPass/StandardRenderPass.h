@@ -15,16 +15,50 @@ namespace ScrapEngine
 			//The constructor is private because this class is a Singleton
 			StandardRenderPass() = default;
 
+		public:
+			//Where the scene is drawn
+			enum class scene_output
+			{
+				//Directly in the swap chain image, the gui is drawn over it in the gui subpass
+				swap_chain,
+				//In the scene color, left in eTransferSrcOptimal for the upscale
+				transfer_source,
+				//In the scene color, with the depth, left readable by the TemporalUpscaler
+				sampled
+			};
+		private:
 			vk::SampleCountFlagBits msaa_samples_;
+			scene_output output_ = scene_output::swap_chain;
+			bool velocity_ = false;
 		public:
+			//Attachments: color, depth and, only with msaa, the output image used as resolve attachment
+			//The output image is the swap chain image or, when the scene is scaled, the scene color
+			//Offscreen the gui is drawn by the GuiRenderPass after the upscale
+			static const uint32_t scene_subpass = 0;
+			//Only with scene_output::swap_chain
+			static const uint32_t gui_subpass = 1;
+			//With scene_output::sampled, that is used without msaa, the meshes also write their velocity
+			//in a second color attachment, left readable by the TemporalUpscaler
+			static const uint32_t velocity_attachment = 2;
+			static const vk::Format velocity_format = vk::Format::eR16G16Sfloat;
+			//Where no mesh is drawn, bigger than any velocity in uv
+			static constexpr float velocity_clear_value = 10000.0f;
+
 			//Method used to init the class with parameters because the constructor is private
-			void init(const vk::Format& swap_chain_image_format, vk::SampleCountFlagBits msaa_samples);
+			void init(const vk::Format& swap_chain_image_format, vk::SampleCountFlagBits msaa_samples,
+			          scene_output output);
 
 			~StandardRenderPass() = default;
 
 			static StandardRenderPass* get_instance();
 
 			vk::SampleCountFlagBits get_msaa_samples() const;
+			//If false the scene is drawn directly in the output image, without the color resources
+			bool is_msaa_enabled() const;
+			bool has_gui_subpass() const;
+			bool has_velocity() const;
+			//Color attachments written by the scene subpass, every pipeline of the subpass has the same count
+			uint32_t get_scene_color_attachment_count() const;
 		};
 	}
 }
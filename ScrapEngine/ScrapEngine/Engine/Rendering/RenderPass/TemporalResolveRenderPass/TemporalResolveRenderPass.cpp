@@ -0,0 +1,73 @@
+#include <Engine/Rendering/RenderPass/TemporalResolveRenderPass/TemporalResolveRenderPass.h>
+#include <array>
+#include <Engine/Rendering/Device/VulkanDevice.h>
+#include <Engine/Debug/DebugLog.h>
+
+ScrapEngine::Render::TemporalResolveRenderPass::TemporalResolveRenderPass(const vk::Format& history_format)
+{
+	//Every pixel is written, so the old content is not loaded
+	const vk::AttachmentDescription attachment_description(
+		vk::AttachmentDescriptionFlags(),
+		history_format,
+		vk::SampleCountFlagBits::e1,
+		vk::AttachmentLoadOp::eDontCare,
+		vk::AttachmentStoreOp::eStore,
+		vk::AttachmentLoadOp::eDontCare,
+		vk::AttachmentStoreOp::eDontCare,
+		vk::ImageLayout::eUndefined,
+		vk::ImageLayout::eTransferSrcOptimal
+	);
+
+	vk::AttachmentReference color_attachment_ref(
+		0,
+		vk::ImageLayout::eColorAttachmentOptimal
+	);
+
+	vk::SubpassDescription subpass(
+		vk::SubpassDescriptionFlags(),
+		vk::PipelineBindPoint::eGraphics,
+		0, nullptr,
+		1, &color_attachment_ref
+	);
+
+	std::array<vk::SubpassDependency, 2> dependencies;
+
+	//The image could still be read as history or copied by the previous frame
+	dependencies[0] = vk::SubpassDependency(
+		VK_SUBPASS_EXTERNAL,
+		0,
+		vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eTransfer,
+		vk::PipelineStageFlagBits::eColorAttachmentOutput,
+		vk::AccessFlags(),
+		vk::AccessFlagBits::eColorAttachmentWrite,
+		vk::DependencyFlagBits::eByRegion
+	);
+
+	//The history is copied in the swap chain image
+	dependencies[1] = vk::SubpassDependency(
+		0,
+		VK_SUBPASS_EXTERNAL,
+		vk::PipelineStageFlagBits::eColorAttachmentOutput,
+		vk::PipelineStageFlagBits::eTransfer,
+		vk::AccessFlagBits::eColorAttachmentWrite,
+		vk::AccessFlagBits::eTransferRead
+	);
+
+	vk::RenderPassCreateInfo render_pass_info(
+		vk::RenderPassCreateFlags(),
+		1,
+		&attachment_description,
+		1,
+		&subpass,
+		static_cast<uint32_t>(dependencies.size()),
+		dependencies.data()
+	);
+
+	const vk::Result result = VulkanDevice::get_instance()->get_logical_device()->createRenderPass(
+		&render_pass_info, nullptr, &render_pass_);
+
+	if (result != vk::Result::eSuccess)
+	{
+		Debug::DebugLog::fatal_error(result, "TemporalResolveRenderPass: Failed to create render pass!");
+	}
+}
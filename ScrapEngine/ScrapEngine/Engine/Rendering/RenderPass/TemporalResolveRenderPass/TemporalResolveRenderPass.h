@@ -0,0 +1,19 @@
+#pragma once
+
+#include <Engine/Rendering/RenderPass/BaseRenderPass.h>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		//Temporal resolve of the scene in a history image, see TemporalUpscaler
+		//The history image is left in eTransferSrcOptimal to be copied in the swap chain image
+		class TemporalResolveRenderPass : public BaseRenderPass
+		{
+		public:
+			TemporalResolveRenderPass(const vk::Format& history_format);
+
+			~TemporalResolveRenderPass() = default;
+		};
+	}
+}
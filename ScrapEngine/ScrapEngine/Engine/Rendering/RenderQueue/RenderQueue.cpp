@@ -0,0 +1,260 @@
+#include <Engine/Rendering/RenderQueue/RenderQueue.h>
+#include <algorithm>
+#include <cstring>
+
+uint32_t ScrapEngine::Render::RenderQueue::queue_stats::get_total_binds() const
+{
+	return pipeline_binds + descriptor_set_binds + vertex_buffer_binds + index_buffer_binds;
+}
+
+void ScrapEngine::Render::RenderQueue::id_table::clear()
+{
+	std::fill(slots.begin(), slots.end(), slot());
+	count = 0;
+}
+
+uint32_t ScrapEngine::Render::RenderQueue::id_table::get_id(const uint64_t handle, const uint32_t bits)
+{
+	//Keep the load under one half
+	if ((count + 1) * 2 > slots.size())
+	{
+		grow();
+	}
+	const size_t mask = slots.size() - 1;
+	//Fibonacci hashing, the handles are often aligned addresses
+	size_t index = static_cast<size_t>((handle * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+	while (slots[index].handle != 0)
+	{
+		if (slots[index].handle == handle)
+		{
+			return slots[index].id;
+		}
+		index = (index + 1) & mask;
+	}
+	//Over the limit the ids are shared, the sort is less effective but the draws are still correct
+	const uint32_t id = count & ((1u << bits) - 1);
+	slots[index].handle = handle;
+	slots[index].id = id;
+	count++;
+	return id;
+}
+
+void ScrapEngine::Render::RenderQueue::id_table::grow()
+{
+	std::vector<slot> old_slots;
+	old_slots.swap(slots);
+	slots.resize(old_slots.empty() ? 64 : old_slots.size() * 2);
+	const size_t mask = slots.size() - 1;
+	for (const slot& old_slot : old_slots)
+	{
+		if (old_slot.handle == 0)
+		{
+			continue;
+		}
+		size_t index = static_cast<size_t>((old_slot.handle * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+		while (slots[index].handle != 0)
+		{
+			index = (index + 1) & mask;
+		}
+		slots[index] = old_slot;
+	}
+}
+
+template <typename T>
+uint64_t ScrapEngine::Render::RenderQueue::to_handle(const T handle)
+{
+	//The non dispatchable handles are pointers on 64 bit and integers on 32 bit
+	uint64_t value = 0;
+	std::memcpy(&value, &handle, sizeof(T));
+	return value;
+}
+
+uint64_t ScrapEngine::Render::RenderQueue::make_key(const queue_pass pass, const draw_call& draw, float depth)
+{
+	depth = std::min(std::max(depth, 0.0f), 1.0f);
+
+	const uint64_t pipeline_id = pipeline_ids_.get_id(to_handle(static_cast<VkPipeline>(draw.pipeline)), 10);
+	const uint64_t material_id = material_ids_.get_id(to_handle(draw.descriptor_sets), 12);
+	const uint64_t geometry_id = geometry_ids_.get_id(to_handle(static_cast<VkBuffer>(draw.position_buffer)), 12);
+	const uint64_t fine_depth = static_cast<uint64_t>(depth * ((1u << 19) - 1));
+
+	uint64_t key = static_cast<uint64_t>(pass) << pass_shift;
+	if (is_front_to_back(pass))
+	{
+		key |= static_cast<uint64_t>(depth * 255.0f) << coarse_depth_shift;
+	}
+	key |= pipeline_id << pipeline_shift;
+	key |= material_id << material_shift;
+	key |= geometry_id << geometry_shift;
+	key |= fine_depth;
+
+	return key;
+}
+
+bool ScrapEngine::Render::RenderQueue::is_front_to_back(const queue_pass pass) const
+{
+	//With the depth prepass the opaque draws already have the final depth, so they are sorted only by state
+	return pass == queue_pass::depth_prepass || !depth_prepass_enabled_;
+}
+
+void ScrapEngine::Render::RenderQueue::radix_sort()
+{
+	//LSD radix sort, 8 bits for each pass
+	sort_buffer_.resize(items_.size());
+
+	for (uint32_t shift = 0; shift < 64; shift += 8)
+	{
+		size_t offsets[256] = {};
+		for (const sort_item& item : items_)
+		{
+			offsets[(item.key >> shift) & 0xFF]++;
+		}
+		//Skip the digit if all the keys have the same value
+		if (offsets[(items_[0].key >> shift) & 0xFF] == items_.size())
+		{
+			continue;
+		}
+		size_t sum = 0;
+		for (size_t& offset : offsets)
+		{
+			const size_t count = offset;
+			offset = sum;
+			sum += count;
+		}
+		for (const sort_item& item : items_)
+		{
+			sort_buffer_[offsets[(item.key >> shift) & 0xFF]++] = item;
+		}
+		items_.swap(sort_buffer_);
+	}
+}
+
+void ScrapEngine::Render::RenderQueue::clear()
+{
+	draws_.clear();
+	items_.clear();
+	pipeline_ids_.clear();
+	material_ids_.clear();
+	geometry_ids_.clear();
+	sorted_ = true;
+}
+
+void ScrapEngine::Render::RenderQueue::add_draw(const draw_call& draw, const vk::Pipeline depth_prepass_pipeline,
+                                                const float depth)
+{
+	draws_.push_back(draw);
+	items_.push_back({make_key(queue_pass::opaque, draw, depth), static_cast<uint32_t>(draws_.size() - 1)});
+
+	if (depth_prepass_enabled_ && depth_prepass_pipeline)
+	{
+		draw_call depth_draw = draw;
+		depth_draw.pipeline = depth_prepass_pipeline;
+		//The prepass shader reads only the positions
+		depth_draw.attribute_buffer = vk::Buffer();
+		draws_.push_back(depth_draw);
+		items_.push_back({
+			make_key(queue_pass::depth_prepass, depth_draw, depth), static_cast<uint32_t>(draws_.size() - 1)
+		});
+	}
+	sorted_ = false;
+}
+
+void ScrapEngine::Render::RenderQueue::sort()
+{
+	if (!sorted_ && items_.size() > 1)
+	{
+		radix_sort();
+	}
+	sorted_ = true;
+}
+
+void ScrapEngine::Render::RenderQueue::record(const vk::CommandBuffer command_buffer, const uint32_t frame_index)
+{
+	sort();
+
+	queue_stats stats;
+	stats.draw_calls = static_cast<uint32_t>(items_.size());
+	//Pipeline, descriptor set, vertex and index buffer for every draw
+	stats.unsorted_binds = stats.draw_calls * 4;
+
+	const vk::DeviceSize offsets[] = {0, 0};
+	vk::Pipeline bound_pipeline;
+	vk::PipelineLayout bound_layout;
+	vk::DescriptorSet bound_descriptor_set;
+	vk::Buffer bound_position_buffer;
+	vk::Buffer bound_attribute_buffer;
+	vk::Buffer bound_index_buffer;
+
+	for (const sort_item& item : items_)
+	{
+		const draw_call& draw = draws_[item.draw];
+
+		if (draw.pipeline != bound_pipeline)
+		{
+			command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, draw.pipeline);
+			bound_pipeline = draw.pipeline;
+			stats.pipeline_binds++;
+		}
+
+		const vk::DescriptorSet descriptor_set = (*draw.descriptor_sets)[frame_index];
+		//Different layouts may not be compatible, so the set is bound again
+		if (descriptor_set != bound_descriptor_set || draw.pipeline_layout != bound_layout)
+		{
+			command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, draw.pipeline_layout, 0,
+			                                  1, &descriptor_set, 0, nullptr);
+			bound_descriptor_set = descriptor_set;
+			bound_layout = draw.pipeline_layout;
+			stats.descriptor_set_binds++;
+		}
+
+		if (!draw.attribute_buffer)
+		{
+			//The stream 1 stays bound, the next full draw with the same attributes can skip it
+			if (draw.position_buffer != bound_position_buffer)
+			{
+				command_buffer.bindVertexBuffers(0, 1, &draw.position_buffer, offsets);
+				bound_position_buffer = draw.position_buffer;
+				stats.vertex_buffer_binds++;
+			}
+		}
+		else if (draw.position_buffer != bound_position_buffer || draw.attribute_buffer != bound_attribute_buffer)
+		{
+			const vk::Buffer vertex_buffers[] = {draw.position_buffer, draw.attribute_buffer};
+			command_buffer.bindVertexBuffers(0, 2, vertex_buffers, offsets);
+			bound_position_buffer = draw.position_buffer;
+			bound_attribute_buffer = draw.attribute_buffer;
+			stats.vertex_buffer_binds++;
+		}
+
+		if (draw.index_buffer != bound_index_buffer)
+		{
+			command_buffer.bindIndexBuffer(draw.index_buffer, 0, vk::IndexType::eUint32);
+			bound_index_buffer = draw.index_buffer;
+			stats.index_buffer_binds++;
+		}
+
+		command_buffer.drawIndexed(draw.index_count, 1, 0, 0, 0);
+	}
+
+	stats_ = stats;
+}
+
+void ScrapEngine::Render::RenderQueue::set_depth_prepass_enabled(const bool enabled)
+{
+	depth_prepass_enabled_ = enabled;
+}
+
+bool ScrapEngine::Render::RenderQueue::is_depth_prepass_enabled() const
+{
+	return depth_prepass_enabled_;
+}
+
+size_t ScrapEngine::Render::RenderQueue::get_draw_count() const
+{
+	return items_.size();
+}
+
+const ScrapEngine::Render::RenderQueue::queue_stats& ScrapEngine::Render::RenderQueue::get_stats() const
+{
+	return stats_;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <Engine/Rendering/VulkanInclude.h>
+#include <vector>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		//Collect the draw calls of the scene, sort them by a 64 bit key and record them
+		//Binds of the state already bound by the previous draw are skipped
+		class RenderQueue
+		{
+		public:
+			enum class queue_pass
+			{
+				//Depth only draws, front to back
+				depth_prepass = 0,
+				opaque = 1
+			};
+
+			struct draw_call
+			{
+				vk::Pipeline pipeline;
+				vk::PipelineLayout pipeline_layout;
+				//Descriptor sets of the material, indexed by frame in flight
+				const std::vector<vk::DescriptorSet>* descriptor_sets = nullptr;
+				//Vertex streams, see Vertex
+				//Without the attribute buffer only the position stream is bound, as in the depth prepass
+				vk::Buffer position_buffer;
+				vk::Buffer attribute_buffer;
+				vk::Buffer index_buffer;
+				uint32_t index_count = 0;
+			};
+
+			struct queue_stats
+			{
+				uint32_t draw_calls = 0;
+				//Binds without sorting and state elision, every draw binds all its state
+				uint32_t unsorted_binds = 0;
+				uint32_t pipeline_binds = 0;
+				uint32_t descriptor_set_binds = 0;
+				uint32_t vertex_buffer_binds = 0;
+				uint32_t index_buffer_binds = 0;
+
+				uint32_t get_total_binds() const;
+			};
+		private:
+			//Key layout, from the most significant bit:
+			//pass (3) | coarse depth (8) | pipeline (10) | material (12) | geometry (12) | fine depth (19)
+			//The coarse depth is used only by the front to back passes, so the other passes are sorted by state
+			static const uint32_t pass_shift = 61;
+			static const uint32_t coarse_depth_shift = 53;
+			static const uint32_t pipeline_shift = 43;
+			static const uint32_t material_shift = 31;
+			static const uint32_t geometry_shift = 19;
+
+			struct sort_item
+			{
+				uint64_t key;
+				uint32_t draw;
+			};
+
+			std::vector<draw_call> draws_;
+			std::vector<sort_item> items_;
+			//Ping pong buffer of the radix sort
+			std::vector<sort_item> sort_buffer_;
+
+			//Small ids assigned in order of appearance, the handles are too big for the key
+			//Open addressing, clear() keeps the slots so the recording doesn't allocate once the scene is stable
+			struct id_table
+			{
+				struct slot
+				{
+					//0 means empty, the null handles are never added
+					uint64_t handle = 0;
+					uint32_t id = 0;
+				};
+
+				std::vector<slot> slots;
+				uint32_t count = 0;
+
+				void clear();
+				uint32_t get_id(uint64_t handle, uint32_t bits);
+			private:
+				void grow();
+			};
+
+			id_table pipeline_ids_;
+			id_table material_ids_;
+			id_table geometry_ids_;
+
+			bool depth_prepass_enabled_ = false;
+			bool sorted_ = true;
+			queue_stats stats_;
+
+			template <typename T>
+			static uint64_t to_handle(T handle);
+
+			uint64_t make_key(queue_pass pass, const draw_call& draw, float depth);
+			bool is_front_to_back(queue_pass pass) const;
+			void radix_sort();
+		public:
+			RenderQueue() = default;
+			~RenderQueue() = default;
+
+			//Remove all the draws, the memory is kept for the next recording
+			void clear();
+
+			//depth is the distance from the camera normalized in [0, 1]
+			//If the depth prepass is enabled the draw is added to it too, using depth_prepass_pipeline
+			void add_draw(const draw_call& draw, vk::Pipeline depth_prepass_pipeline, float depth);
+
+			void sort();
+
+			//Record the sorted draws, the render pass must be already started
+			void record(vk::CommandBuffer command_buffer, uint32_t frame_index);
+
+			void set_depth_prepass_enabled(bool enabled);
+			bool is_depth_prepass_enabled() const;
+
+			size_t get_draw_count() const;
+			//Stats of the last record() call
+			const queue_stats& get_stats() const;
+		};
+	}
+}
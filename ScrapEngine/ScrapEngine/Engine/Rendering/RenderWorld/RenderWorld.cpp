@@ -0,0 +1,68 @@
+#include <Engine/Rendering/RenderWorld/RenderWorld.h>
+#include <Engine/Debug/CpuProfiler.h>
+#include <Engine/Rendering/Shadowmapping/Standard/StandardShadowmapping.h>
+
+ScrapEngine::Render::RenderWorld::RenderWorld(const StandardShadowmapping* shadowmapping)
+{
+	light_.position = shadowmapping->get_light_pos();
+	light_.look_at = shadowmapping->get_light_look_at();
+	light_.fov = shadowmapping->get_light_fov();
+	light_.z_near = shadowmapping->get_z_near();
+	light_.z_far = shadowmapping->get_z_far();
+}
+
+ScrapEngine::Render::RenderWorld::light_proxy* ScrapEngine::Render::RenderWorld::get_light()
+{
+	return &light_;
+}
+
+void ScrapEngine::Render::RenderWorld::set_camera_changed()
+{
+	camera_changed_ = true;
+}
+
+void ScrapEngine::Render::RenderWorld::extract(const std::vector<VulkanMeshInstance*>& meshes, const Camera* camera)
+{
+	SCRAP_PROFILE_FUNCTION();
+	frame_snapshot& snapshot = snapshots_[write_index_];
+	//The vector keeps its capacity, after the first frames there are no allocations
+	snapshot.meshes.clear();
+	for (VulkanMeshInstance* mesh : meshes)
+	{
+		//Added this frame, its resources are loaded at the next render sync
+		if (!mesh->get_is_loaded())
+		{
+			continue;
+		}
+		snapshot.meshes.emplace_back(mesh, *mesh->get_game_state());
+	}
+	snapshot.camera = *camera;
+	snapshot.light = light_;
+	snapshot.camera_changed = camera_changed_;
+	camera_changed_ = false;
+}
+
+void ScrapEngine::Render::RenderWorld::publish()
+{
+	write_index_ = write_index_ == 0 ? 1 : 0;
+}
+
+const ScrapEngine::Render::RenderWorld::frame_snapshot* ScrapEngine::Render::RenderWorld::get_render_snapshot() const
+{
+	return &snapshots_[write_index_ == 0 ? 1 : 0];
+}
+
+void ScrapEngine::Render::RenderWorld::apply(StandardShadowmapping* shadowmapping) const
+{
+	SCRAP_PROFILE_FUNCTION();
+	const frame_snapshot* snapshot = get_render_snapshot();
+	for (const std::pair<VulkanMeshInstance*, VulkanMeshInstance::game_state>& mesh : snapshot->meshes)
+	{
+		mesh.first->apply_game_state(mesh.second);
+	}
+	shadowmapping->set_light_pos(snapshot->light.position);
+	shadowmapping->set_light_look_at(snapshot->light.look_at);
+	shadowmapping->set_light_fov(snapshot->light.fov);
+	shadowmapping->set_z_near(snapshot->light.z_near);
+	shadowmapping->set_z_far(snapshot->light.z_far);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Engine/Rendering/Model/MeshInstance/VulkanMeshInstance.h>
+#include <Engine/Rendering/Camera/Camera.h>
+#include <glm/vec3.hpp>
+#include <vector>
+#include <utility>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		class StandardShadowmapping;
+
+		//Copy of the render relevant game state, extracted at the end of the game frame
+		//There are two snapshots: the render thread reads one while the game thread writes the other
+		//The game thread never touches the render side of the meshes, the render thread never reads the game state
+		class RenderWorld
+		{
+		public:
+			//Values of the directional light used by the shadowmapping
+			struct light_proxy
+			{
+				glm::vec3 position = glm::vec3(0.0f);
+				glm::vec3 look_at = glm::vec3(0.0f);
+				float fov = 45.0f;
+				float z_near = 1.0f;
+				float z_far = 1024.0f;
+			};
+
+			struct frame_snapshot
+			{
+				std::vector<std::pair<VulkanMeshInstance*, VulkanMeshInstance::game_state>> meshes;
+				Camera camera;
+				light_proxy light;
+				//True if the render camera has been replaced since the previous snapshot
+				bool camera_changed = false;
+			};
+		private:
+			frame_snapshot snapshots_[2];
+			//Snapshot written by the game thread, the other one is read by the render thread
+			uint8_t write_index_ = 0;
+
+			//Game side values, copied in every snapshot
+			light_proxy light_;
+			bool camera_changed_ = false;
+		public:
+			explicit RenderWorld(const StandardShadowmapping* shadowmapping);
+			~RenderWorld() = default;
+
+			//---game thread
+			light_proxy* get_light();
+			void set_camera_changed();
+			//Copy the state of the meshes, the camera and the light in the write snapshot
+			void extract(const std::vector<VulkanMeshInstance*>& meshes, const Camera* camera);
+			//Give the written snapshot to the render thread, it must not be running
+			void publish();
+
+			//---render thread
+			const frame_snapshot* get_render_snapshot() const;
+			//Write the snapshot values in the meshes and in the shadowmapping
+			void apply(StandardShadowmapping* shadowmapping) const;
+		};
+	}
+}
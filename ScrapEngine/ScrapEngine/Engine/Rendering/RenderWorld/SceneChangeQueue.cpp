@@ -0,0 +1,104 @@
+#include <Engine/Rendering/RenderWorld/SceneChangeQueue.h>
+
+ScrapEngine::Render::SceneChangeQueue::SceneChangeQueue()
+	: head_(&stub_), tail_(&stub_), block_(new scene_change[block_size])
+{
+}
+
+ScrapEngine::Render::SceneChangeQueue::~SceneChangeQueue()
+{
+	while (scene_change* change = pop())
+	{
+		release(change);
+	}
+}
+
+void ScrapEngine::Render::SceneChangeQueue::push(scene_change* change)
+{
+	change->next.store(nullptr, std::memory_order_relaxed);
+	//After the exchange the change is the new head, then it's linked to the previous one
+	scene_change* previous = head_.exchange(change, std::memory_order_acq_rel);
+	previous->next.store(change, std::memory_order_release);
+}
+
+void ScrapEngine::Render::SceneChangeQueue::push(const change_type type, VulkanMeshInstance* mesh,
+                                                const slot_handle& handle)
+{
+	const uint32_t index = block_used_.fetch_add(1, std::memory_order_relaxed);
+	scene_change* change;
+	if (index < block_size)
+	{
+		change = &block_[index];
+		change->pooled = true;
+	}
+	else
+	{
+		change = new scene_change();
+		change->pooled = false;
+	}
+	change->type = type;
+	change->mesh = mesh;
+	change->handle = handle;
+	push(change);
+	block_pushed_.fetch_add(1, std::memory_order_release);
+}
+
+ScrapEngine::Render::SceneChangeQueue::scene_change* ScrapEngine::Render::SceneChangeQueue::pop()
+{
+	scene_change* tail = tail_;
+	scene_change* next = tail->next.load(std::memory_order_acquire);
+	//Skip the stub
+	if (tail == &stub_)
+	{
+		if (next == nullptr)
+		{
+			return nullptr;
+		}
+		tail_ = next;
+		tail = next;
+		next = next->next.load(std::memory_order_acquire);
+	}
+	if (next)
+	{
+		tail_ = next;
+		return tail;
+	}
+	//The tail is the last linked change, if it isn't the head a producer is linking a new one
+	if (tail != head_.load(std::memory_order_acquire))
+	{
+		return nullptr;
+	}
+	//Push the stub again, so the tail can be returned leaving the list not empty
+	push(&stub_);
+	next = tail->next.load(std::memory_order_acquire);
+	if (next)
+	{
+		tail_ = next;
+		return tail;
+	}
+	return nullptr;
+}
+
+void ScrapEngine::Render::SceneChangeQueue::release(scene_change* change)
+{
+	if (!change->pooled)
+	{
+		delete change;
+	}
+}
+
+void ScrapEngine::Render::SceneChangeQueue::recycle()
+{
+	//Every change taken has been linked, and the queue is empty, so every one has been popped
+	uint32_t used = block_used_.load(std::memory_order_acquire);
+	if (block_pushed_.load(std::memory_order_acquire) != used ||
+		tail_ != &stub_ || head_.load(std::memory_order_acquire) != &stub_)
+	{
+		return;
+	}
+	//Fails if a producer took a change in the meantime, then the block is reused at the next sync
+	if (block_used_.compare_exchange_strong(used, 0, std::memory_order_acq_rel))
+	{
+		block_pushed_.fetch_sub(used, std::memory_order_acq_rel);
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Engine/Utility/SlotMap.h>
+#include <atomic>
+#include <memory>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		class VulkanMeshInstance;
+
+		//Changes of the scene requested by the game, applied by the renderer once per frame at the render sync
+		//Multiple producers, single consumer, lock-free: a push never waits the renderer or the other producers
+		//The changes are taken from a block recycled at the sync, so a steady frame doesn't allocate
+		class SceneChangeQueue
+		{
+		public:
+			enum class change_type
+			{
+				//Insert the mesh with its reserved handle and read its files on a worker
+				add_mesh,
+				//Stop to draw the mesh of the handle, it's deleted when no frame uses it anymore
+				remove_mesh
+			};
+
+			struct scene_change
+			{
+				change_type type = change_type::add_mesh;
+				VulkanMeshInstance* mesh = nullptr;
+				slot_handle handle;
+				std::atomic<scene_change*> next{nullptr};
+				//False if the block was full and the change was allocated
+				bool pooled = true;
+			};
+		private:
+			//Intrusive linked list with a stub node, the producers only swap the head
+			std::atomic<scene_change*> head_;
+			//Only touched by the consumer
+			scene_change* tail_;
+			scene_change stub_;
+
+			static const uint32_t block_size = 256;
+			std::unique_ptr<scene_change[]> block_;
+			//Changes taken since the last recycle, can be more than block_size if some were allocated
+			std::atomic<uint32_t> block_used_{0};
+			//Changes linked in the list, lower than block_used_ while a producer is pushing
+			std::atomic<uint32_t> block_pushed_{0};
+
+			void push(scene_change* change);
+		public:
+			SceneChangeQueue();
+			~SceneChangeQueue();
+			SceneChangeQueue(const SceneChangeQueue&) = delete;
+			SceneChangeQueue& operator=(const SceneChangeQueue&) = delete;
+
+			//Can be called from any thread
+			void push(change_type type, VulkanMeshInstance* mesh, const slot_handle& handle);
+
+			//Only from the consumer thread, the change must be given back with release()
+			//Return nullptr if the queue is empty or if the next change is still being pushed
+			scene_change* pop();
+			void release(scene_change* change);
+
+			//Only from the consumer thread, after the popped changes are released
+			//Reuse the block if every change has been popped, the producers can push meanwhile
+			void recycle();
+		};
+	}
+}
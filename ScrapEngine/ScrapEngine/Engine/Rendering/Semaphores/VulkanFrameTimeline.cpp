@@ -0,0 +1,168 @@
+#include <Engine/Rendering/Semaphores/VulkanFrameTimeline.h>
+#include <Engine/Rendering/Device/VulkanDevice.h>
+#include <Engine/Debug/DebugLog.h>
+
+ScrapEngine::Render::VulkanFrameTimeline::VulkanFrameTimeline(const std::vector<vk::Fence>* in_flight_fences)
+	: timeline_enabled_(VulkanDevice::get_instance()->is_timeline_semaphore_enabled()),
+	  in_flight_fences_ref_(in_flight_fences), frame_values_(in_flight_fences->size(), 0)
+{
+	if (timeline_enabled_)
+	{
+		vk::SemaphoreTypeCreateInfoKHR type_info(vk::SemaphoreTypeKHR::eTimeline, 0);
+		vk::SemaphoreCreateInfo semaphore_info;
+		semaphore_info.setPNext(&type_info);
+
+		const vk::Result result = VulkanDevice::get_instance()->get_logical_device()->createSemaphore(
+			&semaphore_info, nullptr, &timeline_semaphore_);
+		if (result != vk::Result::eSuccess)
+		{
+			Debug::DebugLog::fatal_error(result, "[VulkanFrameTimeline] Failed to create timeline semaphore!");
+		}
+	}
+}
+
+ScrapEngine::Render::VulkanFrameTimeline::~VulkanFrameTimeline()
+{
+	if (timeline_enabled_)
+	{
+		VulkanDevice::get_instance()->get_logical_device()->destroySemaphore(timeline_semaphore_);
+	}
+}
+
+uint64_t ScrapEngine::Render::VulkanFrameTimeline::submit(const vk::Queue queue, const vk::SubmitInfo& submit_info,
+                                                          const uint32_t frame_index)
+{
+	const uint64_t value = submitted_value_ + 1;
+	vk::Result result;
+
+	if (timeline_enabled_)
+	{
+		//Signal the timeline together with the other semaphores, binary semaphores ignore the value
+		const uint32_t signal_count = submit_info.signalSemaphoreCount + 1;
+		if (signal_count > max_signal_semaphores)
+		{
+			Debug::DebugLog::fatal_error(vk::Result(-13), "[VulkanFrameTimeline] Too many signal semaphores!");
+		}
+		for (uint32_t i = 0; i < submit_info.signalSemaphoreCount; i++)
+		{
+			signal_semaphores_[i] = submit_info.pSignalSemaphores[i];
+			signal_values_[i] = 0;
+		}
+		signal_semaphores_[signal_count - 1] = timeline_semaphore_;
+		signal_values_[signal_count - 1] = value;
+
+		vk::TimelineSemaphoreSubmitInfoKHR timeline_info;
+		timeline_info.setSignalSemaphoreValueCount(signal_count);
+		timeline_info.setPSignalSemaphoreValues(signal_values_.data());
+
+		vk::SubmitInfo timeline_submit_info = submit_info;
+		timeline_submit_info.setSignalSemaphoreCount(signal_count);
+		timeline_submit_info.setPSignalSemaphores(signal_semaphores_.data());
+		timeline_submit_info.setPNext(&timeline_info);
+
+		result = queue.submit(1, &timeline_submit_info, vk::Fence());
+	}
+	else
+	{
+		const vk::Fence& fence = (*in_flight_fences_ref_)[frame_index];
+		VulkanDevice::get_instance()->get_logical_device()->resetFences(1, &fence);
+
+		result = queue.submit(1, &submit_info, fence);
+	}
+
+	if (result != vk::Result::eSuccess)
+	{
+		Debug::DebugLog::fatal_error(result, "[VulkanFrameTimeline] Failed to submit draw command buffer!");
+	}
+
+	submitted_value_ = value;
+	frame_values_[frame_index] = value;
+	return value;
+}
+
+void ScrapEngine::Render::VulkanFrameTimeline::wait_frame(const uint32_t frame_index)
+{
+	wait(frame_values_[frame_index]);
+}
+
+void ScrapEngine::Render::VulkanFrameTimeline::wait(const uint64_t value)
+{
+	if (is_completed(value))
+	{
+		return;
+	}
+
+	vk::Result result = vk::Result::eSuccess;
+	if (timeline_enabled_)
+	{
+		const vk::SemaphoreWaitInfoKHR wait_info(vk::SemaphoreWaitFlagsKHR(), 1, &timeline_semaphore_, &value);
+		result = VulkanDevice::get_instance()->get_logical_device()->waitSemaphoresKHR(
+			&wait_info, std::numeric_limits<uint64_t>::max(), *VulkanDevice::get_instance()->get_device_dispatcher());
+	}
+	else
+	{
+		//Wait the fence of the frame that signaled this value
+		for (size_t i = 0; i < frame_values_.size(); i++)
+		{
+			if (frame_values_[i] == value)
+			{
+				result = VulkanDevice::get_instance()->get_logical_device()->waitForFences(
+					1, &(*in_flight_fences_ref_)[i], true, std::numeric_limits<uint64_t>::max());
+				break;
+			}
+		}
+	}
+
+	if (result != vk::Result::eSuccess)
+	{
+		Debug::DebugLog::fatal_error(result, "[VulkanFrameTimeline] An error occurred while waiting a frame");
+	}
+
+	if (value > completed_value_)
+	{
+		completed_value_ = value;
+	}
+}
+
+bool ScrapEngine::Render::VulkanFrameTimeline::is_completed(const uint64_t value)
+{
+	//Check the cached value first, without calling the driver
+	return value <= completed_value_ || value <= get_completed_value();
+}
+
+uint64_t ScrapEngine::Render::VulkanFrameTimeline::get_completed_value()
+{
+	if (timeline_enabled_)
+	{
+		const vk::Result result = VulkanDevice::get_instance()->get_logical_device()->getSemaphoreCounterValueKHR(
+			timeline_semaphore_, &completed_value_, *VulkanDevice::get_instance()->get_device_dispatcher());
+		if (result != vk::Result::eSuccess)
+		{
+			Debug::DebugLog::fatal_error(result, "[VulkanFrameTimeline] Failed to read the timeline value");
+		}
+	}
+	else
+	{
+		//The frames are completed in order, the highest signaled fence is the completed value
+		for (size_t i = 0; i < frame_values_.size(); i++)
+		{
+			if (frame_values_[i] > completed_value_ &&
+				VulkanDevice::get_instance()->get_logical_device()->getFenceStatus((*in_flight_fences_ref_)[i]) ==
+				vk::Result::eSuccess)
+			{
+				completed_value_ = frame_values_[i];
+			}
+		}
+	}
+	return completed_value_;
+}
+
+uint64_t ScrapEngine::Render::VulkanFrameTimeline::get_submitted_value() const
+{
+	return submitted_value_;
+}
+
+bool ScrapEngine::Render::VulkanFrameTimeline::is_timeline_enabled() const
+{
+	return timeline_enabled_;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Engine/Rendering/VulkanInclude.h>
+#include <array>
+#include <vector>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		//Monotonic counter of the frames completed by the gpu
+		//Every submit signal a new value, resources used by a frame can be reused once its value is completed
+		//Uses a timeline semaphore if supported, otherwise the in flight fences of every frame
+		class VulkanFrameTimeline
+		{
+		private:
+			bool timeline_enabled_ = false;
+			vk::Semaphore timeline_semaphore_;
+
+			//Used only without timeline semaphores
+			const std::vector<vk::Fence>* in_flight_fences_ref_ = nullptr;
+
+			//Last value submitted for every frame in flight
+			std::vector<uint64_t> frame_values_;
+
+			//Signal semaphores of the submit plus the timeline, filled on every submit without allocating
+			static const uint32_t max_signal_semaphores = 8;
+			std::array<vk::Semaphore, max_signal_semaphores> signal_semaphores_;
+			std::array<uint64_t, max_signal_semaphores> signal_values_;
+
+			uint64_t submitted_value_ = 0;
+			//Cached, updated when polled
+			uint64_t completed_value_ = 0;
+		public:
+			VulkanFrameTimeline(const std::vector<vk::Fence>* in_flight_fences);
+			~VulkanFrameTimeline();
+
+			//Submit the work of a frame, adding the signal of the next value
+			//Return the value signaled when the work is completed
+			uint64_t submit(vk::Queue queue, const vk::SubmitInfo& submit_info, uint32_t frame_index);
+
+			//Block until the previous frame submitted with this frame_index is completed
+			//Used only for the frame pacing in the main thread
+			void wait_frame(uint32_t frame_index);
+
+			//Block until the value is completed
+			void wait(uint64_t value);
+
+			//Non blocking check, does not wait the gpu
+			bool is_completed(uint64_t value);
+
+			uint64_t get_completed_value();
+			uint64_t get_submitted_value() const;
+			bool is_timeline_enabled() const;
+		};
+	}
+}
@@ -3,18 +3,18 @@
 #include <Engine/Debug/DebugLog.h>
 
 ScrapEngine::Render::VulkanSemaphoresManager::VulkanSemaphoresManager(
-	const uint32_t input_image_count)
-	: image_count_(input_image_count)
+	const uint32_t input_frames_in_flight)
+	: frames_in_flight_(input_frames_in_flight)
 {
-	image_available_semaphores_.resize(image_count_);
-	render_finished_semaphores_.resize(image_count_);
-	in_flight_fences_.resize(image_count_);
+	image_available_semaphores_.resize(frames_in_flight_);
+	render_finished_semaphores_.resize(frames_in_flight_);
+	in_flight_fences_.resize(frames_in_flight_);
 
 	vk::SemaphoreCreateInfo semaphore_info;
 
 	vk::FenceCreateInfo fence_info(vk::FenceCreateFlagBits::eSignaled);
 
-	for (size_t i = 0; i < image_count_; i++)
+	for (size_t i = 0; i < frames_in_flight_; i++)
 	{
 		const vk::Result result1 = VulkanDevice::get_instance()->get_logical_device()->createSemaphore(
 			&semaphore_info, nullptr,
@@ -43,7 +43,7 @@ ScrapEngine::Render::VulkanSemaphoresManager::VulkanSemaphoresManager(
 
 ScrapEngine::Render::VulkanSemaphoresManager::~VulkanSemaphoresManager()
 {
-	for (size_t i = 0; i < image_count_; i++)
+	for (size_t i = 0; i < frames_in_flight_; i++)
 	{
 		VulkanDevice::get_instance()->get_logical_device()->destroySemaphore(render_finished_semaphores_[i]);
 		VulkanDevice::get_instance()->get_logical_device()->destroySemaphore(image_available_semaphores_[i]);
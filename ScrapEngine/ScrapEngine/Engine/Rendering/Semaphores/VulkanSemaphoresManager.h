@@ -14,9 +14,10 @@ namespace ScrapEngine
 			std::vector<vk::Semaphore> render_finished_semaphores_;
 			std::vector<vk::Fence> in_flight_fences_;
 
-			uint32_t image_count_ = -1;
+			//One set of semaphores and fence for each frame in flight
+			uint32_t frames_in_flight_ = -1;
 		public:
-			VulkanSemaphoresManager(uint32_t input_image_count);
+			VulkanSemaphoresManager(uint32_t input_frames_in_flight);
 			~VulkanSemaphoresManager();
 
 			const std::vector<vk::Semaphore>* get_image_available_semaphores_vector() const;
@@ -12,7 +12,7 @@
 ScrapEngine::Render::StandardShadowmapping::StandardShadowmapping(VulkanSwapChain* swap_chain)
 	: depth_format_(VulkanDepthResources::find_depth_format())
 {
-	const size_t size = swap_chain->get_swap_chain_images_vector()->size();
+	const size_t size = swap_chain->get_frames_in_flight();
 	offscreen_descriptor_pool_ = new StandardDescriptorPool(size);
 
 	offscreen_render_pass_ = new ShadowmappingRenderPass(depth_format_);
@@ -5,22 +5,31 @@
 
 ScrapEngine::Render::VulkanSwapChain::VulkanSwapChain(const SwapChainSupportDetails& swap_chain_support,
                                                       const BaseQueue::QueueFamilyIndices indices,
-                                                      vk::SurfaceKHR* input_surface_ref, const uint32_t& width,
-                                                      const uint32_t& height, const bool vsync)
+                                                      vk::SurfaceKHR* input_surface_ref,
+                                                      const game_base_info* base_game_info)
 	: surface_ref_(input_surface_ref)
 {
 	const vk::SurfaceFormatKHR surface_format = choose_swap_surface_format(swap_chain_support.formats);
-	const vk::PresentModeKHR present_mode = choose_swap_present_mode(swap_chain_support.present_modes, vsync);
-	const vk::Extent2D extent = choose_swap_extent(swap_chain_support.capabilities, width, height);
+	const vk::PresentModeKHR present_mode = choose_swap_present_mode(swap_chain_support.present_modes,
+	                                                                 base_game_info->vsync,
+	                                                                 base_game_info->requested_present_mode);
+	const vk::Extent2D extent = choose_swap_extent(swap_chain_support.capabilities, base_game_info->window_width,
+	                                               base_game_info->window_height);
 
-	//That +1 is necessary
-	//See https://github.com/KhronosGroup/Vulkan-Docs/issues/909
-	image_count_ = swap_chain_support.capabilities.minImageCount + 1;
-	if (swap_chain_support.capabilities.maxImageCount > 0 &&
-		image_count_ > swap_chain_support.capabilities.maxImageCount)
+	image_count_ = choose_image_count(swap_chain_support.capabilities, base_game_info->swap_chain_image_count);
+
+	//More frames in flight than images would only wait on the acquire
+	frames_in_flight_ = base_game_info->max_frames_in_flight;
+	if (frames_in_flight_ == 0)
 	{
-		image_count_ = swap_chain_support.capabilities.maxImageCount;
+		frames_in_flight_ = 1;
 	}
+	if (frames_in_flight_ > image_count_)
+	{
+		frames_in_flight_ = image_count_;
+	}
+
+	Debug::DebugLog::print_to_console_log("VulkanSwapChain present mode:" + vk::to_string(present_mode));
 
 	vk::SwapchainCreateInfoKHR create_info(
 		vk::SwapchainCreateFlagsKHR(),
@@ -30,7 +39,8 @@ ScrapEngine::Render::VulkanSwapChain::VulkanSwapChain(const SwapChainSupportDeta
 		surface_format.colorSpace,
 		extent,
 		1,
-		vk::ImageUsageFlagBits::eColorAttachment
+		//The scene is upscaled in the swap chain image with a blit, then the gui is drawn over it
+		vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferDst
 	);
 
 	uint32_t queue_family_indices[] = {
@@ -96,10 +106,39 @@ vk::SurfaceFormatKHR ScrapEngine::Render::VulkanSwapChain::choose_swap_surface_f
 }
 
 vk::PresentModeKHR ScrapEngine::Render::VulkanSwapChain::choose_swap_present_mode(
-	const std::vector<vk::PresentModeKHR>& available_present_modes, const bool vsync)
+	const std::vector<vk::PresentModeKHR>& available_present_modes, const bool vsync,
+	const present_mode requested_mode)
 {
 	vk::PresentModeKHR best_mode = vk::PresentModeKHR::eFifo;
 
+	if (requested_mode != present_mode::automatic)
+	{
+		vk::PresentModeKHR requested_vk_mode = vk::PresentModeKHR::eFifo;
+		switch (requested_mode)
+		{
+		case present_mode::fifo_relaxed:
+			requested_vk_mode = vk::PresentModeKHR::eFifoRelaxed;
+			break;
+		case present_mode::mailbox:
+			requested_vk_mode = vk::PresentModeKHR::eMailbox;
+			break;
+		case present_mode::immediate:
+			requested_vk_mode = vk::PresentModeKHR::eImmediate;
+			break;
+		default:
+			break;
+		}
+		//Fifo is always supported
+		if (std::find(available_present_modes.begin(), available_present_modes.end(), requested_vk_mode)
+			!= available_present_modes.end())
+		{
+			return requested_vk_mode;
+		}
+		Debug::DebugLog::print_to_console_log(
+			"VulkanSwapChain: requested present mode " + vk::to_string(requested_vk_mode) +
+			" not supported, using the automatic selection");
+	}
+
 	for (const auto& available_present_mode : available_present_modes)
 	{
 		if (vsync && (available_present_mode == vk::PresentModeKHR::eFifoRelaxed
@@ -120,6 +159,23 @@ vk::PresentModeKHR ScrapEngine::Render::VulkanSwapChain::choose_swap_present_mod
 	return best_mode;
 }
 
+uint32_t ScrapEngine::Render::VulkanSwapChain::choose_image_count(const vk::SurfaceCapabilitiesKHR& capabilities,
+                                                                  const uint32_t requested_image_count)
+{
+	//That +1 is necessary
+	//See https://github.com/KhronosGroup/Vulkan-Docs/issues/909
+	uint32_t image_count = capabilities.minImageCount + 1;
+	if (requested_image_count > 0)
+	{
+		image_count = std::max(requested_image_count, capabilities.minImageCount);
+	}
+	if (capabilities.maxImageCount > 0 && image_count > capabilities.maxImageCount)
+	{
+		image_count = capabilities.maxImageCount;
+	}
+	return image_count;
+}
+
 vk::Extent2D ScrapEngine::Render::VulkanSwapChain::choose_swap_extent(const vk::SurfaceCapabilitiesKHR& capabilities,
                                                                       const uint32_t& width,
                                                                       const uint32_t& height) const
@@ -165,3 +221,8 @@ uint32_t ScrapEngine::Render::VulkanSwapChain::get_image_count() const
 {
 	return image_count_;
 }
+
+uint32_t ScrapEngine::Render::VulkanSwapChain::get_frames_in_flight() const
+{
+	return frames_in_flight_;
+}
@@ -2,6 +2,7 @@
 
 #include <Engine/Rendering/VulkanInclude.h>
 #include <Engine/Rendering/Queue/BaseQueue.h>
+#include <Engine/Utility/UsefulTypes.h>
 #include <vector>
 
 namespace ScrapEngine
@@ -16,6 +17,8 @@ namespace ScrapEngine
 			vk::Format swap_chain_image_format_;
 			vk::Extent2D swap_chain_extent_;
 			uint32_t image_count_ = -1;
+			//Resources written by the cpu every frame are created for every frame in flight, not for every image
+			uint32_t frames_in_flight_ = 1;
 
 			vk::SurfaceKHR* surface_ref_;
 		public:
@@ -27,14 +30,16 @@ namespace ScrapEngine
 			};
 
 			VulkanSwapChain(const SwapChainSupportDetails& swap_chain_support, BaseQueue::QueueFamilyIndices indices,
-			                vk::SurfaceKHR* input_surface_ref, const uint32_t& width, const uint32_t& height,
-			                bool vsync);
+			                vk::SurfaceKHR* input_surface_ref, const game_base_info* base_game_info);
 			~VulkanSwapChain();
 
 			vk::SurfaceFormatKHR choose_swap_surface_format(const std::vector<vk::SurfaceFormatKHR>& available_formats);
 
 			vk::PresentModeKHR choose_swap_present_mode(const std::vector<vk::PresentModeKHR>& available_present_modes,
-			                                            bool vsync);
+			                                            bool vsync, present_mode requested_mode);
+
+			static uint32_t choose_image_count(const vk::SurfaceCapabilitiesKHR& capabilities,
+			                                   uint32_t requested_image_count);
 
 			vk::Extent2D choose_swap_extent(const vk::SurfaceCapabilitiesKHR& capabilities, const uint32_t& width,
 			                                const uint32_t& height) const;
@@ -45,6 +50,7 @@ namespace ScrapEngine
 			vk::Format get_swap_chain_image_format() const;
 			vk::Extent2D get_swap_chain_extent() const;
 			uint32_t get_image_count() const;
+			uint32_t get_frames_in_flight() const;
 		};
 	}
 }
@@ -0,0 +1,113 @@
+#include <Engine/Rendering/TemporalUpscaling/TemporalImageCheck.h>
+#include <Engine/Debug/DebugLog.h>
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+ScrapEngine::Render::TemporalImageCheck::TemporalImageCheck(const vk::Extent2D& extent, const uint32_t frame_count,
+                                                            const float max_mean_error)
+	: extent_(extent), frame_count_(frame_count), max_mean_error_(max_mean_error)
+{
+	//Four half floats for each pixel
+	const vk::DeviceSize size = static_cast<vk::DeviceSize>(extent.width) * extent.height * 4 * sizeof(uint16_t);
+	for (size_t i = 0; i < buffers_.size(); i++)
+	{
+		VulkanMemoryAllocator::get_instance()->create_readback_buffer(size, buffers_[i], buffers_memory_[i]);
+	}
+}
+
+ScrapEngine::Render::TemporalImageCheck::~TemporalImageCheck()
+{
+	for (size_t i = 0; i < buffers_.size(); i++)
+	{
+		VulkanMemoryAllocator::get_instance()->destroy_buffer(buffers_[i], buffers_memory_[i]);
+	}
+}
+
+void ScrapEngine::Render::TemporalImageCheck::record(const vk::CommandBuffer command_buffer,
+                                                     const vk::Image resolved_image)
+{
+	if (is_recorded())
+	{
+		return;
+	}
+	const uint32_t frame = recorded_frames_++;
+	if (frame != 0 && frame != frame_count_)
+	{
+		return;
+	}
+
+	const vk::BufferImageCopy region(
+		0, 0, 0,
+		vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1),
+		vk::Offset3D(),
+		vk::Extent3D(extent_.width, extent_.height, 1)
+	);
+	command_buffer.copyImageToBuffer(resolved_image, vk::ImageLayout::eTransferSrcOptimal,
+	                                 buffers_[frame == 0 ? 0 : 1], 1, &region);
+
+	//Visible to the cpu once the frame is completed
+	const vk::BufferMemoryBarrier barrier(
+		vk::AccessFlagBits::eTransferWrite,
+		vk::AccessFlagBits::eHostRead,
+		VK_QUEUE_FAMILY_IGNORED,
+		VK_QUEUE_FAMILY_IGNORED,
+		buffers_[frame == 0 ? 0 : 1],
+		0,
+		VK_WHOLE_SIZE
+	);
+	command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost,
+	                               vk::DependencyFlags(), 0, nullptr, 1, &barrier, 0, nullptr);
+}
+
+bool ScrapEngine::Render::TemporalImageCheck::is_recorded() const
+{
+	return recorded_frames_ > frame_count_;
+}
+
+void ScrapEngine::Render::TemporalImageCheck::set_frame_value(const uint64_t frame_value)
+{
+	frame_value_ = frame_value;
+}
+
+uint64_t ScrapEngine::Render::TemporalImageCheck::get_frame_value() const
+{
+	return frame_value_;
+}
+
+bool ScrapEngine::Render::TemporalImageCheck::compare()
+{
+	void* reference_data;
+	void* converged_data;
+	VulkanMemoryAllocator::get_instance()->map_buffer_allocation(buffers_memory_[0], &reference_data);
+	VulkanMemoryAllocator::get_instance()->map_buffer_allocation(buffers_memory_[1], &converged_data);
+	const uint16_t* reference = static_cast<const uint16_t*>(reference_data);
+	const uint16_t* converged = static_cast<const uint16_t*>(converged_data);
+
+	//The alpha is always 1, only the color is compared
+	const size_t pixel_count = static_cast<size_t>(extent_.width) * extent_.height;
+	double error_sum = 0.0;
+	float max_error = 0.f;
+	for (size_t pixel = 0; pixel < pixel_count; pixel++)
+	{
+		for (size_t channel = 0; channel < 3; channel++)
+		{
+			const size_t index = pixel * 4 + channel;
+			const float error = std::abs(glm::unpackHalf1x16(reference[index]) - glm::unpackHalf1x16(converged[index]));
+			error_sum += error;
+			max_error = std::max(max_error, error);
+		}
+	}
+
+	VulkanMemoryAllocator::get_instance()->unmap_buffer_allocation(buffers_memory_[0]);
+	VulkanMemoryAllocator::get_instance()->unmap_buffer_allocation(buffers_memory_[1]);
+
+	const float mean_error = static_cast<float>(error_sum / static_cast<double>(pixel_count * 3));
+	const bool passed = mean_error <= max_mean_error_;
+	Debug::DebugLog::print_to_console_log(
+		std::string("TemporalImageCheck: ") + (passed ? "passed" : "FAILED") +
+		", mean error " + std::to_string(mean_error) + " (max " + std::to_string(max_mean_error_) +
+		"), max pixel error " + std::to_string(max_error) + " after " + std::to_string(frame_count_) + " frames");
+	return passed;
+}
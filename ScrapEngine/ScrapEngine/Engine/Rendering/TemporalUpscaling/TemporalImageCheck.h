@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Engine/Rendering/VulkanInclude.h>
+#include <Engine/Rendering/Memory/VulkanMemoryAllocator.h>
+#include <array>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		//Image diff check of the temporal resolve, the camera must not move while it runs
+		//The first frame is resolved without history and used as reference, after frame_count frames
+		//the history must have converged to the antialiased scene, close to the reference
+		//A wrong reprojection or velocity makes the history drift or ghost and the difference grows
+		class TemporalImageCheck
+		{
+		public:
+			static const uint32_t default_frame_count = 64;
+			//Mean difference of the color channels, the converged image is smoother on the edges
+			static constexpr float default_max_mean_error = 0.02f;
+		private:
+			vk::Extent2D extent_;
+			uint32_t frame_count_;
+			float max_mean_error_;
+			//Reference and converged image, RGBA16F
+			std::array<vk::Buffer, 2> buffers_;
+			std::array<VmaAllocation, 2> buffers_memory_;
+			uint32_t recorded_frames_ = 0;
+			//Frame that copied the converged image
+			uint64_t frame_value_ = 0;
+		public:
+			TemporalImageCheck(const vk::Extent2D& extent, uint32_t frame_count, float max_mean_error);
+			//The gpu must not use the check anymore
+			~TemporalImageCheck();
+
+			//Copy the resolved image, in eTransferSrcOptimal, if this is the reference or the last frame
+			void record(vk::CommandBuffer command_buffer, vk::Image resolved_image);
+			//True once the last copy is recorded, its frame must be completed before compare()
+			bool is_recorded() const;
+			void set_frame_value(uint64_t frame_value);
+			uint64_t get_frame_value() const;
+
+			//Mean absolute difference of the color channels, print the result in the console log
+			//Return true if it's below max_mean_error
+			bool compare();
+		};
+	}
+}
@@ -0,0 +1,246 @@
+#include <Engine/Rendering/TemporalUpscaling/TemporalUpscaler.h>
+#include <Engine/Rendering/TemporalUpscaling/TemporalImageCheck.h>
+#include <Engine/Rendering/Semaphores/VulkanFrameTimeline.h>
+#include <Engine/Rendering/RenderPass/TemporalResolveRenderPass/TemporalResolveRenderPass.h>
+#include <Engine/Rendering/Buffer/FrameBuffer/TemporalHistoryFrameBuffer/TemporalHistoryFrameBuffer.h>
+#include <Engine/Rendering/Descriptor/DescriptorSet/TemporalResolveDescriptorSet/TemporalResolveDescriptorSet.h>
+#include <Engine/Rendering/Descriptor/DescriptorPool/StandardDescriptorPool/StandardDescriptorPool.h>
+#include <Engine/Rendering/Device/VulkanDevice.h>
+#include <Engine/Rendering/Camera/Camera.h>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <algorithm>
+#include <fstream>
+
+namespace
+{
+	const char* resolve_vertex_shader = "../assets/shader/compiled_shaders/taa_resolve.vert.spv";
+	const char* resolve_fragment_shader = "../assets/shader/compiled_shaders/taa_resolve.frag.spv";
+}
+
+ScrapEngine::Render::TemporalUpscaler::TemporalUpscaler(const settings& input_settings,
+                                                        const vk::Extent2D& output_extent,
+                                                        const vk::ImageView scene_color_view,
+                                                        vk::ImageView* depth_view,
+                                                        const vk::ImageView velocity_view)
+	: output_extent_(output_extent)
+{
+	set_settings(input_settings);
+
+	//Half float history, so the accumulation doesn't band in the dark areas
+	render_pass_ = new TemporalResolveRenderPass(vk::Format::eR16G16B16A16Sfloat);
+	history_ = new TemporalHistoryFrameBuffer(output_extent, vk::Format::eR16G16B16A16Sfloat, render_pass_);
+
+	//The depth and the velocity are read without filtering, a mix of them is wrong on the edges
+	vk::SamplerCreateInfo sampler(
+		vk::SamplerCreateFlags(),
+		vk::Filter::eNearest,
+		vk::Filter::eNearest,
+		vk::SamplerMipmapMode::eNearest,
+		vk::SamplerAddressMode::eClampToEdge,
+		vk::SamplerAddressMode::eClampToEdge,
+		vk::SamplerAddressMode::eClampToEdge,
+		0.0f
+	);
+	sampler.setMaxAnisotropy(1.0f);
+	sampler.setMinLod(0.0f);
+	sampler.setMaxLod(0.0f);
+
+	VulkanDevice::get_instance()->get_logical_device()->createSampler(&sampler, nullptr, &depth_sampler_);
+
+	//Four images for each history
+	descriptor_pool_ = new StandardDescriptorPool(TemporalHistoryFrameBuffer::history_count * 4);
+	descriptor_set_ = new TemporalResolveDescriptorSet();
+	descriptor_set_->create_descriptor_sets(descriptor_pool_->get_descriptor_pool(), scene_color_view, depth_view,
+	                                        &depth_sampler_, history_, velocity_view);
+
+	pipeline_ = new TemporalResolvePipeline(resolve_vertex_shader, resolve_fragment_shader,
+	                                        descriptor_set_->get_descriptor_set_layout(), output_extent,
+	                                        render_pass_);
+}
+
+ScrapEngine::Render::TemporalUpscaler::~TemporalUpscaler()
+{
+	delete image_check_;
+	delete pipeline_;
+	delete descriptor_set_;
+	delete descriptor_pool_;
+	VulkanDevice::get_instance()->get_logical_device()->destroySampler(depth_sampler_);
+	delete history_;
+	delete render_pass_;
+}
+
+bool ScrapEngine::Render::TemporalUpscaler::is_supported()
+{
+	const std::ifstream vertex_shader(resolve_vertex_shader, std::ios::binary);
+	const std::ifstream fragment_shader(resolve_fragment_shader, std::ios::binary);
+	return vertex_shader.good() && fragment_shader.good();
+}
+
+float ScrapEngine::Render::TemporalUpscaler::halton(uint32_t index, const uint32_t base)
+{
+	float result = 0.f;
+	float fraction = 1.0f;
+	while (index > 0)
+	{
+		fraction /= static_cast<float>(base);
+		result += fraction * static_cast<float>(index % base);
+		index /= base;
+	}
+	return result;
+}
+
+void ScrapEngine::Render::TemporalUpscaler::update(Camera* render_camera, const vk::Extent2D& render_extent)
+{
+	//Halton(2, 3) starting from 1, the first value is 0 for both the bases
+	jitter_index_ = jitter_index_ % settings_.jitter_phases + 1;
+	//Offset in pixels of the render extent, moved to ndc
+	const glm::vec2 jitter(
+		(halton(jitter_index_, 2) - 0.5f) * 2.0f / static_cast<float>(render_extent.width),
+		(halton(jitter_index_, 3) - 0.5f) * 2.0f / static_cast<float>(render_extent.height));
+	render_camera->set_projection_jitter(jitter);
+
+	//The reprojection goes from the current clip space to the previous one, both without jitter
+	const glm::mat4 view_projection = render_camera->get_camera_unjittered_projection_matrix() *
+		render_camera->get_camera_look_matrix();
+	if (!has_previous_view_projection_)
+	{
+		previous_view_projection_ = view_projection;
+		has_previous_view_projection_ = true;
+	}
+	push_constants_.reprojection = previous_view_projection_ * glm::inverse(view_projection);
+	//The meshes compute their velocity with the same matrices
+	render_camera->set_previous_view_projection(previous_view_projection_);
+	previous_view_projection_ = view_projection;
+
+	//The jitter moves the scene of +jitter in ndc, so it's sampled moved by the same amount in uv
+	push_constants_.jitter_scale = glm::vec4(
+		jitter * 0.5f,
+		static_cast<float>(render_extent.width) / static_cast<float>(output_extent_.width),
+		static_cast<float>(render_extent.height) / static_cast<float>(output_extent_.height));
+
+	history_index_ = (history_index_ + 1) % TemporalHistoryFrameBuffer::history_count;
+}
+
+void ScrapEngine::Render::TemporalUpscaler::record(const vk::CommandBuffer command_buffer, const vk::Image dst_image,
+                                                   const vk::Extent2D& render_extent)
+{
+	push_constants_.params.x = history_valid_ ? settings_.history_weight : 0.f;
+
+	//Resolve in the history written by this frame
+	const vk::RenderPassBeginInfo begin_info(
+		*render_pass_->get_render_pass(),
+		(*history_->get_framebuffers_vector())[history_index_],
+		vk::Rect2D(vk::Offset2D(), output_extent_)
+	);
+
+	command_buffer.beginRenderPass(&begin_info, vk::SubpassContents::eInline);
+	command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipeline_->get_graphics_pipeline());
+	command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipeline_->get_pipeline_layout(), 0, 1,
+	                                  &(*descriptor_set_->get_descriptor_sets())[history_index_], 0, nullptr);
+	command_buffer.pushConstants(*pipeline_->get_pipeline_layout(), vk::ShaderStageFlagBits::eFragment, 0,
+	                             sizeof(TemporalResolvePipeline::push_constant_block), &push_constants_);
+	command_buffer.draw(3, 1, 0, 0);
+	command_buffer.endRenderPass();
+
+	//The history has the swap chain resolution, so the blit only converts the format
+	const vk::ImageSubresourceLayers subresource(vk::ImageAspectFlagBits::eColor, 0, 0, 1);
+
+	vk::ImageBlit blit;
+	blit.setSrcSubresource(subresource);
+	blit.srcOffsets[1] = vk::Offset3D(static_cast<int32_t>(output_extent_.width),
+	                                  static_cast<int32_t>(output_extent_.height), 1);
+	blit.setDstSubresource(subresource);
+	blit.dstOffsets[1] = blit.srcOffsets[1];
+
+	command_buffer.blitImage(history_->get_image(history_index_), vk::ImageLayout::eTransferSrcOptimal,
+	                         dst_image, vk::ImageLayout::eTransferDstOptimal, 1, &blit, vk::Filter::eNearest);
+
+	if (image_check_)
+	{
+		image_check_->record(command_buffer, history_->get_image(history_index_));
+	}
+
+	//The next frame reads this history
+	vk::ImageMemoryBarrier barrier(
+		vk::AccessFlagBits::eTransferRead,
+		vk::AccessFlagBits::eShaderRead,
+		vk::ImageLayout::eTransferSrcOptimal,
+		vk::ImageLayout::eShaderReadOnlyOptimal,
+		VK_QUEUE_FAMILY_IGNORED,
+		VK_QUEUE_FAMILY_IGNORED,
+		history_->get_image(history_index_),
+		vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1)
+	);
+
+	command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader,
+	                               vk::DependencyFlags(), 0, nullptr, 0, nullptr, 1, &barrier);
+
+	history_valid_ = true;
+}
+
+void ScrapEngine::Render::TemporalUpscaler::reset_history()
+{
+	history_valid_ = false;
+	has_previous_view_projection_ = false;
+}
+
+void ScrapEngine::Render::TemporalUpscaler::start_image_check(const uint32_t frame_count, const float max_mean_error)
+{
+	if (image_check_)
+	{
+		return;
+	}
+	//The first frame of the check is the reference, resolved without history
+	image_check_ = new TemporalImageCheck(output_extent_, std::max(frame_count, 1u), max_mean_error);
+	reset_history();
+}
+
+void ScrapEngine::Render::TemporalUpscaler::update_image_check(VulkanFrameTimeline* frame_timeline)
+{
+	if (!image_check_ || !image_check_->is_recorded())
+	{
+		return;
+	}
+	//The last copy is in the last submitted frame
+	if (image_check_->get_frame_value() == 0)
+	{
+		image_check_->set_frame_value(frame_timeline->get_submitted_value());
+	}
+	if (frame_timeline->is_completed(image_check_->get_frame_value()))
+	{
+		image_check_result_ = image_check_->compare() ? image_check_result::passed : image_check_result::failed;
+		delete image_check_;
+		image_check_ = nullptr;
+	}
+}
+
+bool ScrapEngine::Render::TemporalUpscaler::is_image_check_running() const
+{
+	return image_check_ != nullptr;
+}
+
+ScrapEngine::Render::TemporalUpscaler::image_check_result ScrapEngine::Render::TemporalUpscaler::
+get_image_check_result() const
+{
+	return image_check_result_;
+}
+
+vk::Extent2D ScrapEngine::Render::TemporalUpscaler::get_render_extent(const vk::Extent2D& full_extent) const
+{
+	return vk::Extent2D(
+		std::max(static_cast<uint32_t>(static_cast<float>(full_extent.width) * settings_.render_scale), 1u),
+		std::max(static_cast<uint32_t>(static_cast<float>(full_extent.height) * settings_.render_scale), 1u));
+}
+
+void ScrapEngine::Render::TemporalUpscaler::set_settings(const settings& input_settings)
+{
+	settings_ = input_settings;
+	settings_.render_scale = std::min(std::max(settings_.render_scale, 0.1f), 1.0f);
+	settings_.history_weight = std::min(std::max(settings_.history_weight, 0.0f), 0.98f);
+	settings_.jitter_phases = std::max(settings_.jitter_phases, 1u);
+}
+
+const ScrapEngine::Render::TemporalUpscaler::settings& ScrapEngine::Render::TemporalUpscaler::get_settings() const
+{
+	return settings_;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <Engine/Rendering/VulkanInclude.h>
+#include <Engine/Rendering/Pipeline/TemporalResolvePipeline/TemporalResolvePipeline.h>
+#include <glm/mat4x4.hpp>
+
+namespace ScrapEngine
+{
+	namespace Render
+	{
+		class Camera;
+		class TemporalResolveRenderPass;
+		class TemporalHistoryFrameBuffer;
+		class TemporalResolveDescriptorSet;
+		class StandardDescriptorPool;
+		class TemporalImageCheck;
+		class VulkanFrameTimeline;
+
+		//Draw the scene at a lower resolution with a different sub pixel jitter every frame,
+		//then accumulate the frames in a full resolution history reprojected with the camera movement
+		//The meshes write their velocity with the scene, where nothing is drawn the velocity of the camera
+		//is reconstructed from the scene depth, the disocclusions are handled by the neighborhood clamp
+		class TemporalUpscaler
+		{
+		public:
+			struct settings
+			{
+				//Scale of each axis of the scene, the history is at the swap chain resolution
+				float render_scale = 0.6f;
+				//Weight of the history in the resolved pixel, higher is smoother but blurrier in motion
+				float history_weight = 0.9f;
+				//Length of the jitter sequence
+				uint32_t jitter_phases = 8;
+			};
+
+			enum class image_check_result
+			{
+				//No check completed yet
+				none,
+				passed,
+				failed
+			};
+		private:
+			settings settings_;
+			vk::Extent2D output_extent_;
+
+			TemporalResolveRenderPass* render_pass_ = nullptr;
+			TemporalHistoryFrameBuffer* history_ = nullptr;
+			StandardDescriptorPool* descriptor_pool_ = nullptr;
+			TemporalResolveDescriptorSet* descriptor_set_ = nullptr;
+			TemporalResolvePipeline* pipeline_ = nullptr;
+			vk::Sampler depth_sampler_;
+
+			uint32_t jitter_index_ = 0;
+			//History written by the current frame, the other one is read
+			uint32_t history_index_ = 0;
+			bool history_valid_ = false;
+			bool has_previous_view_projection_ = false;
+			glm::mat4 previous_view_projection_ = glm::mat4(1.0f);
+			TemporalResolvePipeline::push_constant_block push_constants_;
+			//nullptr if no check is running
+			TemporalImageCheck* image_check_ = nullptr;
+			image_check_result image_check_result_ = image_check_result::none;
+
+			static float halton(uint32_t index, uint32_t base);
+		public:
+			//scene_color_view and velocity_view must be readable in eShaderReadOnlyOptimal
+			//and the depth in eDepthStencilReadOnlyOptimal
+			TemporalUpscaler(const settings& input_settings, const vk::Extent2D& output_extent,
+			                 vk::ImageView scene_color_view, vk::ImageView* depth_view, vk::ImageView velocity_view);
+			//The gpu must not use the upscaler anymore
+			~TemporalUpscaler();
+
+			//True if the resolve shaders are available
+			static bool is_supported();
+
+			//Set the jitter of the camera and the reprojection for the frame that will be recorded
+			void update(Camera* render_camera, const vk::Extent2D& render_extent);
+			//Resolve the scene in the history, then copy it in dst_image that must be in eTransferDstOptimal
+			void record(vk::CommandBuffer command_buffer, vk::Image dst_image, const vk::Extent2D& render_extent);
+			//The next frame is drawn without history, for example after a camera cut
+			void reset_history();
+
+			//Start the image diff check of the resolve, see TemporalImageCheck, the history is reset
+			//Called while the render thread is not recording
+			void start_image_check(uint32_t frame_count, float max_mean_error);
+			//Compare the images once the frame that copied them is completed, then end the check
+			//Called while the render thread is not recording
+			void update_image_check(VulkanFrameTimeline* frame_timeline);
+			bool is_image_check_running() const;
+			//Result of the last completed check
+			image_check_result get_image_check_result() const;
+
+			//Part of the scene color drawn with the render scale, at least 1x1
+			vk::Extent2D get_render_extent(const vk::Extent2D& full_extent) const;
+			void set_settings(const settings& input_settings);
+			const settings& get_settings() const;
+		};
+	}
+}
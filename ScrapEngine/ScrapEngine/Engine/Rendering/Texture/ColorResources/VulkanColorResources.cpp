@@ -1,5 +1,4 @@
 #include <Engine/Rendering/Texture/ColorResources/VulkanColorResources.h>
-#include <Engine/Rendering/Texture/Texture/BaseTexture.h>
 #include <Engine/Rendering/Texture/TextureImageView/TextureImageView.h>
 #include <Engine/Rendering/Device/VulkanDevice.h>
 #include <Engine/Rendering/Memory/VulkanMemoryAllocator.h>
@@ -24,13 +23,13 @@ ScrapEngine::Render::VulkanColorResources::VulkanColorResources(const vk::Sample
 		vk::SharingMode::eExclusive
 	);
 
-	VulkanMemoryAllocator::get_instance()->create_texture_image(&image_info, color_image_, color_image_memory_);
+	//The image is cleared and resolved inside the render pass, it can live in lazily allocated memory
+	VulkanMemoryAllocator::get_instance()->create_transient_attachment_image(&image_info, color_image_,
+	                                                                         color_image_memory_);
 
+	//No layout transition, the render pass starts from eUndefined
 	color_image_view_ = TextureImageView::create_image_view(
 		&color_image_, color_format, vk::ImageAspectFlagBits::eColor, 1);
-
-	BaseTexture::transition_image_layout(&color_image_, color_format, vk::ImageLayout::eUndefined,
-	                                     vk::ImageLayout::eColorAttachmentOptimal, 1);
 }
 
 
@@ -83,6 +83,14 @@ void ScrapEngine::Render::BaseTexture::transition_image_layout(vk::Image* image,
 		source_stage = vk::PipelineStageFlagBits::eTopOfPipe;
 		destination_stage = vk::PipelineStageFlagBits::eEarlyFragmentTests;
 	}
+	else if (old_layout == vk::ImageLayout::eUndefined && new_layout == vk::ImageLayout::eShaderReadOnlyOptimal)
+	{
+		barrier.srcAccessMask = vk::AccessFlags();
+		barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+
+		source_stage = vk::PipelineStageFlagBits::eTopOfPipe;
+		destination_stage = vk::PipelineStageFlagBits::eFragmentShader;
+	}
 	else if (old_layout == vk::ImageLayout::eUndefined && new_layout == vk::ImageLayout::eColorAttachmentOptimal)
 	{
 		barrier.srcAccessMask = vk::AccessFlags();
@@ -2,9 +2,11 @@
 #include <Engine/Rendering/DepthResources/VulkanDepthResources.h>
 #include <Engine/Rendering/Buffer/StagingBuffer/ImageStagingBuffer/ImageStagingBuffer.h>
 #include <Engine/Debug/DebugLog.h>
+#include <Engine/Debug/CpuProfiler.h>
 
 ScrapEngine::Render::SkyboxStagingTexture::SkyboxStagingTexture(const std::string& file_path)
 {
+	SCRAP_PROFILE_SCOPE("load_skybox_texture");
 	stbi_uc* pixels = stbi_load(file_path.c_str(), &tex_width_, &tex_height_, &tex_channels_, STBI_rgb_alpha);
 
 	const vk::DeviceSize image_size = tex_width_ * tex_height_ * 4;
@@ -3,23 +3,29 @@
 #include <Engine/Rendering/Buffer/StagingBuffer/ImageStagingBuffer/ImageStagingBuffer.h>
 #include <Engine/Rendering/Memory/VulkanMemoryAllocator.h>
 #include <Engine/Debug/DebugLog.h>
+#include <Engine/Debug/CpuProfiler.h>
 
 ScrapEngine::Render::StandardTexture::StandardTexture(const std::string& file_path)
+	: StandardTexture(file_path, decode(file_path))
 {
-	stbi_uc* pixels = stbi_load(file_path.c_str(), &tex_width_, &tex_height_, &tex_channels_, STBI_rgb_alpha);
-
-	const vk::DeviceSize image_size = tex_width_ * tex_height_ * 4;
-	mip_levels_ = static_cast<uint32_t>(std::floor(std::log2(std::max(tex_width_, tex_height_)))) + 1;
+}
 
-	if (!pixels)
+ScrapEngine::Render::StandardTexture::StandardTexture(const std::string& file_path, decoded_image image)
+	: tex_width_(image.width), tex_height_(image.height), tex_channels_(image.channels)
+{
+	SCRAP_PROFILE_SCOPE("load_texture");
+	if (!image.pixels)
 	{
 		Debug::DebugLog::fatal_error(vk::Result(-13), "TextureImage: Failed to load texture image! (pixels not valid) - " + file_path);
 	}
 
+	const vk::DeviceSize image_size = tex_width_ * tex_height_ * 4;
+	mip_levels_ = static_cast<uint32_t>(std::floor(std::log2(std::max(tex_width_, tex_height_)))) + 1;
+
 	const std::unique_ptr<BaseStagingBuffer> staginf_buffer_ref =
-		std::make_unique<ImageStagingBuffer>(image_size, pixels);
+		std::make_unique<ImageStagingBuffer>(image_size, image.pixels);
 
-	stbi_image_free(pixels);
+	release(image);
 
 	//Create the image
 
@@ -48,6 +54,24 @@ ScrapEngine::Render::StandardTexture::StandardTexture(const std::string& file_pa
 	generate_mipmaps(&texture_image_, vk::Format::eR8G8B8A8Unorm, tex_width_, tex_height_, mip_levels_);
 }
 
+ScrapEngine::Render::StandardTexture::decoded_image ScrapEngine::Render::StandardTexture::decode(
+	const std::string& file_path)
+{
+	SCRAP_PROFILE_SCOPE("decode_texture");
+	decoded_image image;
+	image.pixels = stbi_load(file_path.c_str(), &image.width, &image.height, &image.channels, STBI_rgb_alpha);
+	return image;
+}
+
+void ScrapEngine::Render::StandardTexture::release(decoded_image& image)
+{
+	if (image.pixels)
+	{
+		stbi_image_free(image.pixels);
+		image.pixels = nullptr;
+	}
+}
+
 void ScrapEngine::Render::StandardTexture::transition_image_layout(vk::Image* image, const vk::Format& format,
                                                                    const vk::ImageLayout& old_layout,
                                                                    const vk::ImageLayout& new_layout) const
@@ -9,10 +9,25 @@ namespace ScrapEngine
 	{
 		class StandardTexture : public BaseTexture
 		{
+		public:
+			//Pixels of a texture file, decoded without the device so a worker can do it
+			struct decoded_image
+			{
+				unsigned char* pixels = nullptr;
+				int width = 0;
+				int height = 0;
+				int channels = 0;
+			};
 		private:
 			int tex_width_, tex_height_, tex_channels_;
 		public:
 			StandardTexture(const std::string& file_path);
+			//Upload an image decoded by decode(), the constructor releases its pixels
+			StandardTexture(const std::string& file_path, decoded_image image);
+
+			//RGBA pixels, nullptr if the file cannot be read
+			static decoded_image decode(const std::string& file_path);
+			static void release(decoded_image& image);
 			~StandardTexture() = default;
 
 			void transition_image_layout(vk::Image* image, const vk::Format& format, const vk::ImageLayout& old_layout,
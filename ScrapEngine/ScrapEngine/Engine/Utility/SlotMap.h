@@ -0,0 +1,187 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <utility>
+
+namespace ScrapEngine
+{
+	//Reference to an element of a SlotMap
+	//When the element is erased its slot generation changes, so an old handle is detected as stale
+	struct slot_handle
+	{
+		uint32_t index = UINT32_MAX;
+		uint32_t generation = 0;
+
+		bool operator==(const slot_handle& other) const
+		{
+			return index == other.index && generation == other.generation;
+		}
+
+		bool operator!=(const slot_handle& other) const
+		{
+			return !(*this == other);
+		}
+	};
+
+	//Dense storage with stable handles
+	//The values are kept contiguous for the iteration, insert and erase are O(1)
+	//An erased value is replaced by the last one, so the order of the values is not kept
+	//The handles can also be reserved from any thread with reserve(), then the owner inserts the values
+	template <typename T>
+	class SlotMap
+	{
+	private:
+		struct slot
+		{
+			//Position of the value in values_ while the slot is used
+			uint32_t index = 0;
+			//Odd while the slot is used, so a reserved handle is not valid until its value is inserted
+			uint32_t generation = 0;
+		};
+
+		//Free slot with the generation of its next handle
+		struct free_slot
+		{
+			uint32_t index;
+			uint32_t generation;
+		};
+
+		std::vector<T> values_;
+		//Slot of each value, used to fix the slot of the value moved by the erase
+		std::vector<uint32_t> value_slots_;
+		std::vector<slot> slots_;
+
+		//Shared by reserve() and the owner, only this state is locked, never slots_ or values_
+		std::mutex free_mutex_;
+		std::vector<free_slot> free_slots_;
+		uint32_t slot_count_ = 0;
+	public:
+		SlotMap() = default;
+		~SlotMap() = default;
+		SlotMap(const SlotMap&) = delete;
+		SlotMap& operator=(const SlotMap&) = delete;
+
+		slot_handle insert(T value)
+		{
+			const slot_handle handle = reserve();
+			insert_reserved(handle, std::move(value));
+
+			return handle;
+		}
+
+		//Thread safe, also while the owner inserts and erases
+		//The handle stays invalid until the owner calls insert_reserved() with it
+		slot_handle reserve()
+		{
+			std::lock_guard<std::mutex> lock(free_mutex_);
+			if (!free_slots_.empty())
+			{
+				const free_slot reserved = free_slots_.back();
+				free_slots_.pop_back();
+				return slot_handle{reserved.index, reserved.generation};
+			}
+			return slot_handle{slot_count_++, 1};
+		}
+
+		void insert_reserved(const slot_handle& handle, T value)
+		{
+			if (handle.index >= slots_.size())
+			{
+				slots_.resize(handle.index + 1);
+			}
+			slots_[handle.index].index = static_cast<uint32_t>(values_.size());
+			slots_[handle.index].generation = handle.generation;
+			values_.push_back(std::move(value));
+			value_slots_.push_back(handle.index);
+		}
+
+		//True if the handle has been reserved but its value is not inserted yet
+		bool is_reserved(const slot_handle& handle) const
+		{
+			return handle.index >= slots_.size() || slots_[handle.index].generation < handle.generation;
+		}
+
+		bool contains(const slot_handle& handle) const
+		{
+			return handle.index < slots_.size() && slots_[handle.index].generation == handle.generation;
+		}
+
+		//Return nullptr if the handle is stale
+		T* get(const slot_handle& handle)
+		{
+			return contains(handle) ? &values_[slots_[handle.index].index] : nullptr;
+		}
+
+		const T* get(const slot_handle& handle) const
+		{
+			return contains(handle) ? &values_[slots_[handle.index].index] : nullptr;
+		}
+
+		//Return false if the handle is stale
+		bool erase(const slot_handle& handle)
+		{
+			if (!contains(handle))
+			{
+				return false;
+			}
+			erase_at(slots_[handle.index].index);
+			return true;
+		}
+
+		//Erase by position in values(), the last value takes its place
+		void erase_at(const size_t value_index)
+		{
+			const uint32_t slot_index = value_slots_[value_index];
+			const size_t last = values_.size() - 1;
+			if (value_index != last)
+			{
+				values_[value_index] = std::move(values_[last]);
+				value_slots_[value_index] = value_slots_[last];
+				slots_[value_slots_[value_index]].index = static_cast<uint32_t>(value_index);
+			}
+			values_.pop_back();
+			value_slots_.pop_back();
+			//The old handles of the slot become stale
+			slots_[slot_index].generation++;
+			std::lock_guard<std::mutex> lock(free_mutex_);
+			free_slots_.push_back(free_slot{slot_index, slots_[slot_index].generation + 1});
+		}
+
+		const std::vector<T>& values() const
+		{
+			return values_;
+		}
+
+		size_t size() const
+		{
+			return values_.size();
+		}
+
+		bool empty() const
+		{
+			return values_.empty();
+		}
+
+		typename std::vector<T>::iterator begin()
+		{
+			return values_.begin();
+		}
+
+		typename std::vector<T>::iterator end()
+		{
+			return values_.end();
+		}
+
+		typename std::vector<T>::const_iterator begin() const
+		{
+			return values_.begin();
+		}
+
+		typename std::vector<T>::const_iterator end() const
+		{
+			return values_.end();
+		}
+	};
+}
@@ -4,6 +4,22 @@
 
 namespace ScrapEngine
 {
+	//Present mode requested for the swap chain
+	//If the requested mode is not supported the engine fallback to the automatic selection
+	enum class present_mode
+	{
+		//Choose using the vsync flag: fifo with vsync, otherwise mailbox or immediate
+		automatic,
+		//Wait for the vertical blank, no tearing
+		fifo,
+		//Like fifo, but a late frame is presented immediately and can tear
+		fifo_relaxed,
+		//Replace the queued frame with the newest one, lower latency without tearing
+		mailbox,
+		//Present immediately, lowest latency but can tear
+		immediate
+	};
+
 	struct game_base_info
 	{
 		std::string app_name;
@@ -14,6 +30,49 @@ namespace ScrapEngine
 		bool window_fullscreen = false;
 		bool vsync = true;
 
+		present_mode requested_present_mode = present_mode::automatic;
+		//Number of swap chain images, 0 to use the minimum supported + 1
+		uint32_t swap_chain_image_count = 0;
+		//Number of frames the cpu can prepare while the gpu is still drawing
+		//Clamped to the swap chain image count
+		uint32_t max_frames_in_flight = 2;
+		//Number of msaa samples, 0 to use the maximum supported, 1 to disable msaa
+		//Rounded down to a count supported by the device
+		uint32_t msaa_samples = 0;
+		//Draw the depth of the opaque meshes before shading them, useful when the shading is expensive
+		bool depth_prepass = false;
+		//Show the draw calls and binds of the scene in an overlay
+		bool show_render_stats = false;
+		//Scale the scene resolution to keep the gpu frame time in the target, the gui stays at full resolution
+		//Without it (and without temporal upscaling) the scene is drawn directly in the swap chain image
+		bool dynamic_resolution = false;
+		//Bounds of the resolution scale of each axis, in (0, 1]
+		float dynamic_resolution_min_scale = 0.5f;
+		float dynamic_resolution_max_scale = 1.0f;
+		float dynamic_resolution_target_ms = 16.6f;
+		//Draw the scene at a lower resolution with a jittered projection and accumulate it at full resolution
+		//Disables msaa, falls back to the plain upscale if the resolve shaders are not compiled
+		bool temporal_upscaling = false;
+		//Resolution scale of each axis used when the dynamic resolution is disabled, in (0, 1]
+		float temporal_upscaling_scale = 0.6f;
+		//If not 0 the image diff check of the temporal resolve starts at this frame and logs its result
+		//The camera must not move during the check, see RenderManagerView::request_temporal_upscaling_check
+		uint32_t temporal_upscaling_check_frame = 0;
+		//Unattended test run, if not 0 the game loop ends after this many frames
+		//With temporal_upscaling_check_frame the run ends with a fatal error if the check failed or didn't
+		//complete, so it must leave at least the check frames (64 by default) after the check frame
+		uint32_t test_frame_count = 0;
+		//Show the gpu time of the shadow map, scene, skybox and gui passes in a panel (the frame time is always measured)
+		bool gpu_pass_profiler = false;
+		//Count the vertex and fragment shader invocations of the passes too, if supported by the device
+		bool gpu_pass_profiler_statistics = false;
+		//If not empty the profiler writes a csv row for every frame in this file
+		std::string gpu_pass_profiler_csv_path;
+		//Record the cpu zones (SCRAP_PROFILE_SCOPE) from the engine initialization
+		bool cpu_profiler = false;
+		//If not empty the cpu zones are written in this file as Chrome trace json when the engine is closed
+		std::string cpu_profiler_trace_path;
+
 		game_base_info(const std::string& input_app_name, const int input_app_version,
 		               const uint32_t input_window_width, const uint32_t input_window_height,
 		               const bool input_window_fullscreen, const bool input_vsync)
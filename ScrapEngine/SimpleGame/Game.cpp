@@ -1,4 +1,5 @@
 #include <iostream>
+#include <cstring>
 #include <Engine/Manager/EngineManager.h>
 #include <Engine/Input/Manager/InputManager.h>
 #include <Engine/LogicCore/Scene/SceneManager.h>
@@ -17,14 +18,23 @@
 #include "GameObjects/MainMenu/MainMenu.h"
 #include "GameObjects/ScoreManager/ScoreManager.h"
 
-int main()
+int main(int argc, char* argv[])
 {
 	short exit_value = EXIT_SUCCESS;
+	//Test run: render a fixed number of frames, run the temporal upscaling check and exit with its result
+	const bool temporal_upscaling_test = argc > 1 && strcmp(argv[1], "--temporal-upscaling-check") == 0;
 	ScrapEngine::Manager::EngineManager* scrap_engine_manager = nullptr;
 	try
 	{
 		//Init engine
-		scrap_engine_manager = new ScrapEngine::Manager::EngineManager("Example Game", 0, 1280, 720);
+		ScrapEngine::game_base_info game_info("Example Game", 0, 1280, 720, false, true);
+		if (temporal_upscaling_test)
+		{
+			game_info.temporal_upscaling = true;
+			game_info.temporal_upscaling_check_frame = 120;
+			game_info.test_frame_count = 300;
+		}
+		scrap_engine_manager = new ScrapEngine::Manager::EngineManager(game_info);
 		ScrapEngine::Render::GameWindow* game_window_ref = scrap_engine_manager->render_manager_view->get_game_window();
 		game_window_ref->set_window_icon("../assets/game_icon/crate_icon.png");
 		//Create the input manager
@@ -103,7 +113,7 @@ int main()
 	//Delete
 	delete scrap_engine_manager;
 	//Display error message
-	if (exit_value == EXIT_FAILURE)
+	if (exit_value == EXIT_FAILURE && !temporal_upscaling_test)
 	{
 		//Exit failure, wait to close
 		std::cout << std::endl << "EXIT_FAILURE - Press to exit..." << std::endl;
@@ -112,7 +122,7 @@ int main()
 	}
 	else
 	{
-		std::cout << std::endl << "EXIT_SUCCESS" << std::endl;
+		std::cout << std::endl << (exit_value == EXIT_SUCCESS ? "EXIT_SUCCESS" : "EXIT_FAILURE") << std::endl;
 	}
 	//End of program
 	return exit_value;
@@ -16,8 +16,8 @@ CheckpointTrigger::CheckpointTrigger(ScrapEngine::Core::LogicManagerView* logic_
 	pos_ = pos;
 
 	//Get component
-	ScrapEngine::Core::RigidBodyComponent* component = dynamic_cast<ScrapEngine::Core::RigidBodyComponent*>((*
-		player_ref_->get_components())[1]);
+	ScrapEngine::Core::RigidBodyComponent* component = player_ref_->get_component<
+		ScrapEngine::Core::RigidBodyComponent>();
 	if (component)
 	{
 		test_collision_object_ = component;
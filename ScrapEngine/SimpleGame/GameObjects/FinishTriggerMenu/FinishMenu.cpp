@@ -14,8 +14,8 @@ FinishTriggerMenu::FinishTriggerMenu(ScrapEngine::Core::LogicManagerView* logic_
 	set_object_location(ScrapEngine::Core::SVector3(425, -20, 75));
 	
 	//Get component
-	ScrapEngine::Core::RigidBodyComponent* component = dynamic_cast<ScrapEngine::Core::RigidBodyComponent*>((*
-		player_ref_->get_components())[1]);
+	ScrapEngine::Core::RigidBodyComponent* component = player_ref_->get_component<
+		ScrapEngine::Core::RigidBodyComponent>();
 	if (component)
 	{
 		test_collision_object_ = component;
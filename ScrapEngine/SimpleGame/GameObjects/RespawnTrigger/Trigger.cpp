@@ -11,10 +11,9 @@ Trigger::Trigger(ScrapEngine::Core::ComponentsManager* input_component_manager)
 		ScrapEngine::Core::SVector3(0, -150, 0));
 }
 
-void Trigger::add_collision_test(SGameObject* obj, const int index)
+void Trigger::add_collision_test(SGameObject* obj)
 {
-	ScrapEngine::Core::RigidBodyComponent* component = nullptr;
-	component = dynamic_cast<ScrapEngine::Core::RigidBodyComponent*>((*obj->get_components())[index]);
+	ScrapEngine::Core::RigidBodyComponent* component = obj->get_component<ScrapEngine::Core::RigidBodyComponent>();
 	if (component)
 	{
 		test_collision_objects_.push_back(component);
@@ -23,7 +23,7 @@ public:
 	Trigger(ScrapEngine::Core::ComponentsManager* input_component_manager);
 	~Trigger() = default;
 
-	void add_collision_test(SGameObject* obj, int index = 1);
+	void add_collision_test(SGameObject* obj);
 
 	void game_update(float time) override;
 };
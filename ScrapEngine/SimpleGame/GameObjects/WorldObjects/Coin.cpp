@@ -8,38 +8,26 @@
 
 Coin::Coin(ScrapEngine::Core::LogicManagerView* logic_manager_ref,
            const ScrapEngine::Core::SVector3& start_pos,
-           ScoreManager* score_manager)
+           ScoreManager* score_manager,
+           const ScrapEngine::Core::prefab_id coin_prefab)
 	: SGameObject("Coin game object"), logic_manager_view_(logic_manager_ref),
 	  component_manager_ref_(logic_manager_ref->get_components_manager()),
 	  score_manager_ref_(score_manager)
 {
 	set_object_location(start_pos);
-	//Add mesh to that GameObject
-	mesh_ = component_manager_ref_->create_new_mesh_component(
-		"../assets/models/coin.obj",
-		{"../assets/textures/SimpleYellowTexture.png"}
-	);
-	add_component(mesh_);
-
-	//Set mesh scale
-	mesh_->set_component_scale(ScrapEngine::Core::SVector3(0.7f, 0.7f, 0.7f));
-
-	//Trigger
-	box_trigger_ = component_manager_ref_->create_box_trigger_component(
-		ScrapEngine::Core::SVector3(8, 8, 8),
-		start_pos);
-	add_component(box_trigger_);
-
-	//Sound
-	coin_sound_ = component_manager_ref_->create_3d_sound("../assets/sounds/coin_sound.wav");
-	coin_sound_->set_component_location(start_pos);
-	coin_sound_->set_source_gain(100);
+	//Mesh, trigger and sound come from the pool already placed at start_pos
+	instance_ = component_manager_ref_->acquire_prefab(coin_prefab, ScrapEngine::Core::STransform(start_pos));
+	mesh_ = instance_->mesh;
+	box_trigger_ = instance_->trigger;
+	coin_sound_ = instance_->sound;
+	//Keep the prefab scale of the mesh
+	add_component(mesh_, false);
+	add_component(box_trigger_, false);
 }
 
-void Coin::set_collision_test(SGameObject* obj, const int index)
+void Coin::set_collision_test(SGameObject* obj)
 {
-	ScrapEngine::Core::RigidBodyComponent* component = nullptr;
-	component = dynamic_cast<ScrapEngine::Core::RigidBodyComponent*>((*obj->get_components())[index]);
+	ScrapEngine::Core::RigidBodyComponent* component = obj->get_component<ScrapEngine::Core::RigidBodyComponent>();
 	if (component)
 	{
 		test_collision_object_ = component;
@@ -51,15 +39,10 @@ void Coin::game_update(const float time)
 	if (sound_started_ && !coin_sound_->is_playing())
 	{
 		set_should_update(false);
-		//Destroy sound
-		coin_sound_->stop();
-		component_manager_ref_->unload_sound(coin_sound_);
-		//Delete trigger
-		component_manager_ref_->destroy_trigger_component(box_trigger_);
-		//Delete mesh
-		//REMEMBER, after this call the pointer is no longer valid and should not be used
-		//ALSO if the mesh is connected to a rigidbody, you must delete BOTH togheder to avoid errors
-		component_manager_ref_->destroy_mesh_component(mesh_);
+		//Give mesh, trigger and sound back to the pool, they are reused by the next coin
+		//REMEMBER, after this call the components are no longer owned by this coin and should not be used
+		component_manager_ref_->release_prefab(instance_);
+		instance_ = nullptr;
 		//Delete this
 		logic_manager_view_->un_register_game_object(this);
 	}
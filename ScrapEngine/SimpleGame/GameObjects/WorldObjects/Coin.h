@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Engine/LogicCore/GameObject/SGameObject.h>
+#include <Engine/LogicCore/Components/Manager/ComponentsManager.h>
 #include "../ScoreManager/ScoreManager.h"
 
 namespace ScrapEngine
@@ -19,6 +20,8 @@ private:
 	//Utils
 	ScrapEngine::Core::LogicManagerView* logic_manager_view_ = nullptr;
 	ScrapEngine::Core::ComponentsManager* component_manager_ref_ = nullptr;
+	//Pooled mesh, trigger and sound, given back to the pool when the coin is collected
+	ScrapEngine::Core::prefab_instance* instance_ = nullptr;
 	//Mesh
 	ScrapEngine::Core::MeshComponent* mesh_ = nullptr;
 	//Trigger
@@ -32,10 +35,11 @@ private:
 public:
 	Coin(ScrapEngine::Core::LogicManagerView* logic_manager_ref,
 	     const ScrapEngine::Core::SVector3& start_pos,
-	     ScoreManager* score_manager);
+	     ScoreManager* score_manager,
+	     ScrapEngine::Core::prefab_id coin_prefab);
 	~Coin() = default;
 
-	void set_collision_test(SGameObject* obj, int index = 1);
+	void set_collision_test(SGameObject* obj);
 
 	void game_update(float time) override;
 };
@@ -9,9 +9,10 @@ void WorldObjectsCreator::create_crate(const ScrapEngine::Core::SVector3& pos)
 	crates_.push_back(new Crate(logic_manager_ref_, pos));
 }
 
-void WorldObjectsCreator::create_coin(const ScrapEngine::Core::SVector3& pos) const
+void WorldObjectsCreator::create_coin(const ScrapEngine::Core::SVector3& pos,
+                                      const ScrapEngine::Core::prefab_id coin_prefab) const
 {
-	Coin* coin = new Coin(logic_manager_ref_, pos, score_manager_ref_);
+	Coin* coin = new Coin(logic_manager_ref_, pos, score_manager_ref_, coin_prefab);
 	coin->set_collision_test(player_ref_);
 	logic_manager_ref_->register_game_object(coin);
 }
@@ -69,27 +70,45 @@ void WorldObjectsCreator::create_crates()
 
 void WorldObjectsCreator::create_coins() const
 {
-	//First corridor
-	create_coin(ScrapEngine::Core::SVector3(0, -10, -150));
-	create_coin(ScrapEngine::Core::SVector3(0, -10, -200));
-	create_coin(ScrapEngine::Core::SVector3(0, -10, -250));
-	create_coin(ScrapEngine::Core::SVector3(0, -10, -300));
-	create_coin(ScrapEngine::Core::SVector3(0, -10, -350));
-	//After first respawn
-	create_coin(ScrapEngine::Core::SVector3(75, -10, -400));
-	create_coin(ScrapEngine::Core::SVector3(100, -10, -400));
-	//Second right terrain after first respawn
-	create_coin(ScrapEngine::Core::SVector3(300, -10, -475));
-	create_coin(ScrapEngine::Core::SVector3(350, -10, -475));
-	create_coin(ScrapEngine::Core::SVector3(400, -10, -475));
-	create_coin(ScrapEngine::Core::SVector3(470, -10, -500));
-	//Before second respawn
-	create_coin(ScrapEngine::Core::SVector3(350, -10, -225));
-	//Before crates after second respawn
-	create_coin(ScrapEngine::Core::SVector3(325, -10, -100));
-	//Last coins on angles
-	create_coin(ScrapEngine::Core::SVector3(250, -10, -70));
-	create_coin(ScrapEngine::Core::SVector3(450, -10, -120));
+	const std::vector<ScrapEngine::Core::SVector3> positions = {
+		//First corridor
+		ScrapEngine::Core::SVector3(0, -10, -150),
+		ScrapEngine::Core::SVector3(0, -10, -200),
+		ScrapEngine::Core::SVector3(0, -10, -250),
+		ScrapEngine::Core::SVector3(0, -10, -300),
+		ScrapEngine::Core::SVector3(0, -10, -350),
+		//After first respawn
+		ScrapEngine::Core::SVector3(75, -10, -400),
+		ScrapEngine::Core::SVector3(100, -10, -400),
+		//Second right terrain after first respawn
+		ScrapEngine::Core::SVector3(300, -10, -475),
+		ScrapEngine::Core::SVector3(350, -10, -475),
+		ScrapEngine::Core::SVector3(400, -10, -475),
+		ScrapEngine::Core::SVector3(470, -10, -500),
+		//Before second respawn
+		ScrapEngine::Core::SVector3(350, -10, -225),
+		//Before crates after second respawn
+		ScrapEngine::Core::SVector3(325, -10, -100),
+		//Last coins on angles
+		ScrapEngine::Core::SVector3(250, -10, -70),
+		ScrapEngine::Core::SVector3(450, -10, -120)
+	};
+	//All the coins share the same mesh, trigger and sound description
+	ScrapEngine::Core::ComponentsManager* components_manager = logic_manager_ref_->get_components_manager();
+	ScrapEngine::Core::prefab_description coin_description;
+	coin_description.model_path = "../assets/models/coin.obj";
+	coin_description.textures_path = {"../assets/textures/SimpleYellowTexture.png"};
+	coin_description.mesh_scale = ScrapEngine::Core::SVector3(0.7f, 0.7f, 0.7f);
+	coin_description.trigger_size = ScrapEngine::Core::SVector3(8, 8, 8);
+	coin_description.sound_path = "../assets/sounds/coin_sound.wav";
+	coin_description.sound_gain = 100;
+	const ScrapEngine::Core::prefab_id coin_prefab = components_manager->register_prefab(coin_description);
+	components_manager->prewarm_prefab(coin_prefab, positions.size());
+
+	for (const ScrapEngine::Core::SVector3& position : positions)
+	{
+		create_coin(position, coin_prefab);
+	}
 }
 
 void WorldObjectsCreator::create_checkpoints() const
@@ -2,6 +2,7 @@
 
 #include "../RespawnTrigger/Trigger.h"
 #include "../ScoreManager/ScoreManager.h"
+#include <Engine/LogicCore/Components/Manager/ComponentsManager.h>
 #include <list>
 
 namespace ScrapEngine
@@ -16,7 +17,7 @@ class WorldObjectsCreator
 {
 private:
 	void create_crate(const ScrapEngine::Core::SVector3& pos);
-	void create_coin(const ScrapEngine::Core::SVector3& pos) const;
+	void create_coin(const ScrapEngine::Core::SVector3& pos, ScrapEngine::Core::prefab_id coin_prefab) const;
 	void create_checkpoint(const ScrapEngine::Core::SVector3& pos) const;
 	//Creation methods
 	void create_crates();
@@ -10,10 +10,14 @@ layout (location = 2) in vec2 fragTexCoord;
 layout (location = 3) in vec3 inViewVec;
 layout (location = 4) in vec3 inLightVec;
 layout (location = 5) in vec4 inShadowCoord;
+layout (location = 6) in vec4 inCurrentClip;
+layout (location = 7) in vec4 inPreviousClip;
 
 layout (constant_id = 0) const int enablePCF = 0;
 
 layout (location = 0) out vec4 outFragColor;
+// Movement in uv since the previous frame, read by the temporal resolve
+layout (location = 1) out vec2 outVelocity;
 
 #define ambient 0.1
 
@@ -66,4 +70,6 @@ void main()
 
 	outFragColor = vec4(diffuse * shadow, 1.0);
 
+	outVelocity = (inCurrentClip.xy / inCurrentClip.w - inPreviousClip.xy / inPreviousClip.w) * 0.5;
+
 }
\ No newline at end of file
@@ -7,6 +7,8 @@ layout(binding = 0) uniform UniformBufferObject {
     mat4 proj;
     mat4 lightSpace;
 	vec3 lightPos;
+	mat4 unjitteredMVP;
+	mat4 previousMVP;
 } ubo;
 
 layout(location = 0) in vec3 inPosition;
@@ -20,9 +22,11 @@ layout(location = 2) out vec2 fragTexCoord;
 layout(location = 3) out vec3 outViewVec;
 layout(location = 4) out vec3 outLightVec;
 layout(location = 5) out vec4 outShadowCoord;
+layout(location = 6) out vec4 outCurrentClip;
+layout(location = 7) out vec4 outPreviousClip;
 
 out gl_PerVertex {
-    vec4 gl_Position;
+    invariant vec4 gl_Position;
 };
 
 const mat4 biasMat = mat4( 
@@ -46,4 +50,8 @@ void main()
     outViewVec = -pos.xyz;			
 
 	outShadowCoord = ( biasMat * ubo.lightSpace * ubo.model ) * vec4(inPosition, 1.0);	
+
+	// Positions without jitter in this frame and in the previous one, for the velocity
+	outCurrentClip = ubo.unjitteredMVP * vec4(inPosition, 1.0);
+	outPreviousClip = ubo.previousMVP * vec4(inPosition, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+#version 450
+
+layout (binding = 0) uniform sampler2D sceneColor;
+layout (binding = 1) uniform sampler2D sceneDepth;
+layout (binding = 2) uniform sampler2D history;
+layout (binding = 3) uniform sampler2D sceneVelocity;
+
+layout (push_constant) uniform PushConstants {
+	// Current clip space (unjittered) to previous clip space
+	mat4 reprojection;
+	// xy: jitter of the current frame in uv, zw: render extent / output extent
+	vec4 jitterScale;
+	// x: weight of the history, 0 when the history is not valid
+	vec4 params;
+} pushConstants;
+
+layout (location = 0) in vec2 inUV;
+
+layout (location = 0) out vec4 outFragColor;
+
+// The velocity is cleared to a bigger value where no mesh is drawn, see StandardRenderPass
+const float noVelocity = 1000.0;
+
+void main() 
+{
+	// The scene is drawn in the top left part of the scene color, with the jitter of the frame
+	// The samples are kept inside the drawn part, the rest of the image is not cleared
+	vec2 texel = 1.0 / vec2(textureSize(sceneColor, 0));
+	vec2 maxSceneUV = pushConstants.jitterScale.zw - 0.5 * texel;
+	vec2 sceneUV = min((inUV + pushConstants.jitterScale.xy) * pushConstants.jitterScale.zw, maxSceneUV);
+	vec3 current = texture(sceneColor, sceneUV).rgb;
+
+	// The meshes write their velocity, where nothing is drawn (the skybox)
+	// the velocity of the camera is reconstructed from the depth
+	vec2 velocity = texture(sceneVelocity, sceneUV).xy;
+	float depth = texture(sceneDepth, sceneUV).r;
+	vec4 previousClip = pushConstants.reprojection * vec4(inUV * 2.0 - 1.0, depth, 1.0);
+	vec2 cameraUV = (previousClip.xy / previousClip.w) * 0.5 + 0.5;
+	vec2 previousUV = velocity.x < noVelocity ? inUV - velocity : cameraUV;
+
+	// Clamp the history to the neighborhood of the current sample to reject the disoccluded pixels
+	vec3 neighborhoodMin = current;
+	vec3 neighborhoodMax = current;
+	for (int x = -1; x <= 1; x++)
+	{
+		for (int y = -1; y <= 1; y++)
+		{
+			vec3 neighbor = texture(sceneColor, clamp(sceneUV + vec2(x, y) * texel, vec2(0.0), maxSceneUV)).rgb;
+			neighborhoodMin = min(neighborhoodMin, neighbor);
+			neighborhoodMax = max(neighborhoodMax, neighbor);
+		}
+	}
+	vec3 previous = clamp(texture(history, previousUV).rgb, neighborhoodMin, neighborhoodMax);
+
+	bool outside = any(lessThan(previousUV, vec2(0.0))) || any(greaterThan(previousUV, vec2(1.0)));
+	float historyWeight = outside ? 0.0 : pushConstants.params.x;
+
+	outFragColor = vec4(mix(current, previous, historyWeight), 1.0);
+}